@@ -42,6 +42,16 @@ Base::Log::Level getCurrentLogLevel() { return currentLogLevel; }
 
 bool logAdvanced() { return islogAdvanced; }
 
+bool flightRecorder() { return flightRecorderEnabled; }
+
+u32 flightRecorderEntries() {
+  return flightRecorderEntryCount > 0 ? static_cast<u32>(flightRecorderEntryCount) : 0;
+}
+
+Base::Log::Level flightRecorderLevel() { return flightRecorderLogLevel; }
+
+const std::string &flightRecorderFilter() { return flightRecorderLogFilter; }
+
 int smcCurrentAvPack() { return smcAvPackType; }
 
 int smcPowerOnType() { return smcPowerOnReason; }
@@ -50,6 +60,14 @@ u64 HW_INIT_SKIP1() { return SKIP_HW_INIT_1; }
 
 u64 HW_INIT_SKIP2() { return SKIP_HW_INIT_2; }
 
+int ppuWorkers() { return ppuWorkerCount; }
+
+int ppuAffinity() { return ppuWorkerAffinity; }
+
+bool spinLoopSkip() { return spinLoopSkipEnabled; }
+
+bool smtHostThreads() { return smtHostThreadsEnabled; }
+
 s32 windowWidth() { return screenWidth; }
 
 s32 windowHeight() { return screenHeight; }
@@ -66,11 +84,15 @@ std::string nandPath() { return nandBinPath; }
 
 std::string oddImagePath() { return oddDiscImagePath; }
 
+std::string patchesPath() { return patchesTomlPath; }
+
 // s32 getGpuId() {
 //     return gpuId;
 // }
 
 int tpi() { return ticksPerInstruction; }
+bool jit() { return jitEnabled; }
+bool blockDispatch() { return blockDispatchEnabled; }
 
 void loadConfig(const std::filesystem::path &path) {
   // If the configuration file does not exist, create it and return.
@@ -101,6 +123,14 @@ void loadConfig(const std::filesystem::path &path) {
         toml::find_or<bool>(general, "QuitOnWindowClosure", false);
     currentLogLevel = (Base::Log::Level)find_or<int>(general, "LogLevel", false);
     islogAdvanced = toml::find_or<bool>(general, "logAdvanced", false);
+    flightRecorderEnabled =
+        toml::find_or<bool>(general, "FlightRecorder", flightRecorderEnabled);
+    flightRecorderEntryCount = toml::find_or<int>(
+        general, "FlightRecorderEntries", flightRecorderEntryCount);
+    flightRecorderLogLevel = (Base::Log::Level)toml::find_or<int>(
+        general, "FlightRecorderLogLevel", (int)flightRecorderLogLevel);
+    flightRecorderLogFilter = toml::find_or<std::string>(
+        general, "FlightRecorderLogFilter", flightRecorderLogFilter);
   }
 
   if (data.contains("SMC")) {
@@ -114,6 +144,14 @@ void loadConfig(const std::filesystem::path &path) {
     const toml::value &powerpc = data.at("PowerPC");
     SKIP_HW_INIT_1 = toml::find_or<u64>(powerpc, "HW_INIT_SKIP1", false);
     SKIP_HW_INIT_2 = toml::find_or<u64>(powerpc, "HW_INIT_SKIP2", false);
+    ppuWorkerCount =
+        toml::find_or<int>(powerpc, "PPUWorkers", ppuWorkerCount);
+    ppuWorkerAffinity =
+        toml::find_or<int>(powerpc, "PPUAffinity", ppuWorkerAffinity);
+    spinLoopSkipEnabled =
+        toml::find_or<bool>(powerpc, "SpinLoopSkip", spinLoopSkipEnabled);
+    smtHostThreadsEnabled =
+        toml::find_or<bool>(powerpc, "SMTHostThreads", smtHostThreadsEnabled);
   }
 
   if (data.contains("GPU")) {
@@ -135,12 +173,18 @@ void loadConfig(const std::filesystem::path &path) {
         toml::find_or<std::string>(paths, "Nand", nandBinPath);
     oddDiscImagePath =
         toml::find_or<std::string>(paths, "ODDImage", oddDiscImagePath);
+    patchesTomlPath =
+        toml::find_or<std::string>(paths, "Patches", patchesTomlPath);
   }
 
   if (data.contains("HighlyExperimental")) {
     const toml::value &highlyExperimental = data.at("HighlyExperimental");
     ticksPerInstruction =
         toml::find_or<int>(highlyExperimental, "TPI", ticksPerInstruction);
+    jitEnabled =
+        toml::find_or<bool>(highlyExperimental, "JIT", jitEnabled);
+    blockDispatchEnabled = toml::find_or<bool>(
+        highlyExperimental, "BlockDispatch", blockDispatchEnabled);
   }
 }
 
@@ -171,6 +215,9 @@ void saveConfig(const std::filesystem::path &path) {
   // General.                                              
   data["General"]["GPURenderThreadEnabled"].comments().clear();
   data["General"]["LogLevel"].comments().clear();
+  data["General"]["FlightRecorder"].comments().clear();
+  data["General"]["FlightRecorderEntries"].comments().clear();
+  data["General"]["FlightRecorderLogLevel"].comments().clear();
 
   data["General"]["GPURenderThreadEnabled"].comments().push_back("# Enable the GPU Render thread and main window.");
   data["General"]["GPURenderThreadEnabled"] = gpuRenderThreadEnabled;
@@ -180,6 +227,14 @@ void saveConfig(const std::filesystem::path &path) {
   data["General"]["LogLevel"].comments().push_back("# Controls the current log level output filter");
   data["General"]["LogLevel"] = (int)currentLogLevel;
   data["General"]["LogAdvanced"] = islogAdvanced;
+  data["General"]["FlightRecorder"].comments().push_back("# Keeps the last log entries in a binary ring file inside the log folder, even after a crash");
+  data["General"]["FlightRecorder"] = flightRecorderEnabled;
+  data["General"]["FlightRecorderEntries"].comments().push_back("# Amount of entries kept by the flight recorder, each one takes 128 bytes");
+  data["General"]["FlightRecorderEntries"] = flightRecorderEntryCount;
+  data["General"]["FlightRecorderLogLevel"].comments().push_back("# Minimum log level captured by the flight recorder, regardless of LogLevel");
+  data["General"]["FlightRecorderLogLevel"] = (int)flightRecorderLogLevel;
+  data["General"]["FlightRecorderLogFilter"].comments().push_back("# Per class levels of the flight recorder, e.g. \"Xenon.MMU:Trace Xenos:Debug\"");
+  data["General"]["FlightRecorderLogFilter"] = flightRecorderLogFilter;
 
   // SMC.               
   data["SMC"]["COMPort"].comments().clear();
@@ -208,6 +263,20 @@ void saveConfig(const std::filesystem::path &path) {
   data["PowerPC"]["HW_INIT_SKIP1"] = SKIP_HW_INIT_1;
   data["PowerPC"]["HW_INIT_SKIP2"].comments().push_back("# Hardware Init Skip address 2");
   data["PowerPC"]["HW_INIT_SKIP2"] = SKIP_HW_INIT_2;
+  data["PowerPC"]["PPUWorkers"].comments().clear();
+  data["PowerPC"]["PPUWorkers"].comments().push_back("# Host threads used to run the 3 PPU's, idle PPU's don't use any");
+  data["PowerPC"]["PPUWorkers"].comments().push_back("# Zero uses one thread per PPU");
+  data["PowerPC"]["PPUWorkers"] = ppuWorkerCount;
+  data["PowerPC"]["PPUAffinity"].comments().clear();
+  data["PowerPC"]["PPUAffinity"].comments().push_back("# Pin PPU worker N to host core PPUAffinity + N. Negative disables pinning");
+  data["PowerPC"]["PPUAffinity"] = ppuWorkerAffinity;
+  data["PowerPC"]["SpinLoopSkip"].comments().clear();
+  data["PowerPC"]["SpinLoopSkip"].comments().push_back("# Jump to the next timer or device event when a thread keeps polling in a loop that can't exit before it");
+  data["PowerPC"]["SpinLoopSkip"] = spinLoopSkipEnabled;
+  data["PowerPC"]["SMTHostThreads"].comments().clear();
+  data["PowerPC"]["SMTHostThreads"].comments().push_back("# Run each of the 6 hardware threads on its own host thread instead of both threads of a PPU taking turns");
+  data["PowerPC"]["SMTHostThreads"].comments().push_back("# PPUWorkers should then be 0 or at least 6");
+  data["PowerPC"]["SMTHostThreads"] = smtHostThreadsEnabled;
 
   // GPU.                                        
   data["GPU"]["screenWidth"].comments().clear();
@@ -230,6 +299,9 @@ void saveConfig(const std::filesystem::path &path) {
   data["Paths"]["OneBL"] = oneBlBinPath;
   data["Paths"]["Nand"] = nandBinPath;
   data["Paths"]["ODDImage"] = oddDiscImagePath;
+  data["Paths"]["Patches"].comments().clear();
+  data["Paths"]["Patches"].comments().push_back("# Guest code patches for the current NAND, built-in ones are used if it doesn't exist");
+  data["Paths"]["Patches"] = patchesTomlPath;
 
   // HighlyExperimental.                             
   data["HighlyExperimental"].comments().clear();
@@ -241,6 +313,12 @@ void saveConfig(const std::filesystem::path &path) {
   data["HighlyExperimental"]["TPI"].comments().push_back("# Note: This will mess with execution timing, and may break time-sensitive things like XeLL");
   data["HighlyExperimental"]["TPI"].comments().push_back("# Zero will use the estimated TPI for your system (check log for more info)");
   data["HighlyExperimental"]["TPI"] = ticksPerInstruction;
+  data["HighlyExperimental"]["JIT"].comments().clear();
+  data["HighlyExperimental"]["JIT"].comments().push_back("# Recompile guest code into host code instead of interpreting it (x86-64 only)");
+  data["HighlyExperimental"]["JIT"] = jitEnabled;
+  data["HighlyExperimental"]["BlockDispatch"].comments().clear();
+  data["HighlyExperimental"]["BlockDispatch"].comments().push_back("# Interpret whole decoded blocks at once, interrupts and the time base are only checked between blocks");
+  data["HighlyExperimental"]["BlockDispatch"] = blockDispatchEnabled;
 
   std::ofstream file(path, std::ios::binary);
   file << data;
@@ -16,6 +16,12 @@ inline bool vsyncEnabled = true;
 inline bool shouldQuitOnWindowClosure = false;
 inline Base::Log::Level currentLogLevel = Base::Log::Level::Warning;
 inline bool islogAdvanced = false;
+inline bool flightRecorderEnabled = true;
+inline int flightRecorderEntryCount = 0x10000; // 8 MiB ring.
+inline Base::Log::Level flightRecorderLogLevel = Base::Log::Level::Info;
+// Classes captured at a different level, see Base::Log::Filter::ParseFilterString.
+inline std::string flightRecorderLogFilter =
+    "Xenon.IIC:Trace Xenon.MMU:Trace Xenon.PostBus:Trace";
 
 // SMC.
 inline int smcPowerOnReason = 0x11; // SMC_PWR_REAS_EJECT   
@@ -26,6 +32,10 @@ inline std::string com = "";
 // PowerPC.
 inline u64 SKIP_HW_INIT_1 = 0;
 inline u64 SKIP_HW_INIT_2 = 0;
+inline int ppuWorkerCount = 0; // Zero means one host worker per PPU.
+inline int ppuWorkerAffinity = -1; // First host core to pin workers to, negative to let the OS decide.
+inline bool spinLoopSkipEnabled = true;
+inline bool smtHostThreadsEnabled = false;
 
 // GPU.
 inline s32 screenWidth = 1280;
@@ -40,16 +50,20 @@ inline std::string fusesTxtPath = "C:/Xbox/fuses.txt";
 inline std::string oneBlBinPath = "C:/Xbox/1bl.bin";
 inline std::string nandBinPath = "C:/Xbox/nand.bin";
 inline std::string oddDiscImagePath = "C:/Xbox/xenon.iso";
+inline std::string patchesTomlPath = "C:/Xbox/patches.toml";
 #elif defined __linux__
 inline std::string home = getenv("HOME") ? getenv("HOME") : "";
 inline std::string fusesTxtPath = home + "/Xbox/fuses.txt";
 inline std::string oneBlBinPath = home + "/Xbox/1bl.bin";
 inline std::string nandBinPath = home + "/Xbox/nand.bin";
 inline std::string oddDiscImagePath = home + "/Xbox/xenon.iso";
+inline std::string patchesTomlPath = home + "/Xbox/patches.toml";
 #endif
 
 // Highly experimental.
 inline int ticksPerInstruction = 1;
+inline bool jitEnabled = false;
+inline bool blockDispatchEnabled = false;
 
 void loadConfig(const std::filesystem::path &path);
 void saveConfig(const std::filesystem::path &path);
@@ -72,6 +86,14 @@ bool quitOnWindowClosure();
 Base::Log::Level getCurrentLogLevel();
 // Show more details on log.
 bool logAdvanced();
+// Keep the last log entries in a binary ring file that survives crashes.
+bool flightRecorder();
+// Amount of entries kept by the flight recorder.
+u32 flightRecorderEntries();
+// Minimum log level captured by the flight recorder.
+Base::Log::Level flightRecorderLevel();
+// Per class levels of the flight recorder, overriding flightRecorderLevel.
+const std::string &flightRecorderFilter();
 
 //
 // SMC Options.
@@ -90,6 +112,14 @@ int smcPowerOnType();
 // HW_INIT_SKIP.
 u64 HW_INIT_SKIP1();
 u64 HW_INIT_SKIP2();
+// Amount of host worker threads running the PPU's.
+int ppuWorkers();
+// First host core PPU workers are pinned to, negative for no pinning.
+int ppuAffinity();
+// Skip to the next event when a thread is stuck in a polling loop.
+bool spinLoopSkip();
+// Run each hardware thread of the PPU's on its own host thread.
+bool smtHostThreads();
 
 //
 // GPU Options.
@@ -116,10 +146,16 @@ std::string oneBlPath();
 std::string nandPath();
 // ODD Image path
 std::string oddImagePath();
+// Guest code patches path, one file per bootloader/kernel build.
+std::string patchesPath();
 
 //
 // Highly experimental. (things that can either break the emulator or drastically increase performance)
 //
 int tpi();
+// Use the PPU JIT recompiler instead of the interpreter.
+bool jit();
+// Interpret whole pre-decoded blocks at once, checking interrupts per block.
+bool blockDispatch();
 
 } // namespace Config
@@ -2,18 +2,31 @@
 
 #include "Backend.h"
 
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <fmt/format.h>
 
 #ifdef _WIN32
 #include <windows.h> // For OutputDebugStringW
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
-#include "Base/Bounded_threadsafe_queue.h"
+#include "Base/Config.h"
 #include "Base/io_file.h"
 #include "Base/Path_util.h"
 #include "Base/String_util.h"
 #include "Base/Thread.h"
 
+#include "Flight_recorder.h"
 #include "Log.h"
 #include "Log_entry.h"
 #include "Text_formatter.h"
@@ -111,8 +124,239 @@ public:
   void EnableForStacktrace() {}
 };
 
+/*
+ * Backend that keeps the last entries in a memory-mapped ring of fixed-size binary records. The
+ * OS writes the mapping back to disk even if we crash, decode it with the log decoder tool.
+ * Unlike the other backends it's written by the threads logging, not by the logging thread.
+ */
+class FlightRecorderBackend {
+public:
+  explicit FlightRecorderBackend(const std::filesystem::path& filename, u32 entry_count_,
+                   const Filter& filter_)
+    : entry_count{entry_count_}, filter{filter_} {
+    if (entry_count == 0) {
+      return;
+    }
+
+    // Keep the previous run around, it may be the one we're interested in.
+    std::error_code ec;
+    if (std::filesystem::exists(filename, ec)) {
+      std::filesystem::path old_filename = filename;
+      old_filename.replace_extension(".old.bin");
+      std::filesystem::rename(filename, old_filename, ec);
+    }
+
+    map_size = FlightRecorderDataOffset + static_cast<size_t>(entry_count) *
+                        sizeof(FlightRecorderEntry);
+    if (!Map(filename)) {
+      return;
+    }
+
+    header = reinterpret_cast<FlightRecorderHeader*>(map_base);
+    entries = reinterpret_cast<FlightRecorderEntry*>(map_base + FlightRecorderDataOffset);
+    header->magic = FlightRecorderMagic;
+    header->version = FlightRecorderVersion;
+    header->entry_size = sizeof(FlightRecorderEntry);
+    header->entry_count = entry_count;
+    header->class_count = std::min<u32>(static_cast<u32>(Class::Count), FlightRecorderMaxClasses);
+    header->level_count = std::min<u32>(static_cast<u32>(Level::Count), FlightRecorderMaxLevels);
+    header->write_index = 0;
+    for (u32 i = 0; i < header->class_count; ++i) {
+      std::strncpy(header->class_names[i], GetLogClassName(static_cast<Class>(i)),
+             FlightRecorderNameSize - 1);
+    }
+    for (u32 i = 0; i < header->level_count; ++i) {
+      std::strncpy(header->level_names[i], GetLevelName(static_cast<Level>(i)),
+             FlightRecorderNameSize - 1);
+    }
+  }
+
+  ~FlightRecorderBackend() {
+    Flush();
+    Unmap();
+  }
+
+  bool IsEnabled() const {
+    return header != nullptr;
+  }
+
+  bool CheckMessage(Class log_class, Level log_level) const {
+    return header != nullptr && filter.CheckMessage(log_class, log_level);
+  }
+
+  void Write(std::chrono::microseconds timestamp, Class log_class, Level log_level,
+         u32 line_num, u8 thread_id, u64 cia, std::string_view message) {
+    // Every writer gets its own slot.
+    const u64 index =
+      std::atomic_ref<u64>(header->write_index).fetch_add(1, std::memory_order_relaxed);
+    FlightRecorderEntry& record = entries[index % entry_count];
+    std::atomic_ref<u64> sequence{record.sequence};
+    // Mark the slot as torn before touching it, acquire keeps the writes below after it.
+    sequence.exchange(0, std::memory_order_acquire);
+    record.timestamp = static_cast<u64>(timestamp.count());
+    record.cia = cia;
+    record.line_num = line_num;
+    record.log_class = static_cast<u8>(log_class);
+    record.log_level = static_cast<u8>(log_level);
+    record.thread_id = thread_id;
+    const size_t length = std::min<size_t>(message.size(), FlightRecorderMessageSize - 1);
+    std::memcpy(record.message, message.data(), length);
+    record.message[length] = '\0';
+    // Publishes the entry.
+    sequence.store(index + 1, std::memory_order_release);
+  }
+
+  void Flush() {
+    if (map_base == nullptr) {
+      return;
+    }
+#ifdef _WIN32
+    FlushViewOfFile(map_base, 0);
+#else
+    msync(map_base, map_size, MS_ASYNC);
+#endif
+  }
+
+private:
+  bool Map(const std::filesystem::path& filename) {
+#ifdef _WIN32
+    file_handle = CreateFileW(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                  nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+      file_handle = nullptr;
+      return false;
+    }
+    mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READWRITE,
+                      static_cast<DWORD>(static_cast<u64>(map_size) >> 32),
+                      static_cast<DWORD>(map_size), nullptr);
+    if (mapping_handle == nullptr) {
+      Unmap();
+      return false;
+    }
+    map_base = static_cast<u8*>(MapViewOfFile(mapping_handle, FILE_MAP_WRITE, 0, 0, map_size));
+#else
+    fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(map_size)) != 0) {
+      Unmap();
+      return false;
+    }
+    void* mapping = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    map_base = mapping == MAP_FAILED ? nullptr : static_cast<u8*>(mapping);
+#endif
+    if (map_base == nullptr) {
+      Unmap();
+      return false;
+    }
+    return true;
+  }
+
+  void Unmap() {
+    header = nullptr;
+    entries = nullptr;
+#ifdef _WIN32
+    if (map_base != nullptr) {
+      UnmapViewOfFile(map_base);
+    }
+    if (mapping_handle != nullptr) {
+      CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+      CloseHandle(file_handle);
+    }
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+#else
+    if (map_base != nullptr) {
+      munmap(map_base, map_size);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+    fd = -1;
+#endif
+    map_base = nullptr;
+  }
+
+#ifdef _WIN32
+  HANDLE file_handle = nullptr;
+  HANDLE mapping_handle = nullptr;
+#else
+  int fd = -1;
+#endif
+  u8* map_base = nullptr;
+  size_t map_size = 0;
+  FlightRecorderHeader* header = nullptr;
+  FlightRecorderEntry* entries = nullptr;
+  u32 entry_count = 0;
+  Filter filter;
+};
+
+/*
+ * Lock-free ring of the records logged by a single thread, drained by the logging thread. The
+ * thread logging never waits on it: records that don't fit are dropped and counted instead.
+ */
+class LogRing {
+public:
+  static constexpr u64 Capacity = 512;
+
+  bool TryPush(const LogRecord& record) {
+    const u64 index = write_index.load(std::memory_order_relaxed);
+    if (index - read_index.load(std::memory_order_acquire) == Capacity) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    records[index % Capacity] = record;
+    write_index.store(index + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(LogRecord& record) {
+    const u64 index = read_index.load(std::memory_order_relaxed);
+    if (index == write_index.load(std::memory_order_acquire)) {
+      return false;
+    }
+    record = records[index % Capacity];
+    read_index.store(index + 1, std::memory_order_release);
+    return true;
+  }
+
+  u64 TakeDropped() {
+    return dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+  // Cleared when the owning thread exits, so the ring can be handed to a new one.
+  std::atomic_bool in_use{true};
+
+private:
+  alignas(128) std::atomic<u64> read_index{0};
+  alignas(128) std::atomic<u64> write_index{0};
+  std::atomic<u64> dropped{0};
+  std::array<LogRecord, Capacity> records;
+};
+
+/*
+ * Ring of the calling thread, handed back once the thread exits.
+ */
+struct ThreadLogRing {
+  ~ThreadLogRing() {
+    if (ring != nullptr) {
+      ring->in_use.store(false, std::memory_order_release);
+    }
+  }
+
+  LogRing* ring = nullptr;
+};
+
 bool initialization_in_progress_suppress_logging = true;
 
+// Emulated hardware thread running on this host thread, see SetThreadContext.
+thread_local u8 context_thread_id = FlightRecorderNoThread;
+thread_local const u64* context_cia = nullptr;
+thread_local ThreadLogRing thread_log_ring;
+
 /*
  * Static state as a singleton.
  */
@@ -134,8 +378,8 @@ public:
     std::filesystem::create_directory(log_dir);
     Filter filter;
     // filter.ParseFilterString(/*Config::getLogFilter()*/);
-    instance = std::unique_ptr<Impl, decltype(&Deleter)>(new Impl(log_dir / log_file, filter),
-                               Deleter);
+    instance = std::unique_ptr<Impl, decltype(&Deleter)>(
+      new Impl(log_dir / log_file, log_dir / FLIGHT_RECORDER_FILE, filter), Deleter);
     initialization_in_progress_suppress_logging = false;
   }
 
@@ -165,69 +409,162 @@ public:
     color_console_backend.SetEnabled(enabled);
   }
 
-  void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-           const char* function, std::string message) {
+  u8 GetLogTargets(Class log_class, Level log_level) const {
+    return (filter.CheckMessage(log_class, log_level) ? LogTargetBackends : 0) |
+         (flight_recorder_backend.CheckMessage(log_class, log_level) ? LogTargetFlightRecorder
+                                       : 0);
+  }
 
-    if (!filter.CheckMessage(log_class, log_level)) {
-      return;
-    }
+  void RecordMessage(Class log_class, Level log_level, u32 line_num, std::string_view message) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
 
+    flight_recorder_backend.Write(
+      duration_cast<microseconds>(steady_clock::now() - time_origin), log_class, log_level,
+      line_num, context_thread_id, context_cia != nullptr ? *context_cia : 0, message);
+  }
+
+  void PushRecord(LogRecord& record) {
     using std::chrono::duration_cast;
     using std::chrono::microseconds;
     using std::chrono::steady_clock;
 
-    const Entry entry = {
-      .timestamp = duration_cast<microseconds>(steady_clock::now() - time_origin),
-      .log_class = log_class,
-      .log_level = log_level,
-      .filename = filename,
-      .line_num = line_num,
-      .function = function,
-      .message = std::move(message),
-    };
-//    if (Config::getLogType() == "async") {
-//      message_queue.EmplaceWait(entry);
-//    } else {
-      ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
-      std::fflush(stdout);
-//    }
+    record.timestamp = duration_cast<microseconds>(steady_clock::now() - time_origin);
+    record.thread_id = context_thread_id;
+    record.cia = context_cia != nullptr ? *context_cia : 0;
+    if (backend_running.load(std::memory_order_acquire)) {
+      // Formatting and I/O happen on the logging thread.
+      GetThreadLogRing().TryPush(record);
+    } else {
+      // Nobody is draining the rings, either not started yet or shutting down.
+      WriteRecord(record);
+      std::scoped_lock lock{write_mutex};
+      ForEachBackend([](auto& backend) { backend.Flush(); });
+    }
   }
 
 private:
-  Impl(const std::filesystem::path& file_backend_filename, const Filter& filter_)
-    : filter{filter_}, file_backend{file_backend_filename} {}
+  Impl(const std::filesystem::path& file_backend_filename,
+     const std::filesystem::path& flight_recorder_filename, const Filter& filter_)
+    : filter{filter_}, file_backend{file_backend_filename},
+      flight_recorder_backend{flight_recorder_filename,
+                  Config::flightRecorder() ? Config::flightRecorderEntries() : 0,
+                  FlightRecorderFilter()} {}
+
+  static Filter FlightRecorderFilter() {
+    Filter recorder_filter{Config::flightRecorderLevel()};
+    recorder_filter.ParseFilterString(Config::flightRecorderFilter());
+    return recorder_filter;
+  }
 
-  ~Impl() = default;
+  ~Impl() {
+    StopBackendThread();
+  }
+
+  LogRing& GetThreadLogRing() {
+    if (thread_log_ring.ring == nullptr) {
+      std::scoped_lock lock{rings_mutex};
+      for (const auto& ring : rings) {
+        if (!ring->in_use.load(std::memory_order_acquire)) {
+          ring->in_use.store(true, std::memory_order_relaxed);
+          thread_log_ring.ring = ring.get();
+          return *ring;
+        }
+      }
+      thread_log_ring.ring = rings.emplace_back(std::make_unique<LogRing>()).get();
+    }
+    return *thread_log_ring.ring;
+  }
+
+  // Writes out what every thread logged so far, returns false if there was nothing.
+  bool DrainRings() {
+    bool drained = false;
+    LogRecord record;
+    // Rings are never freed, don't hold up threads logging for the first time.
+    std::vector<LogRing*> rings_snapshot;
+    {
+      std::scoped_lock lock{rings_mutex};
+      for (const auto& ring : rings) {
+        rings_snapshot.push_back(ring.get());
+      }
+    }
+    for (LogRing* ring : rings_snapshot) {
+      // Bounded, so a thread that keeps logging can't hold back the others.
+      for (u64 count = 0; count < LogRing::Capacity && ring->TryPop(record); ++count) {
+        WriteRecord(record);
+        drained = true;
+      }
+      if (const u64 dropped = ring->TakeDropped(); dropped != 0) {
+        WriteEntry({
+          .timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - time_origin),
+          .log_class = Class::Log,
+          .log_level = Level::Warning,
+          .filename = "Backend.cpp",
+          .line_num = __LINE__,
+          .function = __func__,
+          .message = fmt::format("Logging fell behind, dropped {} messages", dropped),
+        });
+      }
+    }
+    return drained;
+  }
+
+  void WriteRecord(const LogRecord& record) {
+    LogArgs args;
+    args.reserve(record.arg_count, 0);
+    for (u8 i = 0; i < record.arg_count; ++i) {
+      record.args[i].push(args, record, record.args[i].value);
+    }
+    WriteEntry({
+      .timestamp = record.timestamp,
+      .log_class = record.log_class,
+      .log_level = record.log_level,
+      .filename = record.filename,
+      .line_num = record.line_num,
+      .function = record.function,
+      .thread_id = record.thread_id,
+      .cia = record.cia,
+      .message = fmt::vformat(record.format, args),
+    });
+  }
+
+  void WriteEntry(const Entry& entry) {
+    std::scoped_lock lock{write_mutex};
+    ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
+  }
 
   void StartBackendThread() {
+    if (backend_thread.joinable()) {
+      return;
+    }
+    backend_running.store(true, std::memory_order_release);
     backend_thread = std::jthread([this](std::stop_token stop_token) {
       Base::SetCurrentThreadName("Xenon:Log");
-      Entry entry;
-      const auto write_logs = [this, &entry]() {
-        ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
-      };
       while (!stop_token.stop_requested()) {
-        message_queue.PopWait(entry, stop_token);
-        if (entry.filename != nullptr) {
-          write_logs();
+        // Polled, so that logging threads never have anyone to wake up.
+        if (!DrainRings()) {
+          std::fflush(stdout);
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
       }
-      // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a
-      // case where a system is repeatedly spamming logs even on close.
-      int max_logs_to_write = filter.IsDebug() ? std::numeric_limits<s32>::max() : 100;
-      while (max_logs_to_write-- && message_queue.TryPop(entry)) {
-        write_logs();
+      // Write out whatever was logged until now.
+      while (DrainRings()) {
       }
     });
   }
 
   void StopBackendThread() {
+    // Messages pushed from here on are written synchronously.
+    backend_running.store(false, std::memory_order_release);
     backend_thread.request_stop();
     if (backend_thread.joinable()) {
       backend_thread.join();
     }
 
     ForEachBackend([](auto& backend) { backend.Flush(); });
+    flight_recorder_backend.Flush();
   }
 
   void ForEachBackend(auto lambda) {
@@ -246,8 +583,14 @@ private:
   DebuggerBackend debugger_backend{};
   ColorConsoleBackend color_console_backend{};
   FileBackend file_backend;
-
-  MPSCQueue<Entry> message_queue{};
+  FlightRecorderBackend flight_recorder_backend;
+
+  // One ring per thread that logged something, never freed but reused once the thread exits.
+  std::vector<std::unique_ptr<LogRing>> rings;
+  std::mutex rings_mutex;
+  std::atomic_bool backend_running{false};
+  // Serializes the backends between the logging thread and synchronous writers.
+  std::mutex write_mutex;
   std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
   std::jthread backend_thread;
 };
@@ -287,12 +630,32 @@ void SetColorConsoleBackendEnabled(bool enabled) {
   Impl::Instance().SetColorConsoleBackendEnabled(enabled);
 }
 
-void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
-             unsigned int line_num, const char* function, const char* format,
-             const fmt::format_args& args) {
+u8 GetLogTargets(Class log_class, Level log_level) {
+  if (initialization_in_progress_suppress_logging) [[unlikely]] {
+    return 0;
+  }
+  return Impl::Instance().GetLogTargets(log_class, log_level);
+}
+
+void SetThreadContext(u8 thread_id, const u64* cia) {
+  context_thread_id = thread_id;
+  context_cia = cia;
+}
+
+void ClearThreadContext() {
+  context_thread_id = FlightRecorderNoThread;
+  context_cia = nullptr;
+}
+
+void FmtLogMessageImpl(LogRecord& record) {
+  if (!initialization_in_progress_suppress_logging) [[likely]] {
+    Impl::Instance().PushRecord(record);
+  }
+}
+
+void RecordLogMessage(Class log_class, Level log_level, u32 line_num, std::string_view message) {
   if (!initialization_in_progress_suppress_logging) [[likely]] {
-    Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function,
-                   fmt::vformat(format, args));
+    Impl::Instance().RecordMessage(log_class, log_level, line_num, message);
   }
 }
 } // namespace Base::Log
@@ -0,0 +1,61 @@
+// Copyright 2025 Xenon Emulator Project
+
+#pragma once
+
+#include "Types.h"
+
+namespace Base::Log {
+
+/*
+ * On-disk layout of the flight recorder, a memory-mapped ring of fixed-size binary log entries.
+ * The file starts with a header describing the ring, including the class and level names so
+ * it can be decoded by any build, followed by the entries themselves at FlightRecorderDataOffset.
+ */
+
+constexpr u64 FlightRecorderMagic = 0x31524C46584558ULL; // "XEXFLR1"
+constexpr u32 FlightRecorderVersion = 1;
+constexpr u32 FlightRecorderDataOffset = 0x1000;
+constexpr u32 FlightRecorderMaxClasses = 64;
+constexpr u32 FlightRecorderMaxLevels = 16;
+constexpr u32 FlightRecorderNameSize = 24;
+constexpr u32 FlightRecorderMessageSize = 96;
+
+/// Thread ID of entries that weren't logged from an emulated hardware thread.
+constexpr u8 FlightRecorderNoThread = 0xFF;
+
+struct FlightRecorderHeader {
+    u64 magic;
+    u32 version;
+    u32 entry_size;
+    u32 entry_count;
+    u32 class_count;
+    u32 level_count;
+    u32 reserved;
+    /// Amount of entries claimed so far, the next one goes to write_index % entry_count. Entries
+    /// still being written may be behind it.
+    u64 write_index;
+    char class_names[FlightRecorderMaxClasses][FlightRecorderNameSize];
+    char level_names[FlightRecorderMaxLevels][FlightRecorderNameSize];
+};
+static_assert(sizeof(FlightRecorderHeader) <= FlightRecorderDataOffset);
+
+struct FlightRecorderEntry {
+    /// Index of this entry + 1, zero for never written slots. Cleared before the entry is
+    /// filled in and published with a release store after, so the decoder skips torn entries.
+    u64 sequence;
+    /// Microseconds since the logger started.
+    u64 timestamp;
+    /// Instruction address of the emulated thread that logged the entry.
+    u64 cia;
+    u32 line_num;
+    u8 log_class;
+    u8 log_level;
+    /// Hardware thread (PIR) that logged the entry, or FlightRecorderNoThread.
+    u8 thread_id;
+    u8 reserved;
+    /// Formatted message, truncated and null terminated.
+    char message[FlightRecorderMessageSize];
+};
+static_assert(sizeof(FlightRecorderEntry) == 128);
+
+} // namespace Base::Log
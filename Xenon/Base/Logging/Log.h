@@ -3,7 +3,14 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 
+#include <fmt/args.h>
+
+#include "Flight_recorder.h"
 #include "Formatter.h"
 #include "Types.h"
 
@@ -17,16 +24,126 @@ constexpr const char* TrimSourcePath(std::string_view source) {
     return source.data() + idx;
 }
 
+/// Most arguments a log message can have
+constexpr size_t LogRecordMaxArgs = 8;
+/// Room for the string arguments of a log message, longer ones are truncated
+constexpr size_t LogRecordTextSize = 192;
+
+/// Arguments of a log message, rebuilt from its record by the logging thread
+using LogArgs = fmt::dynamic_format_arg_store<fmt::format_context>;
+
+/*
+ * A log message as captured by the thread that logs it: the format string pointer and the
+ * arguments packed into fixed-size storage, so capturing it never allocates. Every argument
+ * keeps the function that turns it back into a format argument on the logging thread.
+ */
+struct LogRecord {
+    struct Arg {
+        void (*push)(LogArgs& store, const LogRecord& record, u64 value);
+        u64 value;
+    };
+
+    std::chrono::microseconds timestamp;
+    u64 cia;
+    const char* filename;
+    const char* function;
+    const char* format;
+    u32 line_num;
+    Class log_class;
+    Level log_level;
+    u8 thread_id;
+    u8 arg_count;
+    u16 text_size;
+    Arg args[LogRecordMaxArgs];
+    char text[LogRecordTextSize];
+};
+
+/// Where a message goes, as returned by GetLogTargets
+enum LogTarget : u8 {
+    LogTargetBackends = 1 << 0,
+    LogTargetFlightRecorder = 1 << 1,
+};
+
+/// Returns the LogTarget bits of the filters a message of the given class and level passes
+u8 GetLogTargets(Class log_class, Level log_level);
+
+/*
+ * Attaches the emulated hardware thread running on the calling host thread to the entries it
+ * logs, for the flight recorder. cia must stay valid until the context is changed or cleared.
+ */
+void SetThreadContext(u8 thread_id, const u64* cia);
+void ClearThreadContext();
+
 /// Logs a message to the global logger, using fmt
-void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
-                       unsigned int line_num, const char* function, const char* format,
-                       const fmt::format_args& args);
+void FmtLogMessageImpl(LogRecord& record);
+
+/// Writes an already formatted message into the flight recorder, from the thread logging it
+void RecordLogMessage(Class log_class, Level log_level, u32 line_num, std::string_view message);
+
+template <typename T>
+void PushLogRecordValue(LogArgs& store, const LogRecord& record, u64 value) {
+    T arg;
+    std::memcpy(&arg, &value, sizeof(T));
+    store.push_back(arg);
+}
+
+inline void PushLogRecordText(LogArgs& store, const LogRecord& record, u64 value) {
+    store.push_back(std::string_view{record.text + (value & 0xFFFF), value >> 16});
+}
+
+template <typename T>
+void PackLogArg(LogRecord& record, const T& arg) {
+    LogRecord::Arg& packed = record.args[record.arg_count++];
+    char* text = record.text + record.text_size;
+    const size_t text_left = LogRecordTextSize - record.text_size;
+    size_t length = 0;
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        // Strings may not outlive the caller, copy them into the record.
+        const std::string_view view{arg};
+        length = std::min(view.size(), text_left);
+        std::memcpy(text, view.data(), length);
+    } else if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(u64)) {
+        packed = {PushLogRecordValue<T>, 0};
+        std::memcpy(&packed.value, &arg, sizeof(T));
+        return;
+    } else {
+        // Anything bigger is formatted right away, with the default format.
+        length = std::min(fmt::format_to_n(text, text_left, "{}", arg).size, text_left);
+    }
+    packed = {PushLogRecordText, record.text_size | (static_cast<u64>(length) << 16)};
+    record.text_size += static_cast<u16>(length);
+}
 
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const Args&... args) {
-    FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
-                      fmt::make_format_args(args...));
+    static_assert(sizeof...(Args) <= LogRecordMaxArgs, "Too many arguments for a log message");
+    // Filtered messages are dropped before any of the formatting work is done.
+    const u8 targets = GetLogTargets(log_class, log_level);
+    if (targets & LogTargetFlightRecorder) {
+        // Recorded right away, so it isn't lost if we crash with records still queued.
+        char message[FlightRecorderMessageSize - 1];
+        const size_t length =
+            std::min(fmt::vformat_to_n(message, sizeof(message), format,
+                                       fmt::make_format_args(args...))
+                         .size,
+                     sizeof(message));
+        RecordLogMessage(log_class, log_level, line_num, {message, length});
+    }
+    if (!(targets & LogTargetBackends)) {
+        return;
+    }
+    LogRecord record;
+    record.filename = filename;
+    record.function = function;
+    record.format = format;
+    record.line_num = line_num;
+    record.log_class = log_class;
+    record.log_level = log_level;
+    record.arg_count = 0;
+    record.text_size = 0;
+    (PackLogArg(record, args), ...);
+    FmtLogMessageImpl(record);
 }
 
 } // namespace Base::Log
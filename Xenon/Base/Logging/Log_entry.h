@@ -3,7 +3,9 @@
 #pragma once
 
 #include <chrono>
+#include <string>
 
+#include "Flight_recorder.h"
 #include "Types.h"
 
 namespace Base::Log {
@@ -11,6 +13,7 @@ namespace Base::Log {
 /*
  * A log entry. Log entries are store in a structured format to permit more varied output
  * formatting on different frontends, as well as facilitating filtering and aggregation.
+ * Entries are only built, and their message formatted, once a record reaches the logging thread.
  */
 struct Entry {
     std::chrono::microseconds timestamp;
@@ -18,7 +21,9 @@ struct Entry {
     Level log_level{};
     const char* filename = nullptr;
     u32 line_num = 0;
-    std::string function;
+    const char* function = nullptr;
+    u8 thread_id = FlightRecorderNoThread;
+    u64 cia = 0;
     std::string message;
 };
 
@@ -18,6 +18,7 @@ constexpr auto PORTABLE_DIR = "Xenon";
 constexpr auto LOG_DIR = "log";
 
 constexpr auto LOG_FILE = "xenon_log.txt";
+constexpr auto FLIGHT_RECORDER_FILE = "xenon_flight_recorder.bin";
 
 [[nodiscard]] std::string PathToUTF8String(const fs::path &path);
 
@@ -139,6 +139,32 @@ static void AccurateSleep(std::chrono::nanoseconds duration) {
 
 #endif
 
+#ifdef _WIN32
+
+void SetCurrentThreadAffinity(u32 core) {
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << core);
+}
+
+#elif defined(__APPLE__) || defined(__OpenBSD__) || defined(__NetBSD__)
+
+void SetCurrentThreadAffinity(u32 core) {
+    // Not supported
+}
+
+#else
+
+void SetCurrentThreadAffinity(u32 core) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    if (int e = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) {
+        errno = e;
+        LOG_ERROR(Base, "Failed to set thread affinity to core {}: {}", core, GetLastErrorMsg());
+    }
+}
+
+#endif
+
 #ifdef _MSC_VER
 
 // Sets the debugger-visible name of the current thread.
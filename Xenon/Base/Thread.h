@@ -21,6 +21,8 @@ void SetCurrentThreadPriority(ThreadPriority new_priority);
 
 void SetCurrentThreadName(const char* name);
 
+void SetCurrentThreadAffinity(u32 core);
+
 void SetThreadName(void* thread, const char* name);
 
 class AccurateTimer {
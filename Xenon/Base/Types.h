@@ -43,6 +43,10 @@ using f64 = double;
     return 1024_MB * x;
 }
 
+// Host cache line size. State written by different host threads is aligned to
+// it so they don't keep stealing the line from each other.
+#define HOST_CACHE_LINE_SIZE 64
+
 // Min/max value of a typetemplate <typename T>
 template <typename T>
 static consteval T min_t() {
@@ -0,0 +1,52 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include "EventScheduler.h"
+
+void EventScheduler::ScheduleEvent(u64 delayTicks, EventCallback callback) {
+  std::lock_guard lck(eventMutex);
+  const u64 dueTicks = GetTicks() + delayTicks;
+  events.emplace(dueTicks, std::move(callback));
+  nextEventTicks.store(events.begin()->first, std::memory_order_relaxed);
+}
+
+u64 EventScheduler::GetTicksToNextEvent() const {
+  const u64 next = nextEventTicks.load(std::memory_order_relaxed);
+  if (next == XE_NO_EVENT) {
+    return XE_NO_EVENT;
+  }
+  const u64 now = GetTicks();
+  return next > now ? next - now : 0;
+}
+
+bool EventScheduler::FastForward() {
+  const u64 next = nextEventTicks.load(std::memory_order_relaxed);
+  if (next == XE_NO_EVENT) {
+    return false;
+  }
+
+  // Never move the clock backwards, someone may have passed the event already.
+  u64 now = GetTicks();
+  while (now < next && !currentTicks.compare_exchange_weak(
+                           now, next, std::memory_order_relaxed)) {
+  }
+  runDueEvents(GetTicks());
+  return true;
+}
+
+void EventScheduler::runDueEvents(u64 now) {
+  while (true) {
+    EventCallback callback;
+    {
+      std::lock_guard lck(eventMutex);
+      if (events.empty() || events.begin()->first > now) {
+        break;
+      }
+      callback = std::move(events.begin()->second);
+      events.erase(events.begin());
+      nextEventTicks.store(events.empty() ? XE_NO_EVENT : events.begin()->first,
+                           std::memory_order_relaxed);
+    }
+    // Run it unlocked, so it can schedule new events.
+    callback();
+  }
+}
@@ -0,0 +1,67 @@
+// Copyright 2025 Xenon Emulator Project
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "Base/Types.h"
+
+/*
+ *	EventScheduler.h Virtual time event scheduler.
+ *
+ *	Keeps the console wide virtual clock, counted in time base ticks. The PPU's
+ *	advance it as they execute instructions, and devices post events into it
+ *	instead of sleeping or polling host timers, so device latencies are
+ *	measured in guest time and don't depend on the host's speed. When every
+ *	PPU is idle the clock jumps straight to the next event.
+ */
+
+// Nominal time base frequency, used to express device delays.
+#define XE_TIMEBASE_FREQ 50000000ULL
+#define XE_USEC_TO_TICKS(x) (static_cast<u64>(x) * XE_TIMEBASE_FREQ / 1000000)
+#define XE_MSEC_TO_TICKS(x) (static_cast<u64>(x) * XE_TIMEBASE_FREQ / 1000)
+
+// No event is pending.
+#define XE_NO_EVENT 0xFFFFFFFFFFFFFFFFULL
+
+using EventCallback = std::function<void()>;
+
+class EventScheduler {
+public:
+  // Current virtual time.
+  u64 GetTicks() const { return currentTicks.load(std::memory_order_relaxed); }
+
+  // Runs a callback once the clock has advanced delayTicks from now. Events
+  // due at the same time run in the order they were scheduled.
+  void ScheduleEvent(u64 delayTicks, EventCallback callback);
+
+  // Advances the clock, running every event that became due on the calling
+  // thread.
+  void Advance(u64 ticks) {
+    const u64 now =
+        currentTicks.fetch_add(ticks, std::memory_order_relaxed) + ticks;
+    if (now >= nextEventTicks.load(std::memory_order_relaxed)) {
+      runDueEvents(now);
+    }
+  }
+
+  // Ticks left until the next event, XE_NO_EVENT if there's none.
+  u64 GetTicksToNextEvent() const;
+
+  // Jumps to the next event and runs it, returns false if there's none.
+  bool FastForward();
+
+private:
+  // Runs every event due at a given time.
+  void runDueEvents(u64 now);
+
+  std::mutex eventMutex;
+  // Pending events, keyed on the time they're due.
+  std::multimap<u64, EventCallback> events;
+  std::atomic<u64> currentTicks = 0;
+  // Time the first pending event is due, lets Advance skip the lock.
+  std::atomic<u64> nextEventTicks = XE_NO_EVENT;
+};
@@ -32,3 +32,10 @@ u8 *RAM::getPointerToAddress(u32 address) {
   const u64 offset = (u32)(address - RAM_START_ADDR);
   return RAMData.data() + offset;
 }
+
+void RAM::DMAWrite(u32 address, const u8 *data, u64 size) {
+  memcpy(getPointerToAddress(address), data, size);
+  if (dmaWriteCallback) {
+    dmaWriteCallback(address, size);
+  }
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Base/SystemDevice.h"
+#include <functional>
 #include <vector>
 
 #define RAM_START_ADDR 0
@@ -18,6 +19,15 @@ public:
 
   u8 *getPointerToAddress(u32 address);
 
+  // Device DMA into main memory. Anything the CPU caches about the written
+  // range is invalidated through the write callback.
+  void DMAWrite(u32 address, const u8 *data, u64 size);
+  // Called after every DMA write with its address and size.
+  void setDMAWriteCallback(std::function<void(u64, u64)> callback) {
+    dmaWriteCallback = callback;
+  }
+
 private:
   std::vector<u8> RAMData;
+  std::function<void(u64, u64)> dmaWriteCallback;
 };
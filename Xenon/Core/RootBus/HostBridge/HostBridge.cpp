@@ -18,20 +18,24 @@ void HostBridge::RegisterXGPU(Xe::Xenos::XGPU *newXGPU) {
   std::lock_guard lck(mutex);
 
   xGPU = newXGPU;
+  rebuildMemoryMap();
 }
 
 void HostBridge::RegisterPCIBridge(PCIBridge *newPCIBridge) {
   std::lock_guard lck(mutex);
 
   pciBridge = newPCIBridge;
+  rebuildMemoryMap();
   return;
 }
 
 bool HostBridge::Read(u64 readAddress, u64 *data, u8 byteCount) {
   std::lock_guard lck(mutex);
 
+  const HOSTBRIDGE_MAP_ENTRY mapEntry = memoryMap.Find(readAddress);
+
   // Reading from host bridge registers?
-  if (isAddressMappedinBAR(static_cast<u32>(readAddress))) {
+  if (mapEntry.target == HOSTBRIDGE_TARGET_REGS) {
     switch (readAddress) {
       // HostBridge
     case 0xE0020000:
@@ -65,16 +69,18 @@ bool HostBridge::Read(u64 readAddress, u64 *data, u8 byteCount) {
     return true;
   }
 
-  // Check if this address is in the PCI Bridge
-  if (xGPU->isAddressMappedInBAR(static_cast<u32>(readAddress))) {
+  switch (mapEntry.target) {
+  case HOSTBRIDGE_TARGET_XGPU:
     xGPU->Read(readAddress, data, byteCount);
     return true;
-  }
-
-  // Check if this address is in the PCI Bridge
-  if (pciBridge->isAddressMappedinBAR(static_cast<u32>(readAddress))) {
+  case HOSTBRIDGE_TARGET_PCIBRIDGE:
     pciBridge->Read(readAddress, data, byteCount);
     return true;
+  case HOSTBRIDGE_TARGET_PCIDEVICE:
+    mapEntry.device->Read(readAddress, data, byteCount);
+    return true;
+  default:
+    break;
   }
 
   // Read failed or address is not on this bus.
@@ -84,8 +90,10 @@ bool HostBridge::Read(u64 readAddress, u64 *data, u8 byteCount) {
 bool HostBridge::Write(u64 writeAddress, u64 data, u8 byteCount) {
   std::lock_guard lck(mutex);
 
+  const HOSTBRIDGE_MAP_ENTRY mapEntry = memoryMap.Find(writeAddress);
+
   // Writing to host bridge registers?
-  if (isAddressMappedinBAR(static_cast<u32>(writeAddress))) {
+  if (mapEntry.target == HOSTBRIDGE_TARGET_REGS) {
     switch (writeAddress) {
       // HostBridge
     case 0xE0020000:
@@ -161,16 +169,18 @@ bool HostBridge::Write(u64 writeAddress, u64 data, u8 byteCount) {
     return true;
   }
 
-  // Check if this address is mapped on the GPU
-  if (xGPU->isAddressMappedInBAR(static_cast<u32>(writeAddress))) {
+  switch (mapEntry.target) {
+  case HOSTBRIDGE_TARGET_XGPU:
     xGPU->Write(writeAddress, data, byteCount);
     return true;
-  }
-
-  // Check if this address is in the PCI Bridge
-  if (pciBridge->isAddressMappedinBAR(static_cast<u32>(writeAddress))) {
+  case HOSTBRIDGE_TARGET_PCIBRIDGE:
     pciBridge->Write(writeAddress, data, byteCount);
     return true;
+  case HOSTBRIDGE_TARGET_PCIDEVICE:
+    mapEntry.device->Write(writeAddress, data, byteCount);
+    return true;
+  default:
+    break;
   }
 
   // Write failed or address is not on this bus.
@@ -231,25 +241,69 @@ void HostBridge::ConfigWrite(u64 writeAddress, u64 data, u8 byteCount) {
             writeAddress, data);
       break;
     }
-    return;
+  } else {
+    // Config Address belongs to a secondary Bus, let's send it to the PCI-PCI
+    // Bridge
+    pciBridge->ConfigWrite(writeAddress, data, byteCount);
   }
 
-  // Config Address belongs to a secondary Bus, let's send it to the PCI-PCI
-  // Bridge
-  pciBridge->ConfigWrite(writeAddress, data, byteCount);
+  // A BAR was (re)programmed, update the address map.
+  if (configAddress.regOffset + byteCount > 0x10 &&
+      configAddress.regOffset < 0x28) {
+    rebuildMemoryMap();
+  }
 }
 
-bool HostBridge::isAddressMappedinBAR(u32 address) {
-  #define ADDRESS_BOUNDS_CHECK(a, b) (address >= a && address <= (a + b))
+void HostBridge::rebuildMemoryMap() {
+  // Regions are added in the same order the bus was scanned before, so
+  // overlapping BAR's resolve to the same device.
+  memoryMap.Clear();
 
-  if (ADDRESS_BOUNDS_CHECK(hostBridgeConfigSpace.configSpaceHeader.BAR0, XGPU_DEVICE_SIZE) ||
-      ADDRESS_BOUNDS_CHECK(hostBridgeConfigSpace.configSpaceHeader.BAR1, XGPU_DEVICE_SIZE) ||
-      ADDRESS_BOUNDS_CHECK(hostBridgeConfigSpace.configSpaceHeader.BAR2, XGPU_DEVICE_SIZE) ||
-      ADDRESS_BOUNDS_CHECK(hostBridgeConfigSpace.configSpaceHeader.BAR3, XGPU_DEVICE_SIZE) ||
-      ADDRESS_BOUNDS_CHECK(hostBridgeConfigSpace.configSpaceHeader.BAR4, XGPU_DEVICE_SIZE) ||
-      ADDRESS_BOUNDS_CHECK(hostBridgeConfigSpace.configSpaceHeader.BAR5, XGPU_DEVICE_SIZE)) {
-    return true;
+  // Host Bridge registers.
+  const u32 hostBridgeBARs[6] = {hostBridgeConfigSpace.configSpaceHeader.BAR0,
+                                 hostBridgeConfigSpace.configSpaceHeader.BAR1,
+                                 hostBridgeConfigSpace.configSpaceHeader.BAR2,
+                                 hostBridgeConfigSpace.configSpaceHeader.BAR3,
+                                 hostBridgeConfigSpace.configSpaceHeader.BAR4,
+                                 hostBridgeConfigSpace.configSpaceHeader.BAR5};
+  for (const u32 bar : hostBridgeBARs) {
+    memoryMap.AddRegion(bar, bar + XGPU_DEVICE_SIZE,
+                        {HOSTBRIDGE_TARGET_REGS, nullptr});
   }
 
-  return false;
+  // Xenos.
+  if (xGPU) {
+    for (u8 barNum = 0; barNum < 6; barNum++) {
+      const u32 bar = xGPU->GetBAR(barNum);
+      memoryMap.AddRegion(bar, bar + XGPU_DEVICE_SIZE,
+                          {HOSTBRIDGE_TARGET_XGPU, nullptr});
+    }
+  }
+
+  // PCI Bridge, only what falls inside its two windows is reachable.
+  if (pciBridge) {
+    const auto addWindowedRegion = [this](u64 start, u64 end,
+                                          HOSTBRIDGE_MAP_ENTRY entry) {
+      for (u8 window = 0; window < 2; window++) {
+        const u64 windowStart = pciBridge->getBAR(window);
+        const u64 windowEnd = windowStart + PCI_BRIDGE_SIZE;
+        memoryMap.AddRegion(std::max(start, windowStart),
+                            std::min(end, windowEnd), entry);
+      }
+    };
+
+    // Bridge registers.
+    addWindowedRegion(PCI_BRIDGE_BASE_ADDRESS, PCI_BRIDGE_BASE_END_ADDRESS,
+                      {HOSTBRIDGE_TARGET_PCIBRIDGE, nullptr});
+    // Attached devices.
+    for (auto &device : pciBridge->getPCIDevices()) {
+      for (u8 barNum = 0; barNum < 6; barNum++) {
+        const u64 bar = device->GetBAR(barNum);
+        addWindowedRegion(bar, bar + device->GetDeviceSize(),
+                          {HOSTBRIDGE_TARGET_PCIDEVICE, device});
+      }
+    }
+    // Anything else inside the windows is still claimed by the bridge.
+    addWindowedRegion(0, 0xFFFFFFFF, {HOSTBRIDGE_TARGET_PCIBRIDGE, nullptr});
+  }
 }
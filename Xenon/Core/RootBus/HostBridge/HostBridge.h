@@ -5,6 +5,7 @@
 #include "PCIe.h"
 
 #include "Core/RootBus/HostBridge/PCIBridge/PCIBridge.h"
+#include "Core/RootBus/MemoryMap.h"
 
 #include "Core/XGPU/XGPU.h"
 
@@ -45,6 +46,20 @@ struct BIU_REGS {
   u32 REG_E1040078;
 };
 
+// Devices responding on the Host Bridge address space.
+enum HOSTBRIDGE_TARGET : u8 {
+  HOSTBRIDGE_TARGET_NONE,
+  HOSTBRIDGE_TARGET_REGS,      // Host Bridge and BIU registers.
+  HOSTBRIDGE_TARGET_XGPU,      // Xenos registers.
+  HOSTBRIDGE_TARGET_PCIBRIDGE, // PCI Bridge registers or unclaimed window.
+  HOSTBRIDGE_TARGET_PCIDEVICE  // Device behind the PCI Bridge.
+};
+
+struct HOSTBRIDGE_MAP_ENTRY {
+  HOSTBRIDGE_TARGET target = HOSTBRIDGE_TARGET_NONE;
+  PCIDevice *device = nullptr;
+};
+
 class HostBridge {
 public:
   HostBridge();
@@ -78,8 +93,12 @@ private:
   // Pointer to the registered PCI Bridge.
   PCIBridge *pciBridge{};
 
+  // Address map of all the devices on this bus, rebuilt whenever a BAR is
+  // written.
+  MemoryMap<HOSTBRIDGE_MAP_ENTRY> memoryMap;
+
   // Helpers
-  bool isAddressMappedinBAR(u32 address);
+  void rebuildMemoryMap();
 
   HOSTBRIDGE_REGS hostBridgeRegs{};
   BIU_REGS biuRegs{};
@@ -145,7 +145,8 @@ void ODD::doDMA() {
       // Buffer overrun?
       if (byteCount == 0)
         return;
-      memcpy(bufferInMemory, atapiState.dataReadBuffer.Ptr(), byteCount);
+      mainMemory->DMAWrite(bufferAddress, atapiState.dataReadBuffer.Ptr(),
+                           byteCount);
       atapiState.dataReadBuffer.Increment(byteCount);
     } else {
       // Writing to us
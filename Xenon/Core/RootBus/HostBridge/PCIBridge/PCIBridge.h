@@ -87,6 +87,13 @@ public:
   bool isAddressMappedinBAR(u32 address);
 
   void addPCIDevice(PCIDevice *device);
+  const std::vector<PCIDevice *> &getPCIDevices() { return connectedPCIDevices; }
+
+  // Returns the address of one of the two bridge windows.
+  u32 getBAR(u8 barNum) {
+    return barNum == 0 ? pciBridgeConfig.configSpaceHeader.BAR0
+                       : pciBridgeConfig.configSpaceHeader.BAR1;
+  }
 
   bool Read(u64 readAddress, u64 *data, u8 byteCount);
   bool Write(u64 writeAddress, u64 data, u8 byteCount);
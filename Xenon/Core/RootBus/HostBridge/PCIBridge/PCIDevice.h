@@ -24,6 +24,14 @@ public:
   virtual void ConfigWrite(u64 writeAddress, u64 data, u8 byteCount) {}
 
   const char *GetDeviceName() { return deviceInfo.deviceName; }
+  u64 GetDeviceSize() { return deviceInfo.size; }
+
+  // Returns the address a given BAR (0 - 5) is set to.
+  u32 GetBAR(u8 barNum) {
+    u32 bar = 0;
+    memcpy(&bar, &pciConfigSpace.data[0x10 + barNum * 4], sizeof(bar));
+    return bar;
+  }
 
   // Checks wether a given address is mapped in the device's BAR's
   bool isAddressMappedInBAR(u32 address) {
@@ -5,9 +5,10 @@
 #include "Base/Logging/Log.h"
                                                                           
 SFCX::SFCX(const char* deviceName, const std::string nandLoadPath, u64 size,
-  PCIBridge *parentPCIBridge) : PCIDevice(deviceName, size) {
+  PCIBridge *parentPCIBridge, EventScheduler *eventScheduler) : PCIDevice(deviceName, size) {
   // Asign parent PCI Bridge pointer.
   parentBus = parentPCIBridge;
+  events = eventScheduler;
 
   // Set PCI Properties.
   pciConfigSpace.configSpaceHeader.reg0.hexData = 0x580B1414;
@@ -115,10 +116,6 @@ SFCX::SFCX(const char* deviceName, const std::string nandLoadPath, u64 size,
   size_t imageSize = std::filesystem::file_size(nandLoadPath);
 
   // There are two SFCX Versions, original (Pre Jasper) and Jasper+.
-
-  // Enter SFCX Thread.
-  sfcxThread = std::thread(&SFCX::sfcxMainLoop, this);
-  sfcxThread.detach();
 }
 
 void SFCX::Read(u64 readAddress, u64 *data, u8 byteCount) {
@@ -178,7 +175,7 @@ void SFCX::Write(u64 writeAddress, u64 data, u8 byteCount) {
     break;
   case SFCX_COMMAND_REG:
     sfcxState.commandReg = (u32)data;
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sfcxExecuteCommand();
     break;
   case SFCX_ADDRESS_REG:
     sfcxState.addressReg = (u32)data;
@@ -234,68 +231,73 @@ void SFCX::ConfigWrite(u64 writeAddress, u64 data, u8 byteCount) {
   memcpy(&pciConfigSpace.data[offset], &data, byteCount);
 }
 
-void SFCX::sfcxMainLoop() {
+void SFCX::sfcxExecuteCommand() {
   // Config register should be initialized by now.
-  while (true) {
-    // Did we got a command?
-    if (sfcxState.commandReg != NO_CMD) {
-      // Set status to busy.
-      sfcxState.statusReg |= STATUS_BUSY;
-
-      // Check the command reg to see what command was issued.
-      switch (sfcxState.commandReg) {
-      case PAGE_BUF_TO_REG:
-        // If we're reading from data buffer to data reg the Address reg becomes
-        // our buffer pointer.
-        memcpy(&sfcxState.dataReg, &sfcxState.pageBuffer[sfcxState.addressReg],
-               4);
-        sfcxState.addressReg += 4;
-        break;
-      // case REG_TO_PAGE_BUF:
-      //	break;
-      // case LOG_PAGE_TO_BUF:
-      //	break;
-      case PHY_PAGE_TO_BUF:
-        // Read Phyisical page into page buffer.
-        // Physical pages are 0x210 bytes long, logical page (0x200) + meta data
-        // (0x10).                                                
-        nandFile.seekg(sfcxState.addressReg);
-        nandFile.read(reinterpret_cast<char*>(sfcxState.pageBuffer), sizeof(sfcxState.pageBuffer));
-        // Issue Interrupt.
-        if (sfcxState.configReg & CONFIG_INT_EN) {
-          // Set a delay for our interrupt?
-          std::this_thread::sleep_for(std::chrono::milliseconds(150));
-          parentBus->RouteInterrupt(PRIO_SFCX);
-          sfcxState.statusReg |= STATUS_INT_CP;
-        }
-        break;
-      // case WRITE_PAGE_TO_PHY:
-      //	break;
-      // case BLOCK_ERASE:
-      //	break;
-      // case DMA_LOG_TO_RAM:
-      //	break;
-      // case DMA_PHY_TO_RAM:
-      //	break;
-      // case DMA_RAM_TO_PHY:
-      //	break;
-      // case UNLOCK_CMD_0:
-      //	break;
-      // case UNLOCK_CMD_1:
-      //	break;
-      default:
-        LOG_ERROR(SFCX, "Unrecognized command was issued. {:#x}", sfcxState.commandReg);
-        break;
-      }
+  if (sfcxState.commandReg == NO_CMD) {
+    return;
+  }
+
+  // Set status to busy.
+  sfcxState.statusReg |= STATUS_BUSY;
+
+  // Check the command reg to see what command was issued.
+  switch (sfcxState.commandReg) {
+  case PAGE_BUF_TO_REG:
+    // If we're reading from data buffer to data reg the Address reg becomes
+    // our buffer pointer.
+    memcpy(&sfcxState.dataReg, &sfcxState.pageBuffer[sfcxState.addressReg],
+           4);
+    sfcxState.addressReg += 4;
+    break;
+  // case REG_TO_PAGE_BUF:
+  //	break;
+  // case LOG_PAGE_TO_BUF:
+  //	break;
+  case PHY_PAGE_TO_BUF:
+    // Read Phyisical page into page buffer.
+    // Physical pages are 0x210 bytes long, logical page (0x200) + meta data
+    // (0x10).
+    nandFile.seekg(sfcxState.addressReg);
+    nandFile.read(reinterpret_cast<char*>(sfcxState.pageBuffer), sizeof(sfcxState.pageBuffer));
+    // The controller stays busy until the read completes in virtual time.
+    sfcxState.commandReg = NO_CMD;
+    events->ScheduleEvent(SFCX_PAGE_READ_DELAY, [this] { sfcxPageReadDone(); });
+    return;
+  // case WRITE_PAGE_TO_PHY:
+  //	break;
+  // case BLOCK_ERASE:
+  //	break;
+  // case DMA_LOG_TO_RAM:
+  //	break;
+  // case DMA_PHY_TO_RAM:
+  //	break;
+  // case DMA_RAM_TO_PHY:
+  //	break;
+  // case UNLOCK_CMD_0:
+  //	break;
+  // case UNLOCK_CMD_1:
+  //	break;
+  default:
+    LOG_ERROR(SFCX, "Unrecognized command was issued. {:#x}", sfcxState.commandReg);
+    break;
+  }
 
-      // Clear Command Register.
-      sfcxState.commandReg = NO_CMD;
+  // Clear Command Register.
+  sfcxState.commandReg = NO_CMD;
 
-      // Set Status to Ready again.
-      sfcxState.statusReg &= ~STATUS_BUSY;
-    }
-    // Sleep for some time.
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // Set Status to Ready again.
+  sfcxState.statusReg &= ~STATUS_BUSY;
+}
+
+void SFCX::sfcxPageReadDone() {
+  // Set Status to Ready again, before the interrupt handler gets to look at
+  // it.
+  sfcxState.statusReg &= ~STATUS_BUSY;
+
+  // Issue Interrupt.
+  if (sfcxState.configReg & CONFIG_INT_EN) {
+    sfcxState.statusReg |= STATUS_INT_CP;
+    parentBus->RouteInterrupt(PRIO_SFCX);
   }
 }
 
@@ -2,10 +2,10 @@
 
 #pragma once
 
-#include <thread>
 #include <fstream>
 #include <filesystem>
 
+#include "Core/EventScheduler/EventScheduler.h"
 #include "Core/RootBus/HostBridge/PCIBridge/PCIBridge.h"
 #include "Core/RootBus/HostBridge/PCIBridge/PCIDevice.h"
 
@@ -51,6 +51,9 @@
 #define UNLOCK_CMD_0 0x55      // Unlock command 0
 #define UNLOCK_CMD_1 0xAA      // Unlock command 1
 #define NO_CMD 0xFF
+
+// Time it takes to read a physical page into the page buffer, in virtual time.
+#define SFCX_PAGE_READ_DELAY XE_USEC_TO_TICKS(25)
 //
 // Config Register Bitmasks
 //
@@ -157,7 +160,7 @@ struct SFCX_STATE {
 class SFCX : public PCIDevice {
 public:
   SFCX(const char* deviceName, const std::string nandLoadPath, u64 size,
-    PCIBridge *parentPCIBridge);
+    PCIBridge *parentPCIBridge, EventScheduler *eventScheduler);
 
   void Read(u64 readAddress, u64 *data, u8 byteCount) override;
   void ConfigRead(u64 readAddress, u64 *data, u8 byteCount) override;
@@ -165,12 +168,14 @@ public:
   void ConfigWrite(u64 writeAddress, u64 data, u8 byteCount) override;
 
 private:
-  // Secure Flash Controller for Xbox main loop.
-  void sfcxMainLoop();
+  // Executes the command written to the command register.
+  void sfcxExecuteCommand();
+  // Completes a page read, signaling the interrupt if enabled.
+  void sfcxPageReadDone();
   // Magic check
   bool checkMagic();
-  // Thread object
-  std::thread sfcxThread;
+  // Virtual clock, commands complete on it.
+  EventScheduler *events = nullptr;
   // SFCX State
   SFCX_STATE sfcxState;
   // I/O File stream.
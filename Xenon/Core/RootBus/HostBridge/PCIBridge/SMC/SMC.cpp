@@ -60,12 +60,14 @@
 
 // Class Constructor.
 Xe::PCIDev::SMC::SMCCore::SMCCore(const char *deviceName, u64 size,
-  PCIBridge *parentPCIBridge, SMC_CORE_STATE *newSMCCoreState) :
+  PCIBridge *parentPCIBridge, SMC_CORE_STATE *newSMCCoreState,
+  EventScheduler *eventScheduler) :
   PCIDevice(deviceName, size) {
   LOG_INFO(SMC, "Core: Initializing...");
 
   // Assign our parent PCI Bus Ptr.
   pciBridge = parentPCIBridge;
+  events = eventScheduler;
 
   // Assign our core sate, this is already filled with config data regarding
   // AVPACK, PWRON Reason and TrayState.
@@ -91,9 +93,12 @@ Xe::PCIDev::SMC::SMCCore::SMCCore(const char *deviceName, u64 size,
   // Set UART Presence.
   smcCoreState->uartPresent = true;
 
-  // Enter main execution thread.
-  smcThread = std::thread(&SMCCore::smcMainThread, this);
-  smcThread.detach();
+  // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY to indicate we are ready to
+  // receive a message.
+  smcPCIState->fifoInStatusReg = FIFO_STATUS_READY;
+
+  // Start ticking the clock.
+  events->ScheduleEvent(SMC_CLOCK_INT_DELAY, [this] { smcClockTick(); });
 }
 
 // Class Destructor.
@@ -250,6 +255,8 @@ void Xe::PCIDev::SMC::SMCCore::Write(u64 writeAddress, u64 data, u8 byteCount) {
       // Reset our input buffer and buffer pointer.
       memset(&smcCoreState->fifoDataBuffer, 0, 16);
       smcCoreState->fifoBufferPos = 0;
+    } else if (data == FIFO_STATUS_BUSY) { // The message is complete.
+      smcProcessFIFOCommand();
     }
     break;
   case FIFO_OUT_STATUS_REG: // FIFO Out Status Register
@@ -393,258 +400,238 @@ void Xe::PCIDev::SMC::SMCCore::uartMainThread() {
 }
 #endif
 
-// SMC Main Thread
-void Xe::PCIDev::SMC::SMCCore::smcMainThread() {
-  LOG_INFO(SMC, "Entered main thread.");
-  // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY to indicate we are ready to
-  // receive a message.
+// Processes a FIFO command, as soon as the system has finished sending it.
+void Xe::PCIDev::SMC::SMCCore::smcProcessFIFOCommand() {
+  // The System Management Controller (SMC) does the following:
+  // * Communicates over a FIFO Queue with the kernel to execute commands and
+  // provide system info.
+  // * Does the UART/Serial communication between the console and remote
+  // Serial Device/PC.
+  // * Ticks the clock and sends an interrupt (PRIO_CLOCK) every x
+  // milliseconds.
+
+  // Core State (PowerOn Cause, SMC Ver, FAN Speed, Temps, etc...) should be
+  // already set.
+
+  /*
+          1. FIFO communication.
+  */
+
+  // This is done in simple steps:
+
+  /* Message Write (System -> SMC) */
+
+  // 1. System reads FIFO_IN_STATUS_REG to check wheter the SMC is ready to
+  // receive a command.
+  // 2. If the status is FIFO_STATUS_READY (0x4), the System proceeds, else it
+  // loops until the SMC Input Status Register is set to FIFO_STATUS_READY.
+  // 3. System then does a write to FIFO_IN_STATUS_REG setting it to
+  // FIFO_STATUS_READY. This signals the SMC that a new message/command is
+  // about to receive.
+  // 4. System does 4 32 Bit writes to FIFO_IN_DATA_REG, this is our 16 Bytes
+  // message.
+  // 5. System then does a write to FIFO_IN_STATUS_REG setting it to
+  // FIFO_STATUS_BUSY. This Signals the SMC that the message is transmitted
+  // and that it should start message processing.
+  // 6. If SMM (System Management Mode) interrupts are enabled, the SMC
+  // changes the SMI_INT_PENDING_REG to SMI_INT_PENDING and issues one
+  // signaling the System it should read the message. It also sets the
+  // FIFO_OUT_STATUS_REG to FIFO_STATUS_READY.
+
+  /* Message Read (SMC -> System) */
+
+  // Reads Proceed as following:
+  // A. Asynchronous Mode (Interrupts Enabled):
+  // 1. If an interrupt was issued (Asynchronous Mode), System reads
+  // SMI_INT_STATUS_REG to check wheter an interrupt is
+  // pending(SMI_INT_PENDING).
+  // 2. If SMI_INT_STATUS_REG == SMI_INT_PENDING, then a DPC routine is
+  // invoked in order to read the response and the SMI_INT_ACK_REG is set to
+  // 0. Else it just continues normal kernel execution.
+
+  // B. Synchronous Mode (Interrupts Disabled):
+
+  // 1. System reads FIFO_OUT_STATUS_REG to check wheter the SMC has finished
+  // processing the command. If the status is FIFO_STATUS_READY (0x4), the
+  // System proceeds, else it loops until the FIFO_OUT_STATUS_REG is set to
+  // FIFO_STATUS_READY.
+
+  // The process afterwards in both cases is the same as when the system does
+  // a command write. The diffrence resides on the Registers being used, using
+  // FIFO_OUT_STATUS_REG instead of FIFO_IN_STATUS_REG and FIFO_OUT_DATA_REG
+  // instead of FIFO_IN_DATA_REG.
+
+  // This is set first as software waits for this register to become Ready
+  // in order to read a reply. Set FIFO_OUT_STATUS_REG to FIFO_STATUS_BUSY
+  smcPCIState->fifoOutStatusReg = FIFO_STATUS_BUSY;
+
+  // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY
   smcPCIState->fifoInStatusReg = FIFO_STATUS_READY;
 
-  // Timer for measuring elapsed time since last Clock Interrupt.
-  std::chrono::steady_clock::time_point timerStart =
-      std::chrono::steady_clock::now();
-
-  while (true) {
-    // The System Management Controller (SMC) does the following:
-    // * Communicates over a FIFO Queue with the kernel to execute commands and
-    // provide system info.
-    // * Does the UART/Serial communication between the console and remote
-    // Serial Device/PC.
-    // * Ticks the clock and sends an interrupt (PRIO_CLOCK) every x
-    // milliseconds.
-
-    // Core State (PowerOn Cause, SMC Ver, FAN Speed, Temps, etc...) should be
-    // already set.
-
-    /*
-            1. FIFO communication.
-    */
-
-    // This is done in simple steps:
-
-    /* Message Write (System -> SMC) */
-
-    // 1. System reads FIFO_IN_STATUS_REG to check wheter the SMC is ready to
-    // receive a command.
-    // 2. If the status is FIFO_STATUS_READY (0x4), the System proceeds, else it
-    // loops until the SMC Input Status Register is set to FIFO_STATUS_READY.
-    // 3. System then does a write to FIFO_IN_STATUS_REG setting it to
-    // FIFO_STATUS_READY. This signals the SMC that a new message/command is
-    // about to receive.
-    // 4. System does 4 32 Bit writes to FIFO_IN_DATA_REG, this is our 16 Bytes
-    // message.
-    // 5. System then does a write to FIFO_IN_STATUS_REG setting it to
-    // FIFO_STATUS_BUSY. This Signals the SMC that the message is transmitted
-    // and that it should start message processing.
-    // 6. If SMM (System Management Mode) interrupts are enabled, the SMC
-    // changes the SMI_INT_PENDING_REG to SMI_INT_PENDING and issues one
-    // signaling the System it should read the message. It also sets the
-    // FIFO_OUT_STATUS_REG to FIFO_STATUS_READY.
-
-    /* Message Read (SMC -> System) */
-
-    // Reads Proceed as following:
-    // A. Asynchronous Mode (Interrupts Enabled):
-    // 1. If an interrupt was issued (Asynchronous Mode), System reads
-    // SMI_INT_STATUS_REG to check wheter an interrupt is
-    // pending(SMI_INT_PENDING).
-    // 2. If SMI_INT_STATUS_REG == SMI_INT_PENDING, then a DPC routine is
-    // invoked in order to read the response and the SMI_INT_ACK_REG is set to
-    // 0. Else it just continues normal kernel execution.
-
-    // B. Synchronous Mode (Interrupts Disabled):
-
-    // 1. System reads FIFO_OUT_STATUS_REG to check wheter the SMC has finished
-    // processing the command. If the status is FIFO_STATUS_READY (0x4), the
-    // System proceeds, else it loops until the FIFO_OUT_STATUS_REG is set to
-    // FIFO_STATUS_READY.
-
-    // The process afterwards in both cases is the same as when the system does
-    // a command write. The diffrence resides on the Registers being used, using
-    // FIFO_OUT_STATUS_REG instead of FIFO_IN_STATUS_REG and FIFO_OUT_DATA_REG
-    // instead of FIFO_IN_DATA_REG.
-
-    // Check wheter we've received a command. If so, process it.
-    // Software sets FIFO_IN_STATUS_REG to FIFO_STATUS_BUSY after it has
-    // finished sending a command.
-    if (smcPCIState->fifoInStatusReg == FIFO_STATUS_BUSY) {
-      // This is set first as software waits for this register to become Ready
-      // in order to read a reply. Set FIFO_OUT_STATUS_REG to FIFO_STATUS_BUSY
-      smcPCIState->fifoOutStatusReg = FIFO_STATUS_BUSY;
-
-      // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY
-      smcPCIState->fifoInStatusReg = FIFO_STATUS_READY;
-
-      // Some commands does'nt have responses/interrupts.
-      bool noResponse = false;
-
-      // Note that the first byte in the response is always Command ID.
-
-      switch (
-          smcCoreState->fifoDataBuffer[0]) // Data Buffer[0] is our message ID.
-      {
-      case Xe::PCIDev::SMC::SMC_PWRON_TYPE:
-        // Zero out the buffer
-        memset(&smcCoreState->fifoDataBuffer, 0, 16);
-        smcCoreState->fifoDataBuffer[0] = SMC_PWRON_TYPE;
-        smcCoreState->fifoDataBuffer[1] = smcCoreState->currPowerOnReas;
-        break;
-      case Xe::PCIDev::SMC::SMC_QUERY_RTC:
-        // Zero out the buffer
-        memset(&smcCoreState->fifoDataBuffer, 0, 16);
-        smcCoreState->fifoDataBuffer[0] = SMC_QUERY_RTC;
-        smcCoreState->fifoDataBuffer[1] = 0;
-        break;
-      case Xe::PCIDev::SMC::SMC_QUERY_TEMP_SENS:
-        LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_TEMP_SENS");
-        break;
-      case Xe::PCIDev::SMC::SMC_QUERY_TRAY_STATE:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_TRAY_STATE");
-        break;
-      case Xe::PCIDev::SMC::SMC_QUERY_AVPACK:
-        smcCoreState->fifoDataBuffer[0] = SMC_QUERY_AVPACK;
-        smcCoreState->fifoDataBuffer[1] = smcCoreState->currAVPackType;
-        break;
-      case Xe::PCIDev::SMC::SMC_I2C_READ_WRITE:
-        switch (smcCoreState->fifoDataBuffer[1]) {
-        case 0x10: // SMC_READ_ANA
-          smcCoreState->fifoDataBuffer[0] = SMC_I2C_READ_WRITE;
-          smcCoreState->fifoDataBuffer[1] = 0x0;
-          smcCoreState->fifoDataBuffer[4] =
-              (HANA_State[smcCoreState->fifoDataBuffer[6]] & 0xFF);
-          smcCoreState->fifoDataBuffer[5] =
-              ((HANA_State[smcCoreState->fifoDataBuffer[6]] >> 8) & 0xFF);
-          smcCoreState->fifoDataBuffer[6] =
-              ((HANA_State[smcCoreState->fifoDataBuffer[6]] >> 16) & 0xFF);
-          smcCoreState->fifoDataBuffer[7] =
-              ((HANA_State[smcCoreState->fifoDataBuffer[6]] >> 24) & 0xFF);
-          break;
-        case 0x60: // SMC_WRITE_ANA
-          smcCoreState->fifoDataBuffer[0] = SMC_I2C_READ_WRITE;
-          smcCoreState->fifoDataBuffer[1] = 0x0;
-          HANA_State[smcCoreState->fifoDataBuffer[6]] =
-              smcCoreState->fifoDataBuffer[4] |
-              (smcCoreState->fifoDataBuffer[5] << 8) |
-              (smcCoreState->fifoDataBuffer[6] << 16) |
-              (smcCoreState->fifoDataBuffer[7] << 24);
-          break;
-        default:
-            LOG_WARNING(SMC, "SMC_I2C_READ_WRITE: Unimplemented command {:#x}", 
-                smcCoreState->fifoDataBuffer[1]);
-          smcCoreState->fifoDataBuffer[0] = SMC_I2C_READ_WRITE;
-          smcCoreState->fifoDataBuffer[1] = 0x1; // Set R/W Failed.
-        }
-        break;
-      case Xe::PCIDev::SMC::SMC_QUERY_VERSION:
-        smcCoreState->fifoDataBuffer[0] = SMC_QUERY_VERSION;
-        smcCoreState->fifoDataBuffer[1] = 0x41;
-        smcCoreState->fifoDataBuffer[2] = 0x02;
-        smcCoreState->fifoDataBuffer[3] = 0x03;
-        break;
-      case Xe::PCIDev::SMC::SMC_FIFO_TEST:
-        LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_FIFO_TEST");
-        break;
-      case Xe::PCIDev::SMC::SMC_QUERY_IR_ADDRESS:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_IR_ADDRESS");
-        break;
-      case Xe::PCIDev::SMC::SMC_QUERY_TILT_SENSOR:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_TILT_SENSOR");
-        break;
-      case Xe::PCIDev::SMC::SMC_READ_82_INT:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_READ_82_INT");
-        break;
-      case Xe::PCIDev::SMC::SMC_READ_8E_INT:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_READ_8E_INT");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_STANDBY:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_STANDBY");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_TIME:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_TIME");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_FAN_ALGORITHM:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FAN_ALGORITHM");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_FAN_SPEED_CPU:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FAN_SPEED_CPU");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_DVD_TRAY:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_DVD_TRAY");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_POWER_LED:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_POWER_LED");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_AUDIO_MUTE:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_AUDIO_MUTE");
-        break;
-      case Xe::PCIDev::SMC::SMC_ARGON_RELATED:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_ARGON_RELATED");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_FAN_SPEED_GPU:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FAN_SPEED_GPU");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_IR_ADDRESS:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_IR_ADDRESS");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_DVD_TRAY_SECURE:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_DVD_TRAY_SECURE");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_FP_LEDS:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FP_LEDS");
-          noResponse = true;
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_RTC_WAKE:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_RTC_WAKE");
-        break;
-      case Xe::PCIDev::SMC::SMC_ANA_RELATED:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_ANA_RELATED");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_ASYNC_OPERATION:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_ASYNC_OPERATION");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_82_INT:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_82_INT");
-        break;
-      case Xe::PCIDev::SMC::SMC_SET_9F_INT:
-          LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_9F_INT");
-        break;
-      default:
-          LOG_WARNING(SMC, "Unknown SMC_FIFO_CMD: ID = {:#x}", 
-              static_cast<u16>(smcCoreState->fifoDataBuffer[0]));
-        break;
-      }
+  // Some commands does'nt have responses/interrupts.
+  bool noResponse = false;
 
-      // Set FIFO_OUT_STATUS_REG to FIFO_STATUS_READY, signaling we're ready to
-      // transmit a response.
-      smcPCIState->fifoOutStatusReg = FIFO_STATUS_READY;
+  // Note that the first byte in the response is always Command ID.
 
-      // If interrupts are active set Int status and issue one.
-      if (smcPCIState->smiIntEnabledReg & SMI_INT_ENABLED && noResponse == false) {
-        smcPCIState->smiIntPendingReg = SMI_INT_PENDING;
-        pciBridge->RouteInterrupt(PRIO_SMM);
-      }
+  switch (
+      smcCoreState->fifoDataBuffer[0]) // Data Buffer[0] is our message ID.
+  {
+  case Xe::PCIDev::SMC::SMC_PWRON_TYPE:
+    // Zero out the buffer
+    memset(&smcCoreState->fifoDataBuffer, 0, 16);
+    smcCoreState->fifoDataBuffer[0] = SMC_PWRON_TYPE;
+    smcCoreState->fifoDataBuffer[1] = smcCoreState->currPowerOnReas;
+    break;
+  case Xe::PCIDev::SMC::SMC_QUERY_RTC:
+    // Zero out the buffer
+    memset(&smcCoreState->fifoDataBuffer, 0, 16);
+    smcCoreState->fifoDataBuffer[0] = SMC_QUERY_RTC;
+    smcCoreState->fifoDataBuffer[1] = 0;
+    break;
+  case Xe::PCIDev::SMC::SMC_QUERY_TEMP_SENS:
+    LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_TEMP_SENS");
+    break;
+  case Xe::PCIDev::SMC::SMC_QUERY_TRAY_STATE:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_TRAY_STATE");
+    break;
+  case Xe::PCIDev::SMC::SMC_QUERY_AVPACK:
+    smcCoreState->fifoDataBuffer[0] = SMC_QUERY_AVPACK;
+    smcCoreState->fifoDataBuffer[1] = smcCoreState->currAVPackType;
+    break;
+  case Xe::PCIDev::SMC::SMC_I2C_READ_WRITE:
+    switch (smcCoreState->fifoDataBuffer[1]) {
+    case 0x10: // SMC_READ_ANA
+      smcCoreState->fifoDataBuffer[0] = SMC_I2C_READ_WRITE;
+      smcCoreState->fifoDataBuffer[1] = 0x0;
+      smcCoreState->fifoDataBuffer[4] =
+          (HANA_State[smcCoreState->fifoDataBuffer[6]] & 0xFF);
+      smcCoreState->fifoDataBuffer[5] =
+          ((HANA_State[smcCoreState->fifoDataBuffer[6]] >> 8) & 0xFF);
+      smcCoreState->fifoDataBuffer[6] =
+          ((HANA_State[smcCoreState->fifoDataBuffer[6]] >> 16) & 0xFF);
+      smcCoreState->fifoDataBuffer[7] =
+          ((HANA_State[smcCoreState->fifoDataBuffer[6]] >> 24) & 0xFF);
+      break;
+    case 0x60: // SMC_WRITE_ANA
+      smcCoreState->fifoDataBuffer[0] = SMC_I2C_READ_WRITE;
+      smcCoreState->fifoDataBuffer[1] = 0x0;
+      HANA_State[smcCoreState->fifoDataBuffer[6]] =
+          smcCoreState->fifoDataBuffer[4] |
+          (smcCoreState->fifoDataBuffer[5] << 8) |
+          (smcCoreState->fifoDataBuffer[6] << 16) |
+          (smcCoreState->fifoDataBuffer[7] << 24);
+      break;
+    default:
+        LOG_WARNING(SMC, "SMC_I2C_READ_WRITE: Unimplemented command {:#x}", 
+            smcCoreState->fifoDataBuffer[1]);
+      smcCoreState->fifoDataBuffer[0] = SMC_I2C_READ_WRITE;
+      smcCoreState->fifoDataBuffer[1] = 0x1; // Set R/W Failed.
     }
+    break;
+  case Xe::PCIDev::SMC::SMC_QUERY_VERSION:
+    smcCoreState->fifoDataBuffer[0] = SMC_QUERY_VERSION;
+    smcCoreState->fifoDataBuffer[1] = 0x41;
+    smcCoreState->fifoDataBuffer[2] = 0x02;
+    smcCoreState->fifoDataBuffer[3] = 0x03;
+    break;
+  case Xe::PCIDev::SMC::SMC_FIFO_TEST:
+    LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_FIFO_TEST");
+    break;
+  case Xe::PCIDev::SMC::SMC_QUERY_IR_ADDRESS:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_IR_ADDRESS");
+    break;
+  case Xe::PCIDev::SMC::SMC_QUERY_TILT_SENSOR:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_QUERY_TILT_SENSOR");
+    break;
+  case Xe::PCIDev::SMC::SMC_READ_82_INT:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_READ_82_INT");
+    break;
+  case Xe::PCIDev::SMC::SMC_READ_8E_INT:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_READ_8E_INT");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_STANDBY:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_STANDBY");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_TIME:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_TIME");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_FAN_ALGORITHM:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FAN_ALGORITHM");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_FAN_SPEED_CPU:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FAN_SPEED_CPU");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_DVD_TRAY:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_DVD_TRAY");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_POWER_LED:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_POWER_LED");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_AUDIO_MUTE:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_AUDIO_MUTE");
+    break;
+  case Xe::PCIDev::SMC::SMC_ARGON_RELATED:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_ARGON_RELATED");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_FAN_SPEED_GPU:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FAN_SPEED_GPU");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_IR_ADDRESS:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_IR_ADDRESS");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_DVD_TRAY_SECURE:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_DVD_TRAY_SECURE");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_FP_LEDS:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_FP_LEDS");
+      noResponse = true;
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_RTC_WAKE:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_RTC_WAKE");
+    break;
+  case Xe::PCIDev::SMC::SMC_ANA_RELATED:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_ANA_RELATED");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_ASYNC_OPERATION:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_ASYNC_OPERATION");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_82_INT:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_82_INT");
+    break;
+  case Xe::PCIDev::SMC::SMC_SET_9F_INT:
+      LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD: SMC_SET_9F_INT");
+    break;
+  default:
+      LOG_WARNING(SMC, "Unknown SMC_FIFO_CMD: ID = {:#x}", 
+          static_cast<u16>(smcCoreState->fifoDataBuffer[0]));
+    break;
+  }
+
+  // Set FIFO_OUT_STATUS_REG to FIFO_STATUS_READY, signaling we're ready to
+  // transmit a response.
+  smcPCIState->fifoOutStatusReg = FIFO_STATUS_READY;
 
-    // Measure elapsed time
-    std::chrono::steady_clock::time_point timerNow =
-        std::chrono::steady_clock::now();
+  // If interrupts are active set Int status and issue one.
+  if (smcPCIState->smiIntEnabledReg & SMI_INT_ENABLED && noResponse == false) {
+    smcPCIState->smiIntPendingReg = SMI_INT_PENDING;
+    pciBridge->RouteInterrupt(PRIO_SMM);
+  }
+}
 
-    // Check for SMC Clock interrupt register.
-    if (smcPCIState->clockIntEnabledReg ==
-        CLCK_INT_ENABLED) // Clock Int Enabled.
+// Clock tick, runs every SMC_CLOCK_INT_DELAY of virtual time.
+void Xe::PCIDev::SMC::SMCCore::smcClockTick() {
+  // Check for SMC Clock interrupt register.
+  if (smcPCIState->clockIntEnabledReg ==
+      CLCK_INT_ENABLED) // Clock Int Enabled.
+  {
+    if (smcPCIState->clockIntStatusReg ==
+        CLCK_INT_READY) // Clock Interrupt Not Taken.
     {
-      if (smcPCIState->clockIntStatusReg ==
-          CLCK_INT_READY) // Clock Interrupt Not Taken.
-      {
-        // Wait X time before next clock interrupt. TODO: Find the correct
-        // delay.
-        if (timerNow >= timerStart + std::chrono::milliseconds(5000)) {
-          // Update internal timer.
-          timerStart = std::chrono::steady_clock::now();
-          smcPCIState->clockIntStatusReg = CLCK_INT_TAKEN;
-          pciBridge->RouteInterrupt(PRIO_CLOCK);
-        }
-      }
+      smcPCIState->clockIntStatusReg = CLCK_INT_TAKEN;
+      pciBridge->RouteInterrupt(PRIO_CLOCK);
     }
   }
+
+  // Schedule the next tick.
+  events->ScheduleEvent(SMC_CLOCK_INT_DELAY, [this] { smcClockTick(); });
 }
@@ -6,8 +6,10 @@
 #include <windows.h>
 #endif
 #include <condition_variable>
+#include <queue>
 #include <thread>
 
+#include "Core/EventScheduler/EventScheduler.h"
 #include "Core/RootBus/HostBridge/PCIBridge/PCIBridge.h"
 #include "Core/RootBus/HostBridge/PCIBridge/PCIDevice.h"
 
@@ -24,6 +26,9 @@
 
 #define SMC_DEV_SIZE 0x100
 
+// Clock interrupt period, in virtual time. TODO: Find the correct delay.
+#define SMC_CLOCK_INT_DELAY XE_MSEC_TO_TICKS(5000)
+
 namespace Xe {
 namespace PCIDev {
 namespace SMC {
@@ -265,7 +270,8 @@ struct SMC_CORE_STATE {
 class SMCCore : public PCIDevice {
 public:
   SMCCore(const char* deviceName, u64 size,
-    PCIBridge* parentPCIBridge, SMC_CORE_STATE* newSMCCoreState);
+    PCIBridge* parentPCIBridge, SMC_CORE_STATE* newSMCCoreState,
+    EventScheduler* eventScheduler);
   ~SMCCore();
 
   // Read/Write functions.
@@ -284,16 +290,19 @@ private:
   // SMC Core State, tracking all general system status.
   SMC_CORE_STATE *smcCoreState;
 
-  // SMC Thread object
-  std::thread smcThread;
+  // Virtual clock, the clock interrupt is scheduled on it.
+  EventScheduler *events;
 
 #ifndef _WIN32
   // UART Thread object
   std::thread uartThread;
 #endif
 
-  // SMC Main Thread
-  void smcMainThread();
+  // Processes the FIFO command the system just sent.
+  void smcProcessFIFOCommand();
+
+  // Clock tick, sends the clock interrupt if enabled.
+  void smcClockTick();
 
 #ifndef _WIN32
   // UART Thread
@@ -0,0 +1,106 @@
+// Copyright 2025 Xenon Emulator Project
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "Base/Types.h"
+
+/*
+ *	MemoryMap.h Page granular physical address map.
+ *
+ *	Resolves a 32 bit physical address to the device that owns it with a single
+ *	indexed lookup. Regions are added in priority order, the first region added
+ *	that contains an address owns it, just like scanning the devices in order.
+ *	Pages only partially covered by a region, or covered by more than one,
+ *	fall back to a short scan of the regions that overlap that page only.
+ */
+
+#define MEMORY_MAP_PAGE_SHIFT 12
+#define MEMORY_MAP_PAGE_COUNT (0x100000000ULL >> MEMORY_MAP_PAGE_SHIFT)
+
+// Page table entry flag, the entry is an index into the shared pages list.
+#define MEMORY_MAP_SHARED_PAGE 0x8000
+
+template <typename T> class MemoryMap {
+public:
+  MemoryMap() : pageTable(MEMORY_MAP_PAGE_COUNT, 0) {}
+
+  // Removes every mapped region.
+  void Clear() {
+    std::fill(pageTable.begin(), pageTable.end(), 0);
+    regions.clear();
+    sharedPages.clear();
+  }
+
+  // Maps the inclusive range [start, end] to a given target.
+  void AddRegion(u64 start, u64 end, T target) {
+    end = std::min<u64>(end, 0xFFFFFFFF);
+    if (start > end || regions.size() >= MEMORY_MAP_SHARED_PAGE - 1) {
+      return;
+    }
+
+    regions.push_back({start, end, target});
+    const u16 regionIndex = static_cast<u16>(regions.size());
+
+    for (u64 page = start >> MEMORY_MAP_PAGE_SHIFT;
+         page <= end >> MEMORY_MAP_PAGE_SHIFT; page++) {
+      u16 &pageEntry = pageTable[page];
+      const u64 pageStart = page << MEMORY_MAP_PAGE_SHIFT;
+      const u64 pageEnd = pageStart + (1 << MEMORY_MAP_PAGE_SHIFT) - 1;
+      const bool fullPage = start <= pageStart && end >= pageEnd;
+
+      if (pageEntry == 0) {
+        if (fullPage) {
+          pageEntry = regionIndex;
+        } else {
+          sharedPages.push_back({regionIndex});
+          pageEntry = static_cast<u16>(MEMORY_MAP_SHARED_PAGE |
+                                       (sharedPages.size() - 1));
+        }
+      } else if (pageEntry & MEMORY_MAP_SHARED_PAGE) {
+        sharedPages[pageEntry & ~MEMORY_MAP_SHARED_PAGE].push_back(
+            regionIndex);
+      }
+      // Otherwise a region with higher priority already owns the whole page.
+    }
+  }
+
+  // Returns the owner of a given address, or an empty target if unmapped.
+  T Find(u64 address) const {
+    if (address > 0xFFFFFFFF) {
+      return T{};
+    }
+
+    const u16 pageEntry = pageTable[address >> MEMORY_MAP_PAGE_SHIFT];
+    if (pageEntry == 0) {
+      return T{};
+    }
+    if (!(pageEntry & MEMORY_MAP_SHARED_PAGE)) {
+      return regions[pageEntry - 1].target;
+    }
+
+    for (const u16 regionIndex :
+         sharedPages[pageEntry & ~MEMORY_MAP_SHARED_PAGE]) {
+      const MemoryRegion &region = regions[regionIndex - 1];
+      if (address >= region.start && address <= region.end) {
+        return region.target;
+      }
+    }
+    return T{};
+  }
+
+private:
+  struct MemoryRegion {
+    u64 start;
+    u64 end;
+    T target;
+  };
+
+  // One entry per page: 0 = unmapped, otherwise the owning region index + 1,
+  // or a shared pages list index if MEMORY_MAP_SHARED_PAGE is set.
+  std::vector<u16> pageTable;
+  std::vector<MemoryRegion> regions;
+  std::vector<std::vector<u16>> sharedPages;
+};
@@ -27,6 +27,8 @@ void RootBus::AddDevice(SystemDevice *device) {
   deviceCount++;
   LOG_INFO(RootBus, "Device attached: {}", device->GetDeviceName());
   conectedDevices.push_back(device);
+  memoryMap.AddRegion(device->GetStartAddress(), device->GetEndAddress(),
+                      device);
 }
 
 void RootBus::Read(u64 readAddress, u64 *data, u8 byteCount) {
@@ -37,13 +39,10 @@ void RootBus::Read(u64 readAddress, u64 *data, u8 byteCount) {
     return;
   }
 
-  for (auto &device : conectedDevices) {
-    if (readAddress >= device->GetStartAddress() &&
-        readAddress <= device->GetEndAddress()) {
-      // Hit
-      device->Read(readAddress, data, byteCount);
-      return;
-    }
+  if (SystemDevice *device = memoryMap.Find(readAddress)) {
+    // Hit
+    device->Read(readAddress, data, byteCount);
+    return;
   }
 
   // Check on the other Busses.
@@ -66,13 +65,10 @@ void RootBus::Write(u64 writeAddress, u64 data, u8 byteCount) {
     return;
   }
 
-  for (auto &device : conectedDevices) {
-    if (writeAddress >= device->GetStartAddress() &&
-        writeAddress <= device->GetEndAddress()) {
-      // Hit
-      device->Write(writeAddress, data, byteCount);
-      return;
-    }
+  if (SystemDevice *device = memoryMap.Find(writeAddress)) {
+    // Hit
+    device->Write(writeAddress, data, byteCount);
+    return;
   }
 
   // Check on the other Busses.
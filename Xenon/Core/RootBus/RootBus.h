@@ -4,6 +4,7 @@
 
 #include "Base/SystemDevice.h"
 #include "Core/RootBus/HostBridge/HostBridge.h"
+#include "Core/RootBus/MemoryMap.h"
 
 // PCI Configuration region
 #define PCI_CONFIG_REGION_ADDRESS 0xD0000000
@@ -29,6 +30,8 @@ private:
   HostBridge *hostBridge{};
   u32 deviceCount;
   std::vector<SystemDevice*> conectedDevices;
+  // Physical address map of the connected devices.
+  MemoryMap<SystemDevice*> memoryMap;
 
   std::unique_ptr<u8> biuData{ std::make_unique<STRIP_UNIQUE(biuData)>(0x10000) };
 };
@@ -2,6 +2,7 @@
 
 #include "IIC.h"
 
+#include <bit>
 #include <thread>
 
 #include "Base/Logging/Log.h"
@@ -14,8 +15,6 @@ Xe::XCPU::IIC::XenonIIC::XenonIIC() {
 }
 
 void Xe::XCPU::IIC::XenonIIC::writeInterrupt(u64 intAddress, u64 intData) {
-  std::lock_guard lck(mutex);
-
   u32 mask = 0xF000;
   u8 ppeIntCtrlBlckID = static_cast<u8>((intAddress & mask) >> 12);
   u8 ppeIntCtrlBlckReg = intAddress & 0xFF;
@@ -28,10 +27,18 @@ void Xe::XCPU::IIC::XenonIIC::writeInterrupt(u64 intAddress, u64 intData) {
     iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].REG_CPU_WHOAMI =
         static_cast<u32>(std::byteswap<u64>(intData));
     break;
-  case Xe::XCPU::IIC::CPU_CURRENT_TSK_PRI:
-    iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].REG_CPU_CURRENT_TSK_PRI =
-        static_cast<u32>(std::byteswap<u64>(intData));
-    break;
+  case Xe::XCPU::IIC::CPU_CURRENT_TSK_PRI: {
+    const u32 tskPri = static_cast<u32>(std::byteswap<u64>(intData));
+    iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].REG_CPU_CURRENT_TSK_PRI = tskPri;
+    // Replace the priority, leaving the rest of the state untouched.
+    std::atomic<u64> &intState = iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intState;
+    u64 state = intState.load(std::memory_order_relaxed);
+    while (!intState.compare_exchange_weak(
+        state, (state & ~IIC_STATE_TSK_PRI_MASK) |
+                   (static_cast<u64>(tskPri & 0xFF) << IIC_STATE_TSK_PRI_SHIFT),
+        std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  } break;
   case Xe::XCPU::IIC::CPU_IPI_DISPATCH_0:
     iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].REG_CPU_IPI_DISPATCH_0 =
         static_cast<u32>(std::byteswap<u64>(intData));
@@ -42,25 +49,12 @@ void Xe::XCPU::IIC::XenonIIC::writeInterrupt(u64 intAddress, u64 intData) {
     genInterrupt(intType, cpusToInterrupt);
     break;
   case Xe::XCPU::IIC::EOI:
-    // Check if we have interrupts in the queue.
-    if (!iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intQueue.empty()) {
-      // Remove the first interrupt in the Interrupt queue.
-      iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intQueue.pop();
-      // Clear the ACK flag.
-      iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intAck = false;
-    }
+    endOfInterrupt(ppeIntCtrlBlckID, false, 0);
     break;
   case Xe::XCPU::IIC::EOI_SET_CPU_CURRENT_TSK_PRI:
-    // Check if we have interrupts in the queue.
-    if (!iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intQueue.empty()) {
-      // Remove the first interrupt in the Interrupt Queue.
-      iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intQueue.pop();
-      // Clear the ACK flag.
-      iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intAck = false;
-    }
-    // Set new Interrupt priority.
-    iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].REG_CPU_CURRENT_TSK_PRI =
-        static_cast<u32>(std::byteswap<u64>(intData));
+    // Also set new Interrupt priority.
+    endOfInterrupt(ppeIntCtrlBlckID, true,
+                   static_cast<u32>(std::byteswap<u64>(intData)));
     break;
   case Xe::XCPU::IIC::INT_MCACK:
     iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].REG_INT_MCACK =
@@ -73,8 +67,6 @@ void Xe::XCPU::IIC::XenonIIC::writeInterrupt(u64 intAddress, u64 intData) {
 }
 
 void Xe::XCPU::IIC::XenonIIC::readInterrupt(u64 intAddress, u64 *intData) {
-  std::lock_guard lck(mutex);
-
   u32 mask = 0xF000;
   u8 ppeIntCtrlBlckID = static_cast<u8>((intAddress & mask) >> 12);
   u8 ppeIntCtrlBlckReg = intAddress & 0xFF;
@@ -83,23 +75,26 @@ void Xe::XCPU::IIC::XenonIIC::readInterrupt(u64 intAddress, u64 *intData) {
     *intData = std::byteswap<u64>(
         (u64)iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].REG_CPU_CURRENT_TSK_PRI);
     break;
-  case Xe::XCPU::IIC::ACK:
-    // Check if the queue isn't empty (this probably isn't necessary).
-    if (iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intQueue.empty() != true) {
-      // If the first interrupt is ACK'd we return PRIO_NONE.
-      if (iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intAck) {
+  case Xe::XCPU::IIC::ACK: {
+    std::lock_guard lck(mutex);
+    std::atomic<u64> &intState = iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intState;
+    u64 state = intState.load(std::memory_order_acquire);
+    u8 highestPending = PRIO_NONE;
+    do {
+      highestPending = getHighestPending(state);
+      // If the first interrupt is ACK'd, or there's none, we return PRIO_NONE.
+      if (highestPending == PRIO_NONE || (state & IIC_STATE_ACK)) {
         *intData = std::byteswap<u64>(PRIO_NONE);
-      } else {
-        // Signal the Top Priority interrupt.
-        *intData = std::byteswap<u64>(
-            iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intQueue.top());
-        // Set the ACK flag.
-        iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].intAck = true;
         return;
       }
-    }
-    *intData = std::byteswap<u64>(PRIO_NONE);
-    break;
+      // Set the ACK flag.
+    } while (!intState.compare_exchange_weak(state, state | IIC_STATE_ACK,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire));
+    // Signal the Top Priority interrupt.
+    iicState.ppeIntCtrlBlck[ppeIntCtrlBlckID].ackedPrio = highestPending;
+    *intData = std::byteswap<u64>(static_cast<u64>(highestPending));
+  } break;
   default:
     LOG_ERROR(Xenon_IIC, "Unknown interupt being read {:#x}", ppeIntCtrlBlckReg);
     break;
@@ -107,37 +102,69 @@ void Xe::XCPU::IIC::XenonIIC::readInterrupt(u64 intAddress, u64 *intData) {
 }
 
 bool Xe::XCPU::IIC::XenonIIC::checkExtInterrupt(u8 ppuID) {
-  std::lock_guard lck(mutex);
-  // 1. Check if there's any interrupt already taken.
-  if (iicState.ppeIntCtrlBlck[ppuID].intAck) {
+  const u64 state =
+      iicState.ppeIntCtrlBlck[ppuID].intState.load(std::memory_order_relaxed);
+  // 1. Check if there's any interrupt already taken, or none pending at all.
+  if ((state & IIC_STATE_ACK) || (state & IIC_STATE_PENDING_MASK) == 0) {
     return false;
   }
 
-  // Check to see if there are any interrupts in our queue.
-  if (iicState.ppeIntCtrlBlck[ppuID].intQueue.empty() != true) {
-    // Check if the top priority interrupt is higher or equal than current task
-    // priority.
-    if (iicState.ppeIntCtrlBlck[ppuID].intQueue.top() >=
-        iicState.ppeIntCtrlBlck[ppuID].REG_CPU_CURRENT_TSK_PRI) {
-      // Signal the interrupt.
-      return true;
-    }
-  }
-  return false;
+  // Check if the top priority interrupt is higher or equal than current task
+  // priority.
+  return getHighestPending(state) >=
+         ((state & IIC_STATE_TSK_PRI_MASK) >> IIC_STATE_TSK_PRI_SHIFT);
 }
 
 void Xe::XCPU::IIC::XenonIIC::genInterrupt(u8 interruptType,
                                            u8 cpusToInterrupt) {
-  std::lock_guard lck(mutex);
-  XE_INT newInt;
-  newInt.ack = false;
-  newInt.pendingInt = interruptType;
+  const u8 ppeMask = cpusToInterrupt;
   for (u8 ppuID = 0; ppuID < 6; ppuID++) {
     if ((cpusToInterrupt & 0x1) == 1) {
-      // Store the interrupt.
-      iicState.ppeIntCtrlBlck[ppuID].intQueue.push(
-          static_cast<u64>(interruptType));
+      // Mark the interrupt as pending.
+      iicState.ppeIntCtrlBlck[ppuID].intState.fetch_or(
+          1ULL << ((interruptType >> 2) & 0x1F), std::memory_order_release);
     }
     cpusToInterrupt = cpusToInterrupt >> 1;
   }
+  // Let whoever is waiting for it know.
+  if (interruptCallback) {
+    interruptCallback(ppeMask);
+  }
+}
+
+u8 Xe::XCPU::IIC::XenonIIC::getHighestPending(u64 state) {
+  const u32 pending = static_cast<u32>(state & IIC_STATE_PENDING_MASK);
+  if (pending == 0) {
+    return PRIO_NONE;
+  }
+  return static_cast<u8>((31 - std::countl_zero(pending)) << 2);
+}
+
+void Xe::XCPU::IIC::XenonIIC::endOfInterrupt(u8 ppeID, bool setTskPri,
+                                             u32 tskPri) {
+  std::lock_guard lck(mutex);
+  PPE_INT_CTRL_BLCK &intCtrlBlck = iicState.ppeIntCtrlBlck[ppeID];
+  if (setTskPri) {
+    intCtrlBlck.REG_CPU_CURRENT_TSK_PRI = tskPri;
+  }
+
+  u64 state = intCtrlBlck.intState.load(std::memory_order_acquire);
+  u64 newState = 0;
+  do {
+    newState = state;
+    // Remove the interrupt that was ACK'd, or the top priority one.
+    const u8 prio = (state & IIC_STATE_ACK) ? intCtrlBlck.ackedPrio
+                                            : getHighestPending(state);
+    if (prio != PRIO_NONE) {
+      newState &= ~(1ULL << ((prio >> 2) & 0x1F));
+    }
+    // Clear the ACK flag.
+    newState &= ~IIC_STATE_ACK;
+    if (setTskPri) {
+      newState = (newState & ~IIC_STATE_TSK_PRI_MASK) |
+                 (static_cast<u64>(tskPri & 0xFF) << IIC_STATE_TSK_PRI_SHIFT);
+    }
+  } while (!intCtrlBlck.intState.compare_exchange_weak(
+      state, newState, std::memory_order_acq_rel, std::memory_order_acquire));
+  intCtrlBlck.ackedPrio = PRIO_NONE;
 }
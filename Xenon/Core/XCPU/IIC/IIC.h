@@ -2,7 +2,8 @@
 
 #pragma once
 
-#include <queue>
+#include <atomic>
+#include <functional>
 #include <mutex>
 
 #include "Base/Types.h"
@@ -53,13 +54,20 @@ enum XE_IIC_CPU_REG {
   INT_MCACK = 0x70
 };
 
-struct XE_INT {
-  bool ack = false;
-  u8 pendingInt = 0;
-};
+// Per PPE interrupt state, packed in a single atomic value so checking for
+// pending interrupts takes a single load:
+// [0:31] Pending interrupts, one bit per priority (PRIO_* >> 2).
+// [32:39] Current task priority.
+// [40] The highest priority pending interrupt has been ACK'd.
+#define IIC_STATE_PENDING_MASK 0xFFFFFFFFULL
+#define IIC_STATE_TSK_PRI_SHIFT 32
+#define IIC_STATE_TSK_PRI_MASK (0xFFULL << IIC_STATE_TSK_PRI_SHIFT)
+#define IIC_STATE_ACK (1ULL << 40)
 
-// Each logical thread has its own Interrupt Control Block.
-struct PPE_INT_CTRL_BLCK {
+// Each logical thread has its own Interrupt Control Block. Its owner polls it
+// after every instruction while other PPE's post interrupts to it, so blocks
+// don't share cache lines.
+struct alignas(HOST_CACHE_LINE_SIZE) PPE_INT_CTRL_BLCK {
   u32 REG_CPU_WHOAMI;
   u32 REG_CPU_CURRENT_TSK_PRI;
   u32 REG_CPU_IPI_DISPATCH_0;
@@ -68,11 +76,10 @@ struct PPE_INT_CTRL_BLCK {
   u32 REG_EOI;
   u32 REG_EOI_SET_CPU_CURRENT_TSK_PRI;
   u32 REG_INT_MCACK;
-  std::vector<XE_INT> pendingInt;
-  // Interrupt Queue (Higher priority interrupts come first).
-  std::priority_queue<u64> intQueue;
-  // Interrupt Ack flag.
-  bool intAck = false;
+  // Pending interrupts, task priority and ACK flag. See IIC_STATE_*.
+  std::atomic<u64> intState = 0;
+  // Priority of the interrupt that was ACK'd, the next EOI clears it.
+  u8 ackedPrio = PRIO_NONE;
 };
 
 struct IIC_State {
@@ -87,10 +94,22 @@ public:
   void readInterrupt(u64 intAddress, u64 *intData);
   bool checkExtInterrupt(u8 ppuID);
   void genInterrupt(u8 interruptType, u8 cpusToInterrupt);
+  // Called after every interrupt generated, with the mask of the targeted
+  // PPE's. Used to wake up idle PPU's.
+  void setInterruptCallback(std::function<void(u8)> callback) {
+    interruptCallback = callback;
+  }
 
 private:
   IIC_State iicState;
-  std::recursive_mutex mutex;
+  // Only taken on the slow paths, kept apart from the interrupt blocks.
+  alignas(HOST_CACHE_LINE_SIZE) std::recursive_mutex mutex;
+  std::function<void(u8)> interruptCallback;
+
+  // Returns the highest priority pending in a given state, or PRIO_NONE.
+  static u8 getHighestPending(u64 state);
+  // Clears the ACK'd interrupt, or the highest pending one if none was ACK'd.
+  void endOfInterrupt(u8 ppeID, bool setTskPri, u32 tskPri);
 };
 } // namespace IIC
 } // namespace XCPU
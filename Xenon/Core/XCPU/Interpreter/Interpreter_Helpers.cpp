@@ -1,36 +1,34 @@
 // Copyright 2025 Xenon Emulator Project
 
+#include <algorithm>
+
 #include "Base/Logging/Log.h"
 
 #include "PPCInterpreter.h"
 
 void PPCInterpreter::ppcUpdateCR(PPU_STATE *hCore, s8 crNum, u32 crValue) {
+  CR_FIELD &field = hCore->curThread->CR.field[crNum];
+  field.value = crValue & 0xF;
+  field.kind = CR_FIELD_VALUE;
+}
 
-  switch (crNum) {
-  case 0:
-    hCore->ppuThread[hCore->currentThread].CR.CR0 = crValue;
-    break;
-  case 1:
-    hCore->ppuThread[hCore->currentThread].CR.CR1 = crValue;
-    break;
-  case 2:
-    hCore->ppuThread[hCore->currentThread].CR.CR2 = crValue;
-    break;
-  case 3:
-    hCore->ppuThread[hCore->currentThread].CR.CR3 = crValue;
-    break;
-  case 4:
-    hCore->ppuThread[hCore->currentThread].CR.CR4 = crValue;
-    break;
-  case 5:
-    hCore->ppuThread[hCore->currentThread].CR.CR5 = crValue;
-    break;
-  case 6:
-    hCore->ppuThread[hCore->currentThread].CR.CR6 = crValue;
-    break;
-  case 7:
-    hCore->ppuThread[hCore->currentThread].CR.CR7 = crValue;
-    break;
+u32 PPCInterpreter::ppcGetCRHex(PPU_STATE *hCore) {
+  u32 crValue = 0;
+  for (u32 crNum = 0; crNum < 8; crNum++) {
+    crValue = (crValue << 4) | ppcGetCR(hCore, crNum);
+  }
+  return crValue;
+}
+
+void PPCInterpreter::ppcSetCRHex(PPU_STATE *hCore, u32 crValue, u32 mask) {
+  for (u32 crNum = 0; crNum < 8; crNum++) {
+    const u32 shift = 28 - crNum * 4;
+    const u32 fieldMask = (mask >> shift) & 0xF;
+    if (fieldMask) {
+      ppcUpdateCR(hCore, crNum,
+                  ((crValue >> shift) & fieldMask) |
+                      (ppcGetCR(hCore, crNum) & ~fieldMask));
+    }
   }
 }
 
@@ -44,7 +42,7 @@ u32 PPCInterpreter::CRCompU(PPU_STATE *hCore, u64 num1, u64 num2) {
   else
     BSET(CR, 4, CR_BIT_EQ);
 
-  if (hCore->ppuThread[hCore->currentThread].SPR.XER.SO)
+  if (hCore->curThread->XER.SO)
     BSET(CR, 4, CR_BIT_SO);
 
   return CR;
@@ -60,7 +58,7 @@ u32 PPCInterpreter::CRCompS32(PPU_STATE *hCore, u32 num1, u32 num2) {
   else
     BSET(CR, 4, CR_BIT_EQ);
 
-  if (hCore->ppuThread[hCore->currentThread].SPR.XER.SO)
+  if (hCore->curThread->XER.SO)
     BSET(CR, 4, CR_BIT_SO);
 
   return CR;
@@ -76,14 +74,14 @@ u32 PPCInterpreter::CRCompS64(PPU_STATE *hCore, u64 num1, u64 num2) {
   else
     BSET(CR, 4, CR_BIT_EQ);
 
-  if (hCore->ppuThread[hCore->currentThread].SPR.XER.SO)
+  if (hCore->curThread->XER.SO)
     BSET(CR, 4, CR_BIT_SO);
 
   return CR;
 }
 
 u32 PPCInterpreter::CRCompS(PPU_STATE *hCore, u64 num1, u64 num2) {
-  if (hCore->ppuThread[hCore->currentThread].SPR.MSR.SF)
+  if (hCore->curThread->MSR.SF)
     return (CRCompS64(hCore, num1, num2));
   else
     return (CRCompS32(hCore, (u32)num1, (u32)num2));
@@ -110,4 +108,81 @@ void PPCInterpreter::ppcDebugLoadImageSymbols(PPU_STATE *hCore,
 
 void PPCInterpreter::ppcDebugUnloadImageSymbols(PPU_STATE *hCore,
                                                 u64 moduleNameAddress,
-                                                u64 moduleInfoAddress) {}
\ No newline at end of file
+                                                u64 moduleInfoAddress) {}
+
+// Brings the virtual clock, the time base and the decrementers of both threads
+// up to date with the instructions executed since the last update, and works
+// out how many instructions can run before the next decrementer underflow or
+// device event. With SMT host threads both threads update them, each with the
+// instructions it executed.
+void PPCInterpreter::ppcUpdateTimeBase(PPU_STATE *hCore) {
+  const u64 ticks =
+      static_cast<u64>(hCore->tbPendingInstrs) * hCore->ticksPerInstruction;
+  hCore->tbPendingInstrs = 0;
+
+  // Devices run on virtual time, whether the time base is enabled or not.
+  EventScheduler *eventScheduler = intXCPUContext->eventScheduler;
+  if (eventScheduler && ticks != 0) {
+    eventScheduler->Advance(ticks);
+  }
+  u64 ticksToEvent =
+      eventScheduler ? eventScheduler->GetTicksToNextEvent() : XE_NO_EVENT;
+
+  auto coreLock = ppcLockCore(hCore);
+
+  // HID6[15]: Time-base and decrementer facility enable.
+  // 0 -> TBU, TBL, DEC, HDEC, and the hang-detection logic do not
+  // update. 1 -> TBU, TBL, DEC, HDEC, and the hang-detection logic
+  // are enabled to update.
+  const bool timeBaseEnabled =
+      intXCPUContext->timeBaseActive.load(std::memory_order_relaxed) &&
+      (hCore->SPR.HID6 & 0x1000000000000);
+  if (timeBaseEnabled) {
+    if (ticks != 0) {
+      // Update the Time Base.
+      hCore->SPR.TB += ticks;
+      // The Decrementers are driven by the same time frequency.
+      for (u8 thrdID = 0; thrdID < 2; thrdID++) {
+        const u32 dec = hCore->ppuThread[thrdID].SPR.DEC;
+        hCore->ppuThread[thrdID].SPR.DEC = dec - static_cast<u32>(ticks);
+        // Passing zero means the decrementer must issue an interrupt.
+        if (ticks > dec) {
+          ppcPostException(hCore, thrdID, PPU_EX_DEC);
+        }
+      }
+      const u32 hdec = hCore->SPR.HDEC;
+      hCore->SPR.HDEC = hdec - static_cast<u32>(ticks);
+      if (ticks > hdec) {
+        ppcPostException(hCore, PPU_THREAD_0, PPU_EX_HDEC);
+      }
+    }
+
+    // The closest decrementer underflow.
+    const u64 ticksToDec =
+        std::min({static_cast<u32>(hCore->ppuThread[PPU_THREAD_0].SPR.DEC),
+                  static_cast<u32>(hCore->ppuThread[PPU_THREAD_1].SPR.DEC),
+                  hCore->SPR.HDEC});
+    ticksToEvent = std::min(ticksToEvent, ticksToDec + 1);
+  }
+
+  if (ticksToEvent == XE_NO_EVENT) {
+    // Nothing to count down, just check back from time to time.
+    hCore->tbEventInstrs = hCore->SPR.TTR ? hCore->SPR.TTR : 1;
+    return;
+  }
+
+  // Schedule the next update right when it's due.
+  const u64 tpi = hCore->ticksPerInstruction ? hCore->ticksPerInstruction : 1;
+  hCore->tbEventInstrs = static_cast<u32>(
+      std::clamp<u64>((ticksToEvent + tpi - 1) / tpi, 1, 0xFFFFFFFF));
+}
+
+void PPCInterpreter::ppcPostException(PPU_STATE *hCore, u8 thrdID,
+                                      u16 exceptions) {
+  if (!hCore->smtHostThreads || thrdID == hCore->currentThread) {
+    hCore->ppuThread[thrdID].exceptReg |= exceptions;
+    return;
+  }
+  hCore->ppuThread[thrdID].postedRequests.fetch_or(exceptions,
+                                                   std::memory_order_release);
+}
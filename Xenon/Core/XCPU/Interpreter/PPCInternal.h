@@ -122,9 +122,9 @@ static inline u64 ExtractBits64(u32 input, u32 begin, u32 end) {
   (dw) |= ((dwSet) << (31 - (e))) & DMASK(b, e);
 
 #define IFIELD(v, b, e)                                                        \
-  u32 v = DGET(hCore->ppuThread[hCore->currentThread].CI.opcode, b, e);
+  u32 v = DGET(hCore->curThread->CI.opcode, b, e);
 #define IFIELDQ(v, b, e)                                                       \
-  u64 v = DGET(hCore->ppuThread[hCore->currentThread].CI.opcode, b, e);
+  u64 v = DGET(hCore->curThread->CI.opcode, b, e);
 
 #define I_FORM_LI_AA_LK                                                        \
   IFIELD(LI, 6, 29);                                                           \
@@ -243,6 +243,7 @@ static inline u64 ExtractBits64(u32 input, u32 begin, u32 end) {
   IFIELD(rB, 16, 20);
 #define X_FORM_L IFIELD(L, 10, 10);
 #define X_FORM_TO_rA_rB X_FORM(TO, rA, rB)
+#define X_FORM_FrD_rA_rB X_FORM(FrD, rA, rB);
 #define X_FORM_FrD_rA_rB_XO X_FORM_XO(FrD, rA, rB, XO)
 #define X_FORM_FrD_FrB_RC                                                      \
   IFIELD(FrD, 6, 10);                                                          \
@@ -251,6 +252,7 @@ static inline u64 ExtractBits64(u32 input, u32 begin, u32 end) {
 #define X_FORM_FrD_RC                                                          \
   IFIELD(FrD, 6, 10);                                                          \
   IFIELD(RC, 31, 31);
+#define X_FORM_FrS_rA_rB X_FORM(FrS, rA, rB);
 #define X_FORM_FrS_rA_rB_XO X_FORM_XO(FrS, rA, rB, XO)
 #define X_FORM_BT_XO_RC                                                        \
   IFIELD(BT, 6, 10);                                                           \
@@ -405,6 +407,67 @@ static inline u64 ExtractBits64(u32 input, u32 begin, u32 end) {
 #define VX_FORM_rD_rA_rB VX_FORM(rD, rA, rB);
 #define VX_FORM_rD IFIELD(rD, 6, 10);
 #define VX_FORM_rB IFIELD(rB, 16, 20);
+#define VX_FORM_rD_SIMM                                                        \
+  IFIELD(rD, 6, 10);                                                           \
+  IFIELD(SIMM, 11, 15);
+
+#define VA_FORM_rD_rA_rB_rC                                                    \
+  VX_FORM(rD, rA, rB);                                                         \
+  IFIELD(rC, 21, 25);
+
+// VMX128 forms, the extra bits of the 7 bit vector register numbers are
+// scattered around the extended opcode.
+#define VX128_VD128                                                            \
+  IFIELD(VD128l, 6, 10);                                                       \
+  IFIELD(VD128h, 28, 29);                                                      \
+  u32 VD128 = VD128l | (VD128h << 5);
+#define VX128_VA128                                                            \
+  IFIELD(VA128l, 11, 15);                                                      \
+  IFIELD(VA128h, 26, 26);                                                      \
+  IFIELD(VA128H, 21, 21);                                                      \
+  u32 VA128 = VA128l | (VA128h << 5) | (VA128H << 6);
+#define VX128_VB128                                                            \
+  IFIELD(VB128l, 16, 20);                                                      \
+  IFIELD(VB128h, 30, 31);                                                      \
+  u32 VB128 = VB128l | (VB128h << 5);
+
+#define VX128_FORM_VD128_VA128_VB128                                           \
+  VX128_VD128;                                                                 \
+  VX128_VA128;                                                                 \
+  VX128_VB128;
+#define VX128_R_FORM_VD128_VA128_VB128_RC                                      \
+  VX128_FORM_VD128_VA128_VB128;                                                \
+  IFIELD(RC, 25, 25);
+#define VX128_1_FORM_VD128_rA_rB                                               \
+  IFIELD(VD128l, 6, 10);                                                       \
+  IFIELD(VD128h, 28, 29);                                                      \
+  u32 VD128 = VD128l | (VD128h << 5);                                          \
+  IFIELD(rA, 11, 15);                                                          \
+  IFIELD(rB, 16, 20);
+#define VX128_2_FORM_VD128_VA128_VB128_VC                                      \
+  VX128_FORM_VD128_VA128_VB128;                                                \
+  IFIELD(VC, 23, 25);
+#define VX128_3_FORM_VD128_VB128                                               \
+  VX128_VD128;                                                                 \
+  VX128_VB128;
+#define VX128_3_FORM_VD128_VB128_IMM                                           \
+  VX128_3_FORM_VD128_VB128;                                                    \
+  IFIELD(IMM, 11, 15);
+#define VX128_3_FORM_VD128_IMM                                                 \
+  VX128_VD128;                                                                 \
+  IFIELD(IMM, 11, 15);
+#define VX128_4_FORM_VD128_VB128_IMM_z                                         \
+  VX128_3_FORM_VD128_VB128_IMM;                                                \
+  IFIELD(z, 24, 25);
+#define VX128_5_FORM_VD128_VA128_VB128_SH                                      \
+  VX128_FORM_VD128_VA128_VB128;                                                \
+  IFIELD(SH, 22, 25);
+#define VX128_P_FORM_VD128_VB128_PERM                                          \
+  VX128_VD128;                                                                 \
+  VX128_VB128;                                                                 \
+  IFIELD(PERMl, 11, 15);                                                       \
+  IFIELD(PERMh, 23, 25);                                                       \
+  u32 PERM = PERMl | (PERMh << 5);
 
 #define EXTS(qw, ib)                                                           \
   ((((u64)(qw)) & (((u64)(1)) << ((ib) - 1)))                                  \
@@ -419,9 +482,9 @@ static inline u64 ExtractBits64(u32 input, u32 begin, u32 end) {
 
 #define BO_GET(i) BGET(BO, 5, i)
 
-#define CR_GET(i) BGET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, i)
-#define CR_SET(i) BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, i)
-#define CR_CLR(i) BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, i)
+#define CR_GET(i) ppcGetCRBit(hCore, i)
+#define CR_SET(i) ppcSetCRBit(hCore, i, 1)
+#define CR_CLR(i) ppcSetCRBit(hCore, i, 0)
 
 #define CR_BIT_LT 0
 #define CR_BIT_GT 1
@@ -4,14 +4,17 @@
 
 #include "PPCInternal.h"
 
+#include "PPC_Hooks.h"
 #include "PPC_Instruction.h"
 #include "PPCOpcodes.h"
 
+#include "Core/RAM/RAM.h"
 #include "Core/RootBus/RootBus.h"
 #include "Core/XCPU/PPU/PowerPC.h"
 
 namespace PPCInterpreter {
 extern RootBus *sysBus;
+extern RAM *mainMemory;
 extern XENON_CONTEXT *intXCPUContext;
 
 //
@@ -43,9 +46,81 @@ u32 CRCompS64(PPU_STATE *hCore, u64 num1, u64 num2);
 u32 CRCompS(PPU_STATE *hCore, u64 num1, u64 num2);
 // Condition register Update
 void ppcUpdateCR(PPU_STATE *hCore, s8 crNum, u32 crValue);
+// Whole CR, as read by mfcr.
+u32 ppcGetCRHex(PPU_STATE *hCore);
+// Sets the CR fields selected by mask, as mtcrf does.
+void ppcSetCRHex(PPU_STATE *hCore, u32 crValue, u32 mask = 0xFFFFFFFF);
+
+// Record form CR0 update, only the result is stored. The compare with zero
+// happens once CR0 is read.
+inline void ppcRecordCR0(PPU_STATE *hCore, u64 result) {
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+  CR_FIELD &field = thread.CR.field[0];
+  field.result = result;
+  field.value = thread.XER.SO;
+  field.kind = thread.MSR.SF ? CR_FIELD_RESULT64 : CR_FIELD_RESULT32;
+}
+
+// Value of a CR field, LT GT EQ SO from MSB to LSB.
+inline u32 ppcGetCR(PPU_STATE *hCore, u32 crNum) {
+  const CR_FIELD &field =
+      hCore->curThread->CR.field[crNum];
+  s64 result;
+  switch (field.kind) {
+  case CR_FIELD_RESULT32:
+    result = static_cast<s32>(field.result);
+    break;
+  case CR_FIELD_RESULT64:
+    result = static_cast<s64>(field.result);
+    break;
+  default:
+    return field.value;
+  }
+  return (result < 0 ? 0b1000 : result > 0 ? 0b0100 : 0b0010) | field.value;
+}
+
+// CR bit, 0 being CR0[LT].
+inline u32 ppcGetCRBit(PPU_STATE *hCore, u32 bit) {
+  return (ppcGetCR(hCore, bit >> 2) >> (3 - (bit & 3))) & 1;
+}
+
+inline void ppcSetCRBit(PPU_STATE *hCore, u32 bit, u32 value) {
+  const u32 crNum = bit >> 2;
+  const u32 mask = 0b1000 >> (bit & 3);
+  const u32 field = ppcGetCR(hCore, crNum);
+  ppcUpdateCR(hCore, crNum, value ? field | mask : field & ~mask);
+}
 
-// Single instruction execution
-void ppcExecuteSingleInstruction(PPU_STATE *hCore);
+//
+// Time Base
+//
+
+// Applies the pending instructions to TB, DEC and HDEC, must be called before
+// any of them is accessed.
+void ppcUpdateTimeBase(PPU_STATE *hCore);
+
+//
+// SMT
+//
+
+// Locks the state shared by both threads of the core, only when the other
+// thread runs on its own host thread.
+inline std::unique_lock<std::recursive_mutex> ppcLockCore(PPU_STATE *hCore) {
+  if (!hCore->smtHostThreads) {
+    return {};
+  }
+  return std::unique_lock<std::recursive_mutex>(hCore->core->lock);
+}
+// Raises exceptions on a thread of the core. The other thread gets them
+// through its postedRequests when it runs on its own host thread.
+void ppcPostException(PPU_STATE *hCore, u8 thrdID, u16 exceptions);
+
+// Single instruction execution, handler is the already decoded instruction
+// if the caller has it.
+void ppcExecuteSingleInstruction(PPU_STATE *hCore,
+                                 instructionHandler handler = nullptr);
+// Instruction decoding, used to fill the PPU decode caches.
+instructionHandler ppcDecodeInstruction(u32 opcode);
 
 //
 // Exceptions
@@ -66,6 +141,34 @@ void ppcSystemCallException(PPU_STATE *hCore);
 void ppcDecrementerException(PPU_STATE *hCore);
 void ppcProgramException(PPU_STATE *hCore);
 void ppcExternalException(PPU_STATE *hCore);
+void ppcFPUnavailableException(PPU_STATE *hCore);
+void ppcVXUnavailableException(PPU_STATE *hCore);
+
+//
+// FPU
+//
+
+// Folds the host exception flags and the pending result class into the
+// FPSCR, must be called before the FPSCR is read.
+void ppcSyncFPSCR(PPU_STATE *hCore);
+// Switch the host FPU to and from the current hardware thread. Rounding mode
+// and non-IEEE mode are loaded into the host, and the host exception flags are
+// saved on leave.
+void ppcFpuEnterThread(PPU_STATE *hCore);
+void ppcFpuLeaveThread(PPU_STATE *hCore);
+// Conversions used by the floating point loads and stores, bit exact like the
+// hardware, including NaN's and denormals.
+u64 ppcSingleToDouble(u32 value);
+u32 ppcDoubleToSingle(u64 value);
+
+// Raises the Floating-Point Unavailable exception if MSR[FP] is clear.
+inline bool ppcFpuAvailable(PPU_STATE *hCore) {
+  if (hCore->curThread->MSR.FP != 1) {
+    hCore->curThread->exceptReg |= PPU_EX_FPU;
+    return false;
+  }
+  return true;
+}
 
 //
 // MMU
@@ -73,9 +176,24 @@ void ppcExternalException(PPU_STATE *hCore);
 
 bool MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState, bool memWrite);
 u8 mmuGetPageSize(PPU_STATE *hCore, bool L, u8 LP);
+SLBEntry *mmuSearchSlbEntry(PPU_STATE *hCore, u64 ESID);
 void mmuAddTlbEntry(PPU_STATE *hCore);
 bool mmuSearchTlbEntry(PPU_STATE *hCore, u64 *RPN, u64 VA, u64 VPN, u8 p,
-                       bool LP);
+                       bool L, u8 LP, bool memWrite, bool *C);
+void mmuRefillTlbEntry(PPU_STATE *hCore, u64 VA, u64 VPN, u8 p, bool L, u8 LP,
+                       u64 RPN, bool C);
+bool mmuSearchEratEntry(ERAT_Reg *erat, u64 *EA, u8 mode, bool memWrite);
+void mmuAddEratEntry(ERAT_Reg *erat, u64 EA, u64 RA, u8 mode, bool C);
+void mmuInvalidateErats(PPU_STATE *hCore, PPU_THREAD thread);
+void mmuInvalidateEratSegment(PPU_STATE *hCore, u64 ESID);
+u32 mmuMarkCodePage(u64 RA);
+u32 mmuCodePageGeneration(u64 RA);
+void mmuInvalidateCodePages(u64 RA, u64 size);
+void mmuDeviceWrite(u64 RA, u64 size);
+bool mmuStoreConditional(PPU_RES *ppuRes, u64 RA, u64 data, s8 byteCount);
+bool mmuSearchPageTable(PPU_STATE *hCore, u64 VA, u64 VSID, u64 PAGE, u8 p,
+                        bool L, u8 LP, bool memWrite, u64 *RPN,
+                        bool *changeRecorded);
 void mmuReadString(PPU_STATE *hCore, u64 stringAddress, char *string,
                    u32 maxLenght);
 
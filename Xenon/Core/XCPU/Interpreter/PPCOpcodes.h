@@ -11,6 +11,44 @@ namespace PPCInterpreter {
 // Stubs
 extern void PPCInterpreter_invalid(PPU_STATE* hCore);
 extern void PPCInterpreter_known_unimplemented(const char* name, PPU_STATE* hCore);
+// Known but unimplemented, see PPC_Instruction.cpp.
+extern void PPCInterpreter_addcx(PPU_STATE *hCore);
+extern void PPCInterpreter_addcox(PPU_STATE *hCore);
+extern void PPCInterpreter_addox(PPU_STATE *hCore);
+extern void PPCInterpreter_addeox(PPU_STATE *hCore);
+extern void PPCInterpreter_addzeox(PPU_STATE *hCore);
+extern void PPCInterpreter_addmex(PPU_STATE *hCore);
+extern void PPCInterpreter_addmeox(PPU_STATE *hCore);
+extern void PPCInterpreter_subfcox(PPU_STATE *hCore);
+extern void PPCInterpreter_subfeox(PPU_STATE *hCore);
+extern void PPCInterpreter_subfox(PPU_STATE *hCore);
+extern void PPCInterpreter_subfzeox(PPU_STATE *hCore);
+extern void PPCInterpreter_subfmex(PPU_STATE *hCore);
+extern void PPCInterpreter_subfmeox(PPU_STATE *hCore);
+extern void PPCInterpreter_divduox(PPU_STATE *hCore);
+extern void PPCInterpreter_divdox(PPU_STATE *hCore);
+extern void PPCInterpreter_divwox(PPU_STATE *hCore);
+extern void PPCInterpreter_divwuox(PPU_STATE *hCore);
+extern void PPCInterpreter_mulhdx(PPU_STATE *hCore);
+extern void PPCInterpreter_mulldox(PPU_STATE *hCore);
+extern void PPCInterpreter_mulhwx(PPU_STATE *hCore);
+extern void PPCInterpreter_mullwox(PPU_STATE *hCore);
+extern void PPCInterpreter_negox(PPU_STATE *hCore);
+extern void PPCInterpreter_rldclx(PPU_STATE *hCore);
+extern void PPCInterpreter_eqvx(PPU_STATE *hCore);
+extern void PPCInterpreter_td(PPU_STATE *hCore);
+extern void PPCInterpreter_mfsrin(PPU_STATE *hCore);
+extern void PPCInterpreter_mfsr(PPU_STATE *hCore);
+extern void PPCInterpreter_lwaux(PPU_STATE *hCore);
+extern void PPCInterpreter_lswx(PPU_STATE *hCore);
+extern void PPCInterpreter_lhaux(PPU_STATE *hCore);
+extern void PPCInterpreter_lveb(PPU_STATE *hCore);
+extern void PPCInterpreter_stdbrx(PPU_STATE *hCore);
+extern void PPCInterpreter_stswx(PPU_STATE *hCore);
+extern void PPCInterpreter_eciwx(PPU_STATE *hCore);
+extern void PPCInterpreter_ecowx(PPU_STATE *hCore);
+extern void PPCInterpreter_slbmfev(PPU_STATE *hCore);
+extern void PPCInterpreter_slbmfee(PPU_STATE *hCore);
 
 // ALU
 extern void PPCInterpreter_addx(PPU_STATE *hCore);
@@ -124,8 +162,54 @@ extern void PPCInterpreter_icbi(PPU_STATE *hCore);
 //
 // FPU
 //
-extern void PPCInterpreter_mffsx(PPU_STATE* hCore);
-extern void PPCInterpreter_mtfsfx(PPU_STATE* hCore);
+// Arithmetic
+extern void PPCInterpreter_faddx(PPU_STATE *hCore);
+extern void PPCInterpreter_faddsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fsubx(PPU_STATE *hCore);
+extern void PPCInterpreter_fsubsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fmulx(PPU_STATE *hCore);
+extern void PPCInterpreter_fmulsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fdivx(PPU_STATE *hCore);
+extern void PPCInterpreter_fdivsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fmaddx(PPU_STATE *hCore);
+extern void PPCInterpreter_fmaddsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fmsubx(PPU_STATE *hCore);
+extern void PPCInterpreter_fmsubsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fnmaddx(PPU_STATE *hCore);
+extern void PPCInterpreter_fnmaddsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fnmsubx(PPU_STATE *hCore);
+extern void PPCInterpreter_fnmsubsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fsqrtx(PPU_STATE *hCore);
+extern void PPCInterpreter_fsqrtsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fresx(PPU_STATE *hCore);
+extern void PPCInterpreter_frsqrtex(PPU_STATE *hCore);
+extern void PPCInterpreter_fselx(PPU_STATE *hCore);
+
+// Move
+extern void PPCInterpreter_fmrx(PPU_STATE *hCore);
+extern void PPCInterpreter_fnegx(PPU_STATE *hCore);
+extern void PPCInterpreter_fabsx(PPU_STATE *hCore);
+extern void PPCInterpreter_fnabsx(PPU_STATE *hCore);
+
+// Rounding and Conversion
+extern void PPCInterpreter_frspx(PPU_STATE *hCore);
+extern void PPCInterpreter_fctiwx(PPU_STATE *hCore);
+extern void PPCInterpreter_fctiwzx(PPU_STATE *hCore);
+extern void PPCInterpreter_fctidx(PPU_STATE *hCore);
+extern void PPCInterpreter_fctidzx(PPU_STATE *hCore);
+extern void PPCInterpreter_fcfidx(PPU_STATE *hCore);
+
+// Compare
+extern void PPCInterpreter_fcmpu(PPU_STATE *hCore);
+extern void PPCInterpreter_fcmpo(PPU_STATE *hCore);
+
+// Status and Control Register
+extern void PPCInterpreter_mffsx(PPU_STATE *hCore);
+extern void PPCInterpreter_mtfsfx(PPU_STATE *hCore);
+extern void PPCInterpreter_mtfsfix(PPU_STATE *hCore);
+extern void PPCInterpreter_mtfsb0x(PPU_STATE *hCore);
+extern void PPCInterpreter_mtfsb1x(PPU_STATE *hCore);
+extern void PPCInterpreter_mcrfsx(PPU_STATE *hCore);
 
 //
 // Load/Store
@@ -167,6 +251,14 @@ extern void PPCInterpreter_stdx(PPU_STATE *hCore);
 
 // Store Floating
 extern void PPCInterpreter_stfd(PPU_STATE *hCore);
+extern void PPCInterpreter_stfdu(PPU_STATE *hCore);
+extern void PPCInterpreter_stfdux(PPU_STATE *hCore);
+extern void PPCInterpreter_stfdx(PPU_STATE *hCore);
+extern void PPCInterpreter_stfiwx(PPU_STATE *hCore);
+extern void PPCInterpreter_stfs(PPU_STATE *hCore);
+extern void PPCInterpreter_stfsu(PPU_STATE *hCore);
+extern void PPCInterpreter_stfsux(PPU_STATE *hCore);
+extern void PPCInterpreter_stfsx(PPU_STATE *hCore);
 
 // Load Byte
 extern void PPCInterpreter_lbz(PPU_STATE *hCore);
@@ -213,6 +305,291 @@ extern void PPCInterpreter_ldx(PPU_STATE *hCore);
 //
 
 extern void PPCInterpreter_lfd(PPU_STATE *hCore);
+extern void PPCInterpreter_lfdu(PPU_STATE *hCore);
+extern void PPCInterpreter_lfdux(PPU_STATE *hCore);
+extern void PPCInterpreter_lfdx(PPU_STATE *hCore);
 extern void PPCInterpreter_lfs(PPU_STATE *hCore);
+extern void PPCInterpreter_lfsu(PPU_STATE *hCore);
+extern void PPCInterpreter_lfsux(PPU_STATE *hCore);
+extern void PPCInterpreter_lfsx(PPU_STATE *hCore);
+
+//
+// VMX
+//
+
+// Vector Integer Arithmetic
+extern void PPCInterpreter_vaddubm(PPU_STATE *hCore);
+extern void PPCInterpreter_vadduhm(PPU_STATE *hCore);
+extern void PPCInterpreter_vadduwm(PPU_STATE *hCore);
+extern void PPCInterpreter_vsububm(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubuhm(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubuwm(PPU_STATE *hCore);
+extern void PPCInterpreter_vaddcuw(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubcuw(PPU_STATE *hCore);
+extern void PPCInterpreter_vaddubs(PPU_STATE *hCore);
+extern void PPCInterpreter_vadduhs(PPU_STATE *hCore);
+extern void PPCInterpreter_vadduws(PPU_STATE *hCore);
+extern void PPCInterpreter_vaddsbs(PPU_STATE *hCore);
+extern void PPCInterpreter_vaddshs(PPU_STATE *hCore);
+extern void PPCInterpreter_vaddsws(PPU_STATE *hCore);
+extern void PPCInterpreter_vsububs(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubuhs(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubuws(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubsbs(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubshs(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubsws(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxub(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxuh(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxuw(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxsb(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxsh(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxsw(PPU_STATE *hCore);
+extern void PPCInterpreter_vminub(PPU_STATE *hCore);
+extern void PPCInterpreter_vminuh(PPU_STATE *hCore);
+extern void PPCInterpreter_vminuw(PPU_STATE *hCore);
+extern void PPCInterpreter_vminsb(PPU_STATE *hCore);
+extern void PPCInterpreter_vminsh(PPU_STATE *hCore);
+extern void PPCInterpreter_vminsw(PPU_STATE *hCore);
+extern void PPCInterpreter_vavgub(PPU_STATE *hCore);
+extern void PPCInterpreter_vavguh(PPU_STATE *hCore);
+extern void PPCInterpreter_vavguw(PPU_STATE *hCore);
+extern void PPCInterpreter_vavgsb(PPU_STATE *hCore);
+extern void PPCInterpreter_vavgsh(PPU_STATE *hCore);
+extern void PPCInterpreter_vavgsw(PPU_STATE *hCore);
+extern void PPCInterpreter_vmuleub(PPU_STATE *hCore);
+extern void PPCInterpreter_vmuloub(PPU_STATE *hCore);
+extern void PPCInterpreter_vmulesb(PPU_STATE *hCore);
+extern void PPCInterpreter_vmulosb(PPU_STATE *hCore);
+extern void PPCInterpreter_vmuleuh(PPU_STATE *hCore);
+extern void PPCInterpreter_vmulouh(PPU_STATE *hCore);
+extern void PPCInterpreter_vmulesh(PPU_STATE *hCore);
+extern void PPCInterpreter_vmulosh(PPU_STATE *hCore);
+extern void PPCInterpreter_vsum4ubs(PPU_STATE *hCore);
+extern void PPCInterpreter_vsum4sbs(PPU_STATE *hCore);
+extern void PPCInterpreter_vsum4shs(PPU_STATE *hCore);
+extern void PPCInterpreter_vsum2sws(PPU_STATE *hCore);
+extern void PPCInterpreter_vsumsws(PPU_STATE *hCore);
+extern void PPCInterpreter_vmhaddshs(PPU_STATE *hCore);
+extern void PPCInterpreter_vmhraddshs(PPU_STATE *hCore);
+extern void PPCInterpreter_vmladduhm(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsumubm(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsummbm(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsumuhm(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsumuhs(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsumshm(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsumshs(PPU_STATE *hCore);
+
+// Vector Logical
+extern void PPCInterpreter_vand(PPU_STATE *hCore);
+extern void PPCInterpreter_vandc(PPU_STATE *hCore);
+extern void PPCInterpreter_vor(PPU_STATE *hCore);
+extern void PPCInterpreter_vnor(PPU_STATE *hCore);
+extern void PPCInterpreter_vxor(PPU_STATE *hCore);
+extern void PPCInterpreter_vand128(PPU_STATE *hCore);
+extern void PPCInterpreter_vandc128(PPU_STATE *hCore);
+extern void PPCInterpreter_vor128(PPU_STATE *hCore);
+extern void PPCInterpreter_vnor128(PPU_STATE *hCore);
+extern void PPCInterpreter_vxor128(PPU_STATE *hCore);
+extern void PPCInterpreter_vsel(PPU_STATE *hCore);
+extern void PPCInterpreter_vsel128(PPU_STATE *hCore);
+
+// Vector Shift and Rotate
+extern void PPCInterpreter_vslb(PPU_STATE *hCore);
+extern void PPCInterpreter_vslh(PPU_STATE *hCore);
+extern void PPCInterpreter_vslw(PPU_STATE *hCore);
+extern void PPCInterpreter_vsrb(PPU_STATE *hCore);
+extern void PPCInterpreter_vsrh(PPU_STATE *hCore);
+extern void PPCInterpreter_vsrw(PPU_STATE *hCore);
+extern void PPCInterpreter_vsrab(PPU_STATE *hCore);
+extern void PPCInterpreter_vsrah(PPU_STATE *hCore);
+extern void PPCInterpreter_vsraw(PPU_STATE *hCore);
+extern void PPCInterpreter_vrlb(PPU_STATE *hCore);
+extern void PPCInterpreter_vrlh(PPU_STATE *hCore);
+extern void PPCInterpreter_vrlw(PPU_STATE *hCore);
+extern void PPCInterpreter_vsl(PPU_STATE *hCore);
+extern void PPCInterpreter_vsr(PPU_STATE *hCore);
+extern void PPCInterpreter_vslo(PPU_STATE *hCore);
+extern void PPCInterpreter_vsro(PPU_STATE *hCore);
+extern void PPCInterpreter_vslw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vsrw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vsraw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrlw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vslo128(PPU_STATE *hCore);
+extern void PPCInterpreter_vsro128(PPU_STATE *hCore);
+
+// Vector Compare
+extern void PPCInterpreter_vcmpequb(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpequb_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpequh(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpequh_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpequw(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpequw_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtsb(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtsb_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtsh(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtsh_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtsw(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtsw_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtub(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtub_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtuh(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtuh_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtuw(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtuw_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpeqfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpeqfp_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgefp(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgefp_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtfp_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpbfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpbfp_(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpequw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpeqfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgefp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpgtfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcmpbfp128(PPU_STATE *hCore);
+
+// Vector Floating Point
+extern void PPCInterpreter_vaddfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vminfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vrefp(PPU_STATE *hCore);
+extern void PPCInterpreter_vrsqrtefp(PPU_STATE *hCore);
+extern void PPCInterpreter_vexptefp(PPU_STATE *hCore);
+extern void PPCInterpreter_vlogefp(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfin(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfiz(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfip(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfim(PPU_STATE *hCore);
+extern void PPCInterpreter_vaddfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vsubfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vmulfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaxfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vminfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrefp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrsqrtefp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vexptefp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vlogefp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfin128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfiz128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfip128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrfim128(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaddfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vnmsubfp(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaddfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vmaddcfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vnmsubfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsum3fp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vmsum4fp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcfux(PPU_STATE *hCore);
+extern void PPCInterpreter_vcfsx(PPU_STATE *hCore);
+extern void PPCInterpreter_vctuxs(PPU_STATE *hCore);
+extern void PPCInterpreter_vctsxs(PPU_STATE *hCore);
+extern void PPCInterpreter_vcuxwfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcsxwfp128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcfpuxws128(PPU_STATE *hCore);
+extern void PPCInterpreter_vcfpsxws128(PPU_STATE *hCore);
+
+// Vector Merge, Pack and Unpack
+extern void PPCInterpreter_vmrghb(PPU_STATE *hCore);
+extern void PPCInterpreter_vmrghh(PPU_STATE *hCore);
+extern void PPCInterpreter_vmrghw(PPU_STATE *hCore);
+extern void PPCInterpreter_vmrglb(PPU_STATE *hCore);
+extern void PPCInterpreter_vmrglh(PPU_STATE *hCore);
+extern void PPCInterpreter_vmrglw(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuhum(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuwum(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuhus(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuwus(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkshus(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkswus(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkshss(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkswss(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkpx(PPU_STATE *hCore);
+extern void PPCInterpreter_vupkhsb(PPU_STATE *hCore);
+extern void PPCInterpreter_vupklsb(PPU_STATE *hCore);
+extern void PPCInterpreter_vupkhsh(PPU_STATE *hCore);
+extern void PPCInterpreter_vupklsh(PPU_STATE *hCore);
+extern void PPCInterpreter_vupkhpx(PPU_STATE *hCore);
+extern void PPCInterpreter_vupklpx(PPU_STATE *hCore);
+extern void PPCInterpreter_vmrghw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vmrglw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuhum128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuwum128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuhus128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkuwus128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkshus128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkswus128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkshss128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkswss128(PPU_STATE *hCore);
+extern void PPCInterpreter_vupkhsb128(PPU_STATE *hCore);
+extern void PPCInterpreter_vupklsb128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpkd3d128(PPU_STATE *hCore);
+extern void PPCInterpreter_vupkd3d128(PPU_STATE *hCore);
+
+// Vector Permute and Splat
+extern void PPCInterpreter_vperm(PPU_STATE *hCore);
+extern void PPCInterpreter_vperm128(PPU_STATE *hCore);
+extern void PPCInterpreter_vsldoi(PPU_STATE *hCore);
+extern void PPCInterpreter_vsldoi128(PPU_STATE *hCore);
+extern void PPCInterpreter_vpermwi128(PPU_STATE *hCore);
+extern void PPCInterpreter_vrlimi128(PPU_STATE *hCore);
+extern void PPCInterpreter_vspltb(PPU_STATE *hCore);
+extern void PPCInterpreter_vsplth(PPU_STATE *hCore);
+extern void PPCInterpreter_vspltw(PPU_STATE *hCore);
+extern void PPCInterpreter_vspltw128(PPU_STATE *hCore);
+extern void PPCInterpreter_vspltisb(PPU_STATE *hCore);
+extern void PPCInterpreter_vspltish(PPU_STATE *hCore);
+extern void PPCInterpreter_vspltisw(PPU_STATE *hCore);
+extern void PPCInterpreter_vspltisw128(PPU_STATE *hCore);
+
+// Vector Load/Store
+extern void PPCInterpreter_lvx(PPU_STATE *hCore);
+extern void PPCInterpreter_lvxl(PPU_STATE *hCore);
+extern void PPCInterpreter_stvx(PPU_STATE *hCore);
+extern void PPCInterpreter_stvxl(PPU_STATE *hCore);
+extern void PPCInterpreter_lvlx(PPU_STATE *hCore);
+extern void PPCInterpreter_lvlxl(PPU_STATE *hCore);
+extern void PPCInterpreter_lvrx(PPU_STATE *hCore);
+extern void PPCInterpreter_lvrxl(PPU_STATE *hCore);
+extern void PPCInterpreter_stvlx(PPU_STATE *hCore);
+extern void PPCInterpreter_stvlxl(PPU_STATE *hCore);
+extern void PPCInterpreter_stvrx(PPU_STATE *hCore);
+extern void PPCInterpreter_stvrxl(PPU_STATE *hCore);
+extern void PPCInterpreter_lvebx(PPU_STATE *hCore);
+extern void PPCInterpreter_lvehx(PPU_STATE *hCore);
+extern void PPCInterpreter_lvewx(PPU_STATE *hCore);
+extern void PPCInterpreter_stvebx(PPU_STATE *hCore);
+extern void PPCInterpreter_stvehx(PPU_STATE *hCore);
+extern void PPCInterpreter_stvewx(PPU_STATE *hCore);
+extern void PPCInterpreter_lvsl(PPU_STATE *hCore);
+extern void PPCInterpreter_lvsr(PPU_STATE *hCore);
+extern void PPCInterpreter_lvx128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvxl128(PPU_STATE *hCore);
+extern void PPCInterpreter_stvx128(PPU_STATE *hCore);
+extern void PPCInterpreter_stvxl128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvlx128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvlxl128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvrx128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvrxl128(PPU_STATE *hCore);
+extern void PPCInterpreter_stvlx128(PPU_STATE *hCore);
+extern void PPCInterpreter_stvlxl128(PPU_STATE *hCore);
+extern void PPCInterpreter_stvrx128(PPU_STATE *hCore);
+extern void PPCInterpreter_stvrxl128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvewx128(PPU_STATE *hCore);
+extern void PPCInterpreter_stvewx128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvsl128(PPU_STATE *hCore);
+extern void PPCInterpreter_lvsr128(PPU_STATE *hCore);
+
+// Vector Status and Control
+extern void PPCInterpreter_mfvscr(PPU_STATE *hCore);
+extern void PPCInterpreter_mtvscr(PPU_STATE *hCore);
+
+// Vector Data Stream
+extern void PPCInterpreter_dst(PPU_STATE *hCore);
+extern void PPCInterpreter_dstst(PPU_STATE *hCore);
+extern void PPCInterpreter_dss(PPU_STATE *hCore);
 
 }
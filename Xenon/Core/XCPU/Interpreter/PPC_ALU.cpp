@@ -3,10 +3,10 @@
 #include "Base/Logging/Log.h"
 #include "PPCInterpreter.h"
 
-#define GPR(x)        hCore->ppuThread[hCore->currentThread].GPR[x]
-#define XER_SET_CA(v) hCore->ppuThread[hCore->currentThread].SPR.XER.CA = v
-#define XER_GET_CA    hCore->ppuThread[hCore->currentThread].SPR.XER.CA
-#define _instr        hCore->ppuThread[hCore->currentThread].CI
+#define GPR(x)        hCore->curThread->GPR[x]
+#define XER_SET_CA(v) hCore->curThread->XER.CA = v
+#define XER_GET_CA    hCore->curThread->XER.CA
+#define _instr        hCore->curThread->CI
 
 //
 // Helper functions.
@@ -80,8 +80,7 @@ void PPCInterpreter::PPCInterpreter_addx(PPU_STATE *hCore) {
   GPR(_instr.rd) = RA + RB;
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -94,8 +93,7 @@ void PPCInterpreter::PPCInterpreter_addex(PPU_STATE *hCore) {
   XER_SET_CA(add.carry);
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, add.result, 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, add.result);
   }
 }
 
@@ -112,9 +110,8 @@ void PPCInterpreter::PPCInterpreter_addic(PPU_STATE *hCore) {
   XER_SET_CA(add.carry);
 
   // _rc
-  if (hCore->ppuThread[hCore->currentThread].CI.main & 1) {
-    u32 CR = CRCompS(hCore, add.result, 0);
-    ppcUpdateCR(hCore, 0, CR);
+  if (hCore->curThread->CI.main & 1) {
+    ppcRecordCR0(hCore, add.result);
   }
 }
 
@@ -130,8 +127,7 @@ void PPCInterpreter::PPCInterpreter_addzex(PPU_STATE *hCore) {
   XER_SET_CA(add.carry);
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, add.result, 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, add.result);
   }
 }
 
@@ -139,8 +135,7 @@ void PPCInterpreter::PPCInterpreter_andx(PPU_STATE *hCore) {
   GPR(_instr.ra) = GPR(_instr.rs) & GPR(_instr.rb);
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -148,23 +143,20 @@ void PPCInterpreter::PPCInterpreter_andcx(PPU_STATE *hCore) {
   GPR(_instr.ra) = GPR(_instr.rs) & ~GPR(_instr.rb);
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
 void PPCInterpreter::PPCInterpreter_andi(PPU_STATE *hCore) {
   GPR(_instr.ra) = GPR(_instr.rs) & _instr.uimm16;
 
-  u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-  ppcUpdateCR(hCore, 0, CR);
+  ppcRecordCR0(hCore, GPR(_instr.ra));
 }
 
 void PPCInterpreter::PPCInterpreter_andis(PPU_STATE *hCore) {
   GPR(_instr.ra) = GPR(_instr.rs) & (u64{ _instr.uimm16 } << 16);
 
-  u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-  ppcUpdateCR(hCore, 0, CR);
+  ppcRecordCR0(hCore, GPR(_instr.ra));
 }
 
 void PPCInterpreter::PPCInterpreter_cmp(PPU_STATE *hCore) {
@@ -228,8 +220,7 @@ void PPCInterpreter::PPCInterpreter_cntlzdx(PPU_STATE *hCore) {
   GPR(_instr.ra) = std::countl_zero(GPR(_instr.rs));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -237,8 +228,7 @@ void PPCInterpreter::PPCInterpreter_cntlzwx(PPU_STATE *hCore) {
   GPR(_instr.ra) = std::countl_zero(static_cast<u32>(GPR(_instr.rs)));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -250,10 +240,7 @@ void PPCInterpreter::PPCInterpreter_crand(PPU_STATE *hCore) {
 
   const u32 crAnd = a & b;
 
-  if (crAnd & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crAnd & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_crandc(PPU_STATE *hCore) {
@@ -264,10 +251,7 @@ void PPCInterpreter::PPCInterpreter_crandc(PPU_STATE *hCore) {
 
   const u32 crAndc = a & (1 ^ b);
 
-  if (crAndc & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crAndc & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_creqv(PPU_STATE *hCore) {
@@ -278,10 +262,7 @@ void PPCInterpreter::PPCInterpreter_creqv(PPU_STATE *hCore) {
 
   const u32 crEqv = 1 ^ (a ^ b);
 
-  if (crEqv & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crEqv & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_crnand(PPU_STATE *hCore) {
@@ -292,10 +273,7 @@ void PPCInterpreter::PPCInterpreter_crnand(PPU_STATE *hCore) {
 
   const u32 crNand = 1 ^ (a & b);
 
-  if (crNand & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crNand & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_crnor(PPU_STATE *hCore) {
@@ -306,10 +284,7 @@ void PPCInterpreter::PPCInterpreter_crnor(PPU_STATE *hCore) {
 
   const u32 crNor = 1 ^ (a | b);
 
-  if (crNor & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crNor & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_cror(PPU_STATE *hCore) {
@@ -319,10 +294,7 @@ void PPCInterpreter::PPCInterpreter_cror(PPU_STATE *hCore) {
 
   const u32 crOr = a | b;
 
-  if (crOr & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crOr & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_crorc(PPU_STATE *hCore) {
@@ -333,10 +305,7 @@ void PPCInterpreter::PPCInterpreter_crorc(PPU_STATE *hCore) {
 
   const u32 crOrc = a | (1 ^ b);
 
-  if (crOrc & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crOrc & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_crxor(PPU_STATE *hCore) {
@@ -347,10 +316,7 @@ void PPCInterpreter::PPCInterpreter_crxor(PPU_STATE *hCore) {
 
   const u32 crXor = a ^ b;
 
-  if (crXor & 1)
-    BSET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
-  else
-    BCLR(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, 32, BT);
+  ppcSetCRBit(hCore, BT, crXor & 1);
 }
 
 void PPCInterpreter::PPCInterpreter_divdx(PPU_STATE *hCore) {
@@ -360,8 +326,7 @@ void PPCInterpreter::PPCInterpreter_divdx(PPU_STATE *hCore) {
   GPR(_instr.rd) = o ? 0 : RA / RB;
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -371,8 +336,7 @@ void PPCInterpreter::PPCInterpreter_divdux(PPU_STATE *hCore) {
   GPR(_instr.rd) = RB == 0 ? 0 : RA / RB;
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -383,8 +347,7 @@ void PPCInterpreter::PPCInterpreter_divwx(PPU_STATE *hCore) {
   GPR(_instr.rd) = o ? 0 : static_cast<u32>(RA / RB);
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -394,8 +357,7 @@ void PPCInterpreter::PPCInterpreter_divwux(PPU_STATE *hCore) {
   GPR(_instr.rd) = RB == 0 ? 0 : RA / RB;
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -403,8 +365,7 @@ void PPCInterpreter::PPCInterpreter_extsbx(PPU_STATE *hCore) {
   GPR(_instr.ra) = static_cast<s8>(GPR(_instr.rs));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -412,8 +373,7 @@ void PPCInterpreter::PPCInterpreter_extshx(PPU_STATE *hCore) {
   GPR(_instr.ra) = static_cast<s16>(GPR(_instr.rs));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -421,29 +381,28 @@ void PPCInterpreter::PPCInterpreter_extswx(PPU_STATE *hCore) {
   GPR(_instr.ra) = static_cast<s32>(GPR(_instr.rs));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
 void PPCInterpreter::PPCInterpreter_mcrf(PPU_STATE *hCore) {
   XL_FORM_BF_BFA;
 
-  u32 CR = DGET(hCore->ppuThread[hCore->currentThread].CR.CR_Hex, (BFA) * 4,
-                (BFA) * 4 + 3);
-
-  ppcUpdateCR(hCore, BF, CR);
+  ppcUpdateCR(hCore, BF, ppcGetCR(hCore, BFA));
 }
 
 void PPCInterpreter::PPCInterpreter_mfocrf(PPU_STATE *hCore) {
   XFX_FORM_rD;
 
-  GPR(rD) = hCore->ppuThread[hCore->currentThread].CR.CR_Hex;
+  GPR(rD) = ppcGetCRHex(hCore);
 }
 
 void PPCInterpreter::PPCInterpreter_mftb(PPU_STATE *hCore) {
   XFX_FORM_rD_spr; // because 5-bit fields are swapped
 
+  auto coreLock = ppcLockCore(hCore);
+  ppcUpdateTimeBase(hCore);
+
   switch (spr) {
   case 268:
     GPR(rD) = hCore->SPR.TB;
@@ -470,9 +429,7 @@ void PPCInterpreter::PPCInterpreter_mtocrf(PPU_STATE *hCore) {
       Mask |= 0xF;
     }
   }  
-  hCore->ppuThread[hCore->currentThread].CR.CR_Hex =
-      ((u32)GPR(rS) & Mask) |
-      (hCore->ppuThread[hCore->currentThread].CR.CR_Hex & ~Mask);
+  ppcSetCRHex(hCore, static_cast<u32>(GPR(rS)), Mask);
 }
 
 void PPCInterpreter::PPCInterpreter_mulli(PPU_STATE *hCore) {
@@ -485,8 +442,7 @@ void PPCInterpreter::PPCInterpreter_mulldx(PPU_STATE *hCore) {
   GPR(_instr.rd) = RA * RB;
 
   if (_instr.rc) {
-      u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-      ppcUpdateCR(hCore, 0, CR);
+      ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -494,8 +450,7 @@ void PPCInterpreter::PPCInterpreter_mullwx(PPU_STATE *hCore) {
   GPR(_instr.rd) = s64{ static_cast<s32>(GPR(_instr.ra)) } *static_cast<s32>(GPR(_instr.rb));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -505,8 +460,7 @@ void PPCInterpreter::PPCInterpreter_mulhwux(PPU_STATE *hCore) {
   GPR(_instr.rd) = (u64{ a } *b) >> 32;
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -514,8 +468,7 @@ void PPCInterpreter::PPCInterpreter_mulhdux(PPU_STATE *hCore) {
   GPR(_instr.rd) = umulh64(GPR(_instr.ra), GPR(_instr.rb));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -523,8 +476,7 @@ void PPCInterpreter::PPCInterpreter_nandx(PPU_STATE *hCore) {
   GPR(_instr.ra) = ~(GPR(_instr.rs) & GPR(_instr.rb));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -533,8 +485,7 @@ void PPCInterpreter::PPCInterpreter_negx(PPU_STATE *hCore) {
   GPR(_instr.rd) = 0 - RA;
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -542,8 +493,7 @@ void PPCInterpreter::PPCInterpreter_norx(PPU_STATE *hCore) {
   GPR(_instr.ra) = ~(GPR(_instr.rs) | GPR(_instr.rb));
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -552,8 +502,7 @@ void PPCInterpreter::PPCInterpreter_orcx(PPU_STATE* hCore)
   GPR(_instr.ra) = GPR(_instr.rs) | ~GPR(_instr.rb);
 
   if (_instr.rc) {
-        u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-        ppcUpdateCR(hCore, 0, CR);
+        ppcRecordCR0(hCore, GPR(_instr.ra));
     }
 }
 
@@ -569,8 +518,7 @@ void PPCInterpreter::PPCInterpreter_orx(PPU_STATE *hCore) {
   GPR(_instr.ra) = GPR(_instr.rs) | GPR(_instr.rb);
 
   if (_instr.rc) {
-    u32 CR = CRCompU(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -584,8 +532,7 @@ void PPCInterpreter::PPCInterpreter_rldicx(PPU_STATE *hCore) {
   GPR(rA) = r & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -600,8 +547,7 @@ void PPCInterpreter::PPCInterpreter_rldcrx(PPU_STATE *hCore) {
   GPR(rA) = r & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -614,8 +560,7 @@ void PPCInterpreter::PPCInterpreter_rldiclx(PPU_STATE *hCore) {
   GPR(rA) = r & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -627,8 +572,7 @@ void PPCInterpreter::PPCInterpreter_rldicrx(PPU_STATE *hCore) {
   GPR(rA) = r & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -642,8 +586,7 @@ void PPCInterpreter::PPCInterpreter_rldimix(PPU_STATE *hCore) {
   GPR(rA) = (r & m) | (GPR(rA) & ~m);
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -656,8 +599,7 @@ void PPCInterpreter::PPCInterpreter_rlwimix(PPU_STATE *hCore) {
   GPR(rA) = (r & m) | ((u32)GPR(rA) & ~m);
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -669,8 +611,7 @@ void PPCInterpreter::PPCInterpreter_rlwnmx(PPU_STATE *hCore) {
   GPR(rA) = std::rotl<u32>((u32)GPR(rS), ((u32)GPR(rB)) & 31) & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -682,8 +623,7 @@ void PPCInterpreter::PPCInterpreter_rlwinmx(PPU_STATE *hCore) {
   GPR(rA) = std::rotl<u32>((u32)GPR(rS), SH) & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -698,8 +638,7 @@ void PPCInterpreter::PPCInterpreter_sldx(PPU_STATE *hCore) {
   GPR(rA) = r & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -711,8 +650,7 @@ void PPCInterpreter::PPCInterpreter_slwx(PPU_STATE *hCore) {
   GPR(rA) = (n < 32) ? ((u32)(GPR(rS)) << n) : 0;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -728,13 +666,12 @@ void PPCInterpreter::PPCInterpreter_sradx(PPU_STATE *hCore) {
   GPR(rA) = (r & m) | (s & ~m);
 
   if (s && ((r & ~m) != 0))
-    hCore->ppuThread[hCore->currentThread].SPR.XER.CA = 1;
+    hCore->curThread->XER.CA = 1;
   else
-    hCore->ppuThread[hCore->currentThread].SPR.XER.CA = 0;
+    hCore->curThread->XER.CA = 0;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -745,7 +682,7 @@ void PPCInterpreter::PPCInterpreter_sradix(PPU_STATE *hCore) {
 
   if (SH == 0) {
     GPR(rA) = GPR(rS);
-    hCore->ppuThread[hCore->currentThread].SPR.XER.CA = 0;
+    hCore->curThread->XER.CA = 0;
   } else {
     u64 r = std::rotl<u64>(GPR(rS), 64 - SH);
     u64 m = QMASK(SH, 63);
@@ -754,14 +691,13 @@ void PPCInterpreter::PPCInterpreter_sradix(PPU_STATE *hCore) {
     GPR(rA) = (r & m) | (((u64)(-(long long)s)) & ~m);
 
     if (s && (r & ~m) != 0)
-      hCore->ppuThread[hCore->currentThread].SPR.XER.CA = 1;
+      hCore->curThread->XER.CA = 1;
     else
-      hCore->ppuThread[hCore->currentThread].SPR.XER.CA = 0;
+      hCore->curThread->XER.CA = 0;
   }
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -781,8 +717,7 @@ void PPCInterpreter::PPCInterpreter_srawx(PPU_STATE *hCore) {
     XER_SET_CA(0);
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -802,8 +737,7 @@ void PPCInterpreter::PPCInterpreter_srawix(PPU_STATE *hCore) {
     XER_SET_CA(0);
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -818,8 +752,7 @@ void PPCInterpreter::PPCInterpreter_srdx(PPU_STATE *hCore) {
   GPR(rA) = r & m;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -831,8 +764,7 @@ void PPCInterpreter::PPCInterpreter_srwx(PPU_STATE *hCore) {
   GPR(rA) = (n < 32) ? (GPR(rS) >> n) : 0;
 
   if (RC) {
-    u32 CR = CRCompS(hCore, GPR(rA), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(rA));
   }
 }
 
@@ -845,8 +777,7 @@ void PPCInterpreter::PPCInterpreter_subfcx(PPU_STATE *hCore) {
   XER_SET_CA(add.carry);
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -857,8 +788,7 @@ void PPCInterpreter::PPCInterpreter_subfx(PPU_STATE *hCore) {
   GPR(_instr.rd) = RB - RA;
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.rd), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.rd));
   }
 }
 
@@ -871,8 +801,7 @@ void PPCInterpreter::PPCInterpreter_subfex(PPU_STATE *hCore) {
   XER_SET_CA(add.carry);
 
   if (_instr.ra) {
-    u32 CR = CRCompS(hCore, add.result, 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, add.result);
   }
 }
 
@@ -884,8 +813,7 @@ void PPCInterpreter::PPCInterpreter_subfzex(PPU_STATE* hCore) {
   XER_SET_CA(add.carry);
 
   if (_instr.ra) {
-    u32 CR = CRCompS(hCore, add.result, 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, add.result);
   }
 }
 
@@ -902,8 +830,7 @@ void PPCInterpreter::PPCInterpreter_xorx(PPU_STATE* hCore) {
   GPR(_instr.ra) = GPR(_instr.rs) ^ GPR(_instr.rb);
 
   if (_instr.rc) {
-    u32 CR = CRCompS(hCore, GPR(_instr.ra), 0);
-    ppcUpdateCR(hCore, 0, CR);
+    ppcRecordCR0(hCore, GPR(_instr.ra));
   }
 }
 
@@ -0,0 +1,587 @@
+#pragma once
+/*
+* Copyright 2025 Xenon Emulator Project
+
+* All original authors of the rpcs3 PPU_Decoder and PPU_Opcodes maintain their original copyright.
+* Modifed for usage in the Xenon Emulator
+* All rights reserved
+* License: GPL2
+*/
+
+#include "PPCOpcodes.h"
+#include "PPC_Instruction.h"
+
+namespace PPCInterpreter {
+  // Adds every instruction to a decode table through its fillTable and fillTableVMX128,
+  // later entries override earlier ones. PPCDecoder is built from these lists, and so is
+  // the flat table the decoder tests check it against.
+  template <typename DecodeTable>
+  constexpr void ppcFillDecodeTable(DecodeTable &table) {
+  	#define GET_(name) &PPCInterpreter_##name
+  	#define GET(name) GET_(name)
+    #define GETRC(name) GET_(name##x)
+  	// Main opcodes (field 0..5)
+  	table.fillTable(0x00, 6, -1, {
+      { 0x02, GET(tdi) },
+      { 0x03, GET(twi) },
+      { 0x07, GET(mulli) },
+      { 0x08, GET(subfic) },
+      { 0x0A, GET(cmpli) },
+      { 0x0B, GET(cmpi) },
+      { 0x0C, GET(addic) },
+      { 0x0D, GET(addic) },
+      { 0x0E, GET(addi) },
+      { 0x0F, GET(addis) },
+      { 0x10, GET(bc) },
+      { 0x11, GET(sc) },
+      { 0x12, GET(b) },
+      { 0x14, GETRC(rlwimi) },
+      { 0x15, GETRC(rlwinm) },
+      { 0x17, GETRC(rlwnm) },
+      { 0x18, GET(ori) },
+      { 0x19, GET(oris) },
+      { 0x1A, GET(xori) },
+      { 0x1B, GET(xoris) },
+      { 0x1C, GET(andi) },
+      { 0x1D, GET(andis) },
+      { 0x20, GET(lwz) },
+      { 0x21, GET(lwzu) },
+      { 0x22, GET(lbz) },
+      { 0x23, GET(lbzu) },
+      { 0x24, GET(stw) },
+      { 0x25, GET(stwu) },
+      { 0x26, GET(stb) },
+      { 0x27, GET(stbu) },
+      { 0x28, GET(lhz) },
+      { 0x29, GET(lhzu) },
+      { 0x2A, GET(lha) },
+      { 0x2B, GET(lhau) },
+      { 0x2C, GET(sth) },
+      { 0x2D, GET(sthu) },
+      { 0x2E, GET(lmw) },
+      { 0x2F, GET(stmw) },
+      { 0x30, GET(lfs) },
+      { 0x31, GET(lfsu) },
+      { 0x32, GET(lfd) },
+      { 0x33, GET(lfdu) },
+      { 0x34, GET(stfs) },
+      { 0x35, GET(stfsu) },
+      { 0x36, GET(stfd) },
+      { 0x37, GET(stfdu) },
+  	});
+  	// Group 0x04 opcodes (field 21..31)
+  	table.fillTable(0x04, 11, 0, {
+      { 0x0, GET(vaddubm) },
+      { 0x2, GET(vmaxub) },
+      { 0x4, GET(vrlb) },
+      { 0x006, GET(vcmpequb) },
+      { 0x406, GET(vcmpequb_) },
+      { 0x8, GET(vmuloub) },
+      { 0xA, GET(vaddfp) },
+      { 0xC, GET(vmrghb) },
+      { 0xE, GET(vpkuhum) },
+
+      { 0x20, GET(vmhaddshs), 5 },
+      { 0x21, GET(vmhraddshs), 5 },
+      { 0x22, GET(vmladduhm), 5 },
+      { 0x24, GET(vmsumubm), 5 },
+      { 0x25, GET(vmsummbm), 5 },
+      { 0x26, GET(vmsumuhm), 5 },
+      { 0x27, GET(vmsumuhs), 5 },
+      { 0x28, GET(vmsumshm), 5 },
+      { 0x29, GET(vmsumshs), 5 },
+      { 0x2A, GET(vsel), 5 },
+      { 0x2B, GET(vperm), 5 },
+      { 0x2C, GET(vsldoi), 5 },
+      { 0x2E, GET(vmaddfp), 5 },
+      { 0x2F, GET(vnmsubfp), 5 },
+
+      { 0x40, GET(vadduhm) },
+      { 0x42, GET(vmaxuh) },
+      { 0x44, GET(vrlh) },
+      { 0x046, GET(vcmpequh) },
+      { 0x446, GET(vcmpequh_) },
+      { 0x48, GET(vmulouh) },
+      { 0x4A, GET(vsubfp) },
+      { 0x4C, GET(vmrghh) },
+      { 0x4E, GET(vpkuwum) },
+      { 0x80, GET(vadduwm) },
+      { 0x82, GET(vmaxuw) },
+      { 0x84, GET(vrlw) },
+      { 0x086, GET(vcmpequw) },
+      { 0x486, GET(vcmpequw_) },
+      { 0x8C, GET(vmrghw) },
+      { 0x8E, GET(vpkuhus) },
+      { 0x0C6, GET(vcmpeqfp) },
+      { 0x4C6, GET(vcmpeqfp_) },
+      { 0xCE, GET(vpkuwus) },
+
+      { 0x102, GET(vmaxsb) },
+      { 0x104, GET(vslb) },
+      { 0x108, GET(vmulosb) },
+      { 0x10A, GET(vrefp) },
+      { 0x10C, GET(vmrglb) },
+      { 0x10E, GET(vpkshus) },
+      { 0x142, GET(vmaxsh) },
+      { 0x144, GET(vslh) },
+      { 0x148, GET(vmulosh) },
+      { 0x14A, GET(vrsqrtefp) },
+      { 0x14C, GET(vmrglh) },
+      { 0x14E, GET(vpkswus) },
+      { 0x180, GET(vaddcuw) },
+      { 0x182, GET(vmaxsw) },
+      { 0x184, GET(vslw) },
+      { 0x18A, GET(vexptefp) },
+      { 0x18C, GET(vmrglw) },
+      { 0x18E, GET(vpkshss) },
+      { 0x1C4, GET(vsl) },
+      { 0x1C6, GET(vcmpgefp) },
+      { 0x5C6, GET(vcmpgefp_) },
+      { 0x1CA, GET(vlogefp) },
+      { 0x1CE, GET(vpkswss) },
+      { 0x200, GET(vaddubs) },
+      { 0x202, GET(vminub) },
+      { 0x204, GET(vsrb) },
+      { 0x206, GET(vcmpgtub) },
+      { 0x606, GET(vcmpgtub_) },
+      { 0x208, GET(vmuleub) },
+      { 0x20A, GET(vrfin) },
+      { 0x20C, GET(vspltb) },
+      { 0x20E, GET(vupkhsb) },
+      { 0x240, GET(vadduhs) },
+      { 0x242, GET(vminuh) },
+      { 0x244, GET(vsrh) },
+      { 0x246, GET(vcmpgtuh) },
+      { 0x646, GET(vcmpgtuh_) },
+      { 0x248, GET(vmuleuh) },
+      { 0x24A, GET(vrfiz) },
+      { 0x24C, GET(vsplth) },
+      { 0x24E, GET(vupkhsh) },
+      { 0x280, GET(vadduws) },
+      { 0x282, GET(vminuw) },
+      { 0x284, GET(vsrw) },
+      { 0x286, GET(vcmpgtuw) },
+      { 0x686, GET(vcmpgtuw_) },
+      { 0x28A, GET(vrfip) },
+      { 0x28C, GET(vspltw) },
+      { 0x28E, GET(vupklsb) },
+      { 0x2C4, GET(vsr) },
+      { 0x2C6, GET(vcmpgtfp) },
+      { 0x6C6, GET(vcmpgtfp_) },
+      { 0x2CA, GET(vrfim) },
+      { 0x2CE, GET(vupklsh) },
+      { 0x300, GET(vaddsbs) },
+      { 0x302, GET(vminsb) },
+      { 0x304, GET(vsrab) },
+      { 0x306, GET(vcmpgtsb) },
+      { 0x706, GET(vcmpgtsb_) },
+      { 0x308, GET(vmulesb) },
+      { 0x30A, GET(vcfux) },
+      { 0x30C, GET(vspltisb) },
+      { 0x30E, GET(vpkpx) },
+      { 0x340, GET(vaddshs) },
+      { 0x342, GET(vminsh) },
+      { 0x344, GET(vsrah) },
+      { 0x346, GET(vcmpgtsh) },
+      { 0x746, GET(vcmpgtsh_) },
+      { 0x348, GET(vmulesh) },
+      { 0x34A, GET(vcfsx) },
+      { 0x34C, GET(vspltish) },
+      { 0x34E, GET(vupkhpx) },
+      { 0x380, GET(vaddsws) },
+      { 0x382, GET(vminsw) },
+      { 0x384, GET(vsraw) },
+      { 0x386, GET(vcmpgtsw) },
+      { 0x786, GET(vcmpgtsw_) },
+      { 0x38A, GET(vctuxs) },
+      { 0x38C, GET(vspltisw) },
+      { 0x3C6, GET(vcmpbfp) },
+      { 0x7C6, GET(vcmpbfp_) },
+      { 0x3CA, GET(vctsxs) },
+      { 0x3CE, GET(vupklpx) },
+      { 0x400, GET(vsububm) },
+      { 0x402, GET(vavgub) },
+      { 0x404, GET(vand) },
+      { 0x40A, GET(vmaxfp) },
+      { 0x40C, GET(vslo) },
+      { 0x440, GET(vsubuhm) },
+      { 0x442, GET(vavguh) },
+      { 0x444, GET(vandc) },
+      { 0x44A, GET(vminfp) },
+      { 0x44C, GET(vsro) },
+      { 0x480, GET(vsubuwm) },
+      { 0x482, GET(vavguw) },
+      { 0x484, GET(vor) },
+      { 0x4C4, GET(vxor) },
+      { 0x502, GET(vavgsb) },
+      { 0x504, GET(vnor) },
+      { 0x542, GET(vavgsh) },
+      { 0x580, GET(vsubcuw) },
+      { 0x582, GET(vavgsw) },
+      { 0x600, GET(vsububs) },
+      { 0x604, GET(mfvscr) },
+      { 0x608, GET(vsum4ubs) },
+      { 0x640, GET(vsubuhs) },
+      { 0x644, GET(mtvscr) },
+      { 0x648, GET(vsum4shs) },
+      { 0x680, GET(vsubuws) },
+      { 0x688, GET(vsum2sws) },
+      { 0x700, GET(vsubsbs) },
+      { 0x708, GET(vsum4sbs) },
+      { 0x740, GET(vsubshs) },
+      { 0x780, GET(vsubsws) },
+      { 0x788, GET(vsumsws) },
+  	});
+    // Group 0x04 VMX128 opcodes, VX128_1 loads/stores and VX128_5. Each VMX128 form has
+    // its own extended opcode mask.
+    table.fillTableVMX128(0x04, 0x7F3, {
+      { 3, GET(lvsl128) },
+      { 67, GET(lvsr128) },
+      { 131, GET(lvewx128) },
+      { 195, GET(lvx128) },
+      { 387, GET(stvewx128) },
+      { 451, GET(stvx128) },
+      { 707, GET(lvxl128) },
+      { 963, GET(stvxl128) },
+      { 1027, GET(lvlx128) },
+      { 1091, GET(lvrx128) },
+      { 1283, GET(stvlx128) },
+      { 1347, GET(stvrx128) },
+      { 1539, GET(lvlxl128) },
+      { 1603, GET(lvrxl128) },
+      { 1795, GET(stvlxl128) },
+      { 1859, GET(stvrxl128) },
+    });
+    table.fillTableVMX128(0x04, 0x10, {
+      { 16, GET(vsldoi128) },
+    });
+  	// Group 0x13 opcodes (field 21..30)
+  	table.fillTable(0x13, 10, 1, {
+      { 0x000, GET(mcrf) },
+      { 0x010, GET(bclr) },
+      { 0x012, GET(rfid) },
+      { 0x021, GET(crnor) },
+      { 0x081, GET(crandc) },
+      { 0x096, GET(isync) },
+      { 0x0C1, GET(crxor) },
+      { 0x0E1, GET(crnand) },
+      { 0x101, GET(crand) },
+      { 0x121, GET(creqv) },
+      { 0x1A1, GET(crorc) },
+      { 0x1C1, GET(cror) },
+      { 0x210, GET(bcctr) },
+  	});
+  	// Group 0x1E opcodes (field 27..30)
+  	table.fillTable(0x1E, 4, 1, {
+      { 0x0, GETRC(rldicl) },
+      { 0x1, GETRC(rldicl) },
+      { 0x2, GETRC(rldicr) },
+      { 0x3, GETRC(rldicr) },
+      { 0x4, GETRC(rldic) },
+      { 0x5, GETRC(rldic) },
+      { 0x6, GETRC(rldimi) },
+      { 0x7, GETRC(rldimi) },
+      { 0x8, GETRC(rldcl) },
+      { 0x9, GETRC(rldcr) },
+  	});
+  	// Group 0x1F opcodes (field 21..30)
+  	table.fillTable(0x1F, 10, 1, {
+      { 0x000, GET(cmp) },
+      { 0x004, GET(tw) },
+      { 0x006, GET(lvsl) },
+      { 0x007, GET(lvebx) },
+      { 0x008, GETRC(subfc) },
+      { 0x208, GETRC(subfco) },
+      { 0x009, GETRC(mulhdu) },
+      { 0x00A, GETRC(addc) },
+      { 0x20A, GETRC(addco) },
+      { 0x00B, GETRC(mulhwu) },
+      { 0x013, GET(mfocrf) },
+      { 0x014, GET(lwarx) },
+      { 0x015, GET(ldx) },
+      { 0x017, GET(lwzx) },
+      { 0x018, GETRC(slw) },
+      { 0x01A, GETRC(cntlzw) },
+      { 0x01B, GETRC(sld) },
+      { 0x01C, GETRC(and) },
+      { 0x020, GET(cmpl) },
+      { 0x026, GET(lvsr) },
+      { 0x027, GET(lvehx) },
+      { 0x028, GETRC(subf) },
+      { 0x228, GETRC(subfo) },
+      { 0x035, GET(ldux) },
+      { 0x036, GET(dcbst) },
+      { 0x037, GET(lwzux) },
+      { 0x03A, GETRC(cntlzd) },
+      { 0x03C, GETRC(andc) },
+      { 0x044, GET(td) },
+      { 0x047, GET(lvewx) },
+      { 0x049, GETRC(mulhd) },
+      { 0x04B, GETRC(mulhw) },
+      { 0x053, GET(mfmsr) },
+      { 0x054, GET(ldarx) },
+      { 0x056, GET(dcbf) },
+      { 0x057, GET(lbzx) },
+      { 0x067, GET(lvx) },
+      { 0x068, GETRC(neg) },
+      { 0x268, GETRC(nego) },
+      { 0x077, GET(lbzux) },
+      { 0x07C, GETRC(nor) },
+      { 0x087, GET(stvebx) },
+      { 0x088, GETRC(subfe) },
+      { 0x288, GETRC(subfeo) },
+      { 0x08A, GETRC(adde) },
+      { 0x28A, GETRC(addeo) },
+      { 0x090, GET(mtocrf) },
+      { 0x092, GET(mtmsr) },
+      { 0x095, GET(stdx) },
+      { 0x096, GET(stwcx) },
+      { 0x097, GET(stwx) },
+      { 0x0A7, GET(stvehx) },
+      { 0x0B2, GET(mtmsrd) },
+      { 0x0B5, GET(stdux) },
+      { 0x0B7, GET(stwux) },
+      { 0x0C7, GET(stvewx) },
+      { 0x0C8, GETRC(subfze) },
+      { 0x2C8, GETRC(subfzeo) },
+      { 0x0CA, GETRC(addze) },
+      { 0x2CA, GETRC(addzeo) },
+      { 0x0D6, GET(stdcx) },
+      { 0x0D7, GET(stbx) },
+      { 0x0E7, GET(stvx) },
+      { 0x0E8, GETRC(subfme) },
+      { 0x2E8, GETRC(subfmeo) },
+      { 0x0E9, GETRC(mulld) },
+      { 0x2E9, GETRC(mulldo) },
+      { 0x0EA, GETRC(addme) },
+      { 0x2EA, GETRC(addmeo) },
+      { 0x0EB, GETRC(mullw) },
+      { 0x2EB, GETRC(mullwo) },
+      { 0x0F6, GET(dcbtst) },
+      { 0x0F7, GET(stbux) },
+      { 0x10A, GETRC(add) },
+      { 0x30A, GETRC(addo) },
+      { 0x116, GET(dcbt) },
+      { 0x117, GET(lhzx) },
+      { 0x11C, GETRC(eqv) },
+      { 0x112, GET(tlbiel) },
+      { 0x132, GET(tlbie) },
+      { 0x136, GET(eciwx) },
+      { 0x137, GET(lhzux) },
+      { 0x13C, GETRC(xor) },
+      { 0x153, GET(mfspr) },
+      { 0x155, GET(lwax) },
+      { 0x156, GET(dst) },
+      { 0x157, GET(lhax) },
+      { 0x167, GET(lvxl) },
+      { 0x173, GET(mftb) },
+      { 0x175, GET(lwaux) },
+      { 0x176, GET(dstst) },
+      { 0x177, GET(lhaux) },
+      { 0x192, GET(slbmte) },
+      { 0x197, GET(sthx) },
+      { 0x19C, GET(orcx) },
+      { 0x1B2, GET(slbie) },
+      { 0x1B6, GET(ecowx) },
+      { 0x1B7, GET(sthux) },
+      { 0x1BC, GETRC(or) },
+      { 0x1C9, GETRC(divdu) },
+      { 0x3C9, GETRC(divduo) },
+      { 0x1CB, GETRC(divwu) },
+      { 0x3CB, GETRC(divwuo) },
+      { 0x1D3, GET(mtspr) },
+      { 0x1D6, GET(dcbi) },
+      { 0x1DC, GETRC(nand) },
+      { 0x1F2, GET(slbia) },
+      { 0x1E7, GET(stvxl) },
+      { 0x1E9, GETRC(divd) },
+      { 0x3E9, GETRC(divdo) },
+      { 0x1EB, GETRC(divw) },
+      { 0x3EB, GETRC(divwo) },
+      { 0x207, GET(lvlx) },
+      { 0x214, GET(ldbrx) },
+      { 0x215, GET(lswx) },
+      { 0x216, GET(lwbrx) },
+      { 0x217, GET(lfsx) },
+      { 0x218, GETRC(srw) },
+      { 0x21B, GETRC(srd) },
+      { 0x227, GET(lvrx) },
+      { 0x236, GET(tlbsync) },
+      { 0x237, GET(lfsux) },
+      { 0x239, GET(mfsrin) },
+      { 0x253, GET(mfsr) },
+      { 0x255, GET(lswi) },
+      { 0x256, GET(sync) },
+      { 0x257, GET(lfdx) },
+      { 0x277, GET(lfdux) },
+      { 0x287, GET(stvlx) },
+      { 0x294, GET(stdbrx) },
+      { 0x295, GET(stswx) },
+      { 0x296, GET(stwbrx) },
+      { 0x297, GET(stfsx) },
+      { 0x2A7, GET(stvrx) },
+      { 0x2B7, GET(stfsux) },
+      { 0x2D5, GET(stswi) },
+      { 0x2D7, GET(stfdx) },
+      { 0x2F7, GET(stfdux) },
+      { 0x307, GET(lvlxl) },
+      { 0x316, GET(lhbrx) },
+      { 0x318, GETRC(sraw) },
+      { 0x31A, GETRC(srad) },
+      { 0x327, GET(lvrxl) },
+      { 0x336, GET(dss) },
+      { 0x338, GETRC(srawi) },
+      { 0x33A, GETRC(sradi) },
+      { 0x33B, GETRC(sradi) },
+      { 0x353, GET(slbmfev) },
+      { 0x356, GET(eieio) },
+      { 0x387, GET(stvlxl) },
+      { 0x393, GET(slbmfee) },
+      { 0x396, GET(sthbrx) },
+      { 0x39A, GETRC(extsh) },
+      { 0x3A7, GET(stvrxl) },
+      { 0x3BA, GETRC(extsb) },
+      { 0x3D7, GET(stfiwx) },
+      { 0x3DA, GETRC(extsw) },
+      { 0x3D6, GET(icbi) },
+      { 0x3F6, GET(dcbz) },
+  	});
+  	// Group 0x3A opcodes (field 30..31)
+  	table.fillTable(0x3A,2, 0, {
+      { 0x0, GET(ld) },
+      { 0x1, GET(ldu) },
+      { 0x2, GET(lwa) },
+  	});
+  	// Group 0x3B opcodes (field 21..30)
+  	table.fillTable(0x3B, 10, 1, {
+      { 0x12, GETRC(fdivs), 5 },
+      { 0x14, GETRC(fsubs), 5 },
+      { 0x15, GETRC(fadds), 5 },
+      { 0x16, GETRC(fsqrts), 5 },
+      { 0x18, GETRC(fres), 5 },
+      { 0x19, GETRC(fmuls), 5 },
+      { 0x1C, GETRC(fmsubs), 5 },
+      { 0x1D, GETRC(fmadds), 5 },
+      { 0x1E, GETRC(fnmsubs), 5 },
+      { 0x1F, GETRC(fnmadds), 5 },
+  	});
+  	// Group 0x3E opcodes (field 30..31)
+  	table.fillTable(0x3E, 2, 0, {
+      { 0x0, GET(std) },
+      { 0x1, GET(stdu) },
+  	});
+  	// Group 0x3F opcodes (field 21..30)
+  	table.fillTable(0x3F, 10, 1, {
+      { 0x026, GETRC(mtfsb1) },
+      { 0x040, GETRC(mcrfs) },
+      { 0x046, GETRC(mtfsb0) },
+      { 0x086, GETRC(mtfsfi) },
+      { 0x247, GETRC(mffs) },
+      { 0x2C7, GETRC(mtfsf) },
+
+      { 0x000, GET(fcmpu) },
+      { 0x00C, GETRC(frsp) },
+      { 0x00E, GETRC(fctiw) },
+      { 0x00F, GETRC(fctiwz) },
+
+      { 0x012, GETRC(fdiv), 5 },
+      { 0x014, GETRC(fsub), 5 },
+      { 0x015, GETRC(fadd), 5 },
+      { 0x016, GETRC(fsqrt), 5 },
+      { 0x017, GETRC(fsel), 5 },
+      { 0x019, GETRC(fmul), 5 },
+      { 0x01A, GETRC(frsqrte), 5 },
+      { 0x01C, GETRC(fmsub), 5 },
+      { 0x01D, GETRC(fmadd), 5 },
+      { 0x01E, GETRC(fnmsub), 5 },
+      { 0x01F, GETRC(fnmadd), 5 },
+
+      { 0x020, GET(fcmpo) },
+      { 0x028, GETRC(fneg) },
+      { 0x048, GETRC(fmr) },
+      { 0x088, GETRC(fnabs) },
+      { 0x108, GETRC(fabs) },
+      { 0x32E, GETRC(fctid) },
+      { 0x32F, GETRC(fctidz) },
+      { 0x34E, GETRC(fcfid) },
+  	});
+    // VMX128 opcodes (0x05, 0x06), each form has its own extended opcode mask.
+    // Group 0x05 VX128_2 and VX128
+    table.fillTableVMX128(0x05, 0x210, {
+      { 0, GET(vperm128) },
+    });
+    table.fillTableVMX128(0x05, 0x3D0, {
+      { 16, GET(vaddfp128) },
+      { 80, GET(vsubfp128) },
+      { 144, GET(vmulfp128) },
+      { 208, GET(vmaddfp128) },
+      { 272, GET(vmaddcfp128) },
+      { 336, GET(vnmsubfp128) },
+      { 400, GET(vmsum3fp128) },
+      { 464, GET(vmsum4fp128) },
+      { 512, GET(vpkshss128) },
+      { 528, GET(vand128) },
+      { 576, GET(vpkshus128) },
+      { 592, GET(vandc128) },
+      { 640, GET(vpkswss128) },
+      { 656, GET(vnor128) },
+      { 704, GET(vpkswus128) },
+      { 720, GET(vor128) },
+      { 768, GET(vpkuhum128) },
+      { 784, GET(vxor128) },
+      { 832, GET(vpkuhus128) },
+      { 848, GET(vsel128) },
+      { 896, GET(vpkuwum128) },
+      { 912, GET(vslo128) },
+      { 960, GET(vpkuwus128) },
+      { 976, GET(vsro128) },
+    });
+    // Group 0x06 VX128_R, VX128, VX128_P, VX128_3 and VX128_4
+    table.fillTableVMX128(0x06, 0x390, {
+      { 0, GET(vcmpeqfp128) },
+      { 128, GET(vcmpgefp128) },
+      { 256, GET(vcmpgtfp128) },
+      { 384, GET(vcmpbfp128) },
+      { 512, GET(vcmpequw128) },
+    });
+    table.fillTableVMX128(0x06, 0x3D0, {
+      { 80, GET(vrlw128) },
+      { 208, GET(vslw128) },
+      { 336, GET(vsraw128) },
+      { 464, GET(vsrw128) },
+      { 640, GET(vmaxfp128) },
+      { 704, GET(vminfp128) },
+      { 768, GET(vmrghw128) },
+      { 832, GET(vmrglw128) },
+      { 896, GET(vupkhsb128) },
+      { 960, GET(vupklsb128) },
+    });
+    table.fillTableVMX128(0x06, 0x630, {
+      { 528, GET(vpermwi128) },
+    });
+    table.fillTableVMX128(0x06, 0x7F0, {
+      { 560, GET(vcfpsxws128) },
+      { 624, GET(vcfpuxws128) },
+      { 688, GET(vcsxwfp128) },
+      { 752, GET(vcuxwfp128) },
+      { 816, GET(vrfim128) },
+      { 880, GET(vrfin128) },
+      { 944, GET(vrfip128) },
+      { 1008, GET(vrfiz128) },
+      { 1584, GET(vrefp128) },
+      { 1648, GET(vrsqrtefp128) },
+      { 1712, GET(vexptefp128) },
+      { 1776, GET(vlogefp128) },
+      { 1840, GET(vspltw128) },
+      { 1904, GET(vspltisw128) },
+      { 2032, GET(vupkd3d128) },
+    });
+    table.fillTableVMX128(0x06, 0x730, {
+      { 1552, GET(vpkd3d128) },
+      { 1808, GET(vrlimi128) },
+    });
+    #undef GETRC
+    #undef GET
+    #undef GET_
+  }
+} // namespace PPCInterpreter
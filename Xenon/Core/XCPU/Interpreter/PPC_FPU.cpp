@@ -1,54 +1,682 @@
 // Copyright 2025 Xenon Emulator Project
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "Base/Arch.h"
 #include "Base/Logging/Log.h"
 #include "PPCInterpreter.h"
 
-#define FPR(x)			hCore->ppuThread[hCore->currentThread].FPR[x]
-#define GET_FPSCR		hCore->ppuThread[hCore->currentThread].FPSCR.FPSCR_Hex
-#define SET_FPSCR(x)	hCore->ppuThread[hCore->currentThread].FPSCR.FPSCR_Hex = x
+#ifdef ARCH_X86_64
+#include <xmmintrin.h>
+#else
+#include <cfenv>
+#endif
+
+/*
+ *	PPC_FPU.cpp Floating point instructions.
+ *
+ *	Arithmetic runs straight on the host FPU in double precision, single
+ *	precision instructions round the result afterwards. The FPSCR is computed
+ *	lazily: overflow, underflow, zero divide and inexact are left in the host
+ *	exception flags, and the class of the last result (FPRF) is only stored.
+ *	Both are folded into the FPSCR by ppcSyncFPSCR when the guest reads it (mffs,
+ *	mcrfs, record forms) or once per time slice. Invalid operations always
+ *	produce a NaN, so they're detected and handled on a slow path when the
+ *	result is one, which also takes care of the PowerPC NaN propagation rules.
+ *
+ *	Once the guest enables any FP exception the FPSCR is synced after every
+ *	instruction, so the program exception can be raised on the instruction that
+ *	caused it.
+ */
+
+#define FPR(x) hCore->curThread->FPR[x]
+#define CUR_FPSCR hCore->curThread->FPSCR
+#define GET_FPSCR hCore->curThread->FPSCR.FPSCR_Hex
+#define SET_FPSCR(x)                                                           \
+  hCore->curThread->FPSCR.FPSCR_Hex = x
+
+#define FPU_CHECK_AVAILABLE                                                    \
+  if (!ppcFpuAvailable(hCore)) {                                               \
+    return;                                                                    \
+  }
+
+// FPSCR bits, host bit numbering.
+#define FPSCR_FX 0x80000000
+#define FPSCR_FEX 0x40000000
+#define FPSCR_VX 0x20000000
+#define FPSCR_OX 0x10000000
+#define FPSCR_UX 0x08000000
+#define FPSCR_ZX 0x04000000
+#define FPSCR_XX 0x02000000
+#define FPSCR_VXSNAN 0x01000000
+#define FPSCR_VXISI 0x00800000
+#define FPSCR_VXIDI 0x00400000
+#define FPSCR_VXZDZ 0x00200000
+#define FPSCR_VXIMZ 0x00100000
+#define FPSCR_VXVC 0x00080000
+#define FPSCR_FR 0x00040000
+#define FPSCR_FI 0x00020000
+#define FPSCR_FPRF 0x0001F000
+#define FPSCR_FPCC 0x0000F000
+#define FPSCR_VXSOFT 0x00000400
+#define FPSCR_VXSQRT 0x00000200
+#define FPSCR_VXCVI 0x00000100
+#define FPSCR_ENABLES 0x000000F8
+// Any invalid operation exception.
+#define FPSCR_VX_ALL                                                           \
+  (FPSCR_VXSNAN | FPSCR_VXISI | FPSCR_VXIDI | FPSCR_VXZDZ | FPSCR_VXIMZ |      \
+   FPSCR_VXVC | FPSCR_VXSOFT | FPSCR_VXSQRT | FPSCR_VXCVI)
+// Sticky exception bits.
+#define FPSCR_EXCEPTIONS                                                       \
+  (FPSCR_OX | FPSCR_UX | FPSCR_ZX | FPSCR_XX | FPSCR_VX_ALL)
+
+// PowerPC default QNaN.
+#define FPU_DEFAULT_NAN 0x7FF8000000000000ULL
+
+//
+// Host FPU state
+//
+
+#ifdef ARCH_X86_64
+#define HOST_FLAG_INVALID 0x01
+#define HOST_FLAG_ZERODIVIDE 0x04
+#define HOST_FLAG_OVERFLOW 0x08
+#define HOST_FLAG_UNDERFLOW 0x10
+#define HOST_FLAG_INEXACT 0x20
+#define HOST_FLAGS_ALL 0x3F
+#else
+#define HOST_FLAG_INVALID FE_INVALID
+#define HOST_FLAG_ZERODIVIDE FE_DIVBYZERO
+#define HOST_FLAG_OVERFLOW FE_OVERFLOW
+#define HOST_FLAG_UNDERFLOW FE_UNDERFLOW
+#define HOST_FLAG_INEXACT FE_INEXACT
+#define HOST_FLAGS_ALL FE_ALL_EXCEPT
+#endif
+
+// Returns and clears the host exception flags.
+static inline u32 fpuTakeHostFlags() {
+#ifdef ARCH_X86_64
+  const u32 csr = _mm_getcsr();
+  if (csr & HOST_FLAGS_ALL) {
+    _mm_setcsr(csr & ~HOST_FLAGS_ALL);
+  }
+  return csr & HOST_FLAGS_ALL;
+#else
+  const u32 flags = std::fetestexcept(FE_ALL_EXCEPT);
+  if (flags) {
+    std::feclearexcept(FE_ALL_EXCEPT);
+  }
+  return flags;
+#endif
+}
+
+// Loads FPSCR[RN] and FPSCR[NI] into the host.
+static void fpuApplyHostMode(const FPSCRegister &fpscr) {
+#ifdef ARCH_X86_64
+  // RN: nearest, zero, +inf, -inf. MXCSR[RC]: nearest, -inf, +inf, zero.
+  static constexpr u32 roundingModes[4] = {0x0000, 0x6000, 0x4000, 0x2000};
+  u32 csr = _mm_getcsr() & ~(0x6000 | 0x8040);
+  csr |= roundingModes[fpscr.RN];
+  if (fpscr.NI) {
+    // Flush to zero and denormals are zero.
+    csr |= 0x8040;
+  }
+  _mm_setcsr(csr);
+#else
+  static constexpr int roundingModes[4] = {FE_TONEAREST, FE_TOWARDZERO,
+                                           FE_UPWARD, FE_DOWNWARD};
+  std::fesetround(roundingModes[fpscr.RN]);
+#endif
+}
+
+// FPSCR[FPRF] for a result.
+static u32 fpuClassify(f64 value) {
+  const bool negative = std::signbit(value);
+  switch (std::fpclassify(value)) {
+  case FP_NAN:
+    return 0x11;
+  case FP_INFINITE:
+    return negative ? 0x09 : 0x05;
+  case FP_ZERO:
+    return negative ? 0x12 : 0x02;
+  case FP_SUBNORMAL:
+    return negative ? 0x18 : 0x14;
+  default:
+    return negative ? 0x08 : 0x04;
+  }
+}
+
+// Sets the given exception bits, and FX if any of them wasn't set yet. The
+// summary bits are recomputed.
+static inline void fpuSetExceptions(FPSCRegister &fpscr, u32 bits) {
+  u32 value = fpscr.FPSCR_Hex;
+  if (bits & ~value) {
+    value |= FPSCR_FX;
+  }
+  value |= bits;
+  value &= ~(FPSCR_VX | FPSCR_FEX);
+  if (value & FPSCR_VX_ALL) {
+    value |= FPSCR_VX;
+  }
+  // VX..XX line up with their enables VE..XE shifted by 22.
+  if ((value >> 22) & value & FPSCR_ENABLES) {
+    value |= FPSCR_FEX;
+  }
+  fpscr.FPSCR_Hex = value;
+}
+
+// Like fpuSetExceptions, but raises the program exception if any of them is
+// enabled.
+static void fpuRaise(PPU_STATE *hCore, u32 bits) {
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+  fpuSetExceptions(thread.FPSCR, bits);
+  if (bits & FPSCR_VX_ALL) {
+    bits |= FPSCR_VX;
+  }
+  if (((bits >> 22) & thread.FPSCR.FPSCR_Hex & FPSCR_ENABLES) &&
+      (thread.MSR.FE0 || thread.MSR.FE1)) {
+    thread.exceptReg |= PPU_EX_PROG;
+    thread.exceptTrapType = TRAP_TYPE_SRR1_TRAP_FPU;
+  }
+}
+
+void PPCInterpreter::ppcSyncFPSCR(PPU_STATE *hCore) {
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+  const u32 hostFlags = thread.fpuHostFlags | fpuTakeHostFlags();
+  thread.fpuHostFlags = 0;
+
+  if (thread.fpuResultPending) {
+    thread.FPSCR.FPRF = fpuClassify(thread.fpuLastResult);
+    thread.fpuResultPending = false;
+  }
+
+  // Invalid operations were already handled on the NaN path. FR and FI
+  // describe the last instruction only, which we don't track; FI is set if any
+  // instruction since the last sync was inexact.
+  u32 bits = 0;
+  if (hostFlags & HOST_FLAG_OVERFLOW) {
+    bits |= FPSCR_OX;
+  }
+  if (hostFlags & HOST_FLAG_UNDERFLOW) {
+    bits |= FPSCR_UX;
+  }
+  if (hostFlags & HOST_FLAG_ZERODIVIDE) {
+    bits |= FPSCR_ZX;
+  }
+  thread.FPSCR.FI = (hostFlags & HOST_FLAG_INEXACT) ? 1 : 0;
+  if (hostFlags & HOST_FLAG_INEXACT) {
+    bits |= FPSCR_XX;
+  }
+  fpuRaise(hCore, bits);
+}
+
+void PPCInterpreter::ppcFpuEnterThread(PPU_STATE *hCore) {
+  fpuApplyHostMode(hCore->curThread->FPSCR);
+  fpuTakeHostFlags();
+}
+
+void PPCInterpreter::ppcFpuLeaveThread(PPU_STATE *hCore) {
+  // VMX arithmetic shares the host flags, anything raised outside of FPU
+  // instructions ends up here as well.
+  hCore->curThread->fpuHostFlags |= fpuTakeHostFlags();
+}
+
+u64 PPCInterpreter::ppcSingleToDouble(u32 value) {
+  const u64 sign = static_cast<u64>(value & 0x80000000) << 32;
+  const u32 exp = (value >> 23) & 0xFF;
+  u32 mantissa = value & 0x7FFFFF;
+
+  if (exp == 0xFF) {
+    // Infinity and NaN's keep their payload, SNaN's aren't quieted.
+    return sign | 0x7FF0000000000000ULL | (static_cast<u64>(mantissa) << 29);
+  }
+  if (exp != 0) {
+    return sign | (static_cast<u64>(exp - 127 + 1023) << 52) |
+           (static_cast<u64>(mantissa) << 29);
+  }
+  if (mantissa == 0) {
+    return sign;
+  }
+  // Denormal, normalize it. The host would flush it in non-IEEE mode.
+  s32 unbiasedExp = -126;
+  while (!(mantissa & 0x800000)) {
+    mantissa <<= 1;
+    unbiasedExp--;
+  }
+  return sign | (static_cast<u64>(unbiasedExp + 1023) << 52) |
+         (static_cast<u64>(mantissa & 0x7FFFFF) << 29);
+}
+
+u32 PPCInterpreter::ppcDoubleToSingle(u64 value) {
+  const u32 exp = (value >> 52) & 0x7FF;
+  if (exp > 896 || (value & 0x7FFFFFFFFFFFFFFFULL) == 0) {
+    // No denormalization required, the bits are just selected.
+    return static_cast<u32>(((value >> 32) & 0xC0000000) |
+                            ((value >> 29) & 0x3FFFFFFF));
+  }
+  if (exp >= 874) {
+    // Single precision denormal.
+    const u64 mantissa =
+        (0x10000000000000ULL | (value & 0xFFFFFFFFFFFFFULL)) >> (897 - exp);
+    return static_cast<u32>(((value >> 32) & 0x80000000) |
+                            ((mantissa >> 29) & 0x7FFFFF));
+  }
+  // Undefined by the architecture, too small for a single.
+  return static_cast<u32>((value >> 32) & 0x80000000);
+}
+
+//
+// Result handling
+//
+
+static inline bool fpuIsSNaN(f64 value) {
+  u64 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return std::isnan(value) && !(bits & 0x0008000000000000ULL);
+}
+
+static inline f64 fpuQuiet(f64 value) {
+  u64 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits |= 0x0008000000000000ULL;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static inline f64 fpuDefaultNaN() {
+  const u64 bits = FPU_DEFAULT_NAN;
+  f64 value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static inline f64 fpuRoundSingle(f64 value) {
+  return static_cast<f64>(static_cast<f32>(value));
+}
+
+enum FPU_OP : u8 {
+  FPU_OP_ADD,
+  FPU_OP_SUB,
+  FPU_OP_MUL,
+  FPU_OP_DIV,
+  FPU_OP_MADD,
+  FPU_OP_MSUB,
+  FPU_OP_SQRT,
+  FPU_OP_OTHER
+};
+
+// Slow path for NaN results. Operands are given in PowerPC NaN precedence
+// order (frA, frB, frC), the first NaN operand is the result. Otherwise this
+// was an invalid operation and the default NaN is returned.
+static f64 fpuNaNResult(PPU_STATE *hCore, FPU_OP op, f64 a, f64 b, f64 c,
+                        u32 operands) {
+  const f64 values[3] = {a, b, c};
+  u32 bits = 0;
+  for (u32 i = 0; i < operands; i++) {
+    if (fpuIsSNaN(values[i])) {
+      bits |= FPSCR_VXSNAN;
+    }
+  }
+  for (u32 i = 0; i < operands; i++) {
+    if (std::isnan(values[i])) {
+      fpuRaise(hCore, bits);
+      return fpuQuiet(values[i]);
+    }
+  }
+
+  switch (op) {
+  case FPU_OP_ADD:
+  case FPU_OP_SUB:
+    bits |= FPSCR_VXISI;
+    break;
+  case FPU_OP_MUL:
+    bits |= FPSCR_VXIMZ;
+    break;
+  case FPU_OP_DIV:
+    bits |= std::isinf(a) ? FPSCR_VXIDI : FPSCR_VXZDZ;
+    break;
+  case FPU_OP_MADD:
+  case FPU_OP_MSUB:
+    // frA * frC + frB.
+    bits |= (std::isinf(a) && c == 0.0) || (a == 0.0 && std::isinf(c))
+                ? FPSCR_VXIMZ
+                : FPSCR_VXISI;
+    break;
+  case FPU_OP_SQRT:
+    bits |= FPSCR_VXSQRT;
+    break;
+  default:
+    break;
+  }
+  fpuRaise(hCore, bits);
+  return fpuDefaultNaN();
+}
+
+// Syncs the FPSCR after an instruction, if the guest needs it right away.
+static inline void fpuFinish(PPU_STATE *hCore, u32 RC) {
+  if ((GET_FPSCR & FPSCR_ENABLES) || RC) {
+    PPCInterpreter::ppcSyncFPSCR(hCore);
+  }
+  if (RC) {
+    PPCInterpreter::ppcUpdateCR(hCore, 1, GET_FPSCR >> 28);
+  }
+}
 
-static inline void checkFpuAvailable(PPU_STATE* hCore) {
-	if (hCore->ppuThread[hCore->currentThread].SPR.MSR.FP != 1) {
-		hCore->ppuThread[hCore->currentThread].exceptReg |= PPU_EX_FPU;
-		return;
-	}
+// Writes the result of an arithmetic instruction, FPRF is set from it.
+static inline void fpuSetResult(PPU_STATE *hCore, u32 FrD, f64 result, u32 RC) {
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+  thread.FPR[FrD].valueAsDouble = result;
+  thread.fpuLastResult = result;
+  thread.fpuResultPending = true;
+  fpuFinish(hCore, RC);
 }
 
-void PPCInterpreter::PPCInterpreter_mffsx(PPU_STATE* hCore)
-{
-	X_FORM_FrD_RC;
+//
+// Arithmetic
+//
+
+// frD = frA op frB
+#define FPU_ARITH_OP(name, op, fpuOp, single)                                  \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    A_FORM_FrD_FrA_FrB_RC;                                                     \
+    FPU_CHECK_AVAILABLE;                                                       \
+    const f64 a = FPR(FrA).valueAsDouble;                                      \
+    const f64 b = FPR(FrB).valueAsDouble;                                      \
+    f64 result = a op b;                                                       \
+    if (std::isnan(result)) {                                                  \
+      result = fpuNaNResult(hCore, fpuOp, a, b, 0.0, 2);                       \
+    }                                                                          \
+    fpuSetResult(hCore, FrD, single ? fpuRoundSingle(result) : result, RC);    \
+  }
+
+FPU_ARITH_OP(faddx, +, FPU_OP_ADD, false)
+FPU_ARITH_OP(fsubx, -, FPU_OP_SUB, false)
+FPU_ARITH_OP(fdivx, /, FPU_OP_DIV, false)
+FPU_ARITH_OP(faddsx, +, FPU_OP_ADD, true)
+FPU_ARITH_OP(fsubsx, -, FPU_OP_SUB, true)
+FPU_ARITH_OP(fdivsx, /, FPU_OP_DIV, true)
+
+// frD = frA * frC
+#define FPU_MUL_OP(name, single)                                               \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    A_FORM_FrD_FrA_FRC_XO_RC;                                                  \
+    FPU_CHECK_AVAILABLE;                                                       \
+    const f64 a = FPR(FrA).valueAsDouble;                                      \
+    const f64 c = FPR(FRC).valueAsDouble;                                      \
+    f64 result = a * c;                                                        \
+    if (std::isnan(result)) {                                                  \
+      result = fpuNaNResult(hCore, FPU_OP_MUL, a, c, 0.0, 2);                  \
+    }                                                                          \
+    fpuSetResult(hCore, FrD, single ? fpuRoundSingle(result) : result, RC);    \
+  }
 
-	checkFpuAvailable(hCore);
+FPU_MUL_OP(fmulx, false)
+FPU_MUL_OP(fmulsx, true)
 
-	if (RC) {
-		LOG_CRITICAL(Xenon, "FPU: mffs_rc, record not implemented.");
-	}
+// frD = [-](frA * frC +/- frB), fused.
+#define FPU_MADD_OP(name, subtract, negate, single)                            \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    A_FORM_FrD_FrA_FrB_FRC_XO_RC;                                              \
+    FPU_CHECK_AVAILABLE;                                                       \
+    const f64 a = FPR(FrA).valueAsDouble;                                      \
+    const f64 b = FPR(FrB).valueAsDouble;                                      \
+    const f64 c = FPR(FRC).valueAsDouble;                                      \
+    f64 result = std::fma(a, c, subtract ? -b : b);                            \
+    if (std::isnan(result)) {                                                  \
+      result = fpuNaNResult(hCore, subtract ? FPU_OP_MSUB : FPU_OP_MADD, a, b, \
+                            c, 3);                                             \
+    } else if (negate) {                                                       \
+      result = -result;                                                        \
+    }                                                                          \
+    fpuSetResult(hCore, FrD, single ? fpuRoundSingle(result) : result, RC);    \
+  }
 
-	FPR(FrD).valueAsU64 = static_cast<u64>(GET_FPSCR);
+FPU_MADD_OP(fmaddx, false, false, false)
+FPU_MADD_OP(fmsubx, true, false, false)
+FPU_MADD_OP(fnmaddx, false, true, false)
+FPU_MADD_OP(fnmsubx, true, true, false)
+FPU_MADD_OP(fmaddsx, false, false, true)
+FPU_MADD_OP(fmsubsx, true, false, true)
+FPU_MADD_OP(fnmaddsx, false, true, true)
+FPU_MADD_OP(fnmsubsx, true, true, true)
+
+// frD = op(frB)
+#define FPU_UNARY_OP(name, expr, fpuOp, single)                                \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    A_FORM_FrD_FrB_XO_RC;                                                      \
+    FPU_CHECK_AVAILABLE;                                                       \
+    const f64 b = FPR(FrB).valueAsDouble;                                      \
+    f64 result = expr;                                                         \
+    if (std::isnan(result)) {                                                  \
+      result = fpuNaNResult(hCore, fpuOp, b, 0.0, 0.0, 1);                     \
+    }                                                                          \
+    fpuSetResult(hCore, FrD, single ? fpuRoundSingle(result) : result, RC);    \
+  }
+
+FPU_UNARY_OP(fsqrtx, std::sqrt(b), FPU_OP_SQRT, false)
+FPU_UNARY_OP(fsqrtsx, std::sqrt(b), FPU_OP_SQRT, true)
+FPU_UNARY_OP(fresx, 1.0 / b, FPU_OP_OTHER, true)
+FPU_UNARY_OP(frsqrtex, 1.0 / std::sqrt(b), FPU_OP_SQRT, false)
+
+void PPCInterpreter::PPCInterpreter_frspx(PPU_STATE *hCore) {
+  X_FORM_FrD_FrB_RC;
+  FPU_CHECK_AVAILABLE;
+  const f64 b = FPR(FrB).valueAsDouble;
+  f64 result = b;
+  if (std::isnan(b)) {
+    result = fpuNaNResult(hCore, FPU_OP_OTHER, b, 0.0, 0.0, 1);
+  }
+  fpuSetResult(hCore, FrD, fpuRoundSingle(result), RC);
 }
 
-void PPCInterpreter::PPCInterpreter_mtfsfx(PPU_STATE* hCore)
-{
-    XFL_FORM_FLM_FrB_RC;
+// frD = frA >= 0.0 ? frC : frB, doesn't touch the FPSCR.
+void PPCInterpreter::PPCInterpreter_fselx(PPU_STATE *hCore) {
+  A_FORM_FrD_FrA_FrB_FRC_XO_RC;
+  FPU_CHECK_AVAILABLE;
+  FPR(FrD).valueAsDouble = FPR(FrA).valueAsDouble >= 0.0
+                               ? FPR(FRC).valueAsDouble
+                               : FPR(FrB).valueAsDouble;
+  fpuFinish(hCore, RC);
+}
 
-    u32 mask = 0;
-    u32 b = 0x80;
+//
+// Move, only the sign bit is changed and the FPSCR isn't touched.
+//
 
-	checkFpuAvailable(hCore);
+#define FPU_MOVE_OP(name, expr)                                                \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    X_FORM_FrD_FrB_RC;                                                         \
+    FPU_CHECK_AVAILABLE;                                                       \
+    const u64 b = FPR(FrB).valueAsU64;                                         \
+    FPR(FrD).valueAsU64 = expr;                                                \
+    fpuFinish(hCore, RC);                                                      \
+  }
 
-	if (RC) {
-		LOG_CRITICAL(Xenon, "FPU: mtfsf_rc, record not implemented.");
-	}
+FPU_MOVE_OP(fmrx, b)
+FPU_MOVE_OP(fnegx, b ^ 0x8000000000000000ULL)
+FPU_MOVE_OP(fabsx, b & ~0x8000000000000000ULL)
+FPU_MOVE_OP(fnabsx, b | 0x8000000000000000ULL)
 
-    for (; b; b >>= 1)
-    {
-        mask <<= 4;
+//
+// Conversion
+//
 
-        if (FLM & b)
-        {
-            mask |= 0xF;
-        }
+// Converts to an integer of type T, rounding with the current mode or towards
+// zero. Out of range values and NaN's saturate and raise VXCVI.
+template <typename T>
+static inline T fpuConvertToInt(PPU_STATE *hCore, f64 value, bool truncate) {
+  constexpr f64 maxValue = -static_cast<f64>(std::numeric_limits<T>::min());
+  if (std::isnan(value) || value >= maxValue ||
+      value < static_cast<f64>(std::numeric_limits<T>::min())) {
+    fpuRaise(hCore, FPSCR_VXCVI | (fpuIsSNaN(value) ? FPSCR_VXSNAN : 0));
+    if (std::isnan(value) || value < 0.0) {
+      return std::numeric_limits<T>::min();
     }
+    return std::numeric_limits<T>::max();
+  }
+  // The host conversion raises inexact for us.
+  return static_cast<T>(truncate ? value : std::rint(value));
+}
+
+#define FPU_CONVERT_OP(name, T, truncate)                                      \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    X_FORM_FrD_FrB_RC;                                                         \
+    FPU_CHECK_AVAILABLE;                                                       \
+    const T result =                                                           \
+        fpuConvertToInt<T>(hCore, FPR(FrB).valueAsDouble, truncate);           \
+    FPR(FrD).valueAsU64 =                                                      \
+        static_cast<u64>(static_cast<std::make_unsigned_t<T>>(result));        \
+    fpuFinish(hCore, RC);                                                      \
+  }
+
+FPU_CONVERT_OP(fctiwx, s32, false)
+FPU_CONVERT_OP(fctiwzx, s32, true)
+FPU_CONVERT_OP(fctidx, s64, false)
+FPU_CONVERT_OP(fctidzx, s64, true)
+
+void PPCInterpreter::PPCInterpreter_fcfidx(PPU_STATE *hCore) {
+  X_FORM_FrD_FrB_RC;
+  FPU_CHECK_AVAILABLE;
+  const s64 b = static_cast<s64>(FPR(FrB).valueAsU64);
+  fpuSetResult(hCore, FrD, static_cast<f64>(b), RC);
+}
+
+//
+// Compare
+//
+
+// Sets CR[BF] and FPSCR[FPCC], ordered compares also raise VXVC on NaN's.
+static inline void fpuCompare(PPU_STATE *hCore, u32 BF, f64 a, f64 b,
+                              bool ordered) {
+  u32 result;
+  if (std::isnan(a) || std::isnan(b)) {
+    result = 0b0001;
+    const bool snan = fpuIsSNaN(a) || fpuIsSNaN(b);
+    u32 bits = snan ? FPSCR_VXSNAN : 0;
+    if (ordered && (!snan || !CUR_FPSCR.VE)) {
+      bits |= FPSCR_VXVC;
+    }
+    fpuRaise(hCore, bits);
+  } else if (a < b) {
+    result = 0b1000;
+  } else if (a > b) {
+    result = 0b0100;
+  } else {
+    result = 0b0010;
+  }
+
+  // FPCC lives in FPRF, classify the pending result before it's overwritten.
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+  if (thread.fpuResultPending) {
+    thread.FPSCR.FPRF = fpuClassify(thread.fpuLastResult);
+    thread.fpuResultPending = false;
+  }
+  thread.FPSCR.FPSCR_Hex =
+      (thread.FPSCR.FPSCR_Hex & ~FPSCR_FPCC) | (result << 12);
+  PPCInterpreter::ppcUpdateCR(hCore, BF, result);
+  fpuFinish(hCore, 0);
+}
+
+void PPCInterpreter::PPCInterpreter_fcmpu(PPU_STATE *hCore) {
+  X_FORM_BF_FrA_FrB;
+  FPU_CHECK_AVAILABLE;
+  fpuCompare(hCore, BF, FPR(FrA).valueAsDouble, FPR(FrB).valueAsDouble, false);
+}
+
+void PPCInterpreter::PPCInterpreter_fcmpo(PPU_STATE *hCore) {
+  X_FORM_BF_FrA_FrB;
+  FPU_CHECK_AVAILABLE;
+  fpuCompare(hCore, BF, FPR(FrA).valueAsDouble, FPR(FrB).valueAsDouble, true);
+}
+
+//
+// FPSCR
+//
+
+// Recomputes the summary bits and reloads the host mode after the guest wrote
+// the FPSCR.
+static inline void fpuFPSCRWritten(PPU_STATE *hCore, u32 RC) {
+  fpuSetExceptions(CUR_FPSCR, 0);
+  fpuApplyHostMode(CUR_FPSCR);
+  if (RC) {
+    PPCInterpreter::ppcUpdateCR(hCore, 1, GET_FPSCR >> 28);
+  }
+}
+
+void PPCInterpreter::PPCInterpreter_mffsx(PPU_STATE *hCore) {
+  X_FORM_FrD_RC;
+  FPU_CHECK_AVAILABLE;
+
+  ppcSyncFPSCR(hCore);
+  FPR(FrD).valueAsU64 = static_cast<u64>(GET_FPSCR);
+  if (RC) {
+    ppcUpdateCR(hCore, 1, GET_FPSCR >> 28);
+  }
+}
+
+void PPCInterpreter::PPCInterpreter_mtfsfx(PPU_STATE *hCore) {
+  XFL_FORM_FLM_FrB_RC;
+  FPU_CHECK_AVAILABLE;
+
+  u32 mask = 0;
+  for (u32 b = 0x80; b; b >>= 1) {
+    mask <<= 4;
+    if (FLM & b) {
+      mask |= 0xF;
+    }
+  }
+
+  // Keep what happened so far, the new value replaces it.
+  ppcSyncFPSCR(hCore);
+  SET_FPSCR(((u32)FPR(FrB).valueAsU64 & mask) | (GET_FPSCR & ~mask));
+  fpuFPSCRWritten(hCore, RC);
+}
+
+void PPCInterpreter::PPCInterpreter_mtfsfix(PPU_STATE *hCore) {
+  X_FORM_BF_U_XO_RC;
+  FPU_CHECK_AVAILABLE;
+
+  const u32 shift = (7 - BF) * 4;
+  ppcSyncFPSCR(hCore);
+  SET_FPSCR((GET_FPSCR & ~(0xF << shift)) | (U << shift));
+  fpuFPSCRWritten(hCore, RC);
+}
+
+// FEX and VX can't be set or cleared directly.
+void PPCInterpreter::PPCInterpreter_mtfsb0x(PPU_STATE *hCore) {
+  X_FORM_BT_XO_RC;
+  FPU_CHECK_AVAILABLE;
+
+  ppcSyncFPSCR(hCore);
+  SET_FPSCR(GET_FPSCR & ~(0x80000000 >> BT));
+  fpuFPSCRWritten(hCore, RC);
+}
+
+void PPCInterpreter::PPCInterpreter_mtfsb1x(PPU_STATE *hCore) {
+  X_FORM_BT_XO_RC;
+  FPU_CHECK_AVAILABLE;
+
+  ppcSyncFPSCR(hCore);
+  const u32 bit = 0x80000000 >> BT;
+  if (bit & FPSCR_EXCEPTIONS) {
+    fpuRaise(hCore, bit);
+  } else {
+    SET_FPSCR(GET_FPSCR | bit);
+  }
+  fpuFPSCRWritten(hCore, RC);
+}
+
+// CR[BF] = FPSCR[BFA], the exception bits copied are cleared.
+void PPCInterpreter::PPCInterpreter_mcrfsx(PPU_STATE *hCore) {
+  X_FORM_BF_BFA_XO;
+  FPU_CHECK_AVAILABLE;
 
-    SET_FPSCR(((u32)FPR(FrB).valueAsU64 & mask) | (GET_FPSCR & ~mask));
+  ppcSyncFPSCR(hCore);
+  const u32 shift = (7 - BFA) * 4;
+  ppcUpdateCR(hCore, BF, (GET_FPSCR >> shift) & 0xF);
+  SET_FPSCR(GET_FPSCR & ~((FPSCR_FX | FPSCR_EXCEPTIONS) & (0xF << shift)));
+  fpuSetExceptions(CUR_FPSCR, 0);
 }
@@ -0,0 +1,188 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include "PPC_Hooks.h"
+
+#include <cstring>
+#include <vector>
+
+#include <toml.hpp>
+
+#include "Base/Logging/Log.h"
+#include "PPCInterpreter.h"
+
+/*
+ *	Patch file format, one [[Patch]] table per hook:
+ *
+ *	[[Patch]]
+ *	Name = "RGH 2 for CB_A 9188 in a JRunner Normal Build"
+ *	Address = 0x200C820
+ *	Action = "SetGPR"  # SetGPR, SetGPRAfter, Skip or Breakpoint.
+ *	GPR = 3            # SetGPR/SetGPRAfter only.
+ *	Value = 0          # SetGPR/SetGPRAfter only.
+ *	Match32 = false    # Optional, only compare the low 32 bits of the address.
+ *	Enabled = true     # Optional.
+ */
+
+// Used when there's no patch file.
+static const PPC_HOOK defaultHooks[] = {
+    // RGH 2 for CB_A 9188 in a JRunner XDKBuild.
+    // {"RGH 2 CB_A 9188 XDKBuild", 0x200C870, false, PPC_HOOK_SET_GPR, 5, 0},
+    {"RGH 2 CB_A 9188 Normal Build", 0x200C820, false, PPC_HOOK_SET_GPR, 3, 0},
+    {"RGH 2 17489 Corona XDKBuild", 0x200C7F0, false, PPC_HOOK_SET_GPR, 3, 0},
+    // 3BL/4BL check bypasses for devkit 2.0.1838.1 and 2.0.2853.0.
+    // {"3BL Check Bypass 1838", 0x3004994, false, PPC_HOOK_SET_GPR, 3, 1},
+    // {"4BL Check Bypass 1838", 0x3004BF0, false, PPC_HOOK_SET_GPR, 3, 1},
+    // {"3BL Signature Bypass 2853", 0x3006488, false, PPC_HOOK_SET_GPR, 3, 0},
+    // TODO: Investigate this values FSB_CONFIG_RX_STATE - Needed to Work!
+    // These used to be written from MMURead, once the load address was
+    // already computed, so they must not run before the instruction.
+    {"CB FSB_CONFIG_RX_STATE 1", 0x1003598, false, PPC_HOOK_SET_GPR_AFTER, 11,
+     0xE},
+    {"CB FSB_CONFIG_RX_STATE 2", 0x1003644, false, PPC_HOOK_SET_GPR_AFTER, 11,
+     0x2},
+    // XDK 17.489.0 AudioChipCorder Device Detect bypass. This is not needed
+    // for older console revisions.
+    {"AudioChipCorder Detect Bypass", 0x801AF580, true, PPC_HOOK_SKIP, 0, 0},
+};
+
+// Loaded hooks, only modified while no PPU is running.
+static std::vector<PPC_HOOK> hooks;
+
+u64 PPCInterpreter::hookPages[PPC_HOOK_PAGES / 64] = {};
+
+static inline bool hookMatches(const PPC_HOOK &hook, u64 EA) {
+  return hook.match32 ? static_cast<u32>(hook.address) == static_cast<u32>(EA)
+                      : hook.address == EA;
+}
+
+// Set a host breakpoint here to stop on Breakpoint hooks.
+static void hookBreakpoint(PPU_STATE *hCore, const PPC_HOOK &hook) {
+  LOG_INFO(Xenon, "[{}]: Hit breakpoint hook '{}' at {:#x}.", hCore->ppuName,
+           hook.name, hCore->curThread->CIA);
+}
+
+void PPCInterpreter::ppcClearHooks() {
+  hooks.clear();
+  std::memset(hookPages, 0, sizeof(hookPages));
+}
+
+void PPCInterpreter::ppcAddHook(const PPC_HOOK &hook) {
+  hooks.push_back(hook);
+  const u32 page =
+      static_cast<u32>(hook.address >> 12) & (PPC_HOOK_PAGES - 1);
+  hookPages[page >> 6] |= 1ULL << (page & 63);
+}
+
+void PPCInterpreter::ppcLoadHooks(const std::filesystem::path &path) {
+  ppcClearHooks();
+
+  std::error_code error;
+  if (!std::filesystem::exists(path, error)) {
+    for (const PPC_HOOK &hook : defaultHooks) {
+      ppcAddHook(hook);
+    }
+    LOG_INFO(Xenon, "No patch file found at {}, using {} built-in patches.",
+             path.string(), hooks.size());
+    return;
+  }
+
+  toml::value data;
+  try {
+    data = toml::parse(path);
+  } catch (std::exception &ex) {
+    LOG_ERROR(Xenon, "Unable to parse patch file {}. Exception: {}",
+              path.string(), ex.what());
+    return;
+  }
+
+  if (!data.contains("Patch") || !data.at("Patch").is_array()) {
+    LOG_WARNING(Xenon, "Patch file {} has no patches.", path.string());
+    return;
+  }
+
+  for (const toml::value &patch : data.at("Patch").as_array()) {
+    if (!toml::find_or<bool>(patch, "Enabled", true)) {
+      continue;
+    }
+
+    PPC_HOOK hook;
+    hook.name = toml::find_or<std::string>(patch, "Name", "");
+    hook.address = toml::find_or<u64>(patch, "Address", 0);
+    hook.match32 = toml::find_or<bool>(patch, "Match32", false);
+
+    const std::string action = toml::find_or<std::string>(patch, "Action", "");
+    if (action == "SetGPR" || action == "SetGPRAfter") {
+      const int reg = toml::find_or<int>(patch, "GPR", -1);
+      if (reg < 0 || reg > 31) {
+        LOG_ERROR(Xenon, "Patch '{}': Invalid GPR {}.", hook.name, reg);
+        continue;
+      }
+      hook.action =
+          action == "SetGPR" ? PPC_HOOK_SET_GPR : PPC_HOOK_SET_GPR_AFTER;
+      hook.reg = static_cast<u8>(reg);
+      hook.value = toml::find_or<u64>(patch, "Value", 0);
+    } else if (action == "Skip") {
+      hook.action = PPC_HOOK_SKIP;
+    } else if (action == "Breakpoint") {
+      hook.action = PPC_HOOK_BREAKPOINT;
+    } else {
+      LOG_ERROR(Xenon, "Patch '{}': Unknown action '{}'.", hook.name, action);
+      continue;
+    }
+    ppcAddHook(hook);
+  }
+
+  LOG_INFO(Xenon, "Loaded {} patches from {}.", hooks.size(), path.string());
+}
+
+bool PPCInterpreter::ppcHasHook(u64 EA) {
+  if (!ppcHookPageHas(EA)) {
+    return false;
+  }
+  for (const PPC_HOOK &hook : hooks) {
+    if (hookMatches(hook, EA)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PPCInterpreter::ppcExecuteHooked(PPU_STATE *hCore) {
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+
+  // The instruction may branch, keep the address the hooks were matched at.
+  const u64 hookEA = thread.CIA;
+  bool skip = false;
+  bool after = false;
+  for (const PPC_HOOK &hook : hooks) {
+    if (!hookMatches(hook, hookEA)) {
+      continue;
+    }
+    switch (hook.action) {
+    case PPC_HOOK_SET_GPR:
+      thread.GPR[hook.reg] = hook.value;
+      break;
+    case PPC_HOOK_SET_GPR_AFTER:
+      after = true;
+      break;
+    case PPC_HOOK_SKIP:
+      skip = true;
+      break;
+    case PPC_HOOK_BREAKPOINT:
+      hookBreakpoint(hCore, hook);
+      break;
+    }
+  }
+
+  if (!skip) {
+    ppcDecodeInstruction(thread.CI.opcode)(hCore);
+  }
+
+  if (after) {
+    for (const PPC_HOOK &hook : hooks) {
+      if (hook.action == PPC_HOOK_SET_GPR_AFTER && hookMatches(hook, hookEA)) {
+        thread.GPR[hook.reg] = hook.value;
+      }
+    }
+  }
+}
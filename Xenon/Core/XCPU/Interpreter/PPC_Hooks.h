@@ -0,0 +1,70 @@
+// Copyright 2025 Xenon Emulator Project
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include "Base/Types.h"
+#include "Core/XCPU/PPU/PowerPC.h"
+
+/*
+ *	PPC_Hooks.h Guest code patches.
+ *
+ *	A hook is attached to an instruction address and runs right before the
+ *	instruction there is executed, or right after it for the actions that
+ *	patch its results. They're loaded from a patch file so every
+ *	bootloader/kernel build can have its own set, the built-in set is used when
+ *	there's none.
+ *
+ *	The fetch path only looks hooks up for instructions in pages that have at
+ *	least one, see ppcHookPageHas. Hooked instructions then run through
+ *	ppcExecuteHooked instead of their handler.
+ */
+
+enum PPC_HOOK_ACTION : u8 {
+  // GPR[reg] = value, then the instruction runs.
+  PPC_HOOK_SET_GPR,
+  // The instruction runs, then GPR[reg] = value. Doesn't affect the address
+  // of a load or store using GPR[reg].
+  PPC_HOOK_SET_GPR_AFTER,
+  // The instruction is skipped.
+  PPC_HOOK_SKIP,
+  // Logs the hit, useful to set a host breakpoint on. See hookBreakpoint.
+  PPC_HOOK_BREAKPOINT
+};
+
+struct PPC_HOOK {
+  std::string name;
+  u64 address = 0;
+  // Only the low 32 bits of the address are compared.
+  bool match32 = false;
+  PPC_HOOK_ACTION action = PPC_HOOK_SET_GPR;
+  u8 reg = 0;
+  u64 value = 0;
+};
+
+// Amount of pages tracked by the hook page filter.
+#define PPC_HOOK_PAGES 0x10000
+
+namespace PPCInterpreter {
+// Pages containing hooks, indexed by bits 12-27 of the EA. Different pages
+// may share a bit, that only costs a lookup.
+extern u64 hookPages[PPC_HOOK_PAGES / 64];
+
+// Replaces the hooks with the ones in the given patch file, or the built-in
+// ones if it doesn't exist. Must be done while no PPU is running.
+void ppcLoadHooks(const std::filesystem::path &path);
+void ppcAddHook(const PPC_HOOK &hook);
+void ppcClearHooks();
+
+// Quick check, false means there's no hook in the page of EA.
+inline bool ppcHookPageHas(u64 EA) {
+  const u32 page = static_cast<u32>(EA >> 12) & (PPC_HOOK_PAGES - 1);
+  return (hookPages[page >> 6] >> (page & 63)) & 1;
+}
+// Exact check.
+bool ppcHasHook(u64 EA);
+// Runs the hooks for CIA around the instruction, unless it was skipped.
+void ppcExecuteHooked(PPU_STATE *hCore);
+} // namespace PPCInterpreter
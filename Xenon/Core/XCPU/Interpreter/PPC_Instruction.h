@@ -9,6 +9,8 @@
 */
 
 #include <array>
+#include <format>
+#include <initializer_list>
 
 #include "Base/Types.h"
 #include "Base/Logging/Log.h"
@@ -19,68 +21,122 @@ constexpr u64 PPCRotateMask(u32 mb, u32 me) {
   return (mask >> (mb & 63)) | (mask << ((64 - mb) & 63));
 }
 
-constexpr u32 PPCDecode(u32 inst) {
-  return ((inst >> 26) | (inst << 6)) & 0x1FFFF; // Rotate + mask
-}
-
 namespace PPCInterpreter {
 	// Define a type alias for function pointers
 	using instructionHandler = void(*)(PPU_STATE*);
 	extern void PPCInterpreter_nop(PPU_STATE *hCore);
 	extern void PPCInterpreter_invalid(PPU_STATE *hCore);
 	extern void PPCInterpreter_known_unimplemented(const char *name, PPU_STATE *hCore);
+
+	// Decode table sizes, the tables are checked to fill them exactly.
+	#define PPC_DECODE_INDEX_COUNT 10265
+	#define PPC_DECODE_HANDLER_COUNT 510
+
+	// Two level decode table, built at compile time. The primary opcode selects a group,
+	// and the extended opcode bits of that group select a byte index into the handlers of
+	// the group. Instructions without an extended opcode have their handler right at the
+	// group start.
 	class PPCDecoder {
 		class InstrInfo {
 		public:
-			constexpr InstrInfo(u32 v, instructionHandler p, instructionHandler pRc, u32 m = 0) :
-				value(v), ptr0(p), ptrRc(pRc), magn(m)
-			{}
-
-			constexpr InstrInfo(u32 v, const instructionHandler* p, const instructionHandler* pRc, u32 m = 0) :
-				value(v), ptr0(*p), ptrRc(*pRc), magn(m)
+			constexpr InstrInfo(u32 v, instructionHandler p, u32 m = 0) :
+				value(v), ptr(p), magn(m)
 			{}
 
 			u32 value;
-			instructionHandler ptr0;
-			instructionHandler ptrRc;
+			instructionHandler ptr;
 			u32 magn; // Non-zero for "columns" (effectively, number of most significant bits "eaten")
 		};
+		struct Group {
+			// First entry of the group in indices and handlers.
+			u16 indexOffset = 0;
+			u16 handlerOffset = 0;
+			// Extended opcode bits of the group, (inst >> shift) & mask.
+			u16 mask = 0;
+			u8 shift = 0;
+		};
+		// Fills the tables through fillTable and fillTableVMX128.
+		template <typename DecodeTable>
+		friend constexpr void ppcFillDecodeTable(DecodeTable &table);
 	public:
-		PPCDecoder();
-		~PPCDecoder() = default;
-		const std::array<instructionHandler, 0x20000>& getTable() const noexcept {
-			return table;
-		}
+		constexpr PPCDecoder();
 		instructionHandler decode(u32 inst) const noexcept {
-			if (inst == 0x60000000) {
-				return &PPCInterpreter_nop;
-			}
-			return table[PPCDecode(inst)];
+			const Group &group = groups[inst >> 26];
+			return handlers[group.handlerOffset + indices[group.indexOffset + ((inst >> group.shift) & group.mask)]];
 		}
+
+		// Used table entries, only meaningful while building.
+		u32 indexCount = 0;
+		u32 handlerCount = 0;
 	private:
-		// Fast lookup table
-		std::array<instructionHandler, 0x20000> table;
+		std::array<Group, 64> groups{};
+		std::array<u8, PPC_DECODE_INDEX_COUNT> indices{};
+		std::array<instructionHandler, PPC_DECODE_HANDLER_COUNT> handlers{};
+		// Group handlers are being added to, they must be contiguous.
+		u32 lastGroup = 0;
 
-		void fillTable(u32 mainOp, u32 count, u32 sh, std::initializer_list<InstrInfo> entries) noexcept {
+		// Returns the group of an opcode with an extended opcode, creating it on first use.
+		// Index 0 of every group is invalid.
+		constexpr Group &openGroup(u32 mainOp, u32 sh, u32 mask) noexcept {
+			Group &group = groups[mainOp];
+			if (group.mask == 0) {
+				group.indexOffset = static_cast<u16>(indexCount);
+				group.handlerOffset = static_cast<u16>(handlerCount);
+				group.mask = static_cast<u16>(mask);
+				group.shift = static_cast<u8>(sh);
+				indexCount += mask + 1;
+				c_at(handlers, handlerCount++) = &PPCInterpreter_invalid;
+				lastGroup = mainOp;
+			} else if (group.shift != sh || group.mask != mask) [[unlikely]] {
+				assert_fail_debug_msg(std::format("Decode group {:#x} filled with different opcode fields", mainOp));
+			}
+			return group;
+		}
+		// Returns the index of a handler in a group, adding it if needed.
+		constexpr u8 addHandler(u32 mainOp, const Group &group, instructionHandler ptr) noexcept {
+			for (u32 i = group.handlerOffset; i < handlerCount; i++) {
+				if (handlers[i] == ptr) {
+					return static_cast<u8>(i - group.handlerOffset);
+				}
+			}
+			if (mainOp != lastGroup || handlerCount - group.handlerOffset > 0xFF) [[unlikely]] {
+				assert_fail_debug_msg(std::format("Decode group {:#x} handlers aren't contiguous or too many", mainOp));
+			}
+			c_at(handlers, handlerCount) = ptr;
+			return static_cast<u8>(handlerCount++ - group.handlerOffset);
+		}
+		constexpr void fillTable(u32 mainOp, u32 count, u32 sh, std::initializer_list<InstrInfo> entries) noexcept {
 			if (sh < 11) {
+				Group &group = openGroup(mainOp, sh, (1u << count) - 1);
 				for (const auto& v : entries) {
-					for (u32 i = 0; i < 1u << (v.magn + (11 - sh - count)); i++) {
-						for (u32 j = 0; j < 1u << sh; j++) {
-							const u32 k = (((i << (count - v.magn)) | v.value) << sh) | j;
-							c_at(table, (k << 6) | mainOp) = k & 1 ? v.ptrRc : v.ptr0;
-						}
+					const u8 idx = addHandler(mainOp, group, v.ptr);
+					for (u32 i = 0; i < 1u << v.magn; i++) {
+						c_at(indices, group.indexOffset + ((i << (count - v.magn)) | v.value)) = idx;
 					}
 				}
 			}
 			else {
 				// Main table (special case)
 				for (const auto& v : entries) {
-					for (u32 i = 0; i < 1u << 11; i++) {
-						c_at(table, i << 6 | v.value) = i & 1 ? v.ptrRc : v.ptr0;
+					groups[v.value].handlerOffset = static_cast<u16>(handlerCount);
+					c_at(handlers, handlerCount++) = v.ptr;
+				}
+			}
+		}
+		// VMX128 instructions don't have a contiguous extended opcode, only the bits in mask
+		// select the instruction, the rest are register number bits.
+		constexpr void fillTableVMX128(u32 mainOp, u32 mask, std::initializer_list<InstrInfo> entries) noexcept {
+			Group &group = openGroup(mainOp, 0, 0x7FF);
+			for (const auto& v : entries) {
+				const u8 idx = addHandler(mainOp, group, v.ptr);
+				for (u32 k = 0; k < 1u << 11; k++) {
+					if ((k & mask) == (v.value & mask)) {
+						c_at(indices, group.indexOffset + k) = idx;
 					}
 				}
 			}
 		}
 	};
+	extern const PPCDecoder ppcDecoder;
 	std::string legacy_GetOpcodeName(u32 instrData);
 } // namespace PPCInterpreter
@@ -1,7 +1,5 @@
 // Copyright 2025 Xenon Emulator Project
 
-#include <assert.h>
-
 #include "PPCInterpreter.h"
 
 //
@@ -18,8 +16,8 @@ void PPCInterpreter::PPCInterpreter_dcbst(PPU_STATE *hCore) {
 void PPCInterpreter::PPCInterpreter_dcbz(PPU_STATE *hCore) {
   X_FORM_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   EA = EA & ~(128 - 1); // Cache line size
 
   // Temporarely diasable caching.
@@ -34,45 +32,60 @@ void PPCInterpreter::PPCInterpreter_dcbz(PPU_STATE *hCore) {
 
 void PPCInterpreter::PPCInterpreter_icbi(PPU_STATE* hCore)
 {
-    // Do nothing.
+  X_FORM_rA_rB;
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+
+  if (MMUTranslateAddress(&EA, hCore, false) == false)
+    return;
+
+  bool socAccess = false;
+  EA = mmuContructEndAddressFromSecEngAddr(EA, &socAccess);
+
+  // Only main memory instructions are kept pre-decoded, drop the cache block
+  // if any of them live there.
+  if (!socAccess && EA < RAM_START_ADDR + RAM_SIZE) {
+    mmuInvalidateCodePages(EA & ~(128 - 1), 128);
+  }
 }
 
 void PPCInterpreter::PPCInterpreter_stb(PPU_STATE *hCore) {
   D_FORM_rS_rA_D;
   D = EXTS(D, 16);
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
-  MMUWrite8(hCore, EA, (u8)hCore->ppuThread[hCore->currentThread].GPR[rS]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
+  MMUWrite8(hCore, EA, (u8)hCore->curThread->GPR[rS]);
 }
 
 void PPCInterpreter::PPCInterpreter_stbu(PPU_STATE *hCore) {
   D_FORM_rS_rA_D;
   D = EXTS(D, 16);
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + D;
-  MMUWrite8(hCore, EA, (u8)hCore->ppuThread[hCore->currentThread].GPR[rS]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = hCore->curThread->GPR[rA] + D;
+  MMUWrite8(hCore, EA, (u8)hCore->curThread->GPR[rS]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_stbux(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite8(hCore, EA, (u8)hCore->ppuThread[hCore->currentThread].GPR[rS]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
+  MMUWrite8(hCore, EA, (u8)hCore->curThread->GPR[rS]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_stbx(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite8(hCore, EA, (u8)hCore->ppuThread[hCore->currentThread].GPR[rS]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite8(hCore, EA, (u8)hCore->curThread->GPR[rS]);
 }
 
 //
@@ -82,48 +95,48 @@ void PPCInterpreter::PPCInterpreter_stbx(PPU_STATE *hCore) {
 void PPCInterpreter::PPCInterpreter_sth(PPU_STATE *hCore) {
   D_FORM_rS_rA_D;
   D = EXTS(D, 16);
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
-  MMUWrite16(hCore, EA, (u16)hCore->ppuThread[hCore->currentThread].GPR[rS]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
+  MMUWrite16(hCore, EA, (u16)hCore->curThread->GPR[rS]);
 }
 
 void PPCInterpreter::PPCInterpreter_sthbrx(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   MMUWrite16(
       hCore, EA,
-      std::byteswap<u16>((u16)hCore->ppuThread[hCore->currentThread].GPR[rS]));
+      std::byteswap<u16>((u16)hCore->curThread->GPR[rS]));
 }
 
 void PPCInterpreter::PPCInterpreter_sthu(PPU_STATE *hCore) {
   D_FORM_rS_rA_D;
   D = EXTS(D, 16);
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + D;
-  MMUWrite16(hCore, EA, (u16)hCore->ppuThread[hCore->currentThread].GPR[rS]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = hCore->curThread->GPR[rA] + D;
+  MMUWrite16(hCore, EA, (u16)hCore->curThread->GPR[rS]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_sthux(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite16(hCore, EA, (u16)hCore->ppuThread[hCore->currentThread].GPR[rS]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite16(hCore, EA, (u16)hCore->curThread->GPR[rS]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_sthx(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite16(hCore, EA, (u16)hCore->ppuThread[hCore->currentThread].GPR[rS]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite16(hCore, EA, (u16)hCore->curThread->GPR[rS]);
 }
 
 //
@@ -136,7 +149,7 @@ void PPCInterpreter::PPCInterpreter_stswi(PPU_STATE *hCore) {
 
   u64 EA = 0;
   if (rA != 0) {
-    EA = hCore->ppuThread[hCore->currentThread].GPR[rA];
+    EA = hCore->curThread->GPR[rA];
   }
 
   u32 n = 32;
@@ -152,7 +165,7 @@ void PPCInterpreter::PPCInterpreter_stswi(PPU_STATE *hCore) {
       r &= 31;
     }
     MMUWrite8(hCore, EA,
-              (hCore->ppuThread[hCore->currentThread].GPR[r] >> (24 - i)) &
+              (hCore->curThread->GPR[r] >> (24 - i)) &
                   0xFF);
 
     i += 8;
@@ -168,10 +181,10 @@ void PPCInterpreter::PPCInterpreter_stmw(PPU_STATE* hCore)
     D_FORM_rD_rA_D;
     D = EXTS(D, 16);
 
-    u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+    u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
     for (u32 idx = rD; idx < 32; ++idx, EA += 4)
     {
-        MMUWrite32(hCore, EA, static_cast<u32>(hCore->ppuThread[hCore->currentThread].GPR[idx]));         
+        MMUWrite32(hCore, EA, static_cast<u32>(hCore->curThread->GPR[idx]));         
     }
 }
 
@@ -182,57 +195,48 @@ void PPCInterpreter::PPCInterpreter_stmw(PPU_STATE* hCore)
 void PPCInterpreter::PPCInterpreter_stw(PPU_STATE *hCore) {
   D_FORM_rS_rA_D;
   D = EXTS(D, 16);
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
-  MMUWrite32(hCore, EA, (u32)hCore->ppuThread[hCore->currentThread].GPR[rS]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
+  MMUWrite32(hCore, EA, (u32)hCore->curThread->GPR[rS]);
 }
 
 void PPCInterpreter::PPCInterpreter_stwbrx(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   MMUWrite32(hCore, EA,
              std::byteswap<u32>(static_cast<u32>(
-                 hCore->ppuThread[hCore->currentThread].GPR[rS])));
+                 hCore->curThread->GPR[rS])));
 }
 
 void PPCInterpreter::PPCInterpreter_stwcx(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u64 RA = EA;
   u32 CR = 0;
 
   // If address is not aligned by 4, then we must issue a trap.
 
-  if (hCore->ppuThread[hCore->currentThread].SPR.XER.SO)
+  if (hCore->curThread->XER.SO)
     BSET(CR, 4, CR_BIT_SO);
 
-  if (hCore->ppuThread[hCore->currentThread].ppuRes->V) {
+  if (hCore->curThread->ppuRes->resAddr.load(
+          std::memory_order_relaxed) &
+      XENON_RES_VALID) {
     // Translate address
     MMUTranslateAddress(&RA, hCore, true);
-    if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-        hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+    if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+        hCore->curThread->exceptReg & PPU_EX_DATASTOR)
       return;
 
-    intXCPUContext->xenonRes.AcquireLock();
-    if (hCore->ppuThread[hCore->currentThread].ppuRes->V) {
-      if (hCore->ppuThread[hCore->currentThread].ppuRes->resAddr == RA) {
-        // std::cout << " * Res OK, storing data 0x" <<
-        // (u32)hCore->ppuThread[hCore->currentThread].GPR[rS] << std::endl;
-        bool soc = false;
-        u32 data = std::byteswap<u32>(
-            (u32)hCore->ppuThread[hCore->currentThread].GPR[rS]);
-        RA = mmuContructEndAddressFromSecEngAddr(RA, &soc);
-        sysBus->Write(RA, data, 4);
-        intXCPUContext->xenonRes.Check(RA);
-        BSET(CR, 4, CR_BIT_EQ);
-      } else {
-        intXCPUContext->xenonRes.Decrement();
-        hCore->ppuThread[hCore->currentThread].ppuRes->V = false;
-      }
+    bool soc = false;
+    RA = mmuContructEndAddressFromSecEngAddr(RA, &soc);
+    u32 data = std::byteswap<u32>(
+        (u32)hCore->curThread->GPR[rS]);
+    if (mmuStoreConditional(hCore->curThread->ppuRes, RA, data, 4)) {
+      BSET(CR, 4, CR_BIT_EQ);
     }
-    intXCPUContext->xenonRes.ReleaseLock();
   }
 
   ppcUpdateCR(hCore, 0, CR);
@@ -241,32 +245,32 @@ void PPCInterpreter::PPCInterpreter_stwcx(PPU_STATE *hCore) {
 void PPCInterpreter::PPCInterpreter_stwu(PPU_STATE *hCore) {
   D_FORM_rS_rA_D;
   D = EXTS(D, 16);
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + D;
-  MMUWrite32(hCore, EA, (u32)hCore->ppuThread[hCore->currentThread].GPR[rS]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = hCore->curThread->GPR[rA] + D;
+  MMUWrite32(hCore, EA, (u32)hCore->curThread->GPR[rS]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_stwux(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite32(hCore, EA, (u32)hCore->ppuThread[hCore->currentThread].GPR[rS]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
+  MMUWrite32(hCore, EA, (u32)hCore->curThread->GPR[rS]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_stwx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite32(hCore, EA, (u32)hCore->ppuThread[hCore->currentThread].GPR[rD]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite32(hCore, EA, (u32)hCore->curThread->GPR[rD]);
 }
 
 //
@@ -276,43 +280,37 @@ void PPCInterpreter::PPCInterpreter_stwx(PPU_STATE *hCore) {
 void PPCInterpreter::PPCInterpreter_std(PPU_STATE *hCore) {
   DS_FORM_rS_rA_DS;
   DS = EXTS(DS, 14) << 2;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + DS;
-  MMUWrite64(hCore, EA, hCore->ppuThread[hCore->currentThread].GPR[rS]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + DS;
+  MMUWrite64(hCore, EA, hCore->curThread->GPR[rS]);
 }
 
 void PPCInterpreter::PPCInterpreter_stdcx(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u64 RA = EA;
   u32 CR = 0;
 
-  if (hCore->ppuThread[hCore->currentThread].SPR.XER.SO)
+  if (hCore->curThread->XER.SO)
     BSET(CR, 4, CR_BIT_SO);
 
   // If address is not aligned by 4, the we must issue a trap.
-  if (hCore->ppuThread[hCore->currentThread].ppuRes->V) {
+  if (hCore->curThread->ppuRes->resAddr.load(
+          std::memory_order_relaxed) &
+      XENON_RES_VALID) {
     MMUTranslateAddress(&RA, hCore, true);
-    if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-        hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+    if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+        hCore->curThread->exceptReg & PPU_EX_DATASTOR)
       return;
 
-    intXCPUContext->xenonRes.AcquireLock();
-    if (hCore->ppuThread[hCore->currentThread].ppuRes->V) {
-      if (hCore->ppuThread[hCore->currentThread].ppuRes->resAddr == (RA & ~7)) {
-        u64 data =
-            std::byteswap<u64>(hCore->ppuThread[hCore->currentThread].GPR[rS]);
-        bool soc = false;
-        RA = mmuContructEndAddressFromSecEngAddr(RA, &soc);
-        sysBus->Write(RA, data, 8);
-        BSET(CR, 4, CR_BIT_EQ);
-      } else {
-        intXCPUContext->xenonRes.Decrement();
-        hCore->ppuThread[hCore->currentThread].ppuRes->V = false;
-      }
+    bool soc = false;
+    RA = mmuContructEndAddressFromSecEngAddr(RA, &soc);
+    u64 data =
+        std::byteswap<u64>(hCore->curThread->GPR[rS]);
+    if (mmuStoreConditional(hCore->curThread->ppuRes, RA, data, 8)) {
+      BSET(CR, 4, CR_BIT_EQ);
     }
-    intXCPUContext->xenonRes.ReleaseLock();
   }
 
   ppcUpdateCR(hCore, 0, CR);
@@ -321,32 +319,32 @@ void PPCInterpreter::PPCInterpreter_stdcx(PPU_STATE *hCore) {
 void PPCInterpreter::PPCInterpreter_stdu(PPU_STATE *hCore) {
   DS_FORM_rD_rA_DS;
   DS = EXTS(DS, 14) << 2;
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + DS;
-  MMUWrite64(hCore, EA, hCore->ppuThread[hCore->currentThread].GPR[rD]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = hCore->curThread->GPR[rA] + DS;
+  MMUWrite64(hCore, EA, hCore->curThread->GPR[rD]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_stdux(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite64(hCore, EA, hCore->ppuThread[hCore->currentThread].GPR[rS]);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite64(hCore, EA, hCore->curThread->GPR[rS]);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_stdx(PPU_STATE *hCore) {
   X_FORM_rS_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
-  MMUWrite64(hCore, EA, hCore->ppuThread[hCore->currentThread].GPR[rS]);
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite64(hCore, EA, hCore->curThread->GPR[rS]);
 }
 
 //
@@ -354,13 +352,144 @@ void PPCInterpreter::PPCInterpreter_stdx(PPU_STATE *hCore) {
 //
 void PPCInterpreter::PPCInterpreter_stfd(PPU_STATE *hCore) {
   D_FORM_FrS_rA_D;
+  D = EXTS(D, 16);
 
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
+  MMUWrite64(hCore, EA,
+             hCore->curThread->FPR[FrS].valueAsU64);
+}
+
+void PPCInterpreter::PPCInterpreter_stfdu(PPU_STATE *hCore) {
+  D_FORM_FrS_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
 
+  u64 EA = hCore->curThread->GPR[rA] + D;
   MMUWrite64(hCore, EA,
-             hCore->ppuThread[hCore->currentThread].FPR[FrS].valueAsU64);
+             hCore->curThread->FPR[FrS].valueAsU64);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->GPR[rA] = EA;
+}
+
+void PPCInterpreter::PPCInterpreter_stfdux(PPU_STATE *hCore) {
+  X_FORM_FrS_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
+  MMUWrite64(hCore, EA,
+             hCore->curThread->FPR[FrS].valueAsU64);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->GPR[rA] = EA;
+}
+
+void PPCInterpreter::PPCInterpreter_stfdx(PPU_STATE *hCore) {
+  X_FORM_FrS_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite64(hCore, EA,
+             hCore->curThread->FPR[FrS].valueAsU64);
+}
+
+void PPCInterpreter::PPCInterpreter_stfiwx(PPU_STATE *hCore) {
+  X_FORM_FrS_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite32(hCore, EA,
+             static_cast<u32>(
+                 hCore->curThread->FPR[FrS].valueAsU64));
+}
+
+void PPCInterpreter::PPCInterpreter_stfs(PPU_STATE *hCore) {
+  D_FORM_FrS_rA_D;
+  D = EXTS(D, 16);
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
+  MMUWrite32(hCore, EA,
+             ppcDoubleToSingle(
+                 hCore->curThread->FPR[FrS].valueAsU64));
+}
+
+void PPCInterpreter::PPCInterpreter_stfsu(PPU_STATE *hCore) {
+  D_FORM_FrS_rA_D;
+  D = EXTS(D, 16);
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = hCore->curThread->GPR[rA] + D;
+  MMUWrite32(hCore, EA,
+             ppcDoubleToSingle(
+                 hCore->curThread->FPR[FrS].valueAsU64));
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->GPR[rA] = EA;
+}
+
+void PPCInterpreter::PPCInterpreter_stfsux(PPU_STATE *hCore) {
+  X_FORM_FrS_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
+  MMUWrite32(hCore, EA,
+             ppcDoubleToSingle(
+                 hCore->curThread->FPR[FrS].valueAsU64));
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->GPR[rA] = EA;
+}
+
+void PPCInterpreter::PPCInterpreter_stfsx(PPU_STATE *hCore) {
+  X_FORM_FrS_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  MMUWrite32(hCore, EA,
+             ppcDoubleToSingle(
+                 hCore->curThread->FPR[FrS].valueAsU64));
 }
 
 //
@@ -371,58 +500,58 @@ void PPCInterpreter::PPCInterpreter_lbz(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
   u8 data = MMURead8(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lbz: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_lbzu(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + D;
+  u64 EA = hCore->curThread->GPR[rA] + D;
   u8 data = MMURead8(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lbzu: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_lbzux(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
   u8 data = MMURead8(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lbzux: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_lbzx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u8 data = MMURead8(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lbzx: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 //
@@ -432,112 +561,112 @@ void PPCInterpreter::PPCInterpreter_lbzx(PPU_STATE *hCore) {
 void PPCInterpreter::PPCInterpreter_lha(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
   u16 unsignedWord = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lha: Addr 0x" << EA << " data = 0x" << unsignedWord << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = EXTS(unsignedWord, 16);
+  hCore->curThread->GPR[rD] = EXTS(unsignedWord, 16);
 }
 
 void PPCInterpreter::PPCInterpreter_lhau(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + D;
+  u64 EA = hCore->curThread->GPR[rA] + D;
   u16 unsignedWord = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lhau: Addr 0x" << EA << " data = 0x" << unsignedWord << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = EXTS(unsignedWord, 16);
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = EXTS(unsignedWord, 16);
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_lhax(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u16 unsignedWord = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lhax: Addr 0x" << EA << " data = 0x" << unsignedWord << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = EXTS(unsignedWord, 16);
+  hCore->curThread->GPR[rD] = EXTS(unsignedWord, 16);
 }
 
 void PPCInterpreter::PPCInterpreter_lhbrx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
 
   u16 data = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lhbrx: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = std::byteswap<u16>(data);
+  hCore->curThread->GPR[rD] = std::byteswap<u16>(data);
 }
 
 void PPCInterpreter::PPCInterpreter_lhz(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
   u16 data = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_lhzu(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + D;
+  u64 EA = hCore->curThread->GPR[rA] + D;
   u16 data = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lhzu: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_lhzux(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
   u16 data = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lhzux: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_lhzx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u16 data = MMURead16(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
   DBG_LOAD("lhzx: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 //
@@ -550,7 +679,7 @@ void PPCInterpreter::PPCInterpreter_lswi(PPU_STATE *hCore) {
 
   u64 EA = 0;
   if (rA != 0) {
-    EA = hCore->ppuThread[hCore->currentThread].GPR[rA];
+    EA = hCore->curThread->GPR[rA];
   }
 
   u32 n = 32;
@@ -565,12 +694,12 @@ void PPCInterpreter::PPCInterpreter_lswi(PPU_STATE *hCore) {
     if (i == 0) {
       r++;
       r &= 31;
-      hCore->ppuThread[hCore->currentThread].GPR[r] = 0;
+      hCore->curThread->GPR[r] = 0;
     }
 
     const u32 temp_value = MMURead8(hCore, EA) << (24 - i);
 
-    hCore->ppuThread[hCore->currentThread].GPR[r] |= temp_value;
+    hCore->curThread->GPR[r] |= temp_value;
 
     i += 8;
     if (i == 32)
@@ -585,10 +714,10 @@ void PPCInterpreter::PPCInterpreter_lmw(PPU_STATE* hCore)
     D_FORM_rD_rA_D;
     D = EXTS(D, 16);
 
-    u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+    u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
     for (u32 idx = rD; idx < 32; ++idx, EA += 4)
     {
-        hCore->ppuThread[hCore->currentThread].GPR[idx] =
+        hCore->curThread->GPR[idx] =
             MMURead32(hCore, EA);
     }
 }
@@ -601,125 +730,130 @@ void PPCInterpreter::PPCInterpreter_lwa(PPU_STATE *hCore) {
   DS_FORM_rD_rA_DS;
   DS = EXTS(DS, 14) << 2;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + DS;
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + DS;
   u32 unsignedWord = MMURead32(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lwa: Addr 0x" << EA << " data = 0x" << unsignedWord << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = EXTS(unsignedWord, 32);
+  hCore->curThread->GPR[rD] = EXTS(unsignedWord, 32);
 }
 
 void PPCInterpreter::PPCInterpreter_lwax(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u32 unsignedWord = MMURead32(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lwax: Addr 0x" << EA << " data = 0x" << unsignedWord << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = EXTS(unsignedWord, 32);
+  hCore->curThread->GPR[rD] = EXTS(unsignedWord, 32);
 }
 
 void PPCInterpreter::PPCInterpreter_lwarx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
 
   // If address is not aligned by 4, the we must issue a trap.
 
   u64 RA = EA;
   MMUTranslateAddress(&RA, hCore, false);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].ppuRes->V = true;
-  hCore->ppuThread[hCore->currentThread].ppuRes->resAddr = RA;
-  intXCPUContext->xenonRes.Increment();
+  // Reservations are tagged with the real address stores are checked with.
+  bool soc = false;
+  RA = mmuContructEndAddressFromSecEngAddr(RA, &soc);
+  intXCPUContext->xenonRes.Reserve(hCore->curThread->ppuRes, RA);
   u32 data = MMURead32(hCore, EA);
 
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
+  hCore->curThread->ppuRes->resDataAddr = RA;
+  hCore->curThread->ppuRes->resData = std::byteswap<u32>(data);
+  hCore->curThread->ppuRes->resDataSize = 4;
+
   DBG_LOAD("lwarx: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_lwbrx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u32 data = MMURead32(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = std::byteswap<u32>(data);
+  hCore->curThread->GPR[rD] = std::byteswap<u32>(data);
 }
 
 void PPCInterpreter::PPCInterpreter_lwz(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
   u32 data = MMURead32(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_lwzu(PPU_STATE *hCore) {
   D_FORM_rD_rA_D;
   D = EXTS(D, 16);
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + D;
+  u64 EA = hCore->curThread->GPR[rA] + D;
   u32 data = MMURead32(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lwzu: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_lwzux(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
 
   u32 data = MMURead32(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("lwzux: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_lwzx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u32 data = MMURead32(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
   DBG_LOAD("lwzx: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 //
@@ -730,129 +864,249 @@ void PPCInterpreter::PPCInterpreter_ld(PPU_STATE *hCore) {
   DS_FORM_rD_rA_DS;
   DS = EXTS(DS, 14) << 2;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + DS;
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + DS;
   u64 data = MMURead64(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("ld: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_ldbrx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-    hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+    hCore->curThread->GPR[rB];
 
   u64 RA = EA & ~7;
 
   u64 data = MMURead64(hCore, EA);
 
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-    hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+    hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("ldbrx: Addr 0x" << std::hex << EA << " data = 0x" << std::hex << (int)data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_ldarx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
 
   // if not aligned by 8 trap
 
   u64 RA = EA & ~7;
   MMUTranslateAddress(&RA, hCore, false);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
-  hCore->ppuThread[hCore->currentThread].ppuRes->resAddr = RA;
-  hCore->ppuThread[hCore->currentThread].ppuRes->V = true;
-  intXCPUContext->xenonRes.Increment();
+  // Reservations are tagged with the real address stores are checked with.
+  bool soc = false;
+  RA = mmuContructEndAddressFromSecEngAddr(RA, &soc);
+  intXCPUContext->xenonRes.Reserve(hCore->curThread->ppuRes, RA);
 
   u64 data = MMURead64(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
+
+  hCore->curThread->ppuRes->resDataAddr = RA;
+  hCore->curThread->ppuRes->resData = std::byteswap<u64>(data);
+  hCore->curThread->ppuRes->resDataSize = 8;
   DBG_LOAD("ldarx:Addr 0x" << std::hex << EA << " data = 0x" << std::hex << (int)data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_ldu(PPU_STATE *hCore) {
   DS_FORM_rD_rA_DS;
   DS = EXTS(DS, 14) << 2;
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] + DS;
+  u64 EA = hCore->curThread->GPR[rA] + DS;
   u64 data = MMURead64(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("ldu: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_ldux(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = hCore->ppuThread[hCore->currentThread].GPR[rA] +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
   u64 data = MMURead64(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("ldux: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
-  hCore->ppuThread[hCore->currentThread].GPR[rA] = EA;
+  hCore->curThread->GPR[rD] = data;
+  hCore->curThread->GPR[rA] = EA;
 }
 
 void PPCInterpreter::PPCInterpreter_ldx(PPU_STATE *hCore) {
   X_FORM_rD_rA_rB;
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) +
-           hCore->ppuThread[hCore->currentThread].GPR[rB];
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
   u64 data = MMURead64(hCore, EA);
-  if (hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASEGM ||
-      hCore->ppuThread[hCore->currentThread].exceptReg & PPU_EX_DATASTOR)
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
     return;
 
   DBG_LOAD("ldx: Addr 0x" << EA << " data = 0x" << data << std::endl;)
-  hCore->ppuThread[hCore->currentThread].GPR[rD] = data;
+  hCore->curThread->GPR[rD] = data;
 }
 
 void PPCInterpreter::PPCInterpreter_lfd(PPU_STATE *hCore) {
+  D_FORM_FrD_rA_D;
+  D = EXTS(D, 16);
 
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
+  u64 data = MMURead64(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->FPR[FrD].valueAsU64 = data;
+}
+
+void PPCInterpreter::PPCInterpreter_lfdu(PPU_STATE *hCore) {
   D_FORM_FrD_rA_D;
   D = EXTS(D, 16);
 
-  // Check if Floating Point is available.
-  assert(hCore->ppuThread[hCore->currentThread].SPR.MSR.FP == 1);
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = hCore->curThread->GPR[rA] + D;
+  u64 data = MMURead64(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->FPR[FrD].valueAsU64 = data;
+  hCore->curThread->GPR[rA] = EA;
+}
+
+void PPCInterpreter::PPCInterpreter_lfdux(PPU_STATE *hCore) {
+  X_FORM_FrD_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
+  u64 data = MMURead64(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
 
-  hCore->ppuThread[hCore->currentThread].FPR[FrD].valueAsDouble =
-      static_cast<double>(MMURead64(hCore, EA));
+  hCore->curThread->FPR[FrD].valueAsU64 = data;
+  hCore->curThread->GPR[rA] = EA;
+}
+
+void PPCInterpreter::PPCInterpreter_lfdx(PPU_STATE *hCore) {
+  X_FORM_FrD_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  u64 data = MMURead64(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->FPR[FrD].valueAsU64 = data;
 }
 
 void PPCInterpreter::PPCInterpreter_lfs(PPU_STATE *hCore) {
   D_FORM_FrD_rA_D;
   D = EXTS(D, 16);
 
-  // Check if Floating Point is available.
-  assert(hCore->ppuThread[hCore->currentThread].SPR.MSR.FP == 1);
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) + D;
+  u32 data = MMURead32(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->FPR[FrD].valueAsU64 =
+      ppcSingleToDouble(data);
+}
+
+void PPCInterpreter::PPCInterpreter_lfsu(PPU_STATE *hCore) {
+  D_FORM_FrD_rA_D;
+  D = EXTS(D, 16);
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = hCore->curThread->GPR[rA] + D;
+  u32 data = MMURead32(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->FPR[FrD].valueAsU64 =
+      ppcSingleToDouble(data);
+  hCore->curThread->GPR[rA] = EA;
+}
+
+void PPCInterpreter::PPCInterpreter_lfsux(PPU_STATE *hCore) {
+  X_FORM_FrD_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = hCore->curThread->GPR[rA] +
+           hCore->curThread->GPR[rB];
+  u32 data = MMURead32(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
+
+  hCore->curThread->FPR[FrD].valueAsU64 =
+      ppcSingleToDouble(data);
+  hCore->curThread->GPR[rA] = EA;
+}
 
-  u64 EA = (rA ? hCore->ppuThread[hCore->currentThread].GPR[rA] : 0) + D;
+void PPCInterpreter::PPCInterpreter_lfsx(PPU_STATE *hCore) {
+  X_FORM_FrD_rA_rB;
+
+  if (!ppcFpuAvailable(hCore)) {
+    return;
+  }
+
+  u64 EA = (rA ? hCore->curThread->GPR[rA] : 0) +
+           hCore->curThread->GPR[rB];
+  u32 data = MMURead32(hCore, EA);
+  if (hCore->curThread->exceptReg & PPU_EX_DATASEGM ||
+      hCore->curThread->exceptReg & PPU_EX_DATASTOR)
+    return;
 
-  SFPRegister singlePresFP;
-  singlePresFP.valueAsU32 = MMURead32(hCore, EA);
-  hCore->ppuThread[hCore->currentThread].FPR[FrD].valueAsDouble =
-      (double)singlePresFP.valueAsFloat;
+  hCore->curThread->FPR[FrD].valueAsU64 =
+      ppcSingleToDouble(data);
 }
@@ -3,6 +3,12 @@
 #include "PPCInterpreter.h"
 #include "Core/XCPU/PostBus/PostBus.h"
 
+#include "Base/Arch.h"
+
+#ifdef ARCH_X86_64
+#include <emmintrin.h>
+#endif
+
 //
 // Xbox 360 Memory map, info taken from various sources.
 //
@@ -87,9 +93,36 @@ struct PPC_HPTE64 {
 };
 
 void PPCInterpreter::PPCInterpreter_slbia(PPU_STATE *hCore) {
-  for (auto &slbEntry : hCore->ppuThread[hCore->currentThread].SLB) {
+  for (auto &slbEntry : hCore->curThread->SLB) {
     slbEntry.V = 0;
   }
+  memset(hCore->curThread->slbHash, 0,
+         sizeof(hCore->curThread->slbHash));
+  mmuInvalidateErats(hCore, hCore->currentThread);
+}
+
+// Searches the SLB of the current thread for a valid entry of the given ESID.
+SLBEntry *PPCInterpreter::mmuSearchSlbEntry(PPU_STATE *hCore, u64 ESID) {
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+  u8 &hashSlot = thread.slbHash[PPU_SLB_HASH(ESID)];
+
+  // Most translations hit the entry last used for this hash.
+  if (hashSlot != 0) {
+    SLBEntry &slbEntry = thread.SLB[hashSlot - 1];
+    if (slbEntry.V && slbEntry.ESID == ESID) {
+      return &slbEntry;
+    }
+  }
+
+  // Hash collision or stale slot, search the whole SLB.
+  for (u8 slbIdx = 0; slbIdx < PPU_SLB_ENTRIES; slbIdx++) {
+    SLBEntry &slbEntry = thread.SLB[slbIdx];
+    if (slbEntry.V && slbEntry.ESID == ESID) {
+      hashSlot = slbIdx + 1;
+      return &slbEntry;
+    }
+  }
+  return nullptr;
 }
 
 void PPCInterpreter::PPCInterpreter_tlbiel(PPU_STATE *hCore) {
@@ -97,9 +130,9 @@ void PPCInterpreter::PPCInterpreter_tlbiel(PPU_STATE *hCore) {
 
   // The PPU adds two new fields to this instruction, them being LP abd IS.
 
-  bool LP = (hCore->ppuThread[hCore->currentThread].GPR[rB] & 0x1000) >> 12;
+  bool LP = (hCore->curThread->GPR[rB] & 0x1000) >> 12;
   bool invalSelector =
-      (hCore->ppuThread[hCore->currentThread].GPR[rB] & 0x800) >> 11;
+      (hCore->curThread->GPR[rB] & 0x800) >> 11;
   u8 p = mmuGetPageSize(hCore, L, LP);
   u64 VA, VPN = 0;
 
@@ -107,8 +140,9 @@ void PPCInterpreter::PPCInterpreter_tlbiel(PPU_STATE *hCore) {
     // The TLB is as selective as possible when invalidating TLB entries.The
     // invalidation match criteria is VPN[38:79 - p], L, LP, and LPID.
 
-    VA = hCore->ppuThread[hCore->currentThread].GPR[rB];
+    VA = hCore->curThread->GPR[rB];
 
+    auto coreLock = ppcLockCore(hCore);
     if (VA > 0x7FFFFFFF) {
       VPN = (VA >> 16) & ~0x7F;
     } else if (VA > 0x20000000) {
@@ -120,67 +154,38 @@ void PPCInterpreter::PPCInterpreter_tlbiel(PPU_STATE *hCore) {
       VPN = (VA >> 16) & ~0xF;
     }
 
-    for (auto &tlbEntry : hCore->TLB.tlbSet0) {
-      if (tlbEntry.V && tlbEntry.VPN == VPN && tlbEntry.p == p) {
-        tlbEntry.V = 0;
-      }
-    }
-    for (auto &tlbEntry : hCore->TLB.tlbSet1) {
-      if (tlbEntry.V && tlbEntry.VPN == VPN && tlbEntry.p == p) {
-        tlbEntry.V = 0;
-      }
-    }
-    for (auto &tlbEntry : hCore->TLB.tlbSet2) {
-      if (tlbEntry.V && tlbEntry.VPN == VPN && tlbEntry.p == p) {
-        tlbEntry.V = 0;
-      }
-    }
-    for (auto &tlbEntry : hCore->TLB.tlbSet3) {
-      if (tlbEntry.V && tlbEntry.VPN == VPN && tlbEntry.p == p) {
-        tlbEntry.V = 0;
+    for (u16 tlbIndex = 0; tlbIndex < PPU_TLB_INDEXES; tlbIndex++) {
+      for (u8 way = 0; way < PPU_TLB_WAYS; way++) {
+        u64 &tag = hCore->TLB.tag[tlbIndex][way];
+        if ((tag & PPU_TLB_TAG_VALID) &&
+            (tag >> PPU_TLB_TAG_VPN_SHIFT) == VPN &&
+            static_cast<u8>(tag >> PPU_TLB_TAG_P_SHIFT) == p) {
+          tag = 0;
+        }
       }
     }
   } else {
     // Index to one of the 256 rows of the tlb. Possible entire tlb
     // invalidation.
-    u8 tlbCongruenceClass = 0;
     u64 rb_44_51 =
-        (hCore->ppuThread[hCore->currentThread].GPR[rB] & 0xFF000) >> 12;
-
-    hCore->TLB.tlbSet0[rb_44_51].V = false;
-    hCore->TLB.tlbSet0[rb_44_51].VPN = 0;
-    hCore->TLB.tlbSet0[rb_44_51].RPN = 0;
-    hCore->TLB.tlbSet0[rb_44_51].L = false;
-    hCore->TLB.tlbSet0[rb_44_51].LP = 0;
-    hCore->TLB.tlbSet0[rb_44_51].p = 0;
-
-    hCore->TLB.tlbSet1[rb_44_51].V = false;
-    hCore->TLB.tlbSet1[rb_44_51].VPN = 0;
-    hCore->TLB.tlbSet1[rb_44_51].RPN = 0;
-    hCore->TLB.tlbSet1[rb_44_51].L = false;
-    hCore->TLB.tlbSet1[rb_44_51].LP = 0;
-    hCore->TLB.tlbSet1[rb_44_51].p = 0;
-
-    hCore->TLB.tlbSet2[rb_44_51].V = false;
-    hCore->TLB.tlbSet2[rb_44_51].VPN = 0;
-    hCore->TLB.tlbSet2[rb_44_51].RPN = 0;
-    hCore->TLB.tlbSet2[rb_44_51].L = false;
-    hCore->TLB.tlbSet2[rb_44_51].LP = 0;
-    hCore->TLB.tlbSet2[rb_44_51].p = 0;
-
-    hCore->TLB.tlbSet3[rb_44_51].V = false;
-    hCore->TLB.tlbSet3[rb_44_51].VPN = 0;
-    hCore->TLB.tlbSet3[rb_44_51].RPN = 0;
-    hCore->TLB.tlbSet3[rb_44_51].L = false;
-    hCore->TLB.tlbSet3[rb_44_51].LP = 0;
-    hCore->TLB.tlbSet3[rb_44_51].p = 0;
+        (hCore->curThread->GPR[rB] & 0xFF000) >> 12;
+
+    auto coreLock = ppcLockCore(hCore);
+    for (u8 way = 0; way < PPU_TLB_WAYS; way++) {
+      hCore->TLB.tag[rb_44_51][way] = 0;
+      hCore->TLB.RPN[rb_44_51][way] = 0;
+    }
   }
+
+  // The TLB is shared by both threads, so are its translations.
+  mmuInvalidateErats(hCore, PPU_THREAD_BOTH);
 }
 
 void PPCInterpreter::PPCInterpreter_tlbie(PPU_STATE* hCore)
 {
-    // Do nothing.
     LOG_INFO(Xenon, "tlbie");
+    // tlbie is broadcast, every thread on the chip must drop its ERAT's.
+    intXCPUContext->eratGeneration.fetch_add(1, std::memory_order_relaxed);
 }
 
 void PPCInterpreter::PPCInterpreter_tlbsync(PPU_STATE* hCore)
@@ -246,6 +251,97 @@ u8 PPCInterpreter::mmuGetPageSize(PPU_STATE *hCore, bool L, u8 LP) {
   return p;
 }
 
+// Index of the TLB congruence class a VA maps to for a given page size.
+static u16 mmuGetTlbIndex(u64 VA, u8 p) {
+  // 4 Kb - (VA[52:55] xor VA[60:63]) || VA[64:67]
+  // 64 Kb - (VA[52:55] xor VA[56:59]) || VA[60:63]
+  // 16MB - VA[48:55]
+
+  // 52-55 bits of 80 VA
+  u16 bits36_39 = static_cast<u16>(QGET(VA, 36, 39));
+  // 56-59 bits of 80 VA
+  u16 bits40_43 = static_cast<u16>(QGET(VA, 40, 43));
+  // 60-63 bits of 80 VA
+  u16 bits44_47 = static_cast<u16>(QGET(VA, 44, 47));
+  // 64-67 bits of 80 VA
+  u16 bits48_51 = static_cast<u16>(QGET(VA, 48, 51));
+  // 48-55 bits of 80 VA
+  u16 bits32_39 = static_cast<u16>(QGET(VA, 32, 39));
+
+  switch (p) {
+  case MMU_PAGE_SIZE_64KB:
+    return ((bits36_39 ^ bits40_43) << 4 | bits44_47);
+  case MMU_PAGE_SIZE_16MB:
+    if (bits32_39 < 0x80 && bits32_39 > 0x20)
+      return bits32_39 & 0xF;
+    else if (bits32_39 < 0x20)
+      return bits32_39;
+    else
+      return (bits40_43 << 4) ^ bits44_47;
+  default:
+    // p = 12 bits, 4KB
+    return ((bits36_39 ^ bits44_47) << 4 | bits48_51);
+  }
+}
+
+// Compares the tags of the 4 ways of a TLB index against a given tag, the C
+// bit is left out. Returns a bitmask of the matching ways.
+static u8 mmuMatchTlbWays(const u64 *tags, u64 tag) {
+#ifdef ARCH_X86_64
+  const __m128i tagVec = _mm_set1_epi64x(static_cast<s64>(tag));
+  const __m128i cBits = _mm_set1_epi64x(PPU_TLB_TAG_C);
+  const __m128i ways01 = _mm_cmpeq_epi32(
+      _mm_andnot_si128(cBits,
+                       _mm_load_si128(reinterpret_cast<const __m128i *>(tags))),
+      tagVec);
+  const __m128i ways23 = _mm_cmpeq_epi32(
+      _mm_andnot_si128(
+          cBits, _mm_load_si128(reinterpret_cast<const __m128i *>(tags + 2))),
+      tagVec);
+  // Each way is a match only if both of its halves are.
+  const u32 equalHalves = static_cast<u32>(
+      _mm_movemask_ps(_mm_castsi128_ps(ways01)) |
+      (_mm_movemask_ps(_mm_castsi128_ps(ways23)) << 4));
+  // Matching ways are now on even bits, pack them together.
+  u32 hits = equalHalves & (equalHalves >> 1) & 0x55;
+  hits = (hits | (hits >> 1)) & 0x33;
+  hits = (hits | (hits >> 2)) & 0x0F;
+  return static_cast<u8>(hits);
+#else
+  u8 hits = 0;
+  for (u8 way = 0; way < PPU_TLB_WAYS; way++) {
+    hits |= ((tags[way] & ~PPU_TLB_TAG_C) == tag) << way;
+  }
+  return hits;
+#endif
+}
+
+// Moves a way of a TLB index to the most recently used position.
+static void mmuTouchTlbWay(TLB_Reg &tlb, u16 tlbIndex, u8 way) {
+  const u8 order = tlb.lruOrder[tlbIndex];
+  // Current position of the way, 0 being the most recently used.
+  u8 pos = 0;
+  while (((order >> (pos * 2)) & 3) != way) {
+    pos++;
+  }
+  // Everything more recent than it gets one position older.
+  const u8 newerMask = static_cast<u8>((1 << (pos * 2)) - 1);
+  const u8 olderMask = static_cast<u8>(~((1 << ((pos + 1) * 2)) - 1));
+  tlb.lruOrder[tlbIndex] = static_cast<u8>((order & olderMask) |
+                                           ((order & newerMask) << 2) | way);
+}
+
+// Way to be replaced on a TLB index, an invalid one if any, else the least
+// recently used one.
+static u8 mmuGetTlbRefillWay(const TLB_Reg &tlb, u16 tlbIndex) {
+  for (u8 way = 0; way < PPU_TLB_WAYS; way++) {
+    if (!(tlb.tag[tlbIndex][way] & PPU_TLB_TAG_VALID)) {
+      return way;
+    }
+  }
+  return tlb.lruOrder[tlbIndex] >> 6;
+}
+
 // This is done when TLB Reload is in software-controlled mode.
 void PPCInterpreter::mmuAddTlbEntry(PPU_STATE *hCore) {
 #define PPE_TLB_INDEX_LVPN_MASK 0xE00000000000
@@ -323,204 +419,426 @@ void PPCInterpreter::mmuAddTlbEntry(PPU_STATE *hCore) {
 
   // TLB set to choose from
   // There are 4 sets of 256 entries each:
+  u8 way = 0;
   switch (TS) {
   case 0b1000:
-    hCore->TLB.tlbSet0[TI].V = true;
-    hCore->TLB.tlbSet0[TI].RPN = RPN;
-    hCore->TLB.tlbSet0[TI].VPN = VPN;
-    hCore->TLB.tlbSet0[TI].p = p;
-    hCore->TLB.tlbSet0[TI].L = L;
-    hCore->TLB.tlbSet0[TI].LP = LP;
+    way = 0;
     break;
   case 0b0100:
-    hCore->TLB.tlbSet1[TI].V = true;
-    hCore->TLB.tlbSet1[TI].RPN = RPN;
-    hCore->TLB.tlbSet1[TI].VPN = VPN;
-    hCore->TLB.tlbSet1[TI].p = p;
-    hCore->TLB.tlbSet1[TI].L = L;
-    hCore->TLB.tlbSet1[TI].LP = LP;
+    way = 1;
     break;
   case 0b0010:
-    hCore->TLB.tlbSet2[TI].V = true;
-    hCore->TLB.tlbSet2[TI].RPN = RPN;
-    hCore->TLB.tlbSet2[TI].VPN = VPN;
-    hCore->TLB.tlbSet2[TI].p = p;
-    hCore->TLB.tlbSet2[TI].L = L;
-    hCore->TLB.tlbSet2[TI].LP = LP;
+    way = 2;
     break;
   case 0b0001:
-    hCore->TLB.tlbSet3[TI].V = true;
-    hCore->TLB.tlbSet3[TI].RPN = RPN;
-    hCore->TLB.tlbSet3[TI].VPN = VPN;
-    hCore->TLB.tlbSet3[TI].p = p;
-    hCore->TLB.tlbSet3[TI].L = L;
-    hCore->TLB.tlbSet3[TI].LP = LP;
+    way = 3;
     break;
+  default:
+    return;
   }
+
+  // Software reloads take care of the Change bit themselves.
+  hCore->TLB.tag[TI][way] = PPU_TLB_TAG(VPN, p, L, LP) | PPU_TLB_TAG_C;
+  hCore->TLB.RPN[TI][way] = RPN;
+  mmuTouchTlbWay(hCore->TLB, TI, way);
+}
+
+// TLB Reload after a successful page table search, done when the TLB is in
+// hardware-managed mode. An entry already holding the page is updated with the
+// new C bit, else the least recently used way of the index is replaced.
+void PPCInterpreter::mmuRefillTlbEntry(PPU_STATE *hCore, u64 VA, u64 VPN, u8 p,
+                                       bool L, u8 LP, u64 RPN, bool C) {
+  const u16 tlbIndex = mmuGetTlbIndex(VA, p);
+  const u64 tag = PPU_TLB_TAG(VPN, p, L, LP);
+  const u8 hits = mmuMatchTlbWays(hCore->TLB.tag[tlbIndex], tag);
+  const u8 way = hits ? static_cast<u8>(std::countr_zero(hits))
+                      : mmuGetTlbRefillWay(hCore->TLB, tlbIndex);
+
+  hCore->TLB.tag[tlbIndex][way] = tag | (C ? PPU_TLB_TAG_C : 0);
+  hCore->TLB.RPN[tlbIndex][way] = RPN;
+  mmuTouchTlbWay(hCore->TLB, tlbIndex, way);
 }
 
-// Translation Lookaside Buffer Search
+// Translation Lookaside Buffer Search, C is set to the Change bit of the page
+// on a hit. Stores to a page without it miss, so the page table is updated.
 bool PPCInterpreter::mmuSearchTlbEntry(PPU_STATE *hCore, u64 *RPN, u64 VA,
-                                       u64 VPN, u8 p, bool LP) {
+                                       u64 VPN, u8 p, bool L, u8 LP,
+                                       bool memWrite, bool *C) {
+  TLB_Reg &tlb = hCore->TLB;
   // Index to choose from the 256 ways of the TLB
-  u16 tlbIndex = 0;
-  // Tlb Set that was least Recently used for replacement.
-  u8 tlbSet = 0;
+  const u16 tlbIndex = mmuGetTlbIndex(VA, p);
+
+  // The VPN, page size, L and LP must all match, compare every way at once.
+  const u8 hits = mmuMatchTlbWays(tlb.tag[tlbIndex], PPU_TLB_TAG(VPN, p, L, LP));
+  if (hits) {
+    const u8 way = static_cast<u8>(std::countr_zero(hits));
+    *C = tlb.tag[tlbIndex][way] & PPU_TLB_TAG_C;
+    if (memWrite && !*C) {
+      // Only in hardware-managed mode, the entry is refilled after the walk.
+      tlb.misses++;
+      return false;
+    }
+    *RPN = tlb.RPN[tlbIndex][way];
+    mmuTouchTlbWay(tlb, tlbIndex, way);
+    tlb.hits++;
+    return true;
+  }
+  tlb.misses++;
 
-  // 4 Kb - (VA[52:55] xor VA[60:63]) || VA[64:67]
-  // 64 Kb - (VA[52:55] xor VA[56:59]) || VA[60:63]
-  // 16MB - VA[48:55]
+  // If the PPE is running on TLB Software managed mode, then this SPR
+  // is updated every time a Data or Instr Storage Exception occurs. This
+  // ensures that the next time that the tlb software updates via an
+  // interrupt, the index for replacement is not conflictive.
+  // On normal conditions this is done for the LRU index of the TLB.
 
-  // 52-55 bits of 80 VA
-  u16 bits36_39 = static_cast<u16>(QGET(VA, 36, 39));
-  // 56-59 bits of 80 VA
-  u16 bits40_43 = static_cast<u16>(QGET(VA, 40, 43));
-  // 60-63 bits of 80 VA
-  u16 bits44_47 = static_cast<u16>(QGET(VA, 44, 47));
-  // 64-67 bits of 80 VA
-  u16 bits48_51 = static_cast<u16>(QGET(VA, 48, 51));
-  // 48-55 bits of 80 VA
-  u16 bits32_39 = static_cast<u16>(QGET(VA, 32, 39));
+  // Software management of the TLB. 0 = Hardware, 1 = Software.
+  bool tlbSoftwareManaged = ((hCore->SPR.LPCR & 0x400) >> 10);
 
-  switch (p) {
-  case MMU_PAGE_SIZE_64KB:
-    tlbIndex = ((bits36_39 ^ bits40_43) << 4 | bits44_47);
-    break;
-  case MMU_PAGE_SIZE_16MB:
-    if (bits32_39 < 0x80 && bits32_39 > 0x20)
-      tlbIndex = bits32_39 & 0xF;
-    else if (bits32_39 < 0x20)
-      tlbIndex = bits32_39;
-    else {
-      tlbIndex = (bits40_43 << 4) ^ bits44_47;
+  if (tlbSoftwareManaged) {
+    // Set to replace, TS = 0b1000 >> way.
+    const u8 tlbSet = 0b1000 >> mmuGetTlbRefillWay(tlb, tlbIndex);
+    hCore->curThread->SPR.PPE_TLB_Index_Hint =
+        (static_cast<u64>(tlbIndex) << 4) | tlbSet;
+  }
+  return false;
+}
+
+// ERAT Search, on a hit EA is replaced with the Real Address.
+bool PPCInterpreter::mmuSearchEratEntry(ERAT_Reg *erat, u64 *EA, u8 mode,
+                                        bool memWrite) {
+  // A tlbie was issued somewhere on the chip since our last lookup, drop
+  // everything.
+  const u32 generation =
+      intXCPUContext->eratGeneration.load(std::memory_order_relaxed);
+  if (erat->generation != generation) {
+    for (auto &eratSet : erat->eratSet) {
+      for (auto &eratEntry : eratSet) {
+        eratEntry.V = false;
+      }
     }
-    break;
-  default:
-    // p = 12 bits, 4KB
-    tlbIndex = ((bits36_39 ^ bits44_47) << 4 | bits48_51);
-    break;
+    erat->generation = generation;
+    return false;
   }
 
-  if (hCore->TLB.tlbSet0[tlbIndex].V) {
-    if ((u16)hCore->TLB.tlbSet0[tlbIndex].VPN == (u16)VPN) {
-      // Check to see if its this entry!
-      // Need to have a tag
-      if (hCore->TLB.tlbSet0[tlbIndex].p == p) {
-        if (hCore->TLB.tlbSet0[tlbIndex].L) {
-          if (hCore->TLB.tlbSet0[tlbIndex].LP == LP) {
-            // Probably It!
-            *RPN = hCore->TLB.tlbSet0[tlbIndex].RPN;
-            return true;
-          }
-        } else {
-          // Probably It!
-          *RPN = hCore->TLB.tlbSet0[tlbIndex].RPN;
-          return true;
-        }
+  const u64 EPN = *EA >> 12;
+  const u8 set = EPN & (PPU_ERAT_SETS - 1);
+
+  for (u8 way = 0; way < PPU_ERAT_WAYS; way++) {
+    ERATEntry &eratEntry = erat->eratSet[set][way];
+    if (eratEntry.V && eratEntry.EPN == EPN && eratEntry.mode == mode) {
+      // Stores to a page whose Change bit isn't set yet must go through the
+      // page table.
+      if (memWrite && !eratEntry.C) {
+        return false;
       }
+      erat->lruWay[set] = way ^ 1;
+      *EA = eratEntry.RPN | (*EA & 0xFFF);
+      return true;
     }
-  } else {
-    // Entry was invalid, make this set the a candidate for refill.
-    tlbSet = 0b1000;
-  }
-  if (hCore->TLB.tlbSet1[tlbIndex].V) {
-    if ((u16)hCore->TLB.tlbSet1[tlbIndex].VPN == (u16)VPN) {
-      // Check to see if its this entry!
-      // Need to have a tag
-      if (hCore->TLB.tlbSet1[tlbIndex].p == p) {
-        if (hCore->TLB.tlbSet1[tlbIndex].L) {
-          if (hCore->TLB.tlbSet1[tlbIndex].LP == LP) {
-            // Probably It!
-            *RPN = hCore->TLB.tlbSet1[tlbIndex].RPN;
-            return true;
-          }
-        } else {
-          // Probably It!
-          *RPN = hCore->TLB.tlbSet1[tlbIndex].RPN;
-          return true;
-        }
+  }
+  return false;
+}
+
+// ERAT Reload, done after every successful translation.
+void PPCInterpreter::mmuAddEratEntry(ERAT_Reg *erat, u64 EA, u64 RA, u8 mode,
+                                     bool C) {
+  const u64 EPN = EA >> 12;
+  const u8 set = EPN & (PPU_ERAT_SETS - 1);
+
+  // Prefer an invalid way or one already holding this page, else replace the
+  // least recently used one.
+  u8 way = erat->lruWay[set];
+  for (u8 i = 0; i < PPU_ERAT_WAYS; i++) {
+    if (!erat->eratSet[set][i].V ||
+        (erat->eratSet[set][i].EPN == EPN &&
+         erat->eratSet[set][i].mode == mode)) {
+      way = i;
+      break;
+    }
+  }
+
+  erat->eratSet[set][way].V = true;
+  erat->eratSet[set][way].C = C;
+  erat->eratSet[set][way].mode = mode;
+  erat->eratSet[set][way].EPN = EPN;
+  erat->eratSet[set][way].RPN = RA & ~0xFFFULL;
+  erat->lruWay[set] = way ^ 1;
+}
+
+// Invalidates both ERAT's of the given thread(s). A thread running on its own
+// host thread does it itself, before its next instruction.
+void PPCInterpreter::mmuInvalidateErats(PPU_STATE *hCore, PPU_THREAD thread) {
+  for (u8 thrd = PPU_THREAD_0; thrd <= PPU_THREAD_1; thrd++) {
+    if (thread != PPU_THREAD_BOTH && thread != thrd) {
+      continue;
+    }
+    if (hCore->smtHostThreads && thrd != hCore->currentThread) {
+      hCore->ppuThread[thrd].postedRequests.fetch_or(
+          PPU_REQ_FLUSH_ERATS, std::memory_order_release);
+      continue;
+    }
+    for (u8 set = 0; set < PPU_ERAT_SETS; set++) {
+      for (u8 way = 0; way < PPU_ERAT_WAYS; way++) {
+        hCore->ppuThread[thrd].iERAT.eratSet[set][way].V = false;
+        hCore->ppuThread[thrd].dERAT.eratSet[set][way].V = false;
       }
     }
-  } else {
-    // Entry was invalid, make this set the a candidate for refill.
-    tlbSet = 0b0100;
-  }
-  if (hCore->TLB.tlbSet2[tlbIndex].V) {
-    if ((u16)hCore->TLB.tlbSet2[tlbIndex].VPN == (u16)VPN) {
-      // Check to see if its this entry!
-      // Need to have a tag
-      if (hCore->TLB.tlbSet2[tlbIndex].p == p) {
-        if (hCore->TLB.tlbSet2[tlbIndex].L) {
-          if (hCore->TLB.tlbSet2[tlbIndex].LP == LP) {
-            // Probably It!
-            *RPN = hCore->TLB.tlbSet2[tlbIndex].RPN;
-            return true;
-          }
-        } else {
-          // Probably It!
-          *RPN = hCore->TLB.tlbSet2[tlbIndex].RPN;
-          return true;
+  }
+}
+
+// Invalidates all translated ERAT entries of the current thread belonging to
+// a given segment. Real mode entries are unaffected by the SLB.
+void PPCInterpreter::mmuInvalidateEratSegment(PPU_STATE *hCore, u64 ESID) {
+  ERAT_Reg *erats[2] = {&hCore->curThread->iERAT,
+                        &hCore->curThread->dERAT};
+  for (auto &erat : erats) {
+    for (auto &eratSet : erat->eratSet) {
+      for (auto &eratEntry : eratSet) {
+        // EPN is EA[0:51], ESID is EA[0:35].
+        if (eratEntry.V && (eratEntry.mode & PPU_ERAT_MODE_RELOC) &&
+            (eratEntry.EPN >> 16) == ESID) {
+          eratEntry.V = false;
         }
       }
     }
-  } else {
-    // Entry was invalid, make this set the a candidate for refill.
-    tlbSet = 0b0010;
-  }
-  if (hCore->TLB.tlbSet3[tlbIndex].V) {
-    if ((u16)hCore->TLB.tlbSet3[tlbIndex].VPN == (u16)VPN) {
-      // Check to see if its this entry!
-      // Need to have a tag
-      if (hCore->TLB.tlbSet3[tlbIndex].p == p) {
-        if (hCore->TLB.tlbSet3[tlbIndex].L) {
-          if (hCore->TLB.tlbSet3[tlbIndex].LP == LP) {
-            // Probably It!
-            *RPN = hCore->TLB.tlbSet3[tlbIndex].RPN;
-            return true;
-          }
-        } else {
-          // Probably It!
-          *RPN = hCore->TLB.tlbSet3[tlbIndex].RPN;
-          return true;
-        }
+  }
+}
+
+// Marks a page of main memory as holding pre-decoded instructions, returns
+// the generation they belong to.
+u32 PPCInterpreter::mmuMarkCodePage(u64 RA) {
+  return intXCPUContext->codePages[RA >> 12].fetch_or(
+             1, std::memory_order_acq_rel) >>
+         1;
+}
+
+// Returns the current generation of the instructions in a page.
+u32 PPCInterpreter::mmuCodePageGeneration(u64 RA) {
+  return intXCPUContext->codePages[RA >> 12].load(std::memory_order_acquire) >>
+         1;
+}
+
+// Checks if [RA, RA + size) overlaps any page holding pre-decoded
+// instructions, in which case the page moves on to its next generation and the
+// blocks decoded from it are no longer used. Other pages are unaffected.
+void PPCInterpreter::mmuInvalidateCodePages(u64 RA, u64 size) {
+  for (u64 page = RA >> 12; page <= (RA + size - 1) >> 12; page++) {
+    std::atomic<u32> &codePage = intXCPUContext->codePages[page];
+    u32 state = codePage.load(std::memory_order_relaxed);
+    // Clearing the mark and bumping the generation is a single increment.
+    while ((state & 1) &&
+           !codePage.compare_exchange_weak(state, state + 1,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+  }
+}
+
+// Main memory written by a device through DMA. Pre-decoded instructions and
+// reservations must see it just like a store from a PPU.
+void PPCInterpreter::mmuDeviceWrite(u64 RA, u64 size) {
+  if (size == 0) {
+    return;
+  }
+  mmuInvalidateCodePages(RA, size);
+  for (u64 granule = RA & XENON_RES_GRANULE_MASK; granule < RA + size;
+       granule += XENON_RES_GRANULE_SIZE) {
+    intXCPUContext->xenonRes.Check(granule);
+  }
+}
+
+// Performs a stwcx/stdcx, returns true if the reservation was still held and
+// the store done. Conditional stores to the same granule are serialized, and
+// every other reservation on it is dropped both before and after the store, so
+// neither a thread that claims concurrently nor one that reserves in between
+// can succeed with stale data. Plain stores don't take the lock, so the word
+// the lwarx/ldarx read is only replaced if it still holds the same data.
+bool PPCInterpreter::mmuStoreConditional(PPU_RES *ppuRes, u64 RA, u64 data,
+                                         s8 byteCount) {
+  std::lock_guard lock(intXCPUContext->xenonRes.GranuleLock(RA));
+  if (!intXCPUContext->xenonRes.Claim(ppuRes, RA)) {
+    return false;
+  }
+
+  intXCPUContext->xenonRes.Scan(RA);
+
+  if (RA + byteCount <= RAM_START_ADDR + RAM_SIZE) {
+    u8 *hostAddr = mainMemory->getPointerToAddress(static_cast<u32>(RA));
+    const bool reservedWord = RA == ppuRes->resDataAddr &&
+                              byteCount == ppuRes->resDataSize &&
+                              (RA & (byteCount - 1)) == 0;
+    if (reservedWord && byteCount == 4) {
+      u32 expected = static_cast<u32>(ppuRes->resData);
+      if (!std::atomic_ref<u32>(*reinterpret_cast<u32 *>(hostAddr))
+               .compare_exchange_strong(expected, static_cast<u32>(data))) {
+        return false;
+      }
+    } else if (reservedWord && byteCount == 8) {
+      u64 expected = ppuRes->resData;
+      if (!std::atomic_ref<u64>(*reinterpret_cast<u64 *>(hostAddr))
+               .compare_exchange_strong(expected, data)) {
+        return false;
       }
+    } else {
+      memcpy(hostAddr, &data, byteCount);
     }
+    mmuInvalidateCodePages(RA, byteCount);
   } else {
-    // Entry was invalid, make this set the a candidate for refill.
-    tlbSet = 0b0001;
+    sysBus->Write(RA, data, byteCount);
   }
 
-  // If the PPE is running on TLB Software managed mode, then this SPR
-  // is updated every time a Data or Instr Storage Exception occurs. This
-  // ensures that the next time that the tlb software updates via an
-  // interrupt, the index for replacement is not conflictive.
-  // On normal conditions this is done for the LRU index of the TLB.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  intXCPUContext->xenonRes.Scan(RA);
+  return true;
+}
 
-  // Software management of the TLB. 0 = Hardware, 1 = Software.
-  bool tlbSoftwareManaged = ((hCore->SPR.LPCR & 0x400) >> 10);
+// Matches the PTE0 of every entry of a big endian PTEG against a tag, only
+// the bits set in mask are compared. Returns a bitmask of the matching entries.
+static u8 mmuMatchPTEG(const u8 *pteg, u64 mask, u64 tag) {
+  // Swap the mask and tag once instead of every entry.
+  const u64 maskBE = std::byteswap<u64>(mask);
+  const u64 tagBE = std::byteswap<u64>(tag);
+  u8 hits = 0;
+#ifdef ARCH_X86_64
+  const __m128i maskVec = _mm_set1_epi64x(static_cast<s64>(maskBE));
+  const __m128i tagVec = _mm_set1_epi64x(static_cast<s64>(tagBE));
+  for (u8 i = 0; i < PPC_HPTES_PER_GROUP; i += 2) {
+    // PTE0 of two consecutive entries.
+    const __m128i pte0s = _mm_unpacklo_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(pteg + i * 16)),
+        _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(pteg + (i + 1) * 16)));
+    const u32 equalBytes = static_cast<u32>(_mm_movemask_epi8(
+        _mm_cmpeq_epi32(_mm_and_si128(pte0s, maskVec), tagVec)));
+    hits |= ((equalBytes & 0xFF) == 0xFF) << i;
+    hits |= ((equalBytes >> 8) == 0xFF) << (i + 1);
+  }
+#else
+  for (u8 i = 0; i < PPC_HPTES_PER_GROUP; i++) {
+    u64 pte0 = 0;
+    memcpy(&pte0, pteg + i * 16, sizeof(u64));
+    hits |= ((pte0 & maskBE) == tagBE) << i;
+  }
+#endif
+  return hits;
+}
 
-  if (tlbSoftwareManaged) {
-    u64 tlbIndexHint =
-        hCore->ppuThread[hCore->currentThread].SPR.PPE_TLB_Index_Hint;
-    u8 currentTlbSet = tlbIndexHint & 0xF;
-    u8 currentTlbIndex = (u8)(tlbIndexHint & 0xFF0) >> 4;
-    currentTlbSet = tlbSet;
-    if (currentTlbIndex == 0xFF) {
-      if (currentTlbSet == 8) {
-        currentTlbSet = 1;
-      } else {
-        currentTlbSet = currentTlbSet << 1;
+// Hardware page table walk. Searches the primary and then the secondary PTEG
+// for the given VA, straight from RAM through its host pointer. R/C bits of the
+// matching PTE are updated in place. Returns false if no PTE matches.
+bool PPCInterpreter::mmuSearchPageTable(PPU_STATE *hCore, u64 VA, u64 VSID,
+                                        u64 PAGE, u8 p, bool L, u8 LP,
+                                        bool memWrite, u64 *RPN,
+                                        bool *changeRecorded) {
+  // AVPN[0:51] must equal VA[0:51].
+  const u64 avpn = VA >> 28;
+  if (avpn > (PPC_HPTE64_AVPN_0_51 >> 12)) {
+    return false;
+  }
+
+  // Get the primary and secondary hashes.
+  u64 hash0 = (VSID >> 28) ^ (PAGE >> p);
+  u64 hash1 = ~hash0;
+
+  // Get hash table origin and hash table mask.
+  const u64 htabOrg = hCore->SPR.SDR1 & PPC_SPR_SDR_64_HTABORG;
+  const u64 htabSize = hCore->SPR.SDR1 & PPC_SPR_SDR_64_HTABSIZE;
+
+  // Create the mask.
+  const u64 htabMask = QMASK(64 - (11 + htabSize), 63);
+
+  // And both hashes with the created mask, and get both PTEG's addresses.
+  const u64 ptegAddrs[2] = {htabOrg | ((hash0 & htabMask) << 7),
+                            htabOrg | ((hash1 & htabMask) << 7)};
+
+  /*
+  The 16-byte PTEs are organized in memory as groups of eight entries,
+  called PTE groups (PTEGs), each one a full 128-byte cache line. A
+  hardware table lookup consists of searching a primary PTEG and then,
+  if necessary, searching a secondary PTEG to find the correct PTE to be
+  reloaded into the TLB.
+
+  Conditions for a match to occur:
+
+  * PTE: H = 0 for the primary PTEG, 1 for the secondary PTEG
+  * PTE: V = 1
+  * PTE: AVPN[0:51] = VA0:51
+  * PTE: L = SLBE: L, and PTE: LP = SLBE: LP whenever L = 1. In other words,
+    the PTE page size must match the SLBE page size exactly.
+  */
+  const u64 pte0Mask = PPC_HPTE64_AVPN_0_51 | PPC_HPTE64_LARGE |
+                       PPC_HPTE64_HASH | PPC_HPTE64_VALID;
+
+  for (u8 H = 0; H < 2; H++) {
+    const u64 pte0Tag = (avpn << 12) | (L ? PPC_HPTE64_LARGE : 0) |
+                        (H ? PPC_HPTE64_HASH : 0) | PPC_HPTE64_VALID;
+
+    // Page tables live in main memory, anything else goes the slow way with
+    // relocation off.
+    bool socAccess = false;
+    const u64 ptegRA =
+        mmuContructEndAddressFromSecEngAddr(ptegAddrs[H], &socAccess);
+    u8 ptegBuffer[PPC_HPTES_PER_GROUP * 16];
+    u8 *pteg = nullptr;
+    if (!socAccess && ptegRA + sizeof(ptegBuffer) <= RAM_START_ADDR + RAM_SIZE) {
+      pteg = mainMemory->getPointerToAddress(static_cast<u32>(ptegRA));
+    } else {
+      MSRegister &msr = hCore->curThread->MSR;
+      const bool msrDR = msr.DR;
+      const bool msrIR = msr.IR;
+      msr.DR = 0;
+      msr.IR = 0;
+      for (u8 i = 0; i < PPC_HPTES_PER_GROUP * 2; i++) {
+        const u64 data = MMURead(intXCPUContext, hCore, ptegAddrs[H] + i * 8, 8);
+        memcpy(&ptegBuffer[i * 8], &data, sizeof(u64));
       }
+      msr.DR = msrDR;
+      msr.IR = msrIR;
+      pteg = ptegBuffer;
     }
 
-    if (currentTlbSet == 0)
-      currentTlbSet = 1;
+    const u8 hits = mmuMatchPTEG(pteg, pte0Mask, pte0Tag);
+    // Hardware searches the even entries first, then the odd ones.
+    for (u8 candidates : {static_cast<u8>(hits & 0x55),
+                          static_cast<u8>(hits & 0xAA)}) {
+      while (candidates) {
+        const u8 i = static_cast<u8>(std::countr_zero(candidates));
+        candidates &= candidates - 1;
 
-    tlbIndex = tlbIndex << 4;
-    tlbIndexHint = tlbIndex |= currentTlbSet;
-    hCore->ppuThread[hCore->currentThread].SPR.PPE_TLB_Index_Hint =
-        tlbIndexHint;
+        u64 *pte1Ptr = reinterpret_cast<u64 *>(pteg + i * 16 + 8);
+        const u64 pte1 = std::byteswap<u64>(*pte1Ptr);
+
+        // L & LP?
+        if (L && (((pte1 & PPC_HPTE64_LP) >> 12) != LP)) {
+          continue;
+        }
+
+        // Match found. Update Referenced and Change Bits if necessary.
+        const u64 rcBits = PPC_HPTE64_R | (memWrite ? PPC_HPTE64_C : 0);
+        if ((pte1 & rcBits) != rcBits) {
+          if (pteg != ptegBuffer) {
+            // Other threads may be updating it as well.
+            std::atomic_ref<u64>(*pte1Ptr).fetch_or(
+                std::byteswap<u64>(rcBits), std::memory_order_relaxed);
+          } else {
+            MMUWrite64(hCore, ptegAddrs[H] + i * 16 + 8, pte1 | rcBits);
+          }
+        }
+
+        *changeRecorded = memWrite || (pte1 & PPC_HPTE64_C);
+
+        if (L) {
+          // RPN is PTE[86:114].
+          *RPN = pte1 & PPC_HPTE64_RPN_LP;
+        } else {
+          // RPN is PTE[86:115].
+          *RPN = pte1 & PPC_HPTE64_RPN_NO_LP;
+        }
+        return true;
+      }
+    }
   }
+
   return false;
 }
 
@@ -630,7 +948,6 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState,
   // This is controlled via TL bit of the LPCR SPR.
 
   /* TODO */
-  // Implement ERATS and ERAT handling code.
   // Implement L1 per-core data/inst cache and cache handling code.
 
   //
@@ -638,7 +955,7 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState,
   //
 
   // Machine State Register.
-  MSRegister _msr = hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR;
+  MSRegister _msr = hCoreState->curThread->MSR;
   // Logical Partition Control Register.
   u64 LPCR = hCoreState->SPR.LPCR;
   // Hypervisor Real Mode Offset Register.
@@ -668,12 +985,25 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState,
   bool tlbSoftwareManaged = ((LPCR & 0x400) >> 10);
 
   // Instruction relocate and instruction fetch
-  if (_msr.IR && hCoreState->ppuThread[hCoreState->currentThread].iFetch)
+  if (_msr.IR && hCoreState->curThread->iFetch)
     realMode = false;
   // Data fetch
   else if (_msr.DR)
     realMode = false;
 
+  // Check the ERAT first, we only go any further on a miss.
+  ERAT_Reg *erat = hCoreState->curThread->iFetch
+                       ? &hCoreState->curThread->iERAT
+                       : &hCoreState->curThread->dERAT;
+  u8 eratMode = (realMode ? 0 : PPU_ERAT_MODE_RELOC) |
+                (_msr.HV ? PPU_ERAT_MODE_HV : 0) |
+                (_msr.SF ? PPU_ERAT_MODE_SF : 0);
+  if (mmuSearchEratEntry(erat, EA, eratMode, memWrite))
+    return true;
+  // Whether the page Change bit is set after this translation, entries
+  // without it can't be used by stores.
+  bool changeRecorded = true;
+
   // Real Addressing Mode
   if (realMode) {
     // If running in Hypervisor Offset mode.
@@ -721,19 +1051,15 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState,
 
     SLBEntry currslbEntry;
 
-    bool slbHit = false;
     // Search the SLB to get the VSID
-    for (auto &slbEntry :
-         hCoreState->ppuThread[hCoreState->currentThread].SLB) {
-      if (slbEntry.V && (slbEntry.ESID == ESID)) {
-        // Entry valid & SLB->ESID = EA->VSID
-        currslbEntry = slbEntry;
-        VSID = slbEntry.VSID;
-        L = slbEntry.L;
-        LP = slbEntry.LP;
-        slbHit = true;
-        break;
-      }
+    const SLBEntry *slbEntry = mmuSearchSlbEntry(hCoreState, ESID);
+    const bool slbHit = slbEntry != nullptr;
+    if (slbHit) {
+      // Entry valid & SLB->ESID = EA->VSID
+      currslbEntry = *slbEntry;
+      VSID = slbEntry->VSID;
+      L = slbEntry->L;
+      LP = slbEntry->LP;
     }
 
     // Virtual Page Number
@@ -771,279 +1097,66 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState,
         VPN = (VA >> 16) & ~0xF;
       }
 
-      if (mmuSearchTlbEntry(hCoreState, &RPN, VA, VPN, p, LP)) {
+      // The TLB is shared with the other thread, lookups update its LRU.
+      auto coreLock = ppcLockCore(hCoreState);
+      if (mmuSearchTlbEntry(hCoreState, &RPN, VA, VPN, p, L, LP, memWrite,
+                            &changeRecorded)) {
         // TLB Hit, proceed.
         goto end;
       } else {
         // TLB miss, if we are in software managed mode, generate an
         // interrupt, else do page table search.
         if (tlbSoftwareManaged) {
-          bool hv = hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.HV;
+          bool hv = hCoreState->curThread->MSR.HV;
           bool sfMode =
-              hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.SF;
-          u64 CIA = hCoreState->ppuThread[hCoreState->currentThread].CIA;
+              hCoreState->curThread->MSR.SF;
+          u64 CIA = hCoreState->curThread->CIA;
 
-          if (hCoreState->ppuThread[hCoreState->currentThread].iFetch) {
-            hCoreState->ppuThread[hCoreState->currentThread].exceptReg |=
+          if (hCoreState->curThread->iFetch) {
+            hCoreState->curThread->exceptReg |=
                 PPU_EX_INSSTOR;
           } else {
 
-            hCoreState->ppuThread[hCoreState->currentThread].exceptReg |=
+            hCoreState->curThread->exceptReg |=
                 PPU_EX_DATASTOR;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.DAR = *EA;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.DSISR =
+            hCoreState->curThread->SPR.DAR = *EA;
+            hCoreState->curThread->SPR.DSISR =
                 DSISR_NOPTE;
           }
           return false;
         } else {
           // Page Table Lookup:
           // Walk the Page table to find a Page that translates our current VA.
-
-          // Save MSR DR & IR Bits. When an exception occurs they must be reset
-          // to whatever they where.
-          bool msrDR =
-              hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.DR;
-          bool msrIR =
-              hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.IR;
-
-          // Disable relocation.
-          hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.DR = 0;
-          hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.IR = 0;
-
-          // Get the primary and secondary hashes.
-          u64 hash0 = (VSID >> 28) ^ (PAGE >> p);
-          u64 hash1 = ~hash0;
-
-          // Get hash table origin and hash table mask.
-          u64 htabOrg = hCoreState->SPR.SDR1 & PPC_SPR_SDR_64_HTABORG;
-          u64 htabSize = hCoreState->SPR.SDR1 & PPC_SPR_SDR_64_HTABSIZE;
-
-          // Create the mask.
-          u64 htabMask = QMASK(64 - (11 + htabSize), 63);
-
-          // And both hashes with the created mask.
-          hash0 = hash0 & htabMask;
-          hash1 = hash1 & htabMask;
-
-          // Get both PTEG's addresses.
-          u64 pteg0Addr = htabOrg | (hash0 << 7);
-          u64 pteg1Addr = htabOrg | (hash1 << 7);
-
-          /*
-          The 16-byte PTEs are organized in memory as groups of eight entries,
-          called PTE groups (PTEGs), each one a full 128-byte cache line. A
-          hardware table lookup consists of searching a primary PTEG and then,
-          if necessary, searching a secondary PTEG to find the correct PTE to be
-          reloaded into the TLB.
-          */
-
-          // Hardware searches PTEGs in the following order:
-          // 1. Request the even primary PTEG entries.
-          // 2. Search PTE[0], PTE[2], PTE[4], and PTE[6].
-          // 3. Request the odd primary PTEG entries.
-          // 4. Search PTE[1], PTE[3], PTE[5], and PTE[7].
-          // 5. Repeat steps 1 through 4 with the secondary PTE.
-          // 6. If no match occurs, raise a data storage exception.
-
-          // First PTEG.
-          PPC_HPTE64 pteg0[PPC_HPTES_PER_GROUP];
-
-          // Get the pteg data from memory while relocation is off.
-          for (size_t i = 0; i < PPC_HPTES_PER_GROUP; i++) {
-            pteg0[i].pte0 =
-                PPCInterpreter::MMURead64(hCoreState, pteg0Addr + i * 16);
-            pteg0[i].pte1 =
-                PPCInterpreter::MMURead64(hCoreState, pteg0Addr + i * 16 + 8);
-          }
-
-          // We compare all pte's in order for simplicity.
-          for (size_t i = 0; i < PPC_HPTES_PER_GROUP; i++) {
-            /*
-                Conditions for a match to occur:
-
-                * PTE: H = 0 for the primary PTEG, 1 for the secondary PTEG
-                * PTE: V = 1
-                * PTE: AVPN[0:51] = VA0:51
-                * if p < 28, PTE: AVPN[52:51+q] = VA[52:51+q]
-            */
-
-            // H = 0?
-            if (((pteg0[i].pte0 & PPC_HPTE64_HASH) >> 1) != 0) {
-              continue;
-            }
-
-            // V?
-            if ((pteg0[i].pte0 & PPC_HPTE64_VALID) != true) {
-              continue;
-            }
-
-            u64 pteAVPN = pteg0[i].pte0 & PPC_HPTE64_AVPN;
-
-            // PTE:AVPN[0:51] = VA[0:51]?
-            if (((pteAVPN & PPC_HPTE64_AVPN_0_51) >> 12) != (VA >> 28)) {
-              continue;
-            }
-
-            /*
-                The PPE also requires that PTE[LP] = SLBE[LP] whenever PTE[L] =
-               '1'. In other words, the PTE page size must match the SLBE page
-               size exactly for a page-table match to occur.
-            */
-
-            // L?
-            if (((pteg0[i].pte0 & PPC_HPTE64_LARGE) >> 2) != L) {
-              continue;
-            }
-
-            // L & LP?
-            if (L && (((pteg0[i].pte1 & PPC_HPTE64_LP) >> 12) != LP)) {
-              continue;
-            }
-
-            // Match found. Extract the RPN from the page table.
-
-            // Set relocation back to whatever it was.
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.DR = msrDR;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.IR = msrIR;
-
-            // Update Referenced and Change Bits if necessary.
-            if (!((pteg0[i].pte1 & PPC_HPTE64_R) >> 8)) {
-              // Referenced
-              MMUWrite64(hCoreState, pteg0Addr + i * 16 + 8,
-                         (pteg0[i].pte1 | 0x100));
-            }
-            if (!((pteg0[i].pte1 & PPC_HPTE64_C) >> 7)) {
-              // Access is a data write?
-              if (memWrite) {
-                // Change
-                MMUWrite64(hCoreState, pteg0Addr + i * 16 + 8,
-                           (pteg0[i].pte1 | 0x80));
-              }
-            }
-
-            if (L) {
-              // RPN is PTE[86:114].
-              RPN = pteg0[i].pte1 & PPC_HPTE64_RPN_LP;
-            } else {
-              // RPN is PTE[86:115].
-              RPN = pteg0[i].pte1 & PPC_HPTE64_RPN_NO_LP;
-            }
-
+          if (mmuSearchPageTable(hCoreState, VA, VSID, PAGE, p, L, LP,
+                                 memWrite, &RPN, &changeRecorded)) {
+            // Reload the TLB, with the Change bit so the next store to a clean
+            // page knows it has to come back here.
+            mmuRefillTlbEntry(hCoreState, VA, VPN, p, L, LP, RPN,
+                              changeRecorded);
             goto end;
           }
 
-          // Second PTEG.
-          PPC_HPTE64 pteg1[PPC_HPTES_PER_GROUP];
-
-          for (size_t i = 0; i < PPC_HPTES_PER_GROUP; i++) {
-            pteg1[i].pte0 =
-                PPCInterpreter::MMURead64(hCoreState, pteg1Addr + i * 16);
-            pteg1[i].pte1 =
-                PPCInterpreter::MMURead64(hCoreState, pteg1Addr + i * 16 + 8);
-          }
-
-          // We compare all pte's in order for simplicity.
-          for (size_t i = 0; i < PPC_HPTES_PER_GROUP; i++) {
-            /*
-                Conditions for a match to occur:
-
-                * PTE: H = 0 for the primary PTEG, 1 for the secondary PTEG
-                * PTE: V = 1
-                * PTE: AVPN[0:51] = VA0:51
-                * if p < 28, PTE: AVPN[52:51+q] = VA[52:51+q]
-            */
-
-            // H = 0?
-            if (((pteg1[i].pte0 & PPC_HPTE64_HASH) >> 1) != 0) {
-              continue;
-            }
-
-            // V?
-            if ((pteg1[i].pte0 & PPC_HPTE64_VALID) != true) {
-              continue;
-            }
-
-            u64 pteAVPN = pteg1[i].pte0 & PPC_HPTE64_AVPN;
-
-            // PTE:AVPN[0:51] = VA[0:51]?
-            if (((pteAVPN & PPC_HPTE64_AVPN_0_51) >> 12) != (VA >> 28)) {
-              continue;
-            }
-
-            /*
-                The PPE also requires that PTE[LP] = SLBE[LP] whenever PTE[L] =
-               '1'. In other words, the PTE page size must match the SLBE page
-               size exactly for a page-table match to occur.
-            */
-
-            // L?
-            if (((pteg1[i].pte0 & PPC_HPTE64_LARGE) >> 2) != L) {
-              continue;
-            }
-
-            // L & LP?
-            if (L && (((pteg1[i].pte1 & PPC_HPTE64_LP) >> 12) != LP)) {
-              continue;
-            }
-
-            // Match found. Extract the RPN from the page table.
-
-            // Set relocation back to whatever it was.
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.DR = msrDR;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.IR = msrIR;
-
-            // Update Referenced and Change Bits if necessary.
-            if (!((pteg1[i].pte1 & PPC_HPTE64_R) >> 8)) {
-              // Referenced
-              MMUWrite64(hCoreState, pteg1Addr + i * 16 + 8,
-                         (pteg1[i].pte1 | 0x100));
-            }
-            if (!((pteg1[i].pte1 & PPC_HPTE64_C) >> 7)) {
-              // Access is a data write?
-              if (memWrite) {
-                // Change
-                MMUWrite64(hCoreState, pteg1Addr + i * 16 + 8,
-                           (pteg1[i].pte1 | 0x80));
-              }
-            }
-
-            if (L) {
-              // RPN is PTE[86:114].
-              RPN = pteg1[i].pte1 & PPC_HPTE64_RPN_LP;
-            } else {
-              // RPN is PTE[86:115].
-              RPN = pteg1[i].pte1 & PPC_HPTE64_RPN_NO_LP;
-            }
-
-            goto end;
-          }
-
-          // Set MSR to IR/DR mode before raising the interrupt to whatever they
-          // were.
-          hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.DR = msrDR;
-          hCoreState->ppuThread[hCoreState->currentThread].SPR.MSR.IR = msrIR;
-
           // Page Table Lookup Fault.
           // Issue Data/Instr Storage interrupt.
 
           // Instruction read.
-          if (hCoreState->ppuThread[hCoreState->currentThread].iFetch) {
-            hCoreState->ppuThread[hCoreState->currentThread].exceptReg |=
+          if (hCoreState->curThread->iFetch) {
+            hCoreState->curThread->exceptReg |=
                 PPU_EX_INSSTOR;
 
           } else if (memWrite) {
             // Data write.
-            hCoreState->ppuThread[hCoreState->currentThread].exceptReg |=
+            hCoreState->curThread->exceptReg |=
                 PPU_EX_DATASTOR;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.DAR = *EA;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.DSISR =
+            hCoreState->curThread->SPR.DAR = *EA;
+            hCoreState->curThread->SPR.DSISR =
                 DSISR_NOPTE | DSISR_ISSTORE;
           } else {
             // Data read.
-            hCoreState->ppuThread[hCoreState->currentThread].exceptReg |=
+            hCoreState->curThread->exceptReg |=
                 PPU_EX_DATASTOR;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.DAR = *EA;
-            hCoreState->ppuThread[hCoreState->currentThread].SPR.DSISR =
+            hCoreState->curThread->SPR.DAR = *EA;
+            hCoreState->curThread->SPR.DSISR =
                 DSISR_NOPTE;
           }
           return false;
@@ -1052,13 +1165,13 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState,
     } else {
       // SLB Miss
       // Data or Inst Segment Exception
-      if (hCoreState->ppuThread[hCoreState->currentThread].iFetch) {
-        hCoreState->ppuThread[hCoreState->currentThread].exceptReg |=
+      if (hCoreState->curThread->iFetch) {
+        hCoreState->curThread->exceptReg |=
             PPU_EX_INSTSEGM;
       } else {
-        hCoreState->ppuThread[hCoreState->currentThread].exceptReg |=
+        hCoreState->curThread->exceptReg |=
             PPU_EX_DATASEGM;
-        hCoreState->ppuThread[hCoreState->currentThread].SPR.DAR = *EA;
+        hCoreState->curThread->SPR.DAR = *EA;
       }
       return false;
     }
@@ -1069,6 +1182,8 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, PPU_STATE *hCoreState,
     QSET(RA, 0, 21, 0)
   }
 
+  mmuAddEratEntry(erat, *EA, RA, eratMode, changeRecorded);
+
   *EA = RA;
   return true;
 }
@@ -1097,13 +1212,11 @@ u64 PPCInterpreter::MMURead(XENON_CONTEXT *cpuContext, PPU_STATE *ppuState,
     socRead = true;
   }
 
-  // TODO: Investigate this values FSB_CONFIG_RX_STATE - Needed to Work!
-  if (ppuState->ppuThread[ppuState->currentThread].CIA == 0x1003598) {
-    ppuState->ppuThread[ppuState->currentThread].GPR[0xB] = 0xE;
-  }
-
-  if (ppuState->ppuThread[ppuState->currentThread].CIA == 0x1003644) {
-    ppuState->ppuThread[ppuState->currentThread].GPR[0xB] = 0x2;
+  // Main memory, read it directly instead of going trough the bus.
+  if (!socRead && EA + byteCount <= RAM_START_ADDR + RAM_SIZE) {
+    memcpy(&data, mainMemory->getPointerToAddress(static_cast<u32>(EA)),
+           byteCount);
+    return data;
   }
 
   // Hack Needed for CB to work, seems like it reads from some SoC this value
@@ -1219,7 +1332,7 @@ u64 PPCInterpreter::MMURead(XENON_CONTEXT *cpuContext, PPU_STATE *ppuState,
 
   // Time Base register. Writing here starts or stops the RTC apparently.
   if (socRead && EA == 0x611a0) {
-    if (!intXCPUContext->timeBaseActive) {
+    if (!intXCPUContext->timeBaseActive.load(std::memory_order_relaxed)) {
       data = 0;
       return data;
     } else {
@@ -1291,6 +1404,15 @@ void PPCInterpreter::MMUWrite(XENON_CONTEXT *cpuContext, PPU_STATE *ppuState,
     socWrite = true;
   }
 
+  // Main memory, write it directly instead of going trough the bus.
+  if (!socWrite && EA + byteCount <= RAM_START_ADDR + RAM_SIZE) {
+    memcpy(mainMemory->getPointerToAddress(static_cast<u32>(EA)), &data,
+           byteCount);
+    mmuInvalidateCodePages(EA, byteCount);
+    intXCPUContext->xenonRes.Check(EA);
+    return;
+  }
+
   // CPU POST Bus
   if (socWrite && EA == POST_BUS_ADDR) {
     Xe::XCPU::POSTBUS::POST(data);
@@ -1300,12 +1422,12 @@ void PPCInterpreter::MMUWrite(XENON_CONTEXT *cpuContext, PPU_STATE *ppuState,
   // Time Base register. Writing here starts or stops the RTC apparently.
   if (socWrite && EA == 0x611a0) {
     if (data == 0) {
-      intXCPUContext->timeBaseActive = false;
+      intXCPUContext->timeBaseActive.store(false, std::memory_order_relaxed);
       return;
     } else if (data == 0xff01000000000000 ||
                data == 0x0001000000000000) // 0x1FF byte reversed!
     {
-      intXCPUContext->timeBaseActive = true;
+      intXCPUContext->timeBaseActive.store(true, std::memory_order_relaxed);
       return;
     }
   }
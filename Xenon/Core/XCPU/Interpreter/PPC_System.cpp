@@ -1,75 +1,91 @@
 // Copyright 2025 Xenon Emulator Project
 
+#include <atomic>
+
 #include "Base/Logging/Log.h"
 
 #include "PPCInterpreter.h"
 
 void PPCInterpreter::PPCInterpreter_isync(PPU_STATE *hCore) {
-  // Do nothing.
+  // Context synchronizing. isync always ends a PPU decode cache block, so the
+  // next instruction is looked up again and sees any invalidation done by
+  // stores or icbi's issued before it.
 }
 
-void PPCInterpreter::PPCInterpreter_eieio(PPU_STATE* hCore)
-{
-    // Do nothing.
+void PPCInterpreter::PPCInterpreter_eieio(PPU_STATE *hCore) {
+  // Orders storage accesses, PPU's run on different host threads so that
+  // needs a host fence too. Stores to device memory are already done in
+  // program order.
+  std::atomic_thread_fence(std::memory_order_release);
 }
 
 void PPCInterpreter::PPCInterpreter_sc(PPU_STATE *hCore) {
   SC_FORM_LEV;
 
   // Raise the exception.
-  hCore->ppuThread[hCore->currentThread].exceptReg |= PPU_EX_SC;
-  hCore->ppuThread[hCore->currentThread].exceptHVSysCall = LEV & 1;
+  hCore->curThread->exceptReg |= PPU_EX_SC;
+  hCore->curThread->exceptHVSysCall = LEV & 1;
 }
 
 void PPCInterpreter::PPCInterpreter_slbmte(PPU_STATE *hCore) {
   X_FORM_rS_rB;
 
-  u64 VSID = QGET(hCore->ppuThread[hCore->currentThread].GPR[rS], 0, 51);
+  u64 VSID = QGET(hCore->curThread->GPR[rS], 0, 51);
 
-  u8 Ks = QGET(hCore->ppuThread[hCore->currentThread].GPR[rS], 52, 52);
-  u8 Kp = QGET(hCore->ppuThread[hCore->currentThread].GPR[rS], 53, 53);
-  u8 N = QGET(hCore->ppuThread[hCore->currentThread].GPR[rS], 54, 54);
-  u8 L = QGET(hCore->ppuThread[hCore->currentThread].GPR[rS], 55, 55);
-  u8 C = QGET(hCore->ppuThread[hCore->currentThread].GPR[rS], 56, 56);
-  u8 LP = QGET(hCore->ppuThread[hCore->currentThread].GPR[rS], 57, 59);
+  u8 Ks = QGET(hCore->curThread->GPR[rS], 52, 52);
+  u8 Kp = QGET(hCore->curThread->GPR[rS], 53, 53);
+  u8 N = QGET(hCore->curThread->GPR[rS], 54, 54);
+  u8 L = QGET(hCore->curThread->GPR[rS], 55, 55);
+  u8 C = QGET(hCore->curThread->GPR[rS], 56, 56);
+  u8 LP = QGET(hCore->curThread->GPR[rS], 57, 59);
 
-  u64 ESID = QGET(hCore->ppuThread[hCore->currentThread].GPR[rB], 0, 35);
-  bool V = QGET(hCore->ppuThread[hCore->currentThread].GPR[rB], 36, 36);
-  u16 Index = QGET(hCore->ppuThread[hCore->currentThread].GPR[rB], 52, 63);
+  u64 ESID = QGET(hCore->curThread->GPR[rB], 0, 35);
+  bool V = QGET(hCore->curThread->GPR[rB], 36, 36);
+  // Only the low bits select an entry, the SLB has 64 of them.
+  u16 Index = QGET(hCore->curThread->GPR[rB], 52, 63) &
+              (PPU_SLB_ENTRIES - 1);
 
   // VSID is VA 0-52 bit, the remaining 28 bits are adress data
   // so whe shift 28 bits left here so we only do it once per entry.
   // This speeds MMU translation since the shift is only done once.
   VSID = VSID << 28;
 
-  hCore->ppuThread[hCore->currentThread].SLB[Index].ESID = ESID;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].VSID = VSID;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].V = V;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].Kp = Kp;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].Ks = Ks;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].N = N;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].L = L;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].C = C;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].LP = LP;
-  hCore->ppuThread[hCore->currentThread].SLB[Index].vsidReg =
-      hCore->ppuThread[hCore->currentThread].GPR[rS];
-  hCore->ppuThread[hCore->currentThread].SLB[Index].esidReg =
-      hCore->ppuThread[hCore->currentThread].GPR[rB];
+  hCore->curThread->SLB[Index].ESID = ESID;
+  hCore->curThread->SLB[Index].VSID = VSID;
+  hCore->curThread->SLB[Index].V = V;
+  hCore->curThread->SLB[Index].Kp = Kp;
+  hCore->curThread->SLB[Index].Ks = Ks;
+  hCore->curThread->SLB[Index].N = N;
+  hCore->curThread->SLB[Index].L = L;
+  hCore->curThread->SLB[Index].C = C;
+  hCore->curThread->SLB[Index].LP = LP;
+  hCore->curThread->SLB[Index].vsidReg =
+      hCore->curThread->GPR[rS];
+  hCore->curThread->SLB[Index].esidReg =
+      hCore->curThread->GPR[rB];
+
+  // Point the lookup table at the new entry.
+  if (V) {
+    hCore->curThread->slbHash[PPU_SLB_HASH(ESID)] =
+        static_cast<u8>(Index + 1);
+  }
 }
 
 void PPCInterpreter::PPCInterpreter_slbie(PPU_STATE *hCore) {
   X_FORM_rB;
 
   // ESID.
-  const u64 ESID = QGET(hCore->ppuThread[hCore->currentThread].GPR[rB], 0, 35);
+  const u64 ESID = QGET(hCore->curThread->GPR[rB], 0, 35);
   // Class.
-  const u8 C = QGET(hCore->ppuThread[hCore->currentThread].GPR[rB], 36, 36);
+  const u8 C = QGET(hCore->curThread->GPR[rB], 36, 36);
 
-  for (auto &slbEntry : hCore->ppuThread[hCore->currentThread].SLB) {
+  for (auto &slbEntry : hCore->curThread->SLB) {
     if (slbEntry.V && slbEntry.C == C && slbEntry.ESID == ESID) {
       slbEntry.V = false;
     }
   }
+  hCore->curThread->slbHash[PPU_SLB_HASH(ESID)] = 0;
+  mmuInvalidateEratSegment(hCore, ESID);
 }
 
 void PPCInterpreter::PPCInterpreter_rfid(PPU_STATE *hCore) {
@@ -77,7 +93,7 @@ void PPCInterpreter::PPCInterpreter_rfid(PPU_STATE *hCore) {
   u32 b3, b, usr;
 
   // Compose new MSR as per specs
-  srr1 = hCore->ppuThread[hCore->currentThread].SPR.SRR1;
+  srr1 = hCore->curThread->SPR.SRR1;
   new_msr = 0;
 
   usr = BGET(srr1, 64, 49);
@@ -92,12 +108,12 @@ void PPCInterpreter::PPCInterpreter_rfid(PPU_STATE *hCore) {
     BSET(new_msr, 64, 0);
   }
 
-  b3 = BGET(hCore->ppuThread[hCore->currentThread].SPR.MSR.MSR_Hex, 64, 3);
+  b3 = BGET(hCore->curThread->MSR.MSR_Hex, 64, 3);
 
   // MSR.51 = (MSR.3 & SRR1.51) | ((~MSR.3) & MSR.51)
   if ((b3 && BGET(srr1, 64, 51)) ||
       (!b3 &&
-       BGET(hCore->ppuThread[hCore->currentThread].SPR.MSR.MSR_Hex, 64, 51))) {
+       BGET(hCore->curThread->MSR.MSR_Hex, 64, 51))) {
     BSET(new_msr, 64, 51);
   }
 
@@ -127,35 +143,35 @@ void PPCInterpreter::PPCInterpreter_rfid(PPU_STATE *hCore) {
 
   // See what changed and take actions
   // NB: we ignore a bunch of bits..
-  diff_msr = hCore->ppuThread[hCore->currentThread].SPR.MSR.MSR_Hex ^ new_msr;
+  diff_msr = hCore->curThread->MSR.MSR_Hex ^ new_msr;
 
   // NB: we dont do half-modes
   if (diff_msr & QMASK(58, 59)) {
     if (usr) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.IR = true;
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.DR = true;
+      hCore->curThread->MSR.IR = true;
+      hCore->curThread->MSR.DR = true;
     } else if (new_msr & QMASK(58, 59)) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.IR = true;
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.DR = true;
+      hCore->curThread->MSR.IR = true;
+      hCore->curThread->MSR.DR = true;
     } else {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.IR = false;
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.DR = false;
+      hCore->curThread->MSR.IR = false;
+      hCore->curThread->MSR.DR = false;
     }
   }
 
-  hCore->ppuThread[hCore->currentThread].SPR.MSR.MSR_Hex = new_msr;
-  hCore->ppuThread[hCore->currentThread].NIA =
-      hCore->ppuThread[hCore->currentThread].SPR.SRR0 & ~3;
+  hCore->curThread->MSR.MSR_Hex = new_msr;
+  hCore->curThread->NIA =
+      hCore->curThread->SPR.SRR0 & ~3;
 
   // Clear exception taken flag.
-  hCore->ppuThread[hCore->currentThread].exceptionTaken = false;
+  hCore->curThread->exceptionTaken = false;
 }
 
 void PPCInterpreter::PPCInterpreter_tw(PPU_STATE *hCore) {
   X_FORM_TO_rA_rB;
 
-  long a = (long)hCore->ppuThread[hCore->currentThread].GPR[rA];
-  long b = (long)hCore->ppuThread[hCore->currentThread].GPR[rB];
+  long a = (long)hCore->curThread->GPR[rA];
+  long b = (long)hCore->curThread->GPR[rB];
 
   if ((a < b && BGET(TO, 5, 0)) || (a > b && BGET(TO, 5, 1)) ||
       (a == b && BGET(TO, 5, 2)) || ((u32)a < (u32)b && BGET(TO, 5, 3)) ||
@@ -168,7 +184,7 @@ void PPCInterpreter::PPCInterpreter_twi(PPU_STATE *hCore) {
   D_FORM_TO_rA_SI;
   SI = EXTS(SI, 16);
 
-  long a = (long)hCore->ppuThread[hCore->currentThread].GPR[rA];
+  long a = (long)hCore->curThread->GPR[rA];
 
   if ((a < (long)SI && BGET(TO, 5, 0)) || (a > (long)SI && BGET(TO, 5, 1)) ||
       (a == (long)SI && BGET(TO, 5, 2)) || ((u32)a < SI && BGET(TO, 5, 3)) ||
@@ -181,7 +197,7 @@ void PPCInterpreter::PPCInterpreter_tdi(PPU_STATE *hCore) {
   D_FORM_TO_rA_SI;
   SI = EXTS(SI, 16);
 
-  s64 rAReg = (s64)hCore->ppuThread[hCore->currentThread].GPR[rA];
+  s64 rAReg = (s64)hCore->curThread->GPR[rA];
 
   if ((rAReg < (s64)SI && BGET(TO, 5, 0)) ||
       (rAReg > (s64)SI && BGET(TO, 5, 1)) ||
@@ -192,29 +208,68 @@ void PPCInterpreter::PPCInterpreter_tdi(PPU_STATE *hCore) {
   }
 }
 
+// Whether a SPR is shared by both threads of the core or updated along with
+// the time base, which the other thread does too.
+static bool ppcIsCoreSPR(u32 sprNum) {
+  switch (sprNum) {
+  case SPR_DEC:
+  case SPR_SDR1:
+  case SPR_CTRLRD:
+  case SPR_CTRLWR:
+  case SPR_TBL_RO:
+  case SPR_TBU_RO:
+  case SPR_TBL_WO:
+  case SPR_TBU_WO:
+  case SPR_TB:
+  case SPR_HDEC:
+  case SPR_HRMOR:
+  case SPR_RMOR:
+  case SPR_LPCR:
+  case SPR_LPIDR:
+  case SPR_TSCR:
+  case SPR_TTR:
+  case SPR_PpeTlbIndex:
+  case SPR_PpeTlbVpn:
+  case SPR_PpeTlbRpn:
+  case SPR_HID0:
+  case SPR_HID1:
+  case SPR_HID4:
+  case SPR_HID6:
+    return true;
+  default:
+    return false;
+  }
+}
+
 void PPCInterpreter::PPCInterpreter_mfspr(PPU_STATE *hCore) {
   u64 rS, crm = 0;
-  PPC_OPC_TEMPL_XFX(hCore->ppuThread[hCore->currentThread].CI.opcode, rS, crm);
-  u32 sprNum = hCore->ppuThread[hCore->currentThread].CI.spr;
+  PPC_OPC_TEMPL_XFX(hCore->curThread->CI.opcode, rS, crm);
+  u32 sprNum = hCore->curThread->CI.spr;
   sprNum = ((sprNum & 0x1f) << 5) | ((sprNum >> 5) & 0x1F);
 
   u64 value = 0;
 
+  std::unique_lock<std::recursive_mutex> coreLock;
+  if (ppcIsCoreSPR(sprNum)) {
+    coreLock = ppcLockCore(hCore);
+  }
+
   switch (sprNum) {
   case SPR_LR:
-    value = hCore->ppuThread[hCore->currentThread].SPR.LR;
+    value = hCore->curThread->LR;
     break;
   case SPR_CTR:
-    value = hCore->ppuThread[hCore->currentThread].SPR.CTR;
+    value = hCore->curThread->CTR;
     break;
   case SPR_DEC:
-    value = hCore->ppuThread[hCore->currentThread].SPR.DEC;
+    ppcUpdateTimeBase(hCore);
+    value = hCore->curThread->SPR.DEC;
     break;
   case SPR_CFAR:
-    value = hCore->ppuThread[hCore->currentThread].SPR.CFAR;
+    value = hCore->curThread->SPR.CFAR;
     break;
   case SPR_VRSAVE:
-    value = hCore->ppuThread[hCore->currentThread].SPR.VRSAVE;
+    value = hCore->curThread->SPR.VRSAVE;
     break;
   case SPR_HRMOR:
     value = hCore->SPR.HRMOR;
@@ -223,7 +278,7 @@ void PPCInterpreter::PPCInterpreter_mfspr(PPU_STATE *hCore) {
     value = hCore->SPR.RMOR;
     break;
   case SPR_PIR:
-    value = hCore->ppuThread[hCore->currentThread].SPR.PIR;
+    value = hCore->curThread->SPR.PIR;
     break;
   case SPR_HID0:
     value = hCore->SPR.HID0;
@@ -241,13 +296,13 @@ void PPCInterpreter::PPCInterpreter_mfspr(PPU_STATE *hCore) {
     value = hCore->SPR.LPCR;
     break;
   case SPR_PpeTlbIndexHint:
-    value = hCore->ppuThread[hCore->currentThread].SPR.PPE_TLB_Index_Hint;
+    value = hCore->curThread->SPR.PPE_TLB_Index_Hint;
     break;
   case SPR_HSPRG0:
-    value = hCore->ppuThread[hCore->currentThread].SPR.HSPRG0;
+    value = hCore->curThread->SPR.HSPRG0;
     break;
   case SPR_HSPRG1:
-    value = hCore->ppuThread[hCore->currentThread].SPR.HSPRG1;
+    value = hCore->curThread->SPR.HSPRG1;
     break;
   case SPR_TSCR:
     value = hCore->SPR.TSCR;
@@ -259,205 +314,246 @@ void PPCInterpreter::PPCInterpreter_mfspr(PPU_STATE *hCore) {
     value = hCore->SPR.PVR.PVR_Hex;
     break;
   case SPR_SPRG0:
-    value = hCore->ppuThread[hCore->currentThread].SPR.SPRG0;
+    value = hCore->curThread->SPR.SPRG0;
     break;
   case SPR_SPRG1:
-    value = hCore->ppuThread[hCore->currentThread].SPR.SPRG1;
+    value = hCore->curThread->SPR.SPRG1;
     break;
   case SPR_SPRG2:
-    value = hCore->ppuThread[hCore->currentThread].SPR.SPRG2;
+    value = hCore->curThread->SPR.SPRG2;
     break;
   case SPR_SPRG3:
-    value = hCore->ppuThread[hCore->currentThread].SPR.SPRG3;
+    value = hCore->curThread->SPR.SPRG3;
     break;
   case SPR_SRR0:
-    value = hCore->ppuThread[hCore->currentThread].SPR.SRR0;
+    value = hCore->curThread->SPR.SRR0;
     break;
   case SPR_SRR1:
-    value = hCore->ppuThread[hCore->currentThread].SPR.SRR1;
+    value = hCore->curThread->SPR.SRR1;
     break;
   case SPR_XER:
-    value = hCore->ppuThread[hCore->currentThread].SPR.XER.XER_Hex;
+    value = hCore->curThread->XER.XER_Hex;
     break;
   case SPR_DSISR:
-    value = hCore->ppuThread[hCore->currentThread].SPR.DSISR;
+    value = hCore->curThread->SPR.DSISR;
     break;
   case SPR_DAR:
-    value = hCore->ppuThread[hCore->currentThread].SPR.DAR;
+    value = hCore->curThread->SPR.DAR;
     break;
   case SPR_TB:
+    ppcUpdateTimeBase(hCore);
     value = hCore->SPR.TB;
     break;
   case SPR_TBL_RO:
+    ppcUpdateTimeBase(hCore);
     value = hCore->SPR.TB;
     break;
   case SPR_TBU_RO:
+    ppcUpdateTimeBase(hCore);
     value = (hCore->SPR.TB & 0xFFFFFFFF00000000);
     break;
   case SPR_DABR:
-    value = hCore->ppuThread[hCore->currentThread].SPR.DABR;
+    value = hCore->curThread->SPR.DABR;
     break;
   case SPR_CTRLRD:
-    value = hCore->SPR.CTRL;
+    value = std::atomic_ref<u32>(hCore->SPR.CTRL).load(
+        std::memory_order_relaxed);
     break;
   default:
     LOG_ERROR(Xenon, "{}(Thrd{:#d}) mfspr: Unknown SPR: 0x{:#x}", hCore->ppuName, (u8)hCore->currentThread, sprNum);
     break;
   }
 
-  hCore->ppuThread[hCore->currentThread].GPR[rS] = value;
+  hCore->curThread->GPR[rS] = value;
 }
 
 void PPCInterpreter::PPCInterpreter_mtspr(PPU_STATE *hCore) {
   XFX_FORM_rD_spr;
+
+  std::unique_lock<std::recursive_mutex> coreLock;
+  if (ppcIsCoreSPR(spr)) {
+    coreLock = ppcLockCore(hCore);
+  }
+
   switch (spr) {
   case SPR_DEC:
-    hCore->ppuThread[hCore->currentThread].SPR.DEC =
-        static_cast<u32>(hCore->ppuThread[hCore->currentThread].GPR[rD]);
+    // Apply the elapsed time to the old value, then reschedule the underflow.
+    ppcUpdateTimeBase(hCore);
+    hCore->curThread->SPR.DEC =
+        static_cast<u32>(hCore->curThread->GPR[rD]);
+    ppcUpdateTimeBase(hCore);
     break;
   case SPR_SDR1:
-    hCore->SPR.SDR1 = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.SDR1 = hCore->curThread->GPR[rD];
+    mmuInvalidateErats(hCore, PPU_THREAD_BOTH);
     break;
   case SPR_DAR:
-    hCore->ppuThread[hCore->currentThread].SPR.DAR =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.DAR =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_DSISR:
-    hCore->ppuThread[hCore->currentThread].SPR.DSISR =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.DSISR =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_CTR:
-    hCore->ppuThread[hCore->currentThread].SPR.CTR =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->CTR =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_LR:
-    hCore->ppuThread[hCore->currentThread].SPR.LR =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->LR =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_CFAR:
-    hCore->ppuThread[hCore->currentThread].SPR.CFAR =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.CFAR =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_VRSAVE:
-    hCore->ppuThread[hCore->currentThread].SPR.VRSAVE =
-        static_cast<u32>(hCore->ppuThread[hCore->currentThread].GPR[rD]);
+    hCore->curThread->SPR.VRSAVE =
+        static_cast<u32>(hCore->curThread->GPR[rD]);
     break;
   case SPR_LPCR:
-    hCore->SPR.LPCR = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.LPCR = hCore->curThread->GPR[rD];
+    mmuInvalidateErats(hCore, PPU_THREAD_BOTH);
     break;
   case SPR_HID0:
-    hCore->SPR.HID0 = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.HID0 = hCore->curThread->GPR[rD];
     break;
   case SPR_HID1:
-    hCore->SPR.HID1 = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.HID1 = hCore->curThread->GPR[rD];
     break;
   case SPR_HID4:
-    hCore->SPR.HID4 = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.HID4 = hCore->curThread->GPR[rD];
     break;
   case SPR_HID6:
-    hCore->SPR.HID6 = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.HID6 = hCore->curThread->GPR[rD];
+    mmuInvalidateErats(hCore, PPU_THREAD_BOTH);
     break;
   case SPR_SRR0:
-    hCore->ppuThread[hCore->currentThread].SPR.SRR0 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.SRR0 =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_SRR1:
-    hCore->ppuThread[hCore->currentThread].SPR.SRR1 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.SRR1 =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_HRMOR:
-    hCore->SPR.HRMOR = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.HRMOR = hCore->curThread->GPR[rD];
+    mmuInvalidateErats(hCore, PPU_THREAD_BOTH);
     break;
   case SPR_PpeTlbIndex:
-    hCore->SPR.PPE_TLB_Index = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.PPE_TLB_Index = hCore->curThread->GPR[rD];
     break;
   case SPR_PpeTlbRpn:
-    hCore->SPR.PPE_TLB_RPN = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.PPE_TLB_RPN = hCore->curThread->GPR[rD];
     break;
   case SPR_PpeTlbVpn:
-    hCore->SPR.PPE_TLB_VPN = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.PPE_TLB_VPN = hCore->curThread->GPR[rD];
     mmuAddTlbEntry(hCore);
+    mmuInvalidateErats(hCore, PPU_THREAD_BOTH);
     break;
   case SPR_TTR:
-    hCore->SPR.TTR = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.TTR = hCore->curThread->GPR[rD];
     break;
   case SPR_TSCR:
-    hCore->SPR.TSCR = (u32)hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.TSCR = (u32)hCore->curThread->GPR[rD];
     break;
   case SPR_HSPRG0:
-    hCore->ppuThread[hCore->currentThread].SPR.HSPRG0 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.HSPRG0 =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_HSPRG1:
-    hCore->ppuThread[hCore->currentThread].SPR.HSPRG1 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.HSPRG1 =
+        hCore->curThread->GPR[rD];
     break;
-  case SPR_CTRLWR:
-    hCore->SPR.CTRL = (u32)hCore->ppuThread[hCore->currentThread].GPR[rD]; 
+  case SPR_CTRLWR: {
     // Also do the write on SPR_CTRLRD
+    std::atomic_ref<u32> CTRL(hCore->SPR.CTRL);
+    const u32 newCTRL = (u32)hCore->curThread->GPR[rD];
+    const u32 startedThreads =
+        newCTRL & ~CTRL.load(std::memory_order_relaxed) & 0xC00000;
+    CTRL.store(newCTRL, std::memory_order_relaxed);
+    // A thread running on its own host thread is parked while disabled.
+    if (startedThreads && hCore->smtHostThreads &&
+        intXCPUContext->threadStartCallback) {
+      u8 ppeMask = 0;
+      if (startedThreads & 0x800000) { // CTRL[TE0]
+        ppeMask |= 1 << hCore->ppuThread[PPU_THREAD_0].SPR.PIR;
+      }
+      if (startedThreads & 0x400000) { // CTRL[TE1]
+        ppeMask |= 1 << hCore->ppuThread[PPU_THREAD_1].SPR.PIR;
+      }
+      intXCPUContext->threadStartCallback(ppeMask);
+    }
     break;
+  }
   case SPR_RMOR:
-    hCore->SPR.RMOR = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.RMOR = hCore->curThread->GPR[rD];
+    mmuInvalidateErats(hCore, PPU_THREAD_BOTH);
     break;
   case SPR_HDEC:
-    hCore->SPR.HDEC = (u32)hCore->ppuThread[hCore->currentThread].GPR[rD];
+    ppcUpdateTimeBase(hCore);
+    hCore->SPR.HDEC = (u32)hCore->curThread->GPR[rD];
+    ppcUpdateTimeBase(hCore);
     break;
   case SPR_LPIDR:
-    hCore->SPR.LPIDR = (u32)hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->SPR.LPIDR = (u32)hCore->curThread->GPR[rD];
     break;
   case SPR_SPRG0:
-    hCore->ppuThread[hCore->currentThread].SPR.SPRG0 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.SPRG0 =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_SPRG1:
-    hCore->ppuThread[hCore->currentThread].SPR.SPRG1 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.SPRG1 =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_SPRG2:
-    hCore->ppuThread[hCore->currentThread].SPR.SPRG2 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.SPRG2 =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_SPRG3:
-    hCore->ppuThread[hCore->currentThread].SPR.SPRG3 =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.SPRG3 =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_DABR:
-    hCore->ppuThread[hCore->currentThread].SPR.DABR =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.DABR =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_DABRX:
-    hCore->ppuThread[hCore->currentThread].SPR.DABRX =
-        hCore->ppuThread[hCore->currentThread].GPR[rD];
+    hCore->curThread->SPR.DABRX =
+        hCore->curThread->GPR[rD];
     break;
   case SPR_XER:
-    hCore->ppuThread[hCore->currentThread].SPR.XER.XER_Hex =
-        static_cast<u32>(hCore->ppuThread[hCore->currentThread].GPR[rD]);
+    hCore->curThread->XER.XER_Hex =
+        static_cast<u32>(hCore->curThread->GPR[rD]);
     break;
   case SPR_TBL_WO:
-    hCore->SPR.TB = hCore->ppuThread[hCore->currentThread].GPR[rD];
+    ppcUpdateTimeBase(hCore);
+    hCore->SPR.TB = hCore->curThread->GPR[rD];
     break;
   case SPR_TBU_WO:
+    ppcUpdateTimeBase(hCore);
     hCore->SPR.TB = hCore->SPR.TB |=
-        (hCore->ppuThread[hCore->currentThread].GPR[rD] << 32);
+        (hCore->curThread->GPR[rD] << 32);
     break;
   default:
     LOG_ERROR(Xenon, "{}(Thrd{:#d}) SPR {:#x} ={:#x}", hCore->ppuName, (u8)hCore->currentThread,
-        spr, hCore->ppuThread[hCore->currentThread].GPR[rD]);
+        spr, hCore->curThread->GPR[rD]);
     break;
   }
 }
 
 void PPCInterpreter::PPCInterpreter_mfmsr(PPU_STATE *hCore) {
   X_FORM_rD;
-  hCore->ppuThread[hCore->currentThread].GPR[rD] =
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.MSR_Hex;
+  hCore->curThread->GPR[rD] =
+      hCore->curThread->MSR.MSR_Hex;
 }
 
 void PPCInterpreter::PPCInterpreter_mtmsr(PPU_STATE *hCore) {
   X_FORM_rS;
 
-  hCore->ppuThread[hCore->currentThread].SPR.MSR.MSR_Hex =
-      hCore->ppuThread[hCore->currentThread].GPR[rS];
+  hCore->curThread->MSR.MSR_Hex =
+      hCore->curThread->GPR[rS];
+  mmuInvalidateErats(hCore, hCore->currentThread);
 }
 
 void PPCInterpreter::PPCInterpreter_mtmsrd(PPU_STATE *hCore) {
@@ -470,16 +566,16 @@ void PPCInterpreter::PPCInterpreter_mtmsrd(PPU_STATE *hCore) {
     */
 
     // Bit 48 = MSR[EE]
-    if ((hCore->ppuThread[hCore->currentThread].GPR[rS] & 0x8000) == 0x8000) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.EE = 1;
+    if ((hCore->curThread->GPR[rS] & 0x8000) == 0x8000) {
+      hCore->curThread->MSR.EE = 1;
     } else {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.EE = 0;
+      hCore->curThread->MSR.EE = 0;
     }
     // Bit 62 = MSR[RI]
-    if ((hCore->ppuThread[hCore->currentThread].GPR[rS] & 0x2) == 0x2) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.RI = 1;
+    if ((hCore->curThread->GPR[rS] & 0x2) == 0x2) {
+      hCore->curThread->MSR.RI = 1;
     } else {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.RI = 0;
+      hCore->curThread->MSR.RI = 0;
     }
   } else // L = 0
   {
@@ -491,42 +587,49 @@ void PPCInterpreter::PPCInterpreter_mtmsrd(PPU_STATE *hCore) {
        Bits 1:2, 4:47, 49:50, 52:57, and 60:63 of register RS are placed into
        the corresponding bits of the MSR.
     */
-    u64 regRS = hCore->ppuThread[hCore->currentThread].GPR[rS];
-    hCore->ppuThread[hCore->currentThread].SPR.MSR.MSR_Hex = regRS;
+    u64 regRS = hCore->curThread->GPR[rS];
+    hCore->curThread->MSR.MSR_Hex = regRS;
 
     // MSR0 = (RS)0 | (RS)1
     if ((regRS & 0x8000000000000000) || (regRS & 0x4000000000000000)) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.SF = 1;
+      hCore->curThread->MSR.SF = 1;
     } else {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.SF = 0;
+      hCore->curThread->MSR.SF = 0;
     }
 
     // MSR48 = (RS)48 | (RS)49
     if ((regRS & 0x8000) || (regRS & 0x4000)) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.EE = 1;
+      hCore->curThread->MSR.EE = 1;
     } else {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.EE = 0;
+      hCore->curThread->MSR.EE = 0;
     }
 
     // MSR58 = (RS)58 | (RS)49
     if ((regRS & 0x20) || (regRS & 0x4000)) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.IR = 1;
+      hCore->curThread->MSR.IR = 1;
     } else {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.IR = 0;
+      hCore->curThread->MSR.IR = 0;
     }
 
     // MSR59 = (RS)59 | (RS)49
     if ((regRS & 0x10) || (regRS & 0x4000)) {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.DR = 1;
+      hCore->curThread->MSR.DR = 1;
     } else {
-      hCore->ppuThread[hCore->currentThread].SPR.MSR.DR = 0;
+      hCore->curThread->MSR.DR = 0;
     }
+    mmuInvalidateErats(hCore, hCore->currentThread);
   }
 }
 
-void PPCInterpreter::PPCInterpreter_sync(PPU_STATE* hCore)
-{
-    // Do nothing.
+void PPCInterpreter::PPCInterpreter_sync(PPU_STATE *hCore) {
+  X_FORM_L;
+
+  // lwsync (L = 1) doesn't order stores with later loads, sync does.
+  if (L) {
+    std::atomic_thread_fence(std::memory_order_acq_rel);
+  } else {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
 }
 
 void PPCInterpreter::PPCInterpreter_dcbf(PPU_STATE* hCore)
@@ -0,0 +1,1924 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#include "Base/Arch.h"
+#include "Base/Logging/Log.h"
+#include "PPCInterpreter.h"
+
+#ifdef ARCH_X86_64
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+/*
+ *	PPC_VMX.cpp Vector (VMX and VMX128) instructions.
+ *
+ *	Every operation is a kernel working on whole registers, shared by the
+ *	VMX form and the VMX128 form of the instruction. Kernels use SSE2 on x86-64
+ *	hosts where it maps directly to the guest operation, and plain loops over
+ *	the elements elsewhere. Byte shuffles use SSSE3 when the host has it.
+ *	Registers are kept in host order (see VRegister), so only the kernels where
+ *	the element position matters need to care about it.
+ */
+
+#define VR(x) hCore->curThread->VR[x]
+#define VSCR hCore->curThread->VSCR
+#define GPR(x) hCore->curThread->GPR[x]
+
+// Guest element i of a vector register.
+#define VMX_B(v, i) (v).b[15 - (i)]
+#define VMX_H(v, i) (v).h[7 - (i)]
+#define VMX_W(v, i) (v).w[3 - (i)]
+#define VMX_F(v, i) (v).f[3 - (i)]
+
+static inline bool vmxAvailable(PPU_STATE *hCore) {
+  if (hCore->curThread->MSR.VXU != 1) {
+    hCore->curThread->exceptReg |= PPU_EX_VXU;
+    return false;
+  }
+  return true;
+}
+
+#define VMX_CHECK_AVAILABLE                                                    \
+  if (!vmxAvailable(hCore)) {                                                  \
+    return;                                                                    \
+  }
+
+//
+// Element helpers
+//
+
+template <typename T> static inline T *vmxElements(VRegister &v) {
+  return reinterpret_cast<T *>(&v);
+}
+template <typename T> static inline const T *vmxElements(const VRegister &v) {
+  return reinterpret_cast<const T *>(&v);
+}
+
+// Applies op to every pair of elements of vA and vB.
+template <typename T, typename F>
+static inline void vmxMap(VRegister &vD, const VRegister &vA,
+                          const VRegister &vB, F op) {
+  VRegister result;
+  const T *a = vmxElements<T>(vA);
+  const T *b = vmxElements<T>(vB);
+  T *d = vmxElements<T>(result);
+  for (u32 i = 0; i < sizeof(VRegister) / sizeof(T); i++) {
+    d[i] = static_cast<T>(op(a[i], b[i]));
+  }
+  vD = result;
+}
+
+// Clamps value to the range of T, flagging saturation.
+template <typename T> static inline T vmxSaturate(s64 value, bool &sat) {
+  constexpr s64 minValue = static_cast<s64>(std::numeric_limits<T>::min());
+  constexpr s64 maxValue = static_cast<s64>(std::numeric_limits<T>::max());
+  if (value < minValue) {
+    sat = true;
+    return static_cast<T>(minValue);
+  }
+  if (value > maxValue) {
+    sat = true;
+    return static_cast<T>(maxValue);
+  }
+  return static_cast<T>(value);
+}
+
+// Like vmxMap, op returns the exact result which is saturated to T.
+template <typename T, typename F>
+static inline void vmxMapSaturate(VSCRegister &vscr, VRegister &vD,
+                                  const VRegister &vA, const VRegister &vB,
+                                  F op) {
+  VRegister result;
+  const T *a = vmxElements<T>(vA);
+  const T *b = vmxElements<T>(vB);
+  T *d = vmxElements<T>(result);
+  bool sat = false;
+  for (u32 i = 0; i < sizeof(VRegister) / sizeof(T); i++) {
+    d[i] = vmxSaturate<T>(op(a[i], b[i]), sat);
+  }
+  if (sat) {
+    vscr.SAT = 1;
+  }
+  vD = result;
+}
+
+// Denormals are flushed to zero (keeping the sign) in non-Java mode.
+static inline f32 vmxFlush(const VSCRegister &vscr, f32 value) {
+  if (vscr.NJ && std::fpclassify(value) == FP_SUBNORMAL) {
+    return std::copysign(0.0f, value);
+  }
+  return value;
+}
+
+template <typename F>
+static inline void vmxMapFloat(const VSCRegister &vscr, VRegister &vD,
+                               const VRegister &vA, const VRegister &vB,
+                               F op) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    result.f[i] = vmxFlush(
+        vscr, op(vmxFlush(vscr, vA.f[i]), vmxFlush(vscr, vB.f[i])));
+  }
+  vD = result;
+}
+
+#ifdef ARCH_X86_64
+static inline __m128i vmxLoad(const VRegister &v) {
+  return _mm_load_si128(reinterpret_cast<const __m128i *>(&v));
+}
+static inline void vmxStore(VRegister &v, __m128i value) {
+  _mm_store_si128(reinterpret_cast<__m128i *>(&v), value);
+}
+static inline __m128 vmxLoadFloat(const VSCRegister &vscr,
+                                  const VRegister &v) {
+  const __m128 value = _mm_load_ps(v.f);
+  if (!vscr.NJ) {
+    return value;
+  }
+  // Clear everything but the sign of denormals.
+  const __m128 magnitudeMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+  const __m128 denormal =
+      _mm_cmplt_ps(_mm_and_ps(value, magnitudeMask), _mm_set1_ps(FLT_MIN));
+  return _mm_andnot_ps(_mm_and_ps(denormal, magnitudeMask), value);
+}
+static inline void vmxStoreFloat(const VSCRegister &vscr, VRegister &v,
+                                 __m128 value) {
+  _mm_store_ps(v.f, value);
+  if (vscr.NJ) {
+    vmxStore(v, _mm_castps_si128(vmxLoadFloat(vscr, v)));
+  }
+}
+// Sets SAT if the saturated and wrapped results differ anywhere.
+static inline void vmxCheckSaturate(VSCRegister &vscr, __m128i saturated,
+                                    __m128i wrapped) {
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(saturated, wrapped)) != 0xFFFF) {
+    vscr.SAT = 1;
+  }
+}
+
+// SSSE3 kernels are built for it whatever the compiler targets, and only run
+// when the host has it.
+#if defined(__GNUC__) || defined(__clang__)
+#define VMX_SSSE3 __attribute__((target("ssse3")))
+#else
+#define VMX_SSSE3
+#endif
+
+static bool vmxHostHasSSSE3() {
+#ifdef _MSC_VER
+  int cpuInfo[4] = {};
+  __cpuid(cpuInfo, 1);
+  return (cpuInfo[2] & (1 << 9)) != 0;
+#else
+  u32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+  return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3) != 0;
+#endif
+}
+static const bool vmxSSSE3 = vmxHostHasSSSE3();
+
+// Guest byte i lives in host byte 15 - i, so the low 4 bits of an inverted
+// selector index the byte within vA or vB, and bit 4 picks one of them.
+VMX_SSSE3 static __m128i vmxPermuteSSSE3(__m128i a, __m128i b, __m128i c) {
+  const __m128i index = _mm_andnot_si128(c, _mm_set1_epi8(0x0F));
+  const __m128i selectB = _mm_cmpeq_epi8(
+      _mm_and_si128(c, _mm_set1_epi8(0x10)), _mm_set1_epi8(0x10));
+  return _mm_or_si128(_mm_andnot_si128(selectB, _mm_shuffle_epi8(a, index)),
+                      _mm_and_si128(selectB, _mm_shuffle_epi8(b, index)));
+}
+// Host byte j of the result is byte j + 16 - sh of vB:vA, vA being the upper
+// half. Indices with bit 7 set select zero.
+VMX_SSSE3 static __m128i vmxShiftLeftDoubleSSSE3(__m128i a, __m128i b,
+                                                 u32 sh) {
+  const __m128i index =
+      _mm_add_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+                                 14, 15),
+                   _mm_set1_epi8(static_cast<s8>(16 - sh)));
+  const __m128i indexB =
+      _mm_or_si128(index, _mm_cmpgt_epi8(index, _mm_set1_epi8(15)));
+  const __m128i indexA = _mm_sub_epi8(index, _mm_set1_epi8(16));
+  return _mm_or_si128(_mm_shuffle_epi8(a, indexA),
+                      _mm_shuffle_epi8(b, indexB));
+}
+#endif
+
+// Shifts a whole register left (towards guest element 0) or right.
+static inline VRegister vmxShiftLeftBits(const VRegister &v, u32 bits) {
+  VRegister result;
+  if (bits >= 128) {
+    result.dw[1] = 0;
+    result.dw[0] = 0;
+  } else if (bits >= 64) {
+    result.dw[1] = v.dw[0] << (bits - 64);
+    result.dw[0] = 0;
+  } else if (bits != 0) {
+    result.dw[1] = (v.dw[1] << bits) | (v.dw[0] >> (64 - bits));
+    result.dw[0] = v.dw[0] << bits;
+  } else {
+    result = v;
+  }
+  return result;
+}
+static inline VRegister vmxShiftRightBits(const VRegister &v, u32 bits) {
+  VRegister result;
+  if (bits >= 128) {
+    result.dw[1] = 0;
+    result.dw[0] = 0;
+  } else if (bits >= 64) {
+    result.dw[0] = v.dw[1] >> (bits - 64);
+    result.dw[1] = 0;
+  } else if (bits != 0) {
+    result.dw[0] = (v.dw[0] >> bits) | (v.dw[1] << (64 - bits));
+    result.dw[1] = v.dw[1] >> bits;
+  } else {
+    result = v;
+  }
+  return result;
+}
+
+//
+// Kernels
+//
+
+#define VMX_KERNEL(name)                                                       \
+  static void vmx_##name([[maybe_unused]] VSCRegister &vscr, VRegister &vD,    \
+                         const VRegister &vA, const VRegister &vB)
+
+// Integer Arithmetic
+
+VMX_KERNEL(vaddubm) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_add_epi8(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u8>(vD, vA, vB, [](u8 a, u8 b) { return a + b; });
+#endif
+}
+VMX_KERNEL(vadduhm) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_add_epi16(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u16>(vD, vA, vB, [](u16 a, u16 b) { return a + b; });
+#endif
+}
+VMX_KERNEL(vadduwm) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_add_epi32(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u32>(vD, vA, vB, [](u32 a, u32 b) { return a + b; });
+#endif
+}
+VMX_KERNEL(vsububm) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_sub_epi8(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u8>(vD, vA, vB, [](u8 a, u8 b) { return a - b; });
+#endif
+}
+VMX_KERNEL(vsubuhm) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_sub_epi16(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u16>(vD, vA, vB, [](u16 a, u16 b) { return a - b; });
+#endif
+}
+VMX_KERNEL(vsubuwm) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_sub_epi32(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u32>(vD, vA, vB, [](u32 a, u32 b) { return a - b; });
+#endif
+}
+VMX_KERNEL(vaddcuw) {
+  vmxMap<u32>(vD, vA, vB, [](u32 a, u32 b) { return a + b < a ? 1 : 0; });
+}
+VMX_KERNEL(vsubcuw) {
+  vmxMap<u32>(vD, vA, vB, [](u32 a, u32 b) { return a >= b ? 1 : 0; });
+}
+
+#ifdef ARCH_X86_64
+#define VMX_SATURATE_KERNEL(name, T, sseSat, sseWrap, op)                      \
+  VMX_KERNEL(name) {                                                           \
+    const __m128i a = vmxLoad(vA);                                             \
+    const __m128i b = vmxLoad(vB);                                             \
+    const __m128i result = sseSat(a, b);                                       \
+    vmxCheckSaturate(vscr, result, sseWrap(a, b));                             \
+    vmxStore(vD, result);                                                      \
+  }
+#else
+#define VMX_SATURATE_KERNEL(name, T, sseSat, sseWrap, op)                      \
+  VMX_KERNEL(name) {                                                           \
+    vmxMapSaturate<T>(vscr, vD, vA, vB,                                        \
+                      [](T a, T b) { return static_cast<s64>(a) op b; });      \
+  }
+#endif
+
+VMX_SATURATE_KERNEL(vaddubs, u8, _mm_adds_epu8, _mm_add_epi8, +)
+VMX_SATURATE_KERNEL(vadduhs, u16, _mm_adds_epu16, _mm_add_epi16, +)
+VMX_SATURATE_KERNEL(vaddsbs, s8, _mm_adds_epi8, _mm_add_epi8, +)
+VMX_SATURATE_KERNEL(vaddshs, s16, _mm_adds_epi16, _mm_add_epi16, +)
+VMX_SATURATE_KERNEL(vsububs, u8, _mm_subs_epu8, _mm_sub_epi8, -)
+VMX_SATURATE_KERNEL(vsubuhs, u16, _mm_subs_epu16, _mm_sub_epi16, -)
+VMX_SATURATE_KERNEL(vsubsbs, s8, _mm_subs_epi8, _mm_sub_epi8, -)
+VMX_SATURATE_KERNEL(vsubshs, s16, _mm_subs_epi16, _mm_sub_epi16, -)
+
+VMX_KERNEL(vadduws) {
+  vmxMapSaturate<u32>(vscr, vD, vA, vB,
+                      [](u32 a, u32 b) { return static_cast<s64>(a) + b; });
+}
+VMX_KERNEL(vaddsws) {
+  vmxMapSaturate<s32>(vscr, vD, vA, vB,
+                      [](s32 a, s32 b) { return static_cast<s64>(a) + b; });
+}
+VMX_KERNEL(vsubuws) {
+  vmxMapSaturate<u32>(vscr, vD, vA, vB,
+                      [](u32 a, u32 b) { return static_cast<s64>(a) - b; });
+}
+VMX_KERNEL(vsubsws) {
+  vmxMapSaturate<s32>(vscr, vD, vA, vB,
+                      [](s32 a, s32 b) { return static_cast<s64>(a) - b; });
+}
+
+// Maximum, Minimum and Average
+
+VMX_KERNEL(vmaxub) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_max_epu8(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u8>(vD, vA, vB, [](u8 a, u8 b) { return a > b ? a : b; });
+#endif
+}
+VMX_KERNEL(vminub) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_min_epu8(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u8>(vD, vA, vB, [](u8 a, u8 b) { return a < b ? a : b; });
+#endif
+}
+VMX_KERNEL(vmaxsh) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_max_epi16(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<s16>(vD, vA, vB, [](s16 a, s16 b) { return a > b ? a : b; });
+#endif
+}
+VMX_KERNEL(vminsh) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_min_epi16(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<s16>(vD, vA, vB, [](s16 a, s16 b) { return a < b ? a : b; });
+#endif
+}
+VMX_KERNEL(vmaxsb) {
+  vmxMap<s8>(vD, vA, vB, [](s8 a, s8 b) { return a > b ? a : b; });
+}
+VMX_KERNEL(vminsb) {
+  vmxMap<s8>(vD, vA, vB, [](s8 a, s8 b) { return a < b ? a : b; });
+}
+VMX_KERNEL(vmaxuh) {
+  vmxMap<u16>(vD, vA, vB, [](u16 a, u16 b) { return a > b ? a : b; });
+}
+VMX_KERNEL(vminuh) {
+  vmxMap<u16>(vD, vA, vB, [](u16 a, u16 b) { return a < b ? a : b; });
+}
+VMX_KERNEL(vmaxsw) {
+  vmxMap<s32>(vD, vA, vB, [](s32 a, s32 b) { return a > b ? a : b; });
+}
+VMX_KERNEL(vminsw) {
+  vmxMap<s32>(vD, vA, vB, [](s32 a, s32 b) { return a < b ? a : b; });
+}
+VMX_KERNEL(vmaxuw) {
+  vmxMap<u32>(vD, vA, vB, [](u32 a, u32 b) { return a > b ? a : b; });
+}
+VMX_KERNEL(vminuw) {
+  vmxMap<u32>(vD, vA, vB, [](u32 a, u32 b) { return a < b ? a : b; });
+}
+
+VMX_KERNEL(vavgub) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_avg_epu8(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u8>(vD, vA, vB, [](u8 a, u8 b) { return (a + b + 1) >> 1; });
+#endif
+}
+VMX_KERNEL(vavguh) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_avg_epu16(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u16>(vD, vA, vB, [](u16 a, u16 b) { return (a + b + 1) >> 1; });
+#endif
+}
+VMX_KERNEL(vavgsb) {
+  vmxMap<s8>(vD, vA, vB, [](s8 a, s8 b) { return (a + b + 1) >> 1; });
+}
+VMX_KERNEL(vavgsh) {
+  vmxMap<s16>(vD, vA, vB, [](s16 a, s16 b) { return (a + b + 1) >> 1; });
+}
+VMX_KERNEL(vavguw) {
+  vmxMap<u32>(vD, vA, vB, [](u32 a, u32 b) {
+    return (static_cast<u64>(a) + b + 1) >> 1;
+  });
+}
+VMX_KERNEL(vavgsw) {
+  vmxMap<s32>(vD, vA, vB, [](s32 a, s32 b) {
+    return (static_cast<s64>(a) + b + 1) >> 1;
+  });
+}
+
+// Integer Multiply, even (E) and odd (O) elements
+
+#define VMX_MULTIPLY_KERNEL(name, T, R, get, set, odd)                         \
+  VMX_KERNEL(name) {                                                           \
+    VRegister result;                                                          \
+    for (u32 i = 0; i < sizeof(VRegister) / sizeof(R); i++) {                  \
+      const R a = static_cast<T>(get(vA, i * 2 + odd));                        \
+      const R b = static_cast<T>(get(vB, i * 2 + odd));                        \
+      set(result, i) = static_cast<R>(a * b);                                  \
+    }                                                                          \
+    vD = result;                                                               \
+  }
+
+VMX_MULTIPLY_KERNEL(vmuleub, u8, u16, VMX_B, VMX_H, 0)
+VMX_MULTIPLY_KERNEL(vmuloub, u8, u16, VMX_B, VMX_H, 1)
+VMX_MULTIPLY_KERNEL(vmulesb, s8, s16, VMX_B, VMX_H, 0)
+VMX_MULTIPLY_KERNEL(vmulosb, s8, s16, VMX_B, VMX_H, 1)
+VMX_MULTIPLY_KERNEL(vmuleuh, u16, u32, VMX_H, VMX_W, 0)
+VMX_MULTIPLY_KERNEL(vmulouh, u16, u32, VMX_H, VMX_W, 1)
+VMX_MULTIPLY_KERNEL(vmulesh, s16, s32, VMX_H, VMX_W, 0)
+VMX_MULTIPLY_KERNEL(vmulosh, s16, s32, VMX_H, VMX_W, 1)
+
+// Sums across elements
+
+VMX_KERNEL(vsum4ubs) {
+  VRegister result;
+  bool sat = false;
+  for (u32 i = 0; i < 4; i++) {
+    s64 sum = VMX_W(vB, i);
+    for (u32 j = 0; j < 4; j++) {
+      sum += VMX_B(vA, i * 4 + j);
+    }
+    VMX_W(result, i) = vmxSaturate<u32>(sum, sat);
+  }
+  if (sat) {
+    vscr.SAT = 1;
+  }
+  vD = result;
+}
+VMX_KERNEL(vsum4sbs) {
+  VRegister result;
+  bool sat = false;
+  for (u32 i = 0; i < 4; i++) {
+    s64 sum = static_cast<s32>(VMX_W(vB, i));
+    for (u32 j = 0; j < 4; j++) {
+      sum += static_cast<s8>(VMX_B(vA, i * 4 + j));
+    }
+    VMX_W(result, i) = vmxSaturate<s32>(sum, sat);
+  }
+  if (sat) {
+    vscr.SAT = 1;
+  }
+  vD = result;
+}
+VMX_KERNEL(vsum4shs) {
+  VRegister result;
+  bool sat = false;
+  for (u32 i = 0; i < 4; i++) {
+    const s64 sum = static_cast<s64>(static_cast<s32>(VMX_W(vB, i))) +
+                    static_cast<s16>(VMX_H(vA, i * 2)) +
+                    static_cast<s16>(VMX_H(vA, i * 2 + 1));
+    VMX_W(result, i) = vmxSaturate<s32>(sum, sat);
+  }
+  if (sat) {
+    vscr.SAT = 1;
+  }
+  vD = result;
+}
+VMX_KERNEL(vsum2sws) {
+  VRegister result{};
+  bool sat = false;
+  for (u32 i = 1; i < 4; i += 2) {
+    const s64 sum = static_cast<s64>(static_cast<s32>(VMX_W(vB, i))) +
+                    static_cast<s32>(VMX_W(vA, i - 1)) +
+                    static_cast<s32>(VMX_W(vA, i));
+    VMX_W(result, i) = vmxSaturate<s32>(sum, sat);
+  }
+  if (sat) {
+    vscr.SAT = 1;
+  }
+  vD = result;
+}
+VMX_KERNEL(vsumsws) {
+  VRegister result{};
+  bool sat = false;
+  s64 sum = static_cast<s32>(VMX_W(vB, 3));
+  for (u32 i = 0; i < 4; i++) {
+    sum += static_cast<s32>(VMX_W(vA, i));
+  }
+  VMX_W(result, 3) = vmxSaturate<s32>(sum, sat);
+  if (sat) {
+    vscr.SAT = 1;
+  }
+  vD = result;
+}
+
+// Logical
+
+VMX_KERNEL(vand) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_and_si128(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u64>(vD, vA, vB, [](u64 a, u64 b) { return a & b; });
+#endif
+}
+VMX_KERNEL(vandc) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_andnot_si128(vmxLoad(vB), vmxLoad(vA)));
+#else
+  vmxMap<u64>(vD, vA, vB, [](u64 a, u64 b) { return a & ~b; });
+#endif
+}
+VMX_KERNEL(vor) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_or_si128(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u64>(vD, vA, vB, [](u64 a, u64 b) { return a | b; });
+#endif
+}
+VMX_KERNEL(vnor) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_xor_si128(_mm_or_si128(vmxLoad(vA), vmxLoad(vB)),
+                             _mm_set1_epi32(-1)));
+#else
+  vmxMap<u64>(vD, vA, vB, [](u64 a, u64 b) { return ~(a | b); });
+#endif
+}
+VMX_KERNEL(vxor) {
+#ifdef ARCH_X86_64
+  vmxStore(vD, _mm_xor_si128(vmxLoad(vA), vmxLoad(vB)));
+#else
+  vmxMap<u64>(vD, vA, vB, [](u64 a, u64 b) { return a ^ b; });
+#endif
+}
+
+// vD = (vA & ~vC) | (vB & vC)
+static inline void vmxSelect(VRegister &vD, const VRegister &vA,
+                             const VRegister &vB, const VRegister &vC) {
+#ifdef ARCH_X86_64
+  const __m128i mask = vmxLoad(vC);
+  vmxStore(vD, _mm_or_si128(_mm_andnot_si128(mask, vmxLoad(vA)),
+                            _mm_and_si128(mask, vmxLoad(vB))));
+#else
+  VRegister result;
+  for (u32 i = 0; i < 2; i++) {
+    result.dw[i] = (vA.dw[i] & ~vC.dw[i]) | (vB.dw[i] & vC.dw[i]);
+  }
+  vD = result;
+#endif
+}
+
+// Shift and Rotate, each element by the low bits of the same vB element.
+
+#define VMX_SHIFT_KERNEL(name, T, op)                                          \
+  VMX_KERNEL(name) {                                                           \
+    vmxMap<T>(vD, vA, vB, [](T a, T b) {                                       \
+      constexpr u32 bits = sizeof(T) * 8;                                      \
+      const u32 sh = b & (bits - 1);                                           \
+      return op;                                                               \
+    });                                                                        \
+  }
+
+VMX_SHIFT_KERNEL(vslb, u8, a << sh)
+VMX_SHIFT_KERNEL(vslh, u16, a << sh)
+VMX_SHIFT_KERNEL(vslw, u32, a << sh)
+VMX_SHIFT_KERNEL(vsrb, u8, a >> sh)
+VMX_SHIFT_KERNEL(vsrh, u16, a >> sh)
+VMX_SHIFT_KERNEL(vsrw, u32, a >> sh)
+VMX_SHIFT_KERNEL(vsrab, s8, a >> sh)
+VMX_SHIFT_KERNEL(vsrah, s16, a >> sh)
+VMX_SHIFT_KERNEL(vsraw, s32, a >> sh)
+VMX_SHIFT_KERNEL(vrlb, u8, sh ? (a << sh) | (a >> (bits - sh)) : a)
+VMX_SHIFT_KERNEL(vrlh, u16, sh ? (a << sh) | (a >> (bits - sh)) : a)
+VMX_SHIFT_KERNEL(vrlw, u32, sh ? (a << sh) | (a >> (bits - sh)) : a)
+
+// Whole register shifts, by bits (vsl, vsr) or octets (vslo, vsro) taken from
+// the last byte of vB.
+VMX_KERNEL(vsl) { vD = vmxShiftLeftBits(vA, VMX_B(vB, 15) & 7); }
+VMX_KERNEL(vsr) { vD = vmxShiftRightBits(vA, VMX_B(vB, 15) & 7); }
+VMX_KERNEL(vslo) {
+  vD = vmxShiftLeftBits(vA, ((VMX_B(vB, 15) >> 3) & 0xF) * 8);
+}
+VMX_KERNEL(vsro) {
+  vD = vmxShiftRightBits(vA, ((VMX_B(vB, 15) >> 3) & 0xF) * 8);
+}
+
+// Compare, elements are set to all ones when true.
+
+#ifdef ARCH_X86_64
+#define VMX_COMPARE_KERNEL(name, T, op, sse)                                   \
+  VMX_KERNEL(name) { vmxStore(vD, sse); }
+#else
+#define VMX_COMPARE_KERNEL(name, T, op, sse)                                   \
+  VMX_KERNEL(name) {                                                           \
+    vmxMap<T>(vD, vA, vB, [](T a, T b) { return (op) ? ~0ULL : 0; });          \
+  }
+#endif
+
+#ifdef ARCH_X86_64
+// Unsigned compares, by flipping the sign bits.
+static inline __m128i vmxCompareGtUnsigned8(__m128i a, __m128i b) {
+  const __m128i sign = _mm_set1_epi8(static_cast<s8>(0x80));
+  return _mm_cmpgt_epi8(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+}
+static inline __m128i vmxCompareGtUnsigned16(__m128i a, __m128i b) {
+  const __m128i sign = _mm_set1_epi16(static_cast<s16>(0x8000));
+  return _mm_cmpgt_epi16(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+}
+static inline __m128i vmxCompareGtUnsigned32(__m128i a, __m128i b) {
+  const __m128i sign = _mm_set1_epi32(static_cast<s32>(0x80000000));
+  return _mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+}
+#endif
+
+VMX_COMPARE_KERNEL(vcmpequb, u8, a == b,
+                   _mm_cmpeq_epi8(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpequh, u16, a == b,
+                   _mm_cmpeq_epi16(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpequw, u32, a == b,
+                   _mm_cmpeq_epi32(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpgtsb, s8, a > b,
+                   _mm_cmpgt_epi8(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpgtsh, s16, a > b,
+                   _mm_cmpgt_epi16(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpgtsw, s32, a > b,
+                   _mm_cmpgt_epi32(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpgtub, u8, a > b,
+                   vmxCompareGtUnsigned8(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpgtuh, u16, a > b,
+                   vmxCompareGtUnsigned16(vmxLoad(vA), vmxLoad(vB)))
+VMX_COMPARE_KERNEL(vcmpgtuw, u32, a > b,
+                   vmxCompareGtUnsigned32(vmxLoad(vA), vmxLoad(vB)))
+
+#ifdef ARCH_X86_64
+#define VMX_COMPARE_FLOAT_KERNEL(name, op, sse)                                \
+  VMX_KERNEL(name) {                                                           \
+    vmxStore(vD, _mm_castps_si128(sse(vmxLoadFloat(vscr, vA),                  \
+                                      vmxLoadFloat(vscr, vB))));               \
+  }
+#else
+#define VMX_COMPARE_FLOAT_KERNEL(name, op, sse)                                \
+  VMX_KERNEL(name) {                                                           \
+    VRegister result;                                                          \
+    for (u32 i = 0; i < 4; i++) {                                              \
+      const f32 a = vmxFlush(vscr, vA.f[i]);                                   \
+      const f32 b = vmxFlush(vscr, vB.f[i]);                                   \
+      result.w[i] = (op) ? 0xFFFFFFFF : 0;                                     \
+    }                                                                          \
+    vD = result;                                                               \
+  }
+#endif
+
+VMX_COMPARE_FLOAT_KERNEL(vcmpeqfp, a == b, _mm_cmpeq_ps)
+VMX_COMPARE_FLOAT_KERNEL(vcmpgefp, a >= b, _mm_cmpge_ps)
+VMX_COMPARE_FLOAT_KERNEL(vcmpgtfp, a > b, _mm_cmpgt_ps)
+
+// Bounds compare, bit 0 is set if a > b, bit 1 if a < -b. NaN's set both.
+VMX_KERNEL(vcmpbfp) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    const f32 a = vmxFlush(vscr, vA.f[i]);
+    const f32 b = vmxFlush(vscr, vB.f[i]);
+    result.w[i] = (!(a <= b) ? 0x80000000 : 0) | (!(a >= -b) ? 0x40000000 : 0);
+  }
+  vD = result;
+}
+
+// Floating Point
+
+VMX_KERNEL(vaddfp) {
+#ifdef ARCH_X86_64
+  vmxStoreFloat(vscr, vD,
+                _mm_add_ps(vmxLoadFloat(vscr, vA), vmxLoadFloat(vscr, vB)));
+#else
+  vmxMapFloat(vscr, vD, vA, vB, [](f32 a, f32 b) { return a + b; });
+#endif
+}
+VMX_KERNEL(vsubfp) {
+#ifdef ARCH_X86_64
+  vmxStoreFloat(vscr, vD,
+                _mm_sub_ps(vmxLoadFloat(vscr, vA), vmxLoadFloat(vscr, vB)));
+#else
+  vmxMapFloat(vscr, vD, vA, vB, [](f32 a, f32 b) { return a - b; });
+#endif
+}
+VMX_KERNEL(vmulfp) {
+#ifdef ARCH_X86_64
+  vmxStoreFloat(vscr, vD,
+                _mm_mul_ps(vmxLoadFloat(vscr, vA), vmxLoadFloat(vscr, vB)));
+#else
+  vmxMapFloat(vscr, vD, vA, vB, [](f32 a, f32 b) { return a * b; });
+#endif
+}
+
+#ifdef ARCH_X86_64
+// SSE returns the second operand if either is a NaN, VMX returns the NaN.
+static inline __m128 vmxMinMaxNaN(__m128 a, __m128 b, __m128 result) {
+  const __m128 nan = _mm_cmpunord_ps(a, b);
+  return _mm_or_ps(_mm_andnot_ps(nan, result),
+                   _mm_and_ps(nan, _mm_add_ps(a, b)));
+}
+#endif
+
+VMX_KERNEL(vmaxfp) {
+#ifdef ARCH_X86_64
+  const __m128 a = vmxLoadFloat(vscr, vA);
+  const __m128 b = vmxLoadFloat(vscr, vB);
+  vmxStoreFloat(vscr, vD, vmxMinMaxNaN(a, b, _mm_max_ps(a, b)));
+#else
+  vmxMapFloat(vscr, vD, vA, vB, [](f32 a, f32 b) {
+    return std::isnan(a) || std::isnan(b) ? a + b : (a > b ? a : b);
+  });
+#endif
+}
+VMX_KERNEL(vminfp) {
+#ifdef ARCH_X86_64
+  const __m128 a = vmxLoadFloat(vscr, vA);
+  const __m128 b = vmxLoadFloat(vscr, vB);
+  vmxStoreFloat(vscr, vD, vmxMinMaxNaN(a, b, _mm_min_ps(a, b)));
+#else
+  vmxMapFloat(vscr, vD, vA, vB, [](f32 a, f32 b) {
+    return std::isnan(a) || std::isnan(b) ? a + b : (a < b ? a : b);
+  });
+#endif
+}
+
+// vD = vA * vC + vB, negated for vnmsubfp.
+static inline void vmxMultiplyAdd(VSCRegister &vscr, VRegister &vD,
+                                  const VRegister &vA, const VRegister &vB,
+                                  const VRegister &vC, bool negate) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    const f32 value =
+        std::fma(vmxFlush(vscr, vA.f[i]), vmxFlush(vscr, vC.f[i]),
+                 negate ? -vmxFlush(vscr, vB.f[i]) : vmxFlush(vscr, vB.f[i]));
+    result.f[i] = vmxFlush(vscr, negate ? -value : value);
+  }
+  vD = result;
+}
+
+// Single operand floating point operations on vB.
+#define VMX_FLOAT_UNARY_KERNEL(name, op)                                       \
+  VMX_KERNEL(name) {                                                           \
+    vmxMapFloat(vscr, vD, vB, vB, [](f32 b, f32) { return op; });              \
+  }
+
+VMX_FLOAT_UNARY_KERNEL(vrefp, 1.0f / b)
+VMX_FLOAT_UNARY_KERNEL(vrsqrtefp, 1.0f / std::sqrt(b))
+VMX_FLOAT_UNARY_KERNEL(vexptefp, std::exp2(b))
+VMX_FLOAT_UNARY_KERNEL(vlogefp, std::log2(b))
+VMX_FLOAT_UNARY_KERNEL(vrfin, std::nearbyint(b))
+VMX_FLOAT_UNARY_KERNEL(vrfiz, std::trunc(b))
+VMX_FLOAT_UNARY_KERNEL(vrfip, std::ceil(b))
+VMX_FLOAT_UNARY_KERNEL(vrfim, std::floor(b))
+
+// Fixed point conversions, scaled by 2^uimm.
+static inline void vmxConvertFromUnsigned(VRegister &vD, const VRegister &vB,
+                                          u32 uimm) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    result.f[i] =
+        std::ldexp(static_cast<f32>(vB.w[i]), -static_cast<s32>(uimm));
+  }
+  vD = result;
+}
+static inline void vmxConvertFromSigned(VRegister &vD, const VRegister &vB,
+                                        u32 uimm) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    result.f[i] = std::ldexp(static_cast<f32>(static_cast<s32>(vB.w[i])),
+                             -static_cast<s32>(uimm));
+  }
+  vD = result;
+}
+template <typename T>
+static inline void vmxConvertToFixed(VSCRegister &vscr, VRegister &vD,
+                                     const VRegister &vB, u32 uimm) {
+  VRegister result;
+  bool sat = false;
+  for (u32 i = 0; i < 4; i++) {
+    const f64 value = std::ldexp(static_cast<f64>(vB.f[i]), uimm);
+    if (std::isnan(value)) {
+      result.w[i] = 0;
+    } else if (value >= static_cast<f64>(std::numeric_limits<T>::max())) {
+      result.w[i] = static_cast<u32>(std::numeric_limits<T>::max());
+      sat = true;
+    } else if (value <= static_cast<f64>(std::numeric_limits<T>::min())) {
+      result.w[i] = static_cast<u32>(std::numeric_limits<T>::min());
+      sat = value < static_cast<f64>(std::numeric_limits<T>::min()) || sat;
+    } else {
+      result.w[i] = static_cast<u32>(static_cast<T>(value));
+    }
+  }
+  if (sat) {
+    vscr.SAT = 1;
+  }
+  vD = result;
+}
+
+// Dot products of the first 3 or 4 elements, VMX128 only.
+static inline void vmxDotProduct(VSCRegister &vscr, VRegister &vD,
+                                 const VRegister &vA, const VRegister &vB,
+                                 u32 count) {
+  f32 sum = 0.0f;
+  for (u32 i = 0; i < count; i++) {
+    sum += vmxFlush(vscr, VMX_F(vA, i)) * vmxFlush(vscr, VMX_F(vB, i));
+  }
+  sum = vmxFlush(vscr, sum);
+  for (u32 i = 0; i < 4; i++) {
+    vD.f[i] = sum;
+  }
+}
+
+// Merge
+
+#ifdef ARCH_X86_64
+#define VMX_MERGE_KERNEL(name, get, count, high, sse)                          \
+  VMX_KERNEL(name) { vmxStore(vD, sse(vmxLoad(vB), vmxLoad(vA))); }
+#else
+#define VMX_MERGE_KERNEL(name, get, count, high, sse)                          \
+  VMX_KERNEL(name) {                                                           \
+    VRegister result;                                                          \
+    for (u32 i = 0; i < count / 2; i++) {                                      \
+      get(result, i * 2) = get(vA, i + (high ? 0 : count / 2));                \
+      get(result, i * 2 + 1) = get(vB, i + (high ? 0 : count / 2));            \
+    }                                                                          \
+    vD = result;                                                               \
+  }
+#endif
+
+VMX_MERGE_KERNEL(vmrghb, VMX_B, 16, true, _mm_unpackhi_epi8)
+VMX_MERGE_KERNEL(vmrghh, VMX_H, 8, true, _mm_unpackhi_epi16)
+VMX_MERGE_KERNEL(vmrghw, VMX_W, 4, true, _mm_unpackhi_epi32)
+VMX_MERGE_KERNEL(vmrglb, VMX_B, 16, false, _mm_unpacklo_epi8)
+VMX_MERGE_KERNEL(vmrglh, VMX_H, 8, false, _mm_unpacklo_epi16)
+VMX_MERGE_KERNEL(vmrglw, VMX_W, 4, false, _mm_unpacklo_epi32)
+
+// Pack, vA goes to the first half of vD and vB to the second one.
+
+#define VMX_PACK_KERNEL(name, S, D, getS, getD, count, saturate)               \
+  VMX_KERNEL(name) {                                                           \
+    VRegister result;                                                          \
+    bool sat = false;                                                          \
+    for (u32 i = 0; i < count; i++) {                                          \
+      const S a = static_cast<S>(getS(vA, i));                                 \
+      const S b = static_cast<S>(getS(vB, i));                                 \
+      getD(result, i) = saturate ? vmxSaturate<D>(a, sat) : static_cast<D>(a); \
+      getD(result, i + count) =                                                \
+          saturate ? vmxSaturate<D>(b, sat) : static_cast<D>(b);               \
+    }                                                                          \
+    if (sat) {                                                                 \
+      vscr.SAT = 1;                                                            \
+    }                                                                          \
+    vD = result;                                                               \
+  }
+
+VMX_PACK_KERNEL(vpkuhum, u16, u8, VMX_H, VMX_B, 8, false)
+VMX_PACK_KERNEL(vpkuwum, u32, u16, VMX_W, VMX_H, 4, false)
+VMX_PACK_KERNEL(vpkuhus, u16, u8, VMX_H, VMX_B, 8, true)
+VMX_PACK_KERNEL(vpkuwus, u32, u16, VMX_W, VMX_H, 4, true)
+VMX_PACK_KERNEL(vpkshus, s16, u8, VMX_H, VMX_B, 8, true)
+VMX_PACK_KERNEL(vpkswus, s32, u16, VMX_W, VMX_H, 4, true)
+VMX_PACK_KERNEL(vpkshss, s16, s8, VMX_H, VMX_B, 8, true)
+VMX_PACK_KERNEL(vpkswss, s32, s16, VMX_W, VMX_H, 4, true)
+
+// 8:8:8:8 pixels to 1:5:5:5.
+VMX_KERNEL(vpkpx) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    const u32 a = VMX_W(vA, i);
+    const u32 b = VMX_W(vB, i);
+    VMX_H(result, i) = static_cast<u16>(((a >> 9) & 0xFC00) |
+                                        ((a >> 6) & 0x03E0) | ((a >> 3) & 0x1F));
+    VMX_H(result, i + 4) = static_cast<u16>(
+        ((b >> 9) & 0xFC00) | ((b >> 6) & 0x03E0) | ((b >> 3) & 0x1F));
+  }
+  vD = result;
+}
+
+// Unpack, the high or low half of vB sign extended.
+
+#define VMX_UNPACK_KERNEL(name, S, D, getS, getD, count, high)                 \
+  VMX_KERNEL(name) {                                                           \
+    VRegister result;                                                          \
+    for (u32 i = 0; i < count; i++) {                                          \
+      getD(result, i) = static_cast<D>(                                        \
+          static_cast<S>(getS(vB, i + (high ? 0 : count))));                   \
+    }                                                                          \
+    vD = result;                                                               \
+  }
+
+VMX_UNPACK_KERNEL(vupkhsb, s8, s16, VMX_B, VMX_H, 8, true)
+VMX_UNPACK_KERNEL(vupklsb, s8, s16, VMX_B, VMX_H, 8, false)
+VMX_UNPACK_KERNEL(vupkhsh, s16, s32, VMX_H, VMX_W, 4, true)
+VMX_UNPACK_KERNEL(vupklsh, s16, s32, VMX_H, VMX_W, 4, false)
+
+// 1:5:5:5 pixels to 8:8:8:8, the alpha bit is sign extended.
+static inline u32 vmxUnpackPixel(u16 pixel) {
+  return ((pixel & 0x8000) ? 0xFF000000 : 0) | ((pixel & 0x7C00) << 6) |
+         ((pixel & 0x03E0) << 3) | (pixel & 0x1F);
+}
+VMX_KERNEL(vupkhpx) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    VMX_W(result, i) = vmxUnpackPixel(VMX_H(vB, i));
+  }
+  vD = result;
+}
+VMX_KERNEL(vupklpx) {
+  VRegister result;
+  for (u32 i = 0; i < 4; i++) {
+    VMX_W(result, i) = vmxUnpackPixel(VMX_H(vB, i + 4));
+  }
+  vD = result;
+}
+
+// Direct3D vertex formats (VMX128 only). Integer fields travel as floats
+// biased by 3.0 (1.0 for colors), where the field is the low bits of the
+// mantissa, so they're packed by clamping and taking those bits. The packed
+// value is held in w, or in z:w for the 64 bit formats.
+#define VMX_D3D_D3DCOLOR 0
+#define VMX_D3D_NORMSHORT2 1
+#define VMX_D3D_NORMPACKED32 2
+#define VMX_D3D_FLOAT16_2 3
+#define VMX_D3D_NORMSHORT4 4
+#define VMX_D3D_FLOAT16_4 5
+
+// Field bits of a biased float, clamped to [min, max]. NaN's clamp to max.
+static inline u32 vmxD3DField(f32 value, u32 min, u32 max) {
+  if (!(value <= std::bit_cast<f32>(max))) {
+    return max;
+  }
+  if (!(value >= std::bit_cast<f32>(min))) {
+    return min;
+  }
+  return std::bit_cast<u32>(value);
+}
+
+// Biased float of a signed field, the most negative value has no float
+// counterpart and gives a QNaN.
+static inline u32 vmxD3DSigned(u32 field, u32 bits) {
+  const u32 signBit = 1U << (bits - 1);
+  if ((field & ((1U << bits) - 1)) == signBit) {
+    return 0x7FC00000;
+  }
+  return 0x40400000 + static_cast<u32>(static_cast<s32>(field << (32 - bits)) >>
+                                       (32 - bits));
+}
+
+// IEEE single to half precision, rounding to nearest even.
+static inline u16 vmxFloatToHalf(f32 value) {
+  const u32 bits = std::bit_cast<u32>(value);
+  const u16 sign = static_cast<u16>((bits >> 16) & 0x8000);
+  const s32 exponent = static_cast<s32>((bits >> 23) & 0xFF) - 127 + 15;
+  u32 mantissa = bits & 0x7FFFFF;
+  if (((bits >> 23) & 0xFF) == 0xFF) {
+    // Inf or NaN, NaN's stay quiet.
+    return sign | 0x7C00 | (mantissa ? 0x200 | (mantissa >> 13) : 0);
+  }
+  if (exponent >= 0x1F) {
+    return sign | 0x7C00;
+  }
+  if (exponent <= 0) {
+    // Denormal or zero.
+    if (exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const u32 shift = static_cast<u32>(14 - exponent);
+    u32 half = mantissa >> shift;
+    const u32 rest = mantissa & ((1U << shift) - 1);
+    const u32 halfway = 1U << (shift - 1);
+    if (rest > halfway || (rest == halfway && (half & 1))) {
+      half++;
+    }
+    return sign | static_cast<u16>(half);
+  }
+  u32 half = (static_cast<u32>(exponent) << 10) | (mantissa >> 13);
+  const u32 rest = mantissa & 0x1FFF;
+  if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+    // May carry into the exponent, up to infinity.
+    half++;
+  }
+  return sign | static_cast<u16>(half);
+}
+
+static inline f32 vmxHalfToFloat(u16 half) {
+  const u32 sign = static_cast<u32>(half & 0x8000) << 16;
+  const u32 exponent = (half >> 10) & 0x1F;
+  u32 mantissa = half & 0x3FF;
+  if (exponent == 0x1F) {
+    return std::bit_cast<f32>(sign | 0x7F800000 | (mantissa << 13));
+  }
+  if (exponent == 0) {
+    if (mantissa == 0) {
+      return std::bit_cast<f32>(sign);
+    }
+    // Denormal, normalize it.
+    s32 e = -1;
+    do {
+      e++;
+      mantissa <<= 1;
+    } while ((mantissa & 0x400) == 0);
+    return std::bit_cast<f32>(sign | ((112 - e) << 23) |
+                              ((mantissa & 0x3FF) << 13));
+  }
+  return std::bit_cast<f32>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+// Packs vB in one of the formats above. Returns false for unknown formats.
+static inline bool vmxPackD3D(VRegister &vD, const VRegister &vB, u32 type) {
+  vD = {};
+  switch (type) {
+  case VMX_D3D_D3DCOLOR: {
+    // RGBA to ARGB.
+    const u32 r = vmxD3DField(VMX_F(vB, 0), 0x40400000, 0x404000FF) & 0xFF;
+    const u32 g = vmxD3DField(VMX_F(vB, 1), 0x40400000, 0x404000FF) & 0xFF;
+    const u32 b = vmxD3DField(VMX_F(vB, 2), 0x40400000, 0x404000FF) & 0xFF;
+    const u32 a = vmxD3DField(VMX_F(vB, 3), 0x40400000, 0x404000FF) & 0xFF;
+    VMX_W(vD, 3) = (a << 24) | (r << 16) | (g << 8) | b;
+    break;
+  }
+  case VMX_D3D_NORMSHORT2:
+  case VMX_D3D_NORMSHORT4: {
+    const u32 count = type == VMX_D3D_NORMSHORT2 ? 2 : 4;
+    for (u32 i = 0; i < count; i++) {
+      VMX_H(vD, 8 - count + i) = static_cast<u16>(
+          vmxD3DField(VMX_F(vB, i), 0x403F8001, 0x40407FFF));
+    }
+    break;
+  }
+  case VMX_D3D_NORMPACKED32: {
+    u32 packed = 0;
+    for (u32 i = 0; i < 3; i++) {
+      packed |= (vmxD3DField(VMX_F(vB, i), 0x403FFE01, 0x404001FF) & 0x3FF)
+                << (i * 10);
+    }
+    packed |= (vmxD3DField(VMX_F(vB, 3), 0x40400000, 0x40400003) & 0x3) << 30;
+    VMX_W(vD, 3) = packed;
+    break;
+  }
+  case VMX_D3D_FLOAT16_2:
+  case VMX_D3D_FLOAT16_4: {
+    const u32 count = type == VMX_D3D_FLOAT16_2 ? 2 : 4;
+    for (u32 i = 0; i < count; i++) {
+      VMX_H(vD, 8 - count + i) = vmxFloatToHalf(VMX_F(vB, i));
+    }
+    break;
+  }
+  default:
+    return false;
+  }
+  return true;
+}
+
+// Unpacks the value in w, or z:w, of vB. Formats with less than four fields
+// fill z with 0.0 and w with 1.0. Returns false for unknown formats.
+static inline bool vmxUnpackD3D(VRegister &vD, const VRegister &vB, u32 type) {
+  VRegister result;
+  switch (type) {
+  case VMX_D3D_D3DCOLOR: {
+    // ARGB to RGBA.
+    const u32 argb = VMX_W(vB, 3);
+    VMX_W(result, 0) = 0x3F800000 | ((argb >> 16) & 0xFF);
+    VMX_W(result, 1) = 0x3F800000 | ((argb >> 8) & 0xFF);
+    VMX_W(result, 2) = 0x3F800000 | (argb & 0xFF);
+    VMX_W(result, 3) = 0x3F800000 | (argb >> 24);
+    break;
+  }
+  case VMX_D3D_NORMSHORT2:
+  case VMX_D3D_NORMSHORT4: {
+    const u32 count = type == VMX_D3D_NORMSHORT2 ? 2 : 4;
+    for (u32 i = 0; i < count; i++) {
+      VMX_W(result, i) = vmxD3DSigned(VMX_H(vB, 8 - count + i), 16);
+    }
+    if (count == 2) {
+      VMX_F(result, 2) = 0.0f;
+      VMX_F(result, 3) = 1.0f;
+    }
+    break;
+  }
+  case VMX_D3D_NORMPACKED32: {
+    const u32 packed = VMX_W(vB, 3);
+    for (u32 i = 0; i < 3; i++) {
+      VMX_W(result, i) = vmxD3DSigned(packed >> (i * 10), 10);
+    }
+    VMX_W(result, 3) = 0x40400000 | (packed >> 30);
+    break;
+  }
+  case VMX_D3D_FLOAT16_2:
+  case VMX_D3D_FLOAT16_4: {
+    const u32 count = type == VMX_D3D_FLOAT16_2 ? 2 : 4;
+    for (u32 i = 0; i < count; i++) {
+      VMX_F(result, i) = vmxHalfToFloat(VMX_H(vB, 8 - count + i));
+    }
+    if (count == 2) {
+      VMX_F(result, 2) = 0.0f;
+      VMX_F(result, 3) = 1.0f;
+    }
+    break;
+  }
+  default:
+    return false;
+  }
+  vD = result;
+  return true;
+}
+
+// Permute, each byte of vC selects a byte of vA:vB.
+static inline void vmxPermute(VRegister &vD, const VRegister &vA,
+                              const VRegister &vB, const VRegister &vC) {
+#ifdef ARCH_X86_64
+  if (vmxSSSE3) {
+    vmxStore(vD, vmxPermuteSSSE3(vmxLoad(vA), vmxLoad(vB), vmxLoad(vC)));
+    return;
+  }
+#endif
+  VRegister result;
+  for (u32 i = 0; i < 16; i++) {
+    const u8 index = VMX_B(vC, i) & 0x1F;
+    VMX_B(result, i) = index < 16 ? VMX_B(vA, index) : VMX_B(vB, index - 16);
+  }
+  vD = result;
+}
+
+// Bytes sh to sh + 15 of vA:vB.
+static inline void vmxShiftLeftDouble(VRegister &vD, const VRegister &vA,
+                                      const VRegister &vB, u32 sh) {
+#ifdef ARCH_X86_64
+  if (vmxSSSE3) {
+    vmxStore(vD, vmxShiftLeftDoubleSSSE3(vmxLoad(vA), vmxLoad(vB), sh));
+    return;
+  }
+#endif
+  const VRegister high = vmxShiftLeftBits(vA, sh * 8);
+  const VRegister low = vmxShiftRightBits(vB, (16 - sh) * 8);
+  vD.dw[0] = high.dw[0] | low.dw[0];
+  vD.dw[1] = high.dw[1] | low.dw[1];
+}
+
+template <typename T> static inline void vmxSplat(VRegister &vD, T value) {
+  T *d = vmxElements<T>(vD);
+  for (u32 i = 0; i < sizeof(VRegister) / sizeof(T); i++) {
+    d[i] = value;
+  }
+}
+
+// Sets CR6 from the result of a record form compare.
+static inline void vmxUpdateCR6(PPU_STATE *hCore, const VRegister &vD) {
+  const bool allTrue = (vD.dw[0] & vD.dw[1]) == ~0ULL;
+  const bool allFalse = (vD.dw[0] | vD.dw[1]) == 0;
+  PPCInterpreter::ppcUpdateCR(hCore, 6,
+                              (allTrue ? 0b1000 : 0) | (allFalse ? 0b0010 : 0));
+}
+
+//
+// Handlers
+//
+
+// VX form, vD = kernel(vA, vB).
+#define VMX_VX_OP(name, kernel)                                                \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    VX_FORM_rD_rA_rB;                                                          \
+    VMX_CHECK_AVAILABLE;                                                       \
+    vmx_##kernel(VSCR, VR(rD), VR(rA), VR(rB));                                \
+  }
+// VX form compare, record form updates CR6.
+#define VMX_VXR_OP(name, kernel)                                               \
+  VMX_VX_OP(name, kernel)                                                      \
+  void PPCInterpreter::PPCInterpreter_##name##_(PPU_STATE *hCore) {            \
+    VX_FORM_rD_rA_rB;                                                          \
+    VMX_CHECK_AVAILABLE;                                                       \
+    vmx_##kernel(VSCR, VR(rD), VR(rA), VR(rB));                                \
+    vmxUpdateCR6(hCore, VR(rD));                                               \
+  }
+// VMX128 form, vD = kernel(vA, vB).
+#define VMX_VX128_OP(name, kernel)                                             \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    VX128_FORM_VD128_VA128_VB128;                                              \
+    VMX_CHECK_AVAILABLE;                                                       \
+    vmx_##kernel(VSCR, VR(VD128), VR(VA128), VR(VB128));                       \
+  }
+// VMX128 compare, Rc is part of the extended opcode.
+#define VMX_VX128R_OP(name, kernel)                                            \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    VX128_R_FORM_VD128_VA128_VB128_RC;                                         \
+    VMX_CHECK_AVAILABLE;                                                       \
+    vmx_##kernel(VSCR, VR(VD128), VR(VA128), VR(VB128));                       \
+    if (RC) {                                                                  \
+      vmxUpdateCR6(hCore, VR(VD128));                                          \
+    }                                                                          \
+  }
+// VMX128 single operand, vD = kernel(vB).
+#define VMX_VX128_3_OP(name, kernel)                                           \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    VX128_3_FORM_VD128_VB128;                                                  \
+    VMX_CHECK_AVAILABLE;                                                       \
+    vmx_##kernel(VSCR, VR(VD128), VR(VB128), VR(VB128));                       \
+  }
+
+// Integer Arithmetic
+VMX_VX_OP(vaddubm, vaddubm)
+VMX_VX_OP(vadduhm, vadduhm)
+VMX_VX_OP(vadduwm, vadduwm)
+VMX_VX_OP(vsububm, vsububm)
+VMX_VX_OP(vsubuhm, vsubuhm)
+VMX_VX_OP(vsubuwm, vsubuwm)
+VMX_VX_OP(vaddcuw, vaddcuw)
+VMX_VX_OP(vsubcuw, vsubcuw)
+VMX_VX_OP(vaddubs, vaddubs)
+VMX_VX_OP(vadduhs, vadduhs)
+VMX_VX_OP(vadduws, vadduws)
+VMX_VX_OP(vaddsbs, vaddsbs)
+VMX_VX_OP(vaddshs, vaddshs)
+VMX_VX_OP(vaddsws, vaddsws)
+VMX_VX_OP(vsububs, vsububs)
+VMX_VX_OP(vsubuhs, vsubuhs)
+VMX_VX_OP(vsubuws, vsubuws)
+VMX_VX_OP(vsubsbs, vsubsbs)
+VMX_VX_OP(vsubshs, vsubshs)
+VMX_VX_OP(vsubsws, vsubsws)
+VMX_VX_OP(vmaxub, vmaxub)
+VMX_VX_OP(vmaxuh, vmaxuh)
+VMX_VX_OP(vmaxuw, vmaxuw)
+VMX_VX_OP(vmaxsb, vmaxsb)
+VMX_VX_OP(vmaxsh, vmaxsh)
+VMX_VX_OP(vmaxsw, vmaxsw)
+VMX_VX_OP(vminub, vminub)
+VMX_VX_OP(vminuh, vminuh)
+VMX_VX_OP(vminuw, vminuw)
+VMX_VX_OP(vminsb, vminsb)
+VMX_VX_OP(vminsh, vminsh)
+VMX_VX_OP(vminsw, vminsw)
+VMX_VX_OP(vavgub, vavgub)
+VMX_VX_OP(vavguh, vavguh)
+VMX_VX_OP(vavguw, vavguw)
+VMX_VX_OP(vavgsb, vavgsb)
+VMX_VX_OP(vavgsh, vavgsh)
+VMX_VX_OP(vavgsw, vavgsw)
+VMX_VX_OP(vmuleub, vmuleub)
+VMX_VX_OP(vmuloub, vmuloub)
+VMX_VX_OP(vmulesb, vmulesb)
+VMX_VX_OP(vmulosb, vmulosb)
+VMX_VX_OP(vmuleuh, vmuleuh)
+VMX_VX_OP(vmulouh, vmulouh)
+VMX_VX_OP(vmulesh, vmulesh)
+VMX_VX_OP(vmulosh, vmulosh)
+VMX_VX_OP(vsum4ubs, vsum4ubs)
+VMX_VX_OP(vsum4sbs, vsum4sbs)
+VMX_VX_OP(vsum4shs, vsum4shs)
+VMX_VX_OP(vsum2sws, vsum2sws)
+VMX_VX_OP(vsumsws, vsumsws)
+
+// Multiply-Add and Multiply-Sum, VA form.
+#define VMX_VA_OP(name)                                                        \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    VA_FORM_rD_rA_rB_rC;                                                       \
+    VMX_CHECK_AVAILABLE;                                                       \
+    const VRegister &vA = VR(rA);                                              \
+    const VRegister &vB = VR(rB);                                              \
+    const VRegister &vC = VR(rC);                                              \
+    VRegister result;                                                          \
+    bool sat = false;                                                          \
+    VMX_VA_BODY_##name;                                                        \
+    if (sat) {                                                                 \
+      VSCR.SAT = 1;                                                            \
+    }                                                                          \
+    VR(rD) = result;                                                           \
+  }
+
+#define VMX_VA_BODY_vmhaddshs                                                  \
+  for (u32 i = 0; i < 8; i++) {                                                \
+    const s32 product = static_cast<s16>(VMX_H(vA, i)) *                       \
+                        static_cast<s16>(VMX_H(vB, i));                        \
+    VMX_H(result, i) = vmxSaturate<s16>(                                       \
+        (product >> 15) + static_cast<s16>(VMX_H(vC, i)), sat);                \
+  }
+#define VMX_VA_BODY_vmhraddshs                                                 \
+  for (u32 i = 0; i < 8; i++) {                                                \
+    const s32 product = static_cast<s16>(VMX_H(vA, i)) *                       \
+                        static_cast<s16>(VMX_H(vB, i));                        \
+    VMX_H(result, i) = vmxSaturate<s16>(                                       \
+        ((product + 0x4000) >> 15) + static_cast<s16>(VMX_H(vC, i)), sat);     \
+  }
+#define VMX_VA_BODY_vmladduhm                                                  \
+  for (u32 i = 0; i < 8; i++) {                                                \
+    VMX_H(result, i) = static_cast<u16>(                                       \
+        static_cast<u32>(VMX_H(vA, i)) * VMX_H(vB, i) + VMX_H(vC, i));         \
+  }
+#define VMX_VA_BODY_vmsumubm                                                   \
+  for (u32 i = 0; i < 4; i++) {                                                \
+    u32 sum = VMX_W(vC, i);                                                    \
+    for (u32 j = 0; j < 4; j++) {                                              \
+      sum += static_cast<u32>(VMX_B(vA, i * 4 + j)) * VMX_B(vB, i * 4 + j);    \
+    }                                                                          \
+    VMX_W(result, i) = sum;                                                    \
+  }
+#define VMX_VA_BODY_vmsummbm                                                   \
+  for (u32 i = 0; i < 4; i++) {                                                \
+    s32 sum = static_cast<s32>(VMX_W(vC, i));                                  \
+    for (u32 j = 0; j < 4; j++) {                                              \
+      sum += static_cast<s8>(VMX_B(vA, i * 4 + j)) * VMX_B(vB, i * 4 + j);     \
+    }                                                                          \
+    VMX_W(result, i) = static_cast<u32>(sum);                                  \
+  }
+#define VMX_VA_BODY_vmsumuhm                                                   \
+  for (u32 i = 0; i < 4; i++) {                                                \
+    u32 sum = VMX_W(vC, i);                                                    \
+    for (u32 j = 0; j < 2; j++) {                                              \
+      sum += static_cast<u32>(VMX_H(vA, i * 2 + j)) * VMX_H(vB, i * 2 + j);    \
+    }                                                                          \
+    VMX_W(result, i) = sum;                                                    \
+  }
+#define VMX_VA_BODY_vmsumuhs                                                   \
+  for (u32 i = 0; i < 4; i++) {                                                \
+    s64 sum = VMX_W(vC, i);                                                    \
+    for (u32 j = 0; j < 2; j++) {                                              \
+      sum += static_cast<s64>(VMX_H(vA, i * 2 + j)) * VMX_H(vB, i * 2 + j);    \
+    }                                                                          \
+    VMX_W(result, i) = vmxSaturate<u32>(sum, sat);                             \
+  }
+#define VMX_VA_BODY_vmsumshm                                                   \
+  for (u32 i = 0; i < 4; i++) {                                                \
+    s32 sum = static_cast<s32>(VMX_W(vC, i));                                  \
+    for (u32 j = 0; j < 2; j++) {                                              \
+      sum += static_cast<s16>(VMX_H(vA, i * 2 + j)) *                          \
+             static_cast<s16>(VMX_H(vB, i * 2 + j));                           \
+    }                                                                          \
+    VMX_W(result, i) = static_cast<u32>(sum);                                  \
+  }
+#define VMX_VA_BODY_vmsumshs                                                   \
+  for (u32 i = 0; i < 4; i++) {                                                \
+    s64 sum = static_cast<s32>(VMX_W(vC, i));                                  \
+    for (u32 j = 0; j < 2; j++) {                                              \
+      sum += static_cast<s16>(VMX_H(vA, i * 2 + j)) *                          \
+             static_cast<s16>(VMX_H(vB, i * 2 + j));                           \
+    }                                                                          \
+    VMX_W(result, i) = vmxSaturate<s32>(sum, sat);                             \
+  }
+
+VMX_VA_OP(vmhaddshs)
+VMX_VA_OP(vmhraddshs)
+VMX_VA_OP(vmladduhm)
+VMX_VA_OP(vmsumubm)
+VMX_VA_OP(vmsummbm)
+VMX_VA_OP(vmsumuhm)
+VMX_VA_OP(vmsumuhs)
+VMX_VA_OP(vmsumshm)
+VMX_VA_OP(vmsumshs)
+
+// Logical
+VMX_VX_OP(vand, vand)
+VMX_VX_OP(vandc, vandc)
+VMX_VX_OP(vor, vor)
+VMX_VX_OP(vnor, vnor)
+VMX_VX_OP(vxor, vxor)
+VMX_VX128_OP(vand128, vand)
+VMX_VX128_OP(vandc128, vandc)
+VMX_VX128_OP(vor128, vor)
+VMX_VX128_OP(vnor128, vnor)
+VMX_VX128_OP(vxor128, vxor)
+
+void PPCInterpreter::PPCInterpreter_vsel(PPU_STATE *hCore) {
+  VA_FORM_rD_rA_rB_rC;
+  VMX_CHECK_AVAILABLE;
+  vmxSelect(VR(rD), VR(rA), VR(rB), VR(rC));
+}
+// vD is the mask.
+void PPCInterpreter::PPCInterpreter_vsel128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  vmxSelect(VR(VD128), VR(VA128), VR(VB128), VR(VD128));
+}
+
+// Shift and Rotate
+VMX_VX_OP(vslb, vslb)
+VMX_VX_OP(vslh, vslh)
+VMX_VX_OP(vslw, vslw)
+VMX_VX_OP(vsrb, vsrb)
+VMX_VX_OP(vsrh, vsrh)
+VMX_VX_OP(vsrw, vsrw)
+VMX_VX_OP(vsrab, vsrab)
+VMX_VX_OP(vsrah, vsrah)
+VMX_VX_OP(vsraw, vsraw)
+VMX_VX_OP(vrlb, vrlb)
+VMX_VX_OP(vrlh, vrlh)
+VMX_VX_OP(vrlw, vrlw)
+VMX_VX_OP(vsl, vsl)
+VMX_VX_OP(vsr, vsr)
+VMX_VX_OP(vslo, vslo)
+VMX_VX_OP(vsro, vsro)
+VMX_VX128_OP(vslw128, vslw)
+VMX_VX128_OP(vsrw128, vsrw)
+VMX_VX128_OP(vsraw128, vsraw)
+VMX_VX128_OP(vrlw128, vrlw)
+VMX_VX128_OP(vslo128, vslo)
+VMX_VX128_OP(vsro128, vsro)
+
+// Compare
+VMX_VXR_OP(vcmpequb, vcmpequb)
+VMX_VXR_OP(vcmpequh, vcmpequh)
+VMX_VXR_OP(vcmpequw, vcmpequw)
+VMX_VXR_OP(vcmpgtsb, vcmpgtsb)
+VMX_VXR_OP(vcmpgtsh, vcmpgtsh)
+VMX_VXR_OP(vcmpgtsw, vcmpgtsw)
+VMX_VXR_OP(vcmpgtub, vcmpgtub)
+VMX_VXR_OP(vcmpgtuh, vcmpgtuh)
+VMX_VXR_OP(vcmpgtuw, vcmpgtuw)
+VMX_VXR_OP(vcmpeqfp, vcmpeqfp)
+VMX_VXR_OP(vcmpgefp, vcmpgefp)
+VMX_VXR_OP(vcmpgtfp, vcmpgtfp)
+VMX_VXR_OP(vcmpbfp, vcmpbfp)
+VMX_VX128R_OP(vcmpequw128, vcmpequw)
+VMX_VX128R_OP(vcmpeqfp128, vcmpeqfp)
+VMX_VX128R_OP(vcmpgefp128, vcmpgefp)
+VMX_VX128R_OP(vcmpgtfp128, vcmpgtfp)
+VMX_VX128R_OP(vcmpbfp128, vcmpbfp)
+
+// Floating Point
+VMX_VX_OP(vaddfp, vaddfp)
+VMX_VX_OP(vsubfp, vsubfp)
+VMX_VX_OP(vmaxfp, vmaxfp)
+VMX_VX_OP(vminfp, vminfp)
+VMX_VX_OP(vrefp, vrefp)
+VMX_VX_OP(vrsqrtefp, vrsqrtefp)
+VMX_VX_OP(vexptefp, vexptefp)
+VMX_VX_OP(vlogefp, vlogefp)
+VMX_VX_OP(vrfin, vrfin)
+VMX_VX_OP(vrfiz, vrfiz)
+VMX_VX_OP(vrfip, vrfip)
+VMX_VX_OP(vrfim, vrfim)
+VMX_VX128_OP(vaddfp128, vaddfp)
+VMX_VX128_OP(vsubfp128, vsubfp)
+VMX_VX128_OP(vmulfp128, vmulfp)
+VMX_VX128_OP(vmaxfp128, vmaxfp)
+VMX_VX128_OP(vminfp128, vminfp)
+VMX_VX128_3_OP(vrefp128, vrefp)
+VMX_VX128_3_OP(vrsqrtefp128, vrsqrtefp)
+VMX_VX128_3_OP(vexptefp128, vexptefp)
+VMX_VX128_3_OP(vlogefp128, vlogefp)
+VMX_VX128_3_OP(vrfin128, vrfin)
+VMX_VX128_3_OP(vrfiz128, vrfiz)
+VMX_VX128_3_OP(vrfip128, vrfip)
+VMX_VX128_3_OP(vrfim128, vrfim)
+
+void PPCInterpreter::PPCInterpreter_vmaddfp(PPU_STATE *hCore) {
+  VA_FORM_rD_rA_rB_rC;
+  VMX_CHECK_AVAILABLE;
+  vmxMultiplyAdd(VSCR, VR(rD), VR(rA), VR(rB), VR(rC), false);
+}
+void PPCInterpreter::PPCInterpreter_vnmsubfp(PPU_STATE *hCore) {
+  VA_FORM_rD_rA_rB_rC;
+  VMX_CHECK_AVAILABLE;
+  vmxMultiplyAdd(VSCR, VR(rD), VR(rA), VR(rB), VR(rC), true);
+}
+// vD = vA * vB + vD
+void PPCInterpreter::PPCInterpreter_vmaddfp128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  vmxMultiplyAdd(VSCR, VR(VD128), VR(VA128), VR(VD128), VR(VB128), false);
+}
+// vD = vA * vD + vB
+void PPCInterpreter::PPCInterpreter_vmaddcfp128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  vmxMultiplyAdd(VSCR, VR(VD128), VR(VA128), VR(VB128), VR(VD128), false);
+}
+// vD = -(vA * vB - vD)
+void PPCInterpreter::PPCInterpreter_vnmsubfp128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  vmxMultiplyAdd(VSCR, VR(VD128), VR(VA128), VR(VD128), VR(VB128), true);
+}
+void PPCInterpreter::PPCInterpreter_vmsum3fp128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  vmxDotProduct(VSCR, VR(VD128), VR(VA128), VR(VB128), 3);
+}
+void PPCInterpreter::PPCInterpreter_vmsum4fp128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  vmxDotProduct(VSCR, VR(VD128), VR(VA128), VR(VB128), 4);
+}
+
+// Conversions, the scale is in the vA field.
+void PPCInterpreter::PPCInterpreter_vcfux(PPU_STATE *hCore) {
+  VX_FORM_rD_rA_rB;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertFromUnsigned(VR(rD), VR(rB), rA);
+}
+void PPCInterpreter::PPCInterpreter_vcfsx(PPU_STATE *hCore) {
+  VX_FORM_rD_rA_rB;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertFromSigned(VR(rD), VR(rB), rA);
+}
+void PPCInterpreter::PPCInterpreter_vctuxs(PPU_STATE *hCore) {
+  VX_FORM_rD_rA_rB;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertToFixed<u32>(VSCR, VR(rD), VR(rB), rA);
+}
+void PPCInterpreter::PPCInterpreter_vctsxs(PPU_STATE *hCore) {
+  VX_FORM_rD_rA_rB;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertToFixed<s32>(VSCR, VR(rD), VR(rB), rA);
+}
+void PPCInterpreter::PPCInterpreter_vcuxwfp128(PPU_STATE *hCore) {
+  VX128_3_FORM_VD128_VB128_IMM;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertFromUnsigned(VR(VD128), VR(VB128), IMM);
+}
+void PPCInterpreter::PPCInterpreter_vcsxwfp128(PPU_STATE *hCore) {
+  VX128_3_FORM_VD128_VB128_IMM;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertFromSigned(VR(VD128), VR(VB128), IMM);
+}
+void PPCInterpreter::PPCInterpreter_vcfpuxws128(PPU_STATE *hCore) {
+  VX128_3_FORM_VD128_VB128_IMM;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertToFixed<u32>(VSCR, VR(VD128), VR(VB128), IMM);
+}
+void PPCInterpreter::PPCInterpreter_vcfpsxws128(PPU_STATE *hCore) {
+  VX128_3_FORM_VD128_VB128_IMM;
+  VMX_CHECK_AVAILABLE;
+  vmxConvertToFixed<s32>(VSCR, VR(VD128), VR(VB128), IMM);
+}
+
+// Merge, Pack and Unpack
+VMX_VX_OP(vmrghb, vmrghb)
+VMX_VX_OP(vmrghh, vmrghh)
+VMX_VX_OP(vmrghw, vmrghw)
+VMX_VX_OP(vmrglb, vmrglb)
+VMX_VX_OP(vmrglh, vmrglh)
+VMX_VX_OP(vmrglw, vmrglw)
+VMX_VX_OP(vpkuhum, vpkuhum)
+VMX_VX_OP(vpkuwum, vpkuwum)
+VMX_VX_OP(vpkuhus, vpkuhus)
+VMX_VX_OP(vpkuwus, vpkuwus)
+VMX_VX_OP(vpkshus, vpkshus)
+VMX_VX_OP(vpkswus, vpkswus)
+VMX_VX_OP(vpkshss, vpkshss)
+VMX_VX_OP(vpkswss, vpkswss)
+VMX_VX_OP(vpkpx, vpkpx)
+VMX_VX_OP(vupkhsb, vupkhsb)
+VMX_VX_OP(vupklsb, vupklsb)
+VMX_VX_OP(vupkhsh, vupkhsh)
+VMX_VX_OP(vupklsh, vupklsh)
+VMX_VX_OP(vupkhpx, vupkhpx)
+VMX_VX_OP(vupklpx, vupklpx)
+VMX_VX128_OP(vmrghw128, vmrghw)
+VMX_VX128_OP(vmrglw128, vmrglw)
+VMX_VX128_OP(vpkuhum128, vpkuhum)
+VMX_VX128_OP(vpkuwum128, vpkuwum)
+VMX_VX128_OP(vpkuhus128, vpkuhus)
+VMX_VX128_OP(vpkuwus128, vpkuwus)
+VMX_VX128_OP(vpkshus128, vpkshus)
+VMX_VX128_OP(vpkswus128, vpkswus)
+VMX_VX128_OP(vpkshss128, vpkshss)
+VMX_VX128_OP(vpkswss128, vpkswss)
+
+// Both share their opcode with the halfword variants, selected by vA = 0x60.
+void PPCInterpreter::PPCInterpreter_vupkhsb128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  if (VA128 == 0x60) {
+    vmx_vupkhsh(VSCR, VR(VD128), VR(VB128), VR(VB128));
+  } else {
+    vmx_vupkhsb(VSCR, VR(VD128), VR(VB128), VR(VB128));
+  }
+}
+void PPCInterpreter::PPCInterpreter_vupklsb128(PPU_STATE *hCore) {
+  VX128_FORM_VD128_VA128_VB128;
+  VMX_CHECK_AVAILABLE;
+  if (VA128 == 0x60) {
+    vmx_vupklsh(VSCR, VR(VD128), VR(VB128), VR(VB128));
+  } else {
+    vmx_vupklsb(VSCR, VR(VD128), VR(VB128), VR(VB128));
+  }
+}
+
+// IMM holds the format in its upper bits and how much of vD the packed value
+// replaces in the lower two: 1 for a single word, 2 and 3 for two words. z
+// shifts it left that many words from w.
+void PPCInterpreter::PPCInterpreter_vpkd3d128(PPU_STATE *hCore) {
+  VX128_4_FORM_VD128_VB128_IMM_z;
+  VMX_CHECK_AVAILABLE;
+  VRegister packed;
+  if (!vmxPackD3D(packed, VR(VB128), IMM >> 2)) {
+    LOG_ERROR(Xenon, "vpkd3d128: Unknown pack type {}.", IMM >> 2);
+    return;
+  }
+  VRegister &vD = VR(VD128);
+  switch (IMM & 3) {
+  case 1:
+    VMX_W(vD, 3 - z) = VMX_W(packed, 3);
+    break;
+  case 2:
+  case 3:
+    if (z < 3) {
+      VMX_W(vD, 2 - z) = VMX_W(packed, 2);
+      VMX_W(vD, 3 - z) = VMX_W(packed, 3);
+    } else {
+      // No room left for the value, only w is cleared.
+      VMX_W(vD, 3) = 0;
+    }
+    break;
+  default:
+    LOG_ERROR(Xenon, "vpkd3d128: Unknown pack mode {}.", IMM & 3);
+    break;
+  }
+}
+void PPCInterpreter::PPCInterpreter_vupkd3d128(PPU_STATE *hCore) {
+  VX128_3_FORM_VD128_VB128_IMM;
+  VMX_CHECK_AVAILABLE;
+  if (!vmxUnpackD3D(VR(VD128), VR(VB128), IMM >> 2)) {
+    LOG_ERROR(Xenon, "vupkd3d128: Unknown unpack type {}.", IMM >> 2);
+  }
+}
+
+// Permute and Splat
+void PPCInterpreter::PPCInterpreter_vperm(PPU_STATE *hCore) {
+  VA_FORM_rD_rA_rB_rC;
+  VMX_CHECK_AVAILABLE;
+  vmxPermute(VR(rD), VR(rA), VR(rB), VR(rC));
+}
+void PPCInterpreter::PPCInterpreter_vperm128(PPU_STATE *hCore) {
+  VX128_2_FORM_VD128_VA128_VB128_VC;
+  VMX_CHECK_AVAILABLE;
+  vmxPermute(VR(VD128), VR(VA128), VR(VB128), VR(VC));
+}
+void PPCInterpreter::PPCInterpreter_vsldoi(PPU_STATE *hCore) {
+  VA_FORM_rD_rA_rB_rC;
+  VMX_CHECK_AVAILABLE;
+  vmxShiftLeftDouble(VR(rD), VR(rA), VR(rB), rC & 0xF);
+}
+void PPCInterpreter::PPCInterpreter_vsldoi128(PPU_STATE *hCore) {
+  VX128_5_FORM_VD128_VA128_VB128_SH;
+  VMX_CHECK_AVAILABLE;
+  vmxShiftLeftDouble(VR(VD128), VR(VA128), VR(VB128), SH);
+}
+// Each 2 bits of PERM select a word of vB, the first ones for word 0.
+void PPCInterpreter::PPCInterpreter_vpermwi128(PPU_STATE *hCore) {
+  VX128_P_FORM_VD128_VB128_PERM;
+  VMX_CHECK_AVAILABLE;
+  const VRegister vB = VR(VB128);
+  for (u32 i = 0; i < 4; i++) {
+    VMX_W(VR(VD128), i) = VMX_W(vB, (PERM >> ((3 - i) * 2)) & 3);
+  }
+}
+// Rotates vB left by z words and inserts the words selected by IMM into vD.
+void PPCInterpreter::PPCInterpreter_vrlimi128(PPU_STATE *hCore) {
+  VX128_4_FORM_VD128_VB128_IMM_z;
+  VMX_CHECK_AVAILABLE;
+  const VRegister vB = VR(VB128);
+  for (u32 i = 0; i < 4; i++) {
+    if (IMM & (0b1000 >> i)) {
+      VMX_W(VR(VD128), i) = VMX_W(vB, (i + z) & 3);
+    }
+  }
+}
+void PPCInterpreter::PPCInterpreter_vspltb(PPU_STATE *hCore) {
+  VX_FORM_rD_rA_rB;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u8>(VR(rD), VMX_B(VR(rB), rA & 0xF));
+}
+void PPCInterpreter::PPCInterpreter_vsplth(PPU_STATE *hCore) {
+  VX_FORM_rD_rA_rB;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u16>(VR(rD), VMX_H(VR(rB), rA & 0x7));
+}
+void PPCInterpreter::PPCInterpreter_vspltw(PPU_STATE *hCore) {
+  VX_FORM_rD_rA_rB;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u32>(VR(rD), VMX_W(VR(rB), rA & 0x3));
+}
+void PPCInterpreter::PPCInterpreter_vspltw128(PPU_STATE *hCore) {
+  VX128_3_FORM_VD128_VB128_IMM;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u32>(VR(VD128), VMX_W(VR(VB128), IMM & 0x3));
+}
+void PPCInterpreter::PPCInterpreter_vspltisb(PPU_STATE *hCore) {
+  VX_FORM_rD_SIMM;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u8>(VR(rD), static_cast<u8>(EXTS(SIMM, 5)));
+}
+void PPCInterpreter::PPCInterpreter_vspltish(PPU_STATE *hCore) {
+  VX_FORM_rD_SIMM;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u16>(VR(rD), static_cast<u16>(EXTS(SIMM, 5)));
+}
+void PPCInterpreter::PPCInterpreter_vspltisw(PPU_STATE *hCore) {
+  VX_FORM_rD_SIMM;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u32>(VR(rD), static_cast<u32>(EXTS(SIMM, 5)));
+}
+void PPCInterpreter::PPCInterpreter_vspltisw128(PPU_STATE *hCore) {
+  VX128_3_FORM_VD128_IMM;
+  VMX_CHECK_AVAILABLE;
+  vmxSplat<u32>(VR(VD128), static_cast<u32>(EXTS(IMM, 5)));
+}
+
+// Status and Control Register, kept in the last word.
+void PPCInterpreter::PPCInterpreter_mfvscr(PPU_STATE *hCore) {
+  VX_FORM_rD;
+  VMX_CHECK_AVAILABLE;
+  VR(rD) = {};
+  VMX_W(VR(rD), 3) = VSCR.VSCR_Hex;
+}
+void PPCInterpreter::PPCInterpreter_mtvscr(PPU_STATE *hCore) {
+  VX_FORM_rB;
+  VMX_CHECK_AVAILABLE;
+  VSCR.VSCR_Hex = VMX_W(VR(rB), 3) & 0x00010001;
+}
+
+//
+// Load/Store
+//
+
+static inline bool vmxMemoryFault(PPU_STATE *hCore) {
+  return hCore->curThread->exceptReg &
+         (PPU_EX_DATASEGM | PPU_EX_DATASTOR);
+}
+
+// Reads an aligned quadword, guest byte order matches our register layout
+// once each doubleword is swapped.
+static inline bool vmxReadQuadword(PPU_STATE *hCore, u64 EA,
+                                   VRegister &value) {
+  const u64 high = PPCInterpreter::MMURead64(hCore, EA);
+  if (vmxMemoryFault(hCore)) {
+    return false;
+  }
+  const u64 low = PPCInterpreter::MMURead64(hCore, EA + 8);
+  if (vmxMemoryFault(hCore)) {
+    return false;
+  }
+  value.dw[1] = high;
+  value.dw[0] = low;
+  return true;
+}
+
+static void vmxLoadVector(PPU_STATE *hCore, u32 vD, u64 EA) {
+  VRegister value;
+  if (vmxReadQuadword(hCore, EA & ~0xF, value)) {
+    VR(vD) = value;
+  }
+}
+static void vmxStoreVector(PPU_STATE *hCore, u32 vS, u64 EA) {
+  EA &= ~0xF;
+  PPCInterpreter::MMUWrite64(hCore, EA, VR(vS).dw[1]);
+  if (vmxMemoryFault(hCore)) {
+    return;
+  }
+  PPCInterpreter::MMUWrite64(hCore, EA + 8, VR(vS).dw[0]);
+}
+// Bytes from EA to the end of its quadword, to the left of vD.
+static void vmxLoadVectorLeft(PPU_STATE *hCore, u32 vD, u64 EA) {
+  VRegister value;
+  if (vmxReadQuadword(hCore, EA & ~0xF, value)) {
+    VR(vD) = vmxShiftLeftBits(value, (EA & 0xF) * 8);
+  }
+}
+// Bytes from the start of the quadword up to EA, to the right of vD.
+static void vmxLoadVectorRight(PPU_STATE *hCore, u32 vD, u64 EA) {
+  VRegister value{};
+  if ((EA & 0xF) != 0 && !vmxReadQuadword(hCore, EA & ~0xF, value)) {
+    return;
+  }
+  VR(vD) = vmxShiftRightBits(value, (16 - (EA & 0xF)) * 8);
+}
+static void vmxStoreVectorLeft(PPU_STATE *hCore, u32 vS, u64 EA) {
+  const u32 count = 16 - (EA & 0xF);
+  const VRegister value = VR(vS);
+  for (u32 i = 0; i < count; i++) {
+    PPCInterpreter::MMUWrite8(hCore, EA + i, VMX_B(value, i));
+    if (vmxMemoryFault(hCore)) {
+      return;
+    }
+  }
+}
+static void vmxStoreVectorRight(PPU_STATE *hCore, u32 vS, u64 EA) {
+  const u32 count = EA & 0xF;
+  const VRegister value = VR(vS);
+  for (u32 i = 0; i < count; i++) {
+    PPCInterpreter::MMUWrite8(hCore, (EA & ~0xF) + i,
+                              VMX_B(value, 16 - count + i));
+    if (vmxMemoryFault(hCore)) {
+      return;
+    }
+  }
+}
+// Element loads and stores use the element matching the address.
+static void vmxLoadByteElement(PPU_STATE *hCore, u32 vD, u64 EA) {
+  const u8 data = PPCInterpreter::MMURead8(hCore, EA);
+  if (!vmxMemoryFault(hCore)) {
+    VMX_B(VR(vD), EA & 0xF) = data;
+  }
+}
+static void vmxLoadHalfwordElement(PPU_STATE *hCore, u32 vD, u64 EA) {
+  EA &= ~1;
+  const u16 data = PPCInterpreter::MMURead16(hCore, EA);
+  if (!vmxMemoryFault(hCore)) {
+    VMX_H(VR(vD), (EA & 0xF) >> 1) = data;
+  }
+}
+static void vmxLoadWordElement(PPU_STATE *hCore, u32 vD, u64 EA) {
+  EA &= ~3;
+  const u32 data = PPCInterpreter::MMURead32(hCore, EA);
+  if (!vmxMemoryFault(hCore)) {
+    VMX_W(VR(vD), (EA & 0xF) >> 2) = data;
+  }
+}
+static void vmxStoreByteElement(PPU_STATE *hCore, u32 vS, u64 EA) {
+  PPCInterpreter::MMUWrite8(hCore, EA, VMX_B(VR(vS), EA & 0xF));
+}
+static void vmxStoreHalfwordElement(PPU_STATE *hCore, u32 vS, u64 EA) {
+  EA &= ~1;
+  PPCInterpreter::MMUWrite16(hCore, EA, VMX_H(VR(vS), (EA & 0xF) >> 1));
+}
+static void vmxStoreWordElement(PPU_STATE *hCore, u32 vS, u64 EA) {
+  EA &= ~3;
+  PPCInterpreter::MMUWrite32(hCore, EA, VMX_W(VR(vS), (EA & 0xF) >> 2));
+}
+// Permute control vectors for unaligned accesses.
+static void vmxLoadShiftLeft(PPU_STATE *hCore, u32 vD, u64 EA) {
+  for (u32 i = 0; i < 16; i++) {
+    VMX_B(VR(vD), i) = static_cast<u8>((EA & 0xF) + i);
+  }
+}
+static void vmxLoadShiftRight(PPU_STATE *hCore, u32 vD, u64 EA) {
+  for (u32 i = 0; i < 16; i++) {
+    VMX_B(VR(vD), i) = static_cast<u8>(16 - (EA & 0xF) + i);
+  }
+}
+
+#define VMX_X_MEM_OP(name, kernel)                                             \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    X_FORM_rD_rA_rB;                                                           \
+    VMX_CHECK_AVAILABLE;                                                       \
+    kernel(hCore, rD, (rA ? GPR(rA) : 0) + GPR(rB));                           \
+  }
+#define VMX_VX128_1_MEM_OP(name, kernel)                                       \
+  void PPCInterpreter::PPCInterpreter_##name(PPU_STATE *hCore) {               \
+    VX128_1_FORM_VD128_rA_rB;                                                  \
+    VMX_CHECK_AVAILABLE;                                                       \
+    kernel(hCore, VD128, (rA ? GPR(rA) : 0) + GPR(rB));                        \
+  }
+
+// The LRU (l) variants are only cache hints.
+VMX_X_MEM_OP(lvx, vmxLoadVector)
+VMX_X_MEM_OP(lvxl, vmxLoadVector)
+VMX_X_MEM_OP(stvx, vmxStoreVector)
+VMX_X_MEM_OP(stvxl, vmxStoreVector)
+VMX_X_MEM_OP(lvlx, vmxLoadVectorLeft)
+VMX_X_MEM_OP(lvlxl, vmxLoadVectorLeft)
+VMX_X_MEM_OP(lvrx, vmxLoadVectorRight)
+VMX_X_MEM_OP(lvrxl, vmxLoadVectorRight)
+VMX_X_MEM_OP(stvlx, vmxStoreVectorLeft)
+VMX_X_MEM_OP(stvlxl, vmxStoreVectorLeft)
+VMX_X_MEM_OP(stvrx, vmxStoreVectorRight)
+VMX_X_MEM_OP(stvrxl, vmxStoreVectorRight)
+VMX_X_MEM_OP(lvebx, vmxLoadByteElement)
+VMX_X_MEM_OP(lvehx, vmxLoadHalfwordElement)
+VMX_X_MEM_OP(lvewx, vmxLoadWordElement)
+VMX_X_MEM_OP(stvebx, vmxStoreByteElement)
+VMX_X_MEM_OP(stvehx, vmxStoreHalfwordElement)
+VMX_X_MEM_OP(stvewx, vmxStoreWordElement)
+VMX_X_MEM_OP(lvsl, vmxLoadShiftLeft)
+VMX_X_MEM_OP(lvsr, vmxLoadShiftRight)
+
+VMX_VX128_1_MEM_OP(lvx128, vmxLoadVector)
+VMX_VX128_1_MEM_OP(lvxl128, vmxLoadVector)
+VMX_VX128_1_MEM_OP(stvx128, vmxStoreVector)
+VMX_VX128_1_MEM_OP(stvxl128, vmxStoreVector)
+VMX_VX128_1_MEM_OP(lvlx128, vmxLoadVectorLeft)
+VMX_VX128_1_MEM_OP(lvlxl128, vmxLoadVectorLeft)
+VMX_VX128_1_MEM_OP(lvrx128, vmxLoadVectorRight)
+VMX_VX128_1_MEM_OP(lvrxl128, vmxLoadVectorRight)
+VMX_VX128_1_MEM_OP(stvlx128, vmxStoreVectorLeft)
+VMX_VX128_1_MEM_OP(stvlxl128, vmxStoreVectorLeft)
+VMX_VX128_1_MEM_OP(stvrx128, vmxStoreVectorRight)
+VMX_VX128_1_MEM_OP(stvrxl128, vmxStoreVectorRight)
+VMX_VX128_1_MEM_OP(lvewx128, vmxLoadWordElement)
+VMX_VX128_1_MEM_OP(stvewx128, vmxStoreWordElement)
+VMX_VX128_1_MEM_OP(lvsl128, vmxLoadShiftLeft)
+VMX_VX128_1_MEM_OP(lvsr128, vmxLoadShiftRight)
+
+// Data stream touch hints, there's no cache to prefetch into.
+void PPCInterpreter::PPCInterpreter_dst(PPU_STATE *hCore) {}
+void PPCInterpreter::PPCInterpreter_dstst(PPU_STATE *hCore) {}
+void PPCInterpreter::PPCInterpreter_dss(PPU_STATE *hCore) {}
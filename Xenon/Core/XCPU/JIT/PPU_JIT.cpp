@@ -0,0 +1,394 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include "PPU_JIT.h"
+
+#include <cstddef>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Base/Logging/Log.h"
+#include "Core/XCPU/Interpreter/PPCInterpreter.h"
+#include "Core/XCPU/PPU/PPU.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PPU_JIT_X86_64
+#endif
+
+// Host registers used by the emitter.
+#define HOST_RAX 0
+#define HOST_RCX 1
+
+// Worst case size of a single recompiled instruction, plus the prologue.
+#define PPU_JIT_MAX_INSTR_SIZE 0x80
+
+// Offsets of the guest registers used by the generated code.
+#define THREAD_OFFSET(x) static_cast<u32>(offsetof(PPU_THREAD_REGISTERS, x))
+
+PPU_JIT::PPU_JIT() {
+#ifdef PPU_JIT_X86_64
+  // Start out writable, pages are made executable as blocks are sealed.
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  pageSize = systemInfo.dwPageSize;
+  codeBuffer = static_cast<u8 *>(
+      VirtualAlloc(nullptr, PPU_JIT_CODE_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE,
+                   PAGE_READWRITE));
+#else
+  pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  void *buffer = mmap(nullptr, PPU_JIT_CODE_BUFFER_SIZE,
+                      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+                      0);
+  codeBuffer = buffer == MAP_FAILED ? nullptr : static_cast<u8 *>(buffer);
+#endif
+  if (codeBuffer == nullptr) {
+    LOG_ERROR(Xenon, "JIT: Unable to allocate executable memory, falling back "
+                     "to the interpreter.");
+  }
+#else
+  LOG_WARNING(Xenon, "JIT: Host architecture not supported, falling back to "
+                     "the interpreter.");
+#endif
+  codePtr = codeBuffer;
+  sealedPtr = codeBuffer;
+}
+
+PPU_JIT::~PPU_JIT() {
+  if (codeBuffer == nullptr) {
+    return;
+  }
+#ifdef _WIN32
+  VirtualFree(codeBuffer, 0, MEM_RELEASE);
+#else
+  munmap(codeBuffer, PPU_JIT_CODE_BUFFER_SIZE);
+#endif
+}
+
+bool PPU_JIT::Seal() {
+  if (codePtr == sealedPtr) {
+    return true;
+  }
+  if (!setWritable(sealedPtr, codePtr - sealedPtr, false)) {
+    return false;
+  }
+  // The rest of the last page is executable now, carry on from the next one.
+  const uintptr_t pageMask = ~static_cast<uintptr_t>(pageSize - 1);
+  codePtr = reinterpret_cast<u8 *>(
+      (reinterpret_cast<uintptr_t>(codePtr) + pageSize - 1) & pageMask);
+  sealedPtr = codePtr;
+  return true;
+}
+
+bool PPU_JIT::Flush() {
+  if (sealedPtr != codeBuffer &&
+      !setWritable(codeBuffer, sealedPtr - codeBuffer, true)) {
+    return false;
+  }
+  codePtr = codeBuffer;
+  sealedPtr = codeBuffer;
+  return true;
+}
+
+bool PPU_JIT::setWritable(u8 *start, size_t size, bool writable) {
+  // Round out to whole pages.
+  const uintptr_t pageMask = ~static_cast<uintptr_t>(pageSize - 1);
+  u8 *pageStart =
+      reinterpret_cast<u8 *>(reinterpret_cast<uintptr_t>(start) & pageMask);
+  u8 *pageEnd = reinterpret_cast<u8 *>(
+      (reinterpret_cast<uintptr_t>(start + size) + pageSize - 1) & pageMask);
+  const size_t protectSize = pageEnd - pageStart;
+#ifdef _WIN32
+  DWORD oldProtect = 0;
+  if (!VirtualProtect(pageStart, protectSize,
+                      writable ? PAGE_READWRITE : PAGE_EXECUTE_READ,
+                      &oldProtect)) {
+    return false;
+  }
+  if (!writable) {
+    FlushInstructionCache(GetCurrentProcess(), pageStart, protectSize);
+  }
+  return true;
+#else
+  return mprotect(pageStart, protectSize,
+                  writable ? PROT_READ | PROT_WRITE
+                           : PROT_READ | PROT_EXEC) == 0;
+#endif
+}
+
+JITBlockFunc PPU_JIT::Compile(const PPU_DECODE_BLOCK *block, u64 EA) {
+  if (codeBuffer == nullptr) {
+    return nullptr;
+  }
+
+  // Make sure the whole block fits.
+  const size_t maxBlockSize =
+      (block->instrCount + 1) * PPU_JIT_MAX_INSTR_SIZE;
+  if (codePtr + maxBlockSize > codeBuffer + PPU_JIT_CODE_BUFFER_SIZE) {
+    return nullptr;
+  }
+
+  JITBlockFunc blockFunc = reinterpret_cast<JITBlockFunc>(codePtr);
+
+  emitPrologue();
+
+  for (u8 instrIdx = 0; instrIdx < block->instrCount; instrIdx++) {
+    const PPU_DECODED_INSTR &instr = block->instrs[instrIdx];
+    const u64 CIA = EA + instrIdx * 4;
+    const bool lastInstr = instrIdx == block->instrCount - 1;
+    const bool hasHook = PPCInterpreter::ppcHasHook(CIA);
+
+    // Simple integer instructions, these can't raise exceptions.
+    if (!hasHook && emitNativeInstruction(instr.opcode)) {
+      if (lastInstr) {
+        emitMovImm(HOST_RAX, CIA);
+        emitStoreReg(THREAD_OFFSET(CIA));
+        emitMovImm(HOST_RAX, CIA + 4);
+        emitStoreReg(THREAD_OFFSET(NIA));
+      }
+      continue;
+    }
+
+    // Interpreter fallback, set up the thread as ppuReadNextInstruction does.
+    emitMovImm(HOST_RAX, CIA);
+    emitStoreReg(THREAD_OFFSET(CIA));
+    emitMovImm(HOST_RAX, CIA + 4);
+    emitStoreReg(THREAD_OFFSET(NIA));
+    // mov dword [r12 + CI], opcode
+    emit8(0x41);
+    emit8(0xC7);
+    emit8(0x84);
+    emit8(0x24);
+    emit32(THREAD_OFFSET(CI));
+    emit32(instr.opcode);
+
+#ifdef _WIN32
+    // mov rcx, rbx
+    emit8(0x48);
+    emit8(0x89);
+    emit8(0xD9);
+#else
+    // mov rdi, rbx
+    emit8(0x48);
+    emit8(0x89);
+    emit8(0xDF);
+#endif
+    // Instructions with guest patches attached run them first.
+    emitMovImm(HOST_RAX,
+               reinterpret_cast<u64>(hasHook ? &PPCInterpreter::ppcExecuteHooked
+                                             : instr.handler));
+    // call rax
+    emit8(0xFF);
+    emit8(0xD0);
+
+    if (lastInstr) {
+      break;
+    }
+
+    // cmp word [r12 + exceptReg], 0
+    emit8(0x66);
+    emit8(0x41);
+    emit8(0x83);
+    emit8(0xBC);
+    emit8(0x24);
+    emit32(THREAD_OFFSET(exceptReg));
+    emit8(0x00);
+    // je over the exit path below.
+    emit8(0x74);
+    u8 *jumpOffset = codePtr;
+    emit8(0x00);
+    emitEpilogue(instrIdx + 1);
+    *jumpOffset = static_cast<u8>(codePtr - jumpOffset - 1);
+  }
+
+  emitEpilogue(block->instrCount);
+
+  return blockFunc;
+}
+
+bool PPU_JIT::emitNativeInstruction(u32 opcode) {
+  const u8 rD = (opcode >> 21) & 0x1F; // Also rS.
+  const u8 rA = (opcode >> 16) & 0x1F;
+  const u8 rB = (opcode >> 11) & 0x1F;
+  const u64 simm = static_cast<u64>(static_cast<s64>(static_cast<s16>(opcode)));
+  const u64 uimm = opcode & 0xFFFF;
+
+  switch (opcode >> 26) {
+  case 14: // addi
+  case 15: // addis
+  {
+    const u64 imm = (opcode >> 26) == 14 ? simm : simm << 16;
+    if (rA) {
+      emitLoadGPR(HOST_RAX, rA);
+      emitMovImm(HOST_RCX, imm);
+      emit8(0x48); // add rax, rcx
+      emit8(0x01);
+      emit8(0xC8);
+    } else {
+      emitMovImm(HOST_RAX, imm);
+    }
+    emitStoreGPR(rD);
+    return true;
+  }
+  case 24: // ori
+  case 25: // oris
+  case 26: // xori
+  case 27: // xoris
+  {
+    const u8 op = opcode >> 26;
+    emitLoadGPR(HOST_RAX, rD);
+    emitMovImm(HOST_RCX, (op & 1) ? uimm << 16 : uimm);
+    emit8(0x48); // or/xor rax, rcx
+    emit8(op < 26 ? 0x09 : 0x31);
+    emit8(0xC8);
+    emitStoreGPR(rA);
+    return true;
+  }
+  case 31:
+    // Record and overflow forms update CR/XER, leave them to the interpreter.
+    if (opcode & 1) {
+      return false;
+    }
+    switch ((opcode >> 1) & 0x3FF) {
+    case 28:  // and
+    case 124: // nor
+    case 316: // xor
+    case 444: // or
+    {
+      const u16 xo = (opcode >> 1) & 0x3FF;
+      emitLoadGPR(HOST_RAX, rD);
+      emitLoadGPR(HOST_RCX, rB);
+      emit8(0x48);
+      emit8(xo == 28 ? 0x21 : xo == 316 ? 0x31 : 0x09);
+      emit8(0xC8);
+      if (xo == 124) {
+        emit8(0x48); // not rax
+        emit8(0xF7);
+        emit8(0xD0);
+      }
+      emitStoreGPR(rA);
+      return true;
+    }
+    case 266: // add
+      emitLoadGPR(HOST_RAX, rA);
+      emitLoadGPR(HOST_RCX, rB);
+      emit8(0x48); // add rax, rcx
+      emit8(0x01);
+      emit8(0xC8);
+      emitStoreGPR(rD);
+      return true;
+    case 40: // subf
+      emitLoadGPR(HOST_RAX, rB);
+      emitLoadGPR(HOST_RCX, rA);
+      emit8(0x48); // sub rax, rcx
+      emit8(0x29);
+      emit8(0xC8);
+      emitStoreGPR(rD);
+      return true;
+    }
+    break;
+  }
+  return false;
+}
+
+void PPU_JIT::emit32(u32 value) {
+  memcpy(codePtr, &value, sizeof(u32));
+  codePtr += sizeof(u32);
+}
+
+void PPU_JIT::emit64(u64 value) {
+  memcpy(codePtr, &value, sizeof(u64));
+  codePtr += sizeof(u64);
+}
+
+void PPU_JIT::emitLoadGPR(u8 hostReg, u8 gpr) {
+  emitLoadReg(hostReg, THREAD_OFFSET(GPR) + gpr * sizeof(u64));
+}
+
+void PPU_JIT::emitStoreGPR(u8 gpr) {
+  emitStoreReg(THREAD_OFFSET(GPR) + gpr * sizeof(u64));
+}
+
+void PPU_JIT::emitLoadReg(u8 hostReg, u32 disp) {
+  // mov reg, [r12 + disp32]
+  emit8(0x49);
+  emit8(0x8B);
+  emit8(0x84 | (hostReg << 3));
+  emit8(0x24);
+  emit32(disp);
+}
+
+void PPU_JIT::emitStoreReg(u32 disp) {
+  // mov [r12 + disp32], rax
+  emit8(0x49);
+  emit8(0x89);
+  emit8(0x84);
+  emit8(0x24);
+  emit32(disp);
+}
+
+void PPU_JIT::emitMovImm(u8 hostReg, u64 value) {
+  // mov reg, imm64
+  emit8(0x48);
+  emit8(0xB8 + hostReg);
+  emit64(value);
+}
+
+void PPU_JIT::emitPrologue() {
+  // push rbx; push r12, both hold our arguments during the whole block.
+  emit8(0x53);
+  emit8(0x41);
+  emit8(0x54);
+#ifdef _WIN32
+  // sub rsp, 40 (Shadow space + stack alignment)
+  emit8(0x48);
+  emit8(0x83);
+  emit8(0xEC);
+  emit8(0x28);
+  // mov rbx, rcx; mov r12, rdx
+  emit8(0x48);
+  emit8(0x89);
+  emit8(0xCB);
+  emit8(0x49);
+  emit8(0x89);
+  emit8(0xD4);
+#else
+  // sub rsp, 8 (Stack alignment)
+  emit8(0x48);
+  emit8(0x83);
+  emit8(0xEC);
+  emit8(0x08);
+  // mov rbx, rdi; mov r12, rsi
+  emit8(0x48);
+  emit8(0x89);
+  emit8(0xFB);
+  emit8(0x49);
+  emit8(0x89);
+  emit8(0xF4);
+#endif
+}
+
+void PPU_JIT::emitEpilogue(u32 instrCount) {
+  // mov eax, instrCount
+  emit8(0xB8);
+  emit32(instrCount);
+  // add rsp, 40/8
+  emit8(0x48);
+  emit8(0x83);
+  emit8(0xC4);
+#ifdef _WIN32
+  emit8(0x28);
+#else
+  emit8(0x08);
+#endif
+  // pop r12; pop rbx; ret
+  emit8(0x41);
+  emit8(0x5C);
+  emit8(0x5B);
+  emit8(0xC3);
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 Xenon Emulator Project
+
+#pragma once
+
+#include "Core/XCPU/PPU/PowerPC.h"
+
+/*
+ *	PPU_JIT.h Basic block recompiler for the PPU.
+ *
+ *	Translates the pre-decoded blocks of the PPU decode cache into x86-64 host
+ *	code. Simple integer instructions are emitted natively, everything else
+ *	calls into the interpreter handlers with CIA, NIA and the current opcode set
+ *	up just like the interpreter does. Guest state stays in
+ *	PPU_THREAD_REGISTERS, and execution leaves the block as soon as an
+ *	instruction raises an exception, so exceptReg is handled by the PPU at
+ *	block boundaries.
+ */
+
+struct PPU_DECODE_BLOCK;
+
+// Recompiled block entry point, returns the amount of instructions executed.
+using JITBlockFunc = u32 (*)(PPU_STATE *hCore, PPU_THREAD_REGISTERS *thread);
+
+// Size of the host code buffer for each PPU.
+#define PPU_JIT_CODE_BUFFER_SIZE 0x1000000
+
+class PPU_JIT {
+public:
+  PPU_JIT();
+  ~PPU_JIT();
+
+  // Whether we can generate code for the host we're running on.
+  bool IsAvailable() const { return codeBuffer != nullptr; }
+
+  // Recompiles a decoded block whose first instruction lives at EA. Returns
+  // nullptr if the code buffer is full, call Flush and try again. The code
+  // can't run before the next Seal.
+  JITBlockFunc Compile(const PPU_DECODE_BLOCK *block, u64 EA);
+
+  // Makes every block compiled since the last call executable. Returns false
+  // if the host refused.
+  bool Seal();
+
+  // Discards all generated code. Returns false if the host refused to make the
+  // buffer writable again.
+  bool Flush();
+
+private:
+  // Host code buffer. Pages are never writable and executable at once, blocks
+  // are emitted into writable pages past the sealed ones, and Seal makes them
+  // executable. A batch never shares a page with the previous one, so sealed
+  // pages only become writable again when the buffer is flushed.
+  u8 *codeBuffer = nullptr;
+  // End of the executable pages.
+  u8 *sealedPtr = nullptr;
+  // Current write position inside the buffer.
+  u8 *codePtr = nullptr;
+  // Host page size, the granularity protections can be changed with.
+  size_t pageSize = 0x1000;
+
+  // Switches the pages covering [start, start + size) between read/write and
+  // read/execute. Returns false if the host refused.
+  bool setWritable(u8 *start, size_t size, bool writable);
+
+  // Emits a natively translated instruction, returns false if the instruction
+  // must go through its interpreter handler instead.
+  bool emitNativeInstruction(u32 opcode);
+
+  // x86-64 emitter helpers.
+  void emit8(u8 value) { *codePtr++ = value; }
+  void emit32(u32 value);
+  void emit64(u64 value);
+  // mov rax/rcx, [r12 + disp32] and mov [r12 + disp32], rax.
+  void emitLoadGPR(u8 hostReg, u8 gpr);
+  void emitStoreGPR(u8 gpr);
+  void emitLoadReg(u8 hostReg, u32 disp);
+  void emitStoreReg(u32 disp);
+  // mov rax/rcx, imm64.
+  void emitMovImm(u8 hostReg, u64 value);
+  void emitPrologue();
+  void emitEpilogue(u32 instrCount);
+};
@@ -13,60 +13,69 @@
 
 #define TPI_FORMULA(ips) ((ips) / 500000)
 
-PPU::PPU(XENON_CONTEXT *inXenonContext, RootBus *mainBus, u32 PVR,
+PPU::PPU(XENON_CONTEXT *inXenonContext, RootBus *mainBus, RAM *ramPtr, u32 PVR,
                   u32 PIR, const char *ppuName) {
   //
   // Set evrything as in POR. See CELL-BE Programming Handbook.
   //
 
   // Allocate memory for our PPU state.
-  ppuState = std::make_shared<STRIP_UNIQUE(ppuState)>();
+  coreState = std::make_shared<STRIP_UNIQUE(coreState)>();
+  ppuState = std::make_shared<STRIP_UNIQUE(ppuState)>(coreState.get());
 
   // Initialize Both threads as in a Reset.
   for (u8 thrdNum = 0; thrdNum < 2; thrdNum++) {
     // Set Reset vector for both threads
     ppuState->ppuThread[thrdNum].NIA = XE_RESET_VECTOR;
     // Set MSR for both Threads
-    ppuState->ppuThread[thrdNum].SPR.MSR.MSR_Hex = 0x9000000000000000;
+    ppuState->ppuThread[thrdNum].MSR.MSR_Hex = 0x9000000000000000;
+    // VMX starts in non-Java mode.
+    ppuState->ppuThread[thrdNum].VSCR.NJ = 1;
   }
 
   // Set Thread Timeout Register.
   ppuState->SPR.TTR = 0x1000; // Execute 4096 instructions.
 
+  // Set up the TLB replacement order.
+  for (u8 &lruOrder : ppuState->TLB.lruOrder) {
+    lruOrder = PPU_TLB_LRU_RESET;
+  }
+
   // Asign global Xenon context.
   xenonContext = inXenonContext;
 
   // Asign Interpreter global variables.
   PPCInterpreter::intXCPUContext = xenonContext;
   PPCInterpreter::sysBus = mainBus;
+  PPCInterpreter::mainMemory = ramPtr;
 
-  // Get the instructions per second that we're able to execute.
-  u32 instrPerSecond = getIPS();
-  LOG_INFO(Xenon, "{} Speed: {:#d} instructions per second.", ppuName, instrPerSecond);
+  initExecution();
 
   // Find a way to calculate the right ticks/IPS ratio.
   int configTpi = Config::tpi();
-  ticksPerInstruction = configTpi ? configTpi : TPI_FORMULA(instrPerSecond);
-  if (!configTpi)
-    LOG_INFO(Xenon, "{} TPI: {} ticks per instruction", ppuName, ticksPerInstruction);
-  else
-    LOG_INFO(Xenon, "{} TPI: {} ticks per instruction (overrwriten! actual tps: {})", ppuName, ticksPerInstruction, TPI_FORMULA(instrPerSecond));
+  if (configTpi) {
+    // Fixed ratio, skip the wall clock calibration so timing is reproducible.
+    ppuState->ticksPerInstruction = configTpi;
+    LOG_INFO(Xenon, "{} TPI: {} ticks per instruction (overrwriten!)", ppuName, ppuState->ticksPerInstruction);
+  } else {
+    // Get the instructions per second that we're able to execute.
+    u32 instrPerSecond = getIPS();
+    LOG_INFO(Xenon, "{} Speed: {:#d} instructions per second.", ppuName, instrPerSecond);
+    ppuState->ticksPerInstruction = TPI_FORMULA(instrPerSecond);
+    LOG_INFO(Xenon, "{} TPI: {} ticks per instruction", ppuName, ppuState->ticksPerInstruction);
+  }
 
   for (u8 thrdID = 0; thrdID < 2; thrdID++) {
     ppuState->ppuThread[thrdID].ppuRes = new PPU_RES;
-    memset(ppuState->ppuThread[thrdID].ppuRes, 0, sizeof(PPU_RES));
     xenonContext->xenonRes.Register(ppuState->ppuThread[thrdID].ppuRes);
 
     // Set the decrementer as per docs. See CBE Public Registers pdf in Docs.
-    ppuState->ppuThread[ppuState->currentThread].SPR.DEC = 0x7FFFFFFF;
+    ppuState->ppuThread[thrdID].SPR.DEC = 0x7FFFFFFF;
   }
 
   // Set PPU Name.
   ppuState->ppuName = ppuName;
 
-  // Set thread name.
-  Base::SetCurrentThreadName(ppuName);
-
   // Set PVR and PIR
   ppuState->SPR.PVR.PVR_Hex = PVR;
   ppuState->ppuThread[PPU_THREAD_0].SPR.PIR = PIR;
@@ -90,127 +99,166 @@ PPU::PPU(XENON_CONTEXT *inXenonContext, RootBus *mainBus, u32 PVR,
     ppuState->SPR.HRMOR = 0x0000020000000000;
     ppuState->ppuThread[PPU_THREAD_0].NIA = 0x20000000100;
   }
+}
 
-  ppuThread = std::thread(&PPU::StartExecution, this);
-  ppuThread.detach();
+PPU::PPU(PPU *corePPU) {
+  // Same core, with our own execution context.
+  coreState = corePPU->coreState;
+  ppuState = std::make_shared<STRIP_UNIQUE(ppuState)>(coreState.get());
+  xenonContext = corePPU->xenonContext;
+
+  ppuState->ticksPerInstruction = corePPU->ppuState->ticksPerInstruction;
+  ppuState->ppuName = corePPU->ppuState->ppuName;
+
+  // Split the threads, from now on neither can touch the other's state.
+  execThreads = PPU_THREAD_1;
+  ppuState->currentThread = PPU_THREAD_1;
+  ppuState->curThread = &ppuState->ppuThread[PPU_THREAD_1];
+  ppuState->smtHostThreads = true;
+  corePPU->execThreads = PPU_THREAD_0;
+  corePPU->ppuState->currentThread = PPU_THREAD_0;
+  corePPU->ppuState->curThread = &corePPU->ppuState->ppuThread[PPU_THREAD_0];
+  corePPU->ppuState->smtHostThreads = true;
+
+  initExecution();
+
+  ppuRunning = corePPU->ppuRunning;
 }
 
-// PPU Entry Point.
-void PPU::StartExecution() {
+// Allocates what's needed to run the threads, every PPU has its own.
+void PPU::initExecution() {
+  // Allocate our decode cache.
+  decodeCache = std::make_unique<PPU_DECODE_BLOCK[]>(PPU_DECODE_CACHE_BLOCKS);
+
+  blockDispatch = Config::blockDispatch();
+  spinLoopSkip = Config::spinLoopSkip();
+
+  // Create the block recompiler if requested.
+  if (Config::jit()) {
+    ppuJIT = std::make_unique<STRIP_UNIQUE(ppuJIT)>();
+    if (!ppuJIT->IsAvailable()) {
+      ppuJIT.reset();
+    }
+  }
+}
+
+// PPU Entry Point, called by the scheduler. Executes one time slice, TTR
+// instructions on every running thread. Returns false if no thread is running,
+// so the PPU can be parked until the IIC signals an interrupt for it.
+bool PPU::ExecuteSlice() {
   // While the CPU is running
-  while (ppuRunning) {
+  if (ppuRunning) {
     // See if we have any threads active.
-    while (getCurrentRunningThreads() != PPU_THREAD_NONE) {
+    if (isThreadActive(PPU_THREAD_0) || isThreadActive(PPU_THREAD_1)) {
       // We have some threads active!
 
       // Check if the 1st thread is active and process instructions on it.
-      if (getCurrentRunningThreads() == PPU_THREAD_0 ||
-          getCurrentRunningThreads() == PPU_THREAD_BOTH) {
-        // Thread 0 is running, process instructions until we reach TTR timeout.
-        ppuState->currentThread = PPU_THREAD_0;
-
-        // Loop on this thread for the amount of Instructions that TTR tells us.
-        for (size_t instrCount = 0; instrCount < ppuState->SPR.TTR;
-             instrCount++) {
-          // Main processing loop.
-
-          // Read next intruction from Memory.
-          if (ppuReadNextInstruction()) {
-            // Execute next intrucrtion.
-            PPCInterpreter::ppcExecuteSingleInstruction(ppuState.get());
-          }
-
-          // Increase Time Base Counter
-          if (xenonContext->timeBaseActive) {
-            // HID6[15]: Time-base and decrementer facility enable.
-            // 0 -> TBU, TBL, DEC, HDEC, and the hang-detection logic do not
-            // update. 1 -> TBU, TBL, DEC, HDEC, and the hang-detection logic
-            // are enabled to update.
-            if (ppuState->SPR.HID6 & 0x1000000000000) {
-              updateTimeBase();
-            }
-          }
-
-          // Check if External interrupts are enabled and the IIC has a pending
-          // interrupt.
-          if (ppuState->ppuThread[ppuState->currentThread].SPR.MSR.EE) {
-            if (xenonContext->xenonIIC.checkExtInterrupt(
-                    ppuState->ppuThread[ppuState->currentThread].SPR.PIR)) {
-              ppuState->ppuThread[ppuState->currentThread].exceptReg |=
-                  PPU_EX_EXT;
-            }
-          }
-
-          // Check Exceptions pending.
-          ppuCheckExceptions();
-        }
+      if (isThreadActive(PPU_THREAD_0)) {
+        runThreadSlice(PPU_THREAD_0);
       }
       // Check again for the 2nd thread.
-      if (getCurrentRunningThreads() == PPU_THREAD_1 ||
-          getCurrentRunningThreads() == PPU_THREAD_BOTH) {
-        // Thread 0 is running, process instructions until we reach TTR timeout.
-        ppuState->currentThread = PPU_THREAD_1;
-
-        // Loop on this thread for the amount of Instructions that TTR tells us.
-        for (size_t instrCount = 0; instrCount < ppuState->SPR.TTR;
-             instrCount++) {
-          // Main processing loop.
-
-          // Read next intruction from Memory.
-          if (ppuReadNextInstruction()) {
-            // Execute next intrucrtion.
-            PPCInterpreter::ppcExecuteSingleInstruction(ppuState.get());
-          }
-
-          // Check if time base is active.
-          if (xenonContext->timeBaseActive) {
-            // HID6[15]: Time-base and decrementer facility enable.
-            // 0 -> TBU, TBL, DEC, HDEC, and the hang-detection logic do not
-            // update. 1 -> TBU, TBL, DEC, HDEC, and the hang-detection logic
-            // are enabled to update.
-            if (ppuState->SPR.HID6 & 0x1000000000000) {
-              updateTimeBase();
-            }
-          }
-
-          // Check if External interrupts are enabled and the IIC has a pending
-          // interrupt.
-          if (ppuState->ppuThread[ppuState->currentThread].SPR.MSR.EE) {
-            if (xenonContext->xenonIIC.checkExtInterrupt(
-                    ppuState->ppuThread[ppuState->currentThread].SPR.PIR)) {
-              ppuState->ppuThread[ppuState->currentThread].exceptReg |=
-                  PPU_EX_EXT;
-            }
-          }
-
-          // Check Exceptions pending.
-          ppuCheckExceptions();
-        }
+      if (isThreadActive(PPU_THREAD_1)) {
+        runThreadSlice(PPU_THREAD_1);
       }
+      // Keep the time base current between slices.
+      PPCInterpreter::ppcUpdateTimeBase(ppuState.get());
+      return true;
     }
 
     //
-    // Check for external interrupts that enable us if we're allowed to.
+    // Check for external interrupts that enable us if we're allowed to. With
+    // SMT host threads, only the PPU running thread 0 does it and only if the
+    // other thread isn't running either.
     //
 
+    auto coreLock = PPCInterpreter::ppcLockCore(ppuState.get());
+    if (execThreads == PPU_THREAD_1 ||
+        getCurrentRunningThreads() != PPU_THREAD_NONE) {
+      return false;
+    }
+
     // If TSCR[WEXT] = '1', wake up at System Reset and set SRR1[42:44] = '100'.
     bool WEXT = (ppuState->SPR.TSCR & 0x100000) >> 20;
     if (xenonContext->xenonIIC.checkExtInterrupt(
-            ppuState->ppuThread[ppuState->currentThread].SPR.PIR) &&
+            ppuState->curThread->SPR.PIR) &&
         WEXT) {
       // Great, someone started us! Let's enable THRD0.
-      ppuState->SPR.CTRL = 0x800000;
+      std::atomic_ref<u32>(ppuState->SPR.CTRL)
+          .store(0x800000, std::memory_order_relaxed);
       // Issue reset!
-      ppuState->ppuThread[PPU_THREAD_0].exceptReg |= PPU_EX_RESET;
-      ppuState->ppuThread[PPU_THREAD_1].exceptReg |=
-          PPU_EX_RESET; // Set CIA to 0x100 as per docs.
-      ppuState->ppuThread[ppuState->currentThread].SPR.SRR1 =
+      PPCInterpreter::ppcPostException(ppuState.get(), PPU_THREAD_0,
+                                       PPU_EX_RESET);
+      PPCInterpreter::ppcPostException(
+          ppuState.get(), PPU_THREAD_1,
+          PPU_EX_RESET); // Set CIA to 0x100 as per docs.
+      ppuState->curThread->SPR.SRR1 =
           0x200000; // Set SRR1 42-44 = 100
       // EOI the interrupt:
       xenonContext->xenonIIC.writeInterrupt(
-        ppuState->ppuThread[ppuState->currentThread].SPR.PIR * 0x1000 + 0x50060, 0);
+        ppuState->curThread->SPR.PIR * 0x1000 + 0x50060, 0);
+    }
+  }
+  return isThreadActive(PPU_THREAD_0) || isThreadActive(PPU_THREAD_1);
+}
+
+// Runs a thread for the amount of instructions that TTR tells us.
+void PPU::runThreadSlice(PPU_THREAD thrdID) {
+  ppuState->currentThread = thrdID;
+  ppuState->curThread = &ppuState->ppuThread[thrdID];
+  Base::Log::SetThreadContext(
+      static_cast<u8>(ppuState->ppuThread[thrdID].SPR.PIR),
+      &ppuState->ppuThread[thrdID].CIA);
+  PPCInterpreter::ppcFpuEnterThread(ppuState.get());
+
+  for (size_t instrCount = 0; instrCount < ppuState->SPR.TTR; instrCount++) {
+    // Main processing loop.
+
+    // Run a whole recompiled block if we can, exceptions and interrupts are
+    // then checked at its end.
+    u32 executedInstrs = ppuJIT ? ppuExecuteJitBlock() : 0;
+    if (executedInstrs == 0 && blockDispatch) {
+      executedInstrs = ppuExecuteDecodedBlock();
+    }
+    if (executedInstrs != 0) {
+      instrCount += executedInstrs - 1;
+    } else {
+      executedInstrs = 1;
+      // Read next intruction from Memory.
+      if (ppuReadNextInstruction()) {
+        // Execute next intrucrtion.
+        PPCInterpreter::ppcExecuteSingleInstruction(ppuState.get(),
+                                                    nextHandler);
+      }
+    }
+
+    // Increase Time Base Counter, it's only brought up to date when a
+    // decrementer is due or when the time base registers are accessed.
+    ppuState->tbPendingInstrs += executedInstrs;
+    // A thread stuck polling can't exit its loop before the next event, don't
+    // spin until then. A block may already have taken us past the end of the
+    // slice, in which case there's nothing left to skip.
+    if (spinDetected) {
+      instrCount += ppuSkipSpinLoop(instrCount + 1 < ppuState->SPR.TTR
+                                        ? ppuState->SPR.TTR - instrCount - 1
+                                        : 0);
+    }
+    if (ppuState->tbPendingInstrs >= ppuState->tbEventInstrs) {
+      PPCInterpreter::ppcUpdateTimeBase(ppuState.get());
+    }
+
+    // Check if External interrupts are enabled and the IIC has a pending
+    // interrupt.
+    if (ppuState->curThread->MSR.EE) {
+      if (xenonContext->xenonIIC.checkExtInterrupt(
+              ppuState->curThread->SPR.PIR)) {
+        ppuState->curThread->exceptReg |= PPU_EX_EXT;
+      }
     }
+
+    // Check Exceptions pending.
+    ppuCheckExceptions();
   }
+  PPCInterpreter::ppcFpuLeaveThread(ppuState.get());
 }
 
 // Returns a pointer to the specified thread.
@@ -238,7 +286,7 @@ u32 PPU::getIPS() {
   }
 
   // Set our NIP to our calibration code address.
-  ppuState->ppuThread[ppuState->currentThread].NIA = 4;
+  ppuState->curThread->NIA = 4;
 
   // Start a timer.
   auto timerStart = std::chrono::steady_clock::now();
@@ -250,7 +298,7 @@ u32 PPU::getIPS() {
   while (auto timerEnd = std::chrono::steady_clock::now() <=
                          timerStart + std::chrono::seconds(1)) {
     ppuReadNextInstruction();
-    PPCInterpreter::ppcExecuteSingleInstruction(ppuState.get());
+    PPCInterpreter::ppcExecuteSingleInstruction(ppuState.get(), nextHandler);
     instrCount++;
   }
 
@@ -262,11 +310,11 @@ u32 PPU::getIPS() {
   }
 
   // Set the NIP back to default.
-  ppuState->ppuThread[ppuState->currentThread].NIA = 0x100;
+  ppuState->curThread->NIA = 0x100;
 
   // Set the registers back to 0.
   for (int i = 0; i < 32; i++) {
-    ppuState->ppuThread[ppuState->currentThread].GPR[i] = 0;
+    ppuState->curThread->GPR[i] = 0;
   }
 
   return instrCount;
@@ -275,28 +323,566 @@ u32 PPU::getIPS() {
 // Reads the next instruction from memory and advances the NIP accordingly.
 bool PPU::ppuReadNextInstruction() {
   // Update CIA.
-  ppuState->ppuThread[ppuState->currentThread].CIA =
-      ppuState->ppuThread[ppuState->currentThread].NIA;
+  ppuState->curThread->CIA =
+      ppuState->curThread->NIA;
   // Increase Next Instruction Address.
-  ppuState->ppuThread[ppuState->currentThread].NIA += 4;
-  ppuState->ppuThread[ppuState->currentThread].iFetch = true;
+  ppuState->curThread->NIA += 4;
+
+  // Try the decode cache first.
+  const PPU_DECODED_INSTR *decodedInstr = ppuFetchDecodedInstruction();
+  if (decodedInstr != nullptr) {
+    ppuState->curThread->CI.opcode =
+        decodedInstr->opcode;
+    nextHandler = decodedInstr->handler;
+    if (curBlockHooked[ppuState->currentThread] &&
+        PPCInterpreter::ppcHasHook(
+            ppuState->curThread->CIA)) {
+      nextHandler = &PPCInterpreter::ppcExecuteHooked;
+    }
+    return true;
+  }
+  nextHandler = nullptr;
+  if (ppuState->curThread->exceptReg & PPU_EX_INSSTOR ||
+      ppuState->curThread->exceptReg &
+          PPU_EX_INSTSEGM) {
+    return false;
+  }
+
+  ppuState->curThread->iFetch = true;
   // Fetch the instruction from memory.
-  ppuState->ppuThread[ppuState->currentThread].CI.opcode = PPCInterpreter::MMURead32(
-      ppuState.get(), ppuState->ppuThread[ppuState->currentThread].CIA);
-  if (ppuState->ppuThread[ppuState->currentThread].exceptReg & PPU_EX_INSSTOR ||
-      ppuState->ppuThread[ppuState->currentThread].exceptReg &
+  ppuState->curThread->CI.opcode = PPCInterpreter::MMURead32(
+      ppuState.get(), ppuState->curThread->CIA);
+  if (ppuState->curThread->exceptReg & PPU_EX_INSSTOR ||
+      ppuState->curThread->exceptReg &
           PPU_EX_INSTSEGM) {
     return false;
   }
-  ppuState->ppuThread[ppuState->currentThread].iFetch = false;
+  ppuState->curThread->iFetch = false;
+  if (PPCInterpreter::ppcHasHook(
+          ppuState->curThread->CIA)) {
+    nextHandler = &PPCInterpreter::ppcExecuteHooked;
+  }
   return true;
 }
 
+// Returns true if the given instruction must be the last one of a decode
+// block: branches, exception causing instructions and anything that may alter
+// the translation of the following instructions.
+static bool ppuEndsDecodeBlock(u32 opcode) {
+  switch (opcode >> 26) {
+  case 2:  // tdi
+  case 3:  // twi
+  case 16: // bc
+  case 17: // sc
+  case 18: // b
+  case 19: // bclr, bcctr, rfid, isync...
+    return true;
+  case 31:
+    switch ((opcode >> 1) & 0x3FF) {
+    case 4:   // tw
+    case 68:  // td
+    case 146: // mtmsr
+    case 178: // mtmsrd
+    case 274: // tlbiel
+    case 306: // tlbie
+    case 402: // slbmte
+    case 434: // slbie
+    case 467: // mtspr
+    case 498: // slbia
+    case 982: // icbi
+      return true;
+    }
+    break;
+  }
+  return false;
+}
+
+// GPR's read and written by an instruction allowed in a spin loop. Returns
+// false for anything that may have other side effects.
+static bool ppuSpinLoopRegs(u32 opcode, u32 *readRegs, u32 *writeRegs) {
+  const u32 rD = (opcode >> 21) & 0x1F;
+  const u32 rA = (opcode >> 16) & 0x1F;
+  const u32 rB = (opcode >> 11) & 0x1F;
+  // rA = 0 means a literal zero for loads and addi/addis.
+  const u32 baseReg = rA ? 1U << rA : 0;
+
+  switch (opcode >> 26) {
+  case 10: // cmpli
+  case 11: // cmpi
+    *readRegs = 1U << rA;
+    *writeRegs = 0;
+    return true;
+  case 14: // addi
+  case 15: // addis
+  case 32: // lwz
+  case 34: // lbz
+  case 40: // lhz
+  case 42: // lha
+    *readRegs = baseReg;
+    *writeRegs = 1U << rD;
+    return true;
+  case 58: // ld, lwa
+    if ((opcode & 3) == 1) {
+      return false;
+    }
+    *readRegs = baseReg;
+    *writeRegs = 1U << rD;
+    return true;
+  case 21: // rlwinm
+  case 24: // ori
+  case 25: // oris
+  case 26: // xori
+  case 27: // xoris
+  case 28: // andi.
+  case 29: // andis.
+    *readRegs = 1U << rD;
+    *writeRegs = 1U << rA;
+    return true;
+  case 30: // rldicl, rldicr, rldic
+    if (((opcode >> 2) & 7) > 2) {
+      return false;
+    }
+    *readRegs = 1U << rD;
+    *writeRegs = 1U << rA;
+    return true;
+  case 31:
+    switch ((opcode >> 1) & 0x3FF) {
+    case 0:  // cmp
+    case 32: // cmpl
+      *readRegs = (1U << rA) | (1U << rB);
+      *writeRegs = 0;
+      return true;
+    case 21:  // ldx
+    case 23:  // lwzx
+    case 87:  // lbzx
+    case 279: // lhzx
+    case 341: // lwax
+    case 343: // lhax
+    case 534: // lwbrx
+    case 790: // lhbrx
+      *readRegs = baseReg | (1U << rB);
+      *writeRegs = 1U << rD;
+      return true;
+    case 40:  // subf
+    case 266: // add
+      *readRegs = (1U << rA) | (1U << rB);
+      *writeRegs = 1U << rD;
+      return true;
+    case 24:  // slw
+    case 27:  // sld
+    case 28:  // and
+    case 60:  // andc
+    case 124: // nor
+    case 316: // xor
+    case 444: // or
+    case 536: // srw
+    case 539: // srd
+      *readRegs = (1U << rD) | (1U << rB);
+      *writeRegs = 1U << rA;
+      return true;
+    case 26:  // cntlzw
+    case 58:  // cntlzd
+    case 922: // extsh
+    case 954: // extsb
+    case 986: // extsw
+      *readRegs = 1U << rD;
+      *writeRegs = 1U << rA;
+      return true;
+    case 339: { // mfspr
+      const u32 sprNum = rA | (rB << 5);
+      if (sprNum != SPR_DEC && sprNum != SPR_TBL_RO && sprNum != SPR_TBU_RO) {
+        return false;
+      }
+      *readRegs = 0;
+      *writeRegs = 1U << rD;
+      return true;
+    }
+    case 371: // mftb
+      *readRegs = 0;
+      *writeRegs = 1U << rD;
+      return true;
+    }
+    break;
+  }
+  return false;
+}
+
+// Returns true if a decode block is a loop back to its own start with no side
+// effects, every iteration then runs on the same state and only memory, the
+// time base or an interrupt can get it out.
+static bool ppuIsSpinLoop(const PPU_DECODE_BLOCK *block) {
+  // The loop branch, relative, not linking and not decrementing CTR.
+  const u32 branch = block->instrs[block->instrCount - 1].opcode;
+  const s64 loopOffset = -static_cast<s64>(block->instrCount - 1) * 4;
+  if (branch & 3) {
+    return false;
+  }
+  switch (branch >> 26) {
+  case 16: // bc
+    if (!((branch >> 21) & 0x4) ||
+        static_cast<s16>(branch & 0xFFFC) != loopOffset) {
+      return false;
+    }
+    break;
+  case 18: // b
+    if ((static_cast<s32>(branch << 6) >> 6) != loopOffset) {
+      return false;
+    }
+    break;
+  default:
+    return false;
+  }
+
+  // Registers read before being written in an iteration hold values from the
+  // previous one, the loop must not write those.
+  u32 writtenRegs = 0;
+  u32 carriedRegs = 0;
+  for (u8 instrIdx = 0; instrIdx < block->instrCount - 1; instrIdx++) {
+    u32 readRegs = 0;
+    u32 writeRegs = 0;
+    if (!ppuSpinLoopRegs(block->instrs[instrIdx].opcode, &readRegs,
+                         &writeRegs)) {
+      return false;
+    }
+    carriedRegs |= readRegs & ~writtenRegs;
+    writtenRegs |= writeRegs;
+  }
+  return (carriedRegs & writtenRegs) == 0;
+}
+
+// Checks a block against the generation of the page it was decoded from,
+// stores to that page move it to the next one.
+bool PPU::ppuDecodeBlockCurrent(const PPU_DECODE_BLOCK *block) {
+  return block->codeGeneration ==
+         PPCInterpreter::mmuCodePageGeneration(block->startRA);
+}
+
+// Fetches the instruction at CIA from the decode cache. Returns nullptr when
+// the instruction can't be cached or its translation failed, in which case the
+// exception is already set.
+const PPU_DECODED_INSTR *PPU::ppuFetchDecodedInstruction() {
+  PPU_THREAD_REGISTERS &thread = *ppuState->curThread;
+  const u8 thrd = ppuState->currentThread;
+
+  // Sequential execution inside the block we're already in. The other thread
+  // may have replaced it meanwhile, or its instructions may have been
+  // modified.
+  PPU_DECODE_BLOCK *block = curBlock[thrd];
+  if (block != nullptr && block->valid && block->startRA == curBlockRA[thrd] &&
+      thread.CIA == curBlockNextEA[thrd] &&
+      curBlockIndex[thrd] < block->instrCount &&
+      ppuDecodeBlockCurrent(block)) {
+    curBlockNextEA[thrd] += 4;
+    return &block->instrs[curBlockIndex[thrd]++];
+  }
+  curBlock[thrd] = nullptr;
+
+  // Entering a new block, translate its address.
+  u64 RA = thread.CIA;
+  thread.iFetch = true;
+  if (PPCInterpreter::MMUTranslateAddress(&RA, ppuState.get(), false) ==
+      false) {
+    return nullptr;
+  }
+  thread.iFetch = false;
+
+  bool socFetch = false;
+  RA = PPCInterpreter::mmuContructEndAddressFromSecEngAddr(RA, &socFetch);
+  if (((thread.CIA & 0x000000007fff0000) >> 16) == 0x7FFF) {
+    socFetch = true;
+  }
+
+  // Only main memory is cached, SROM/SRAM code is fetched as usual.
+  if (socFetch || RA + 4 > RAM_START_ADDR + RAM_SIZE) {
+    spinBlock[thrd] = nullptr;
+    return nullptr;
+  }
+
+  block = &decodeCache[(RA >> 2) & (PPU_DECODE_CACHE_BLOCKS - 1)];
+  if (!block->valid || block->startRA != RA || !ppuDecodeBlockCurrent(block)) {
+    ppuBuildDecodeBlock(block, RA);
+  }
+  ppuTrackSpinLoop(block, thread.CIA);
+
+  curBlock[thrd] = block;
+  curBlockRA[thrd] = RA;
+  curBlockNextEA[thrd] = thread.CIA + 4;
+  curBlockIndex[thrd] = 1;
+  // Blocks never cross a page, so this holds for the whole block.
+  curBlockHooked[thrd] = PPCInterpreter::ppcHookPageHas(thread.CIA);
+  return &block->instrs[0];
+}
+
+// Looks up the decode block starting at NIA. Only blocks already in the decode
+// cache and whose address is in the I-ERAT are returned, anything else has to
+// go through the regular fetch path first, which takes care of exceptions.
+PPU_DECODE_BLOCK *PPU::ppuLookupDecodeBlock() {
+  PPU_THREAD_REGISTERS &thread = *ppuState->curThread;
+
+  // Translate NIA through the I-ERAT, as MMUTranslateAddress does on
+  // instruction fetches.
+  u64 RA = thread.NIA;
+  if (!thread.MSR.SF) {
+    RA = static_cast<u32>(RA);
+  }
+  const u8 eratMode =
+      (thread.MSR.IR || thread.MSR.DR ? PPU_ERAT_MODE_RELOC : 0) |
+      (thread.MSR.HV ? PPU_ERAT_MODE_HV : 0) |
+      (thread.MSR.SF ? PPU_ERAT_MODE_SF : 0);
+  if (!PPCInterpreter::mmuSearchEratEntry(&thread.iERAT, &RA, eratMode,
+                                          false)) {
+    return nullptr;
+  }
+
+  bool socFetch = false;
+  RA = PPCInterpreter::mmuContructEndAddressFromSecEngAddr(RA, &socFetch);
+  if (socFetch || ((thread.NIA & 0x000000007fff0000) >> 16) == 0x7FFF ||
+      RA + 4 > RAM_START_ADDR + RAM_SIZE) {
+    return nullptr;
+  }
+
+  PPU_DECODE_BLOCK *block =
+      &decodeCache[(RA >> 2) & (PPU_DECODE_CACHE_BLOCKS - 1)];
+  if (!block->valid || block->startRA != RA || !ppuDecodeBlockCurrent(block)) {
+    return nullptr;
+  }
+  return block;
+}
+
+// Returns the recompiled code of a block for a given EA, nullptr if there's
+// none.
+static JITBlockFunc ppuGetJitCode(const PPU_DECODE_BLOCK *block, u64 EA) {
+  for (const PPU_JIT_ENTRY &jitEntry : block->jitEntries) {
+    if (jitEntry.code != nullptr && jitEntry.EA == EA) {
+      return jitEntry.code;
+    }
+  }
+  return nullptr;
+}
+
+// Adds the code of a block for an EA it has none for yet, replacing the
+// oldest one when all entries are in use.
+static void ppuSetJitCode(PPU_DECODE_BLOCK *block, u64 EA, JITBlockFunc code) {
+  block->jitEntries[block->jitNextEntry] = {EA, code};
+  block->jitNextEntry = (block->jitNextEntry + 1) % PPU_JIT_BLOCK_EAS;
+}
+
+// Runs the recompiled block starting at NIA.
+u32 PPU::ppuExecuteJitBlock() {
+  PPU_THREAD_REGISTERS &thread = *ppuState->curThread;
+
+  PPU_DECODE_BLOCK *block = ppuLookupDecodeBlock();
+  if (block == nullptr) {
+    return 0;
+  }
+
+  JITBlockFunc jitCode = ppuGetJitCode(block, thread.NIA);
+  if (jitCode == nullptr) {
+    block->jitLastEA = thread.NIA;
+    if (block->jitExecCount < PPU_JIT_COMPILE_THRESHOLD) {
+      block->jitExecCount++;
+      return 0;
+    }
+    if (!ppuCompileJitBlocks(block, thread.NIA)) {
+      return 0;
+    }
+    jitCode = ppuGetJitCode(block, thread.NIA);
+  }
+
+  // We're leaving whatever block the fetch path was in.
+  curBlock[ppuState->currentThread] = nullptr;
+  ppuTrackSpinLoop(block, thread.NIA);
+
+  return jitCode(ppuState.get(), &thread);
+}
+
+// Recompiles a block entered PPU_JIT_COMPILE_THRESHOLD times from EA. Blocks
+// at least half as hot are likely next, so they're compiled in the same batch
+// and the code buffer only changes protection once for all of them.
+bool PPU::ppuCompileJitBlocks(PPU_DECODE_BLOCK *hotBlock, u64 EA) {
+  JITBlockFunc jitCode = ppuJIT->Compile(hotBlock, EA);
+  if (jitCode == nullptr) {
+    // Out of code space, start over.
+    if (!ppuJIT->Flush()) {
+      LOG_ERROR(Xenon, "JIT: Unable to make the code buffer writable, falling "
+                       "back to the interpreter.");
+      ppuDiscardJitCode(true);
+      return false;
+    }
+    ppuDiscardJitCode(false);
+    jitCode = ppuJIT->Compile(hotBlock, EA);
+    if (jitCode == nullptr) {
+      return false;
+    }
+  }
+  ppuSetJitCode(hotBlock, EA, jitCode);
+
+  for (u32 blockIdx = 0; blockIdx < PPU_DECODE_CACHE_BLOCKS; blockIdx++) {
+    PPU_DECODE_BLOCK *block = &decodeCache[blockIdx];
+    if (!block->valid ||
+        block->jitExecCount < PPU_JIT_COMPILE_THRESHOLD / 2 ||
+        ppuGetJitCode(block, block->jitLastEA) != nullptr ||
+        !ppuDecodeBlockCurrent(block)) {
+      continue;
+    }
+    jitCode = ppuJIT->Compile(block, block->jitLastEA);
+    if (jitCode == nullptr) {
+      break;
+    }
+    ppuSetJitCode(block, block->jitLastEA, jitCode);
+  }
+
+  if (!ppuJIT->Seal()) {
+    LOG_ERROR(Xenon, "JIT: Unable to make the code buffer executable, falling "
+                     "back to the interpreter.");
+    ppuDiscardJitCode(true);
+    return false;
+  }
+  return true;
+}
+
+// Forgets the recompiled code of every block.
+void PPU::ppuDiscardJitCode(bool disable) {
+  for (u32 blockIdx = 0; blockIdx < PPU_DECODE_CACHE_BLOCKS; blockIdx++) {
+    PPU_DECODE_BLOCK &block = decodeCache[blockIdx];
+    for (PPU_JIT_ENTRY &jitEntry : block.jitEntries) {
+      jitEntry = {};
+    }
+    block.jitNextEntry = 0;
+  }
+  if (disable) {
+    ppuJIT.reset();
+  }
+}
+
+// Runs the decoded block starting at NIA, calling the handlers one after the
+// other without going through the fetch path. Stops at the end of the block,
+// when control leaves it or when an exception is raised. Time base, interrupts
+// and exceptions are then handled once for the whole block, as for JIT blocks.
+u32 PPU::ppuExecuteDecodedBlock() {
+  PPU_THREAD_REGISTERS &thread = *ppuState->curThread;
+
+  PPU_DECODE_BLOCK *block = ppuLookupDecodeBlock();
+  // Guest patches are only run by the fetch path.
+  if (block == nullptr || PPCInterpreter::ppcHookPageHas(thread.NIA)) {
+    return 0;
+  }
+
+  // We're leaving whatever block the fetch path was in.
+  curBlock[ppuState->currentThread] = nullptr;
+  ppuTrackSpinLoop(block, thread.NIA);
+
+  PPU_STATE *hCore = ppuState.get();
+  const PPU_DECODED_INSTR *instr = block->instrs;
+  const PPU_DECODED_INSTR *blockEnd = block->instrs + block->instrCount;
+  u64 CIA = thread.NIA;
+  do {
+    thread.CIA = CIA;
+    thread.NIA = CIA + 4;
+    thread.CI.opcode = instr->opcode;
+    instr->handler(hCore);
+    CIA += 4;
+    instr++;
+  } while (instr != blockEnd && thread.NIA == CIA &&
+           thread.exceptReg == PPU_EX_NONE);
+
+  return static_cast<u32>(instr - block->instrs);
+}
+
+// Decodes instructions starting at a given real address until the end of the
+// basic block.
+void PPU::ppuBuildDecodeBlock(PPU_DECODE_BLOCK *block, u64 RA) {
+  // Stores to this page must invalidate us from now on. Mark it before
+  // reading the instructions so no store can be missed.
+  block->codeGeneration = PPCInterpreter::mmuMarkCodePage(RA);
+
+  // Whatever loop a thread was in, this block no longer holds it.
+  for (PPU_DECODE_BLOCK *&threadSpinBlock : spinBlock) {
+    if (threadSpinBlock == block) {
+      threadSpinBlock = nullptr;
+    }
+  }
+
+  block->valid = true;
+  block->startRA = RA;
+  block->instrCount = 0;
+  for (PPU_JIT_ENTRY &jitEntry : block->jitEntries) {
+    jitEntry = {};
+  }
+  block->jitNextEntry = 0;
+  block->jitExecCount = 0;
+
+  const u8 *code =
+      PPCInterpreter::mainMemory->getPointerToAddress(static_cast<u32>(RA));
+  do {
+    u32 opcode = 0;
+    memcpy(&opcode, code + block->instrCount * 4, sizeof(u32));
+    opcode = std::byteswap<u32>(opcode);
+
+    PPU_DECODED_INSTR &decodedInstr = block->instrs[block->instrCount++];
+    decodedInstr.opcode = opcode;
+    decodedInstr.handler = PPCInterpreter::ppcDecodeInstruction(opcode);
+
+    if (ppuEndsDecodeBlock(opcode)) {
+      break;
+    }
+  } while (block->instrCount < PPU_DECODE_BLOCK_MAX_INSTRS &&
+           ((RA + block->instrCount * 4) & 0xFFF) != 0);
+
+  block->spinLoop = ppuIsSpinLoop(block);
+}
+
+// Counts how many times in a row the current thread entered the same spin
+// loop. Every other block it enters resets the count, so the thread must have
+// gone around the loop each time.
+void PPU::ppuTrackSpinLoop(PPU_DECODE_BLOCK *block, u64 EA) {
+  const u8 thrd = ppuState->currentThread;
+  if (!block->spinLoop || spinBlock[thrd] != block || spinEA[thrd] != EA) {
+    spinBlock[thrd] = block->spinLoop ? block : nullptr;
+    spinEA[thrd] = EA;
+    spinIters[thrd] = 0;
+    return;
+  }
+  if (++spinIters[thrd] >= PPU_SPIN_LOOP_ITERS) {
+    spinIters[thrd] = 0;
+    spinDetected = spinLoopSkip;
+  }
+}
+
+// Accounts for the instructions the current thread would spin for until the
+// time base is next updated, that is the next decrementer underflow or device
+// event. With nothing due the rest of the time slice is given up instead.
+u64 PPU::ppuSkipSpinLoop(u64 maxInstrs) {
+  spinDetected = false;
+  const u32 pendingInstrs = ppuState->tbPendingInstrs;
+  const u64 skippedInstrs = std::min<u64>(
+      ppuState->tbEventInstrs > pendingInstrs
+          ? ppuState->tbEventInstrs - pendingInstrs
+          : 0,
+      maxInstrs);
+  ppuState->tbPendingInstrs += static_cast<u32>(skippedInstrs);
+  return skippedInstrs;
+}
+
 // Checks for exceptions and process them in the correct order.
 void PPU::ppuCheckExceptions() {
+  // Pick up whatever the other thread of the core posted us.
+  std::atomic<u32> &postedRequests = ppuState->curThread->postedRequests;
+  if (postedRequests.load(std::memory_order_relaxed) != 0) {
+    const u32 requests = postedRequests.exchange(0, std::memory_order_acquire);
+    if (requests & PPU_REQ_FLUSH_ERATS) {
+      PPCInterpreter::mmuInvalidateErats(ppuState.get(),
+                                         ppuState->currentThread);
+    }
+    ppuState->curThread->exceptReg |= static_cast<u16>(requests);
+  }
+
   // Check Exceptions pending and process them in order.
-  u16 exceptions = ppuState->ppuThread[ppuState->currentThread].exceptReg;
+  u16 exceptions = ppuState->curThread->exceptReg;
   if (exceptions != PPU_EX_NONE) {
+    // Whatever loop the thread was in, it's leaving it.
+    spinBlock[ppuState->currentThread] = nullptr;
+
     // Non Maskable:
 
     //
@@ -312,7 +898,7 @@ void PPU::ppuCheckExceptions() {
     // 2. Machine Check
     //
     if (exceptions & PPU_EX_MC) {
-      if (ppuState->ppuThread[ppuState->currentThread].SPR.MSR.ME) {
+      if (ppuState->curThread->MSR.ME) {
         PPCInterpreter::ppcResetException(ppuState.get());
         exceptions &= ~PPU_EX_MC;
         goto end;
@@ -334,7 +920,7 @@ void PPU::ppuCheckExceptions() {
 
     // A. Program - Illegal Instruction
     if (exceptions & PPU_EX_PROG &&
-        ppuState->ppuThread[ppuState->currentThread].exceptTrapType == 44) {
+        ppuState->curThread->exceptTrapType == 44) {
       LOG_ERROR(Xenon, "{}(Thrd{:#d}): Unhandled Exception: Illegal Instruction.",
           ppuState->ppuName, (u8)ppuState->currentThread);
       exceptions &= ~PPU_EX_PROG;
@@ -342,11 +928,16 @@ void PPU::ppuCheckExceptions() {
     }
     // B. Floating-Point Unavailable
     if (exceptions & PPU_EX_FPU) {
-        LOG_ERROR(Xenon, "{}(Thrd{:#d}): Unhandled Exception: Floating-Point Unavailable.",
-            ppuState->ppuName, (u8)ppuState->currentThread);
+      PPCInterpreter::ppcFPUnavailableException(ppuState.get());
       exceptions &= ~PPU_EX_FPU;
       goto end;
     }
+    // Vector Unavailable
+    if (exceptions & PPU_EX_VXU) {
+      PPCInterpreter::ppcVXUnavailableException(ppuState.get());
+      exceptions &= ~PPU_EX_VXU;
+      goto end;
+    }
     // C. Data Storage, Data Segment, or Alignment
     // Data Storage
     if (exceptions & PPU_EX_DATASTOR) {
@@ -377,7 +968,7 @@ void PPU::ppuCheckExceptions() {
     // E. Program Trap, System Call, Program Priv Inst, Program Illegal Inst
     // Program Trap
     if (exceptions & PPU_EX_PROG &&
-        ppuState->ppuThread[ppuState->currentThread].exceptTrapType == 46) {
+        ppuState->curThread->exceptTrapType == 46) {
       PPCInterpreter::ppcProgramException(ppuState.get());
       exceptions &= ~PPU_EX_PROG;
       goto end;
@@ -390,7 +981,7 @@ void PPU::ppuCheckExceptions() {
     }
     // Program - Privileged Instruction
     if (exceptions & PPU_EX_PROG &&
-        ppuState->ppuThread[ppuState->currentThread].exceptTrapType == 45) {
+        ppuState->curThread->exceptTrapType == 45) {
         LOG_ERROR(Xenon, "{}(Thrd{:#d}): Unhandled Exception: Privileged Instruction.",
             ppuState->ppuName, (u8)ppuState->currentThread);
       exceptions &= ~PPU_EX_PROG;
@@ -414,6 +1005,15 @@ void PPU::ppuCheckExceptions() {
     // 4. Program - Imprecise Mode Floating-Point Enabled Exception
     //
 
+    if (exceptions & PPU_EX_PROG &&
+        ppuState->curThread->exceptTrapType ==
+            TRAP_TYPE_SRR1_TRAP_FPU) {
+      // Raised right after the instruction, so every mode is handled as
+      // precise.
+      PPCInterpreter::ppcProgramException(ppuState.get());
+      exceptions &= ~PPU_EX_PROG;
+      goto end;
+    }
     if (exceptions & PPU_EX_PROG) {
         LOG_ERROR(Xenon, "{}(Thrd{:#d}): Unhandled Exception: Imprecise Mode Floating-Point Enabled Exception.",
             ppuState->ppuName, (u8)ppuState->currentThread);
@@ -427,7 +1027,7 @@ void PPU::ppuCheckExceptions() {
 
     // External
     if (exceptions & PPU_EX_EXT &&
-        ppuState->ppuThread[ppuState->currentThread].SPR.MSR.EE) {
+        ppuState->curThread->MSR.EE) {
       PPCInterpreter::ppcExternalException(ppuState.get());
       exceptions &= ~PPU_EX_EXT;
       goto end;
@@ -435,7 +1035,7 @@ void PPU::ppuCheckExceptions() {
     // Decrementer. A dec exception may be present but will only be taken when
     // the EE bit of MSR is set.
     if (exceptions & PPU_EX_DEC &&
-        ppuState->ppuThread[ppuState->currentThread].SPR.MSR.EE) {
+        ppuState->curThread->MSR.EE) {
       PPCInterpreter::ppcDecrementerException(ppuState.get());
       exceptions &= ~PPU_EX_DEC;
       goto end;
@@ -450,36 +1050,17 @@ void PPU::ppuCheckExceptions() {
 
     // Set the new value for our exception register.
   end:
-    ppuState->ppuThread[ppuState->currentThread].exceptReg = exceptions;
-  }
-}
-
-// Updates the time base based on the amount of ticks and checks for decrementer
-// interrupts if enabled.
-void PPU::updateTimeBase() {
-  // The Decrementer and the Time Base are driven by the same time frequency.
-  u32 newDec = 0;
-  u32 dec = 0;
-  // Update the Time Base.
-  ppuState->SPR.TB += ticksPerInstruction;
-  // Get the decrementer value.
-  dec = ppuState->ppuThread[ppuState->currentThread].SPR.DEC;
-  newDec = dec - ticksPerInstruction;
-  // Update the new decrementer value.
-  ppuState->ppuThread[ppuState->currentThread].SPR.DEC = newDec;
-  // Check if Previous decrementer measurement is smaller than current and a
-  // decrementer exception is not pending.
-  if (newDec > dec && ((ppuState->ppuThread[ppuState->currentThread].exceptReg &
-                        PPU_EX_DEC) == 0)) {
-    // The decrementer must issue an interrupt.
-    ppuState->ppuThread[ppuState->currentThread].exceptReg |= PPU_EX_DEC;
+    ppuState->curThread->exceptReg = exceptions;
   }
 }
 
 // Returns current executing thread by reading CTRL register.
 PPU_THREAD PPU::getCurrentRunningThreads() {
   // Check CTRL Register CTRL>TE[0,1];
-  u8 ctrlTE = (ppuState->SPR.CTRL & 0xC00000) >> 22;
+  // The other thread of the core may write it from another host thread.
+  const u32 CTRL = std::atomic_ref<u32>(ppuState->SPR.CTRL)
+                       .load(std::memory_order_relaxed);
+  u8 ctrlTE = (CTRL & 0xC00000) >> 22;
   switch (ctrlTE) {
   case 0b10:
     return PPU_THREAD_0;
@@ -491,3 +1072,12 @@ PPU_THREAD PPU::getCurrentRunningThreads() {
     return PPU_THREAD_NONE;
   }
 }
+
+// Returns whether a thread is enabled in CTRL and executed by this PPU.
+bool PPU::isThreadActive(PPU_THREAD thrdID) {
+  if (execThreads != PPU_THREAD_BOTH && execThreads != thrdID) {
+    return false;
+  }
+  const PPU_THREAD runningThreads = getCurrentRunningThreads();
+  return runningThreads == thrdID || runningThreads == PPU_THREAD_BOTH;
+}
@@ -6,49 +6,165 @@
 
 #include "PowerPC.h"
 
+#include "Core/RAM/RAM.h"
 #include "Core/RootBus/RootBus.h"
+#include "Core/XCPU/Interpreter/PPC_Instruction.h"
+#include "Core/XCPU/JIT/PPU_JIT.h"
+
+// Decode cache, holds pre-decoded basic blocks of instructions residing in
+// main memory, keyed on their real address. Blocks end at a branch, at an
+// instruction that alters the translation context, or at a page boundary.
+#define PPU_DECODE_CACHE_BLOCKS 1024
+#define PPU_DECODE_BLOCK_MAX_INSTRS 32
+
+// Back to back iterations of a spin loop after which the thread is considered
+// stuck polling, see ppuTrackSpinLoop.
+#define PPU_SPIN_LOOP_ITERS 64
+
+// Times a decode block has to be entered before it's recompiled, cold code is cheaper to interpret than to compile.
+#define PPU_JIT_COMPILE_THRESHOLD 32
+// EA's a decode block keeps recompiled code for. Real mode and translated code
+// can reach the same real page.
+#define PPU_JIT_BLOCK_EAS 2
+
+struct PPU_DECODED_INSTR {
+  PPCInterpreter::instructionHandler handler;
+  u32 opcode;
+};
+
+// Recompiled code of a decode block and the EA it was compiled for.
+struct PPU_JIT_ENTRY {
+  u64 EA = 0;
+  JITBlockFunc code = nullptr;
+};
+
+struct PPU_DECODE_BLOCK {
+  bool valid = false;
+  // Real address of the first instruction.
+  u64 startRA = 0;
+  // Generation of the page it was decoded from, see mmuMarkCodePage.
+  u32 codeGeneration = 0;
+  u8 instrCount = 0;
+  // The block is a loop that only reads memory, SPR's like the time base and
+  // registers it writes itself, so it can only exit when something outside of
+  // it changes.
+  bool spinLoop = false;
+  PPU_DECODED_INSTR instrs[PPU_DECODE_BLOCK_MAX_INSTRS];
+  // Recompiled code for this block and the entry replaced next once all are
+  // in use. Then how many times it was entered from an EA without code, up to
+  // PPU_JIT_COMPILE_THRESHOLD, and the last such EA.
+  PPU_JIT_ENTRY jitEntries[PPU_JIT_BLOCK_EAS];
+  u8 jitNextEntry = 0;
+  u32 jitExecCount = 0;
+  u64 jitLastEA = 0;
+};
 
 class PPU {
 public:
-  PPU(XENON_CONTEXT *inXenonContext, RootBus *mainBus, u32 PVR,
+  PPU(XENON_CONTEXT *inXenonContext, RootBus *mainBus, RAM *ramPtr, u32 PVR,
                   u32 PIR, const char *ppuName);
+  // Runs thread 1 of the core of corePPU on another host thread, corePPU is
+  // left with thread 0. See Config::smtHostThreads.
+  explicit PPU(PPU *corePPU);
+
+  // Executes a time slice, returns false if the PPU is idle.
+  bool ExecuteSlice();
 
-  void StartExecution();
+  // Hardware threads (IIC interrupt targets) owned by this PPU. The one
+  // running thread 0 is also the one that wakes up a stopped core.
+  u8 GetPPEMask() const {
+    if (execThreads == PPU_THREAD_1) {
+      return 1 << ppuState->ppuThread[PPU_THREAD_1].SPR.PIR;
+    }
+    return 0x3 << ppuState->ppuThread[PPU_THREAD_0].SPR.PIR;
+  }
 
   // Returns a pointer to a thread.
   PPU_THREAD_REGISTERS *GetPPUThread(u8 thrdID);
 
 private:
-  // Thread handle
-  std::thread ppuThread;
-
   // PPU running?
   bool ppuRunning = false;
 
   // Reset ocurred or signaled?
   bool systemReset = false;
 
-  // Execution threads inside this PPU.
+  // Execution threads inside this PPU, shared with the PPU running the other
+  // thread when using SMT host threads.
+  std::shared_ptr<PPU_CORE_STATE> coreState;
+  // Our view of them, see PPU_STATE.
   std::shared_ptr<PPU_STATE> ppuState;
+  // Threads executed by this PPU.
+  PPU_THREAD execThreads = PPU_THREAD_BOTH;
 
   // Main CPU Context.
   XENON_CONTEXT *xenonContext = nullptr;
 
-  // Amount of CPU ticks per instruction executed.
-  u32 ticksPerInstruction = 0;
+  // Decode cache, shared by both threads.
+  std::unique_ptr<PPU_DECODE_BLOCK[]> decodeCache;
+  // Block each thread is executing, the real address it was entered with,
+  // and the EA and index of the next instruction expected from it.
+  PPU_DECODE_BLOCK *curBlock[2] = {};
+  u64 curBlockRA[2] = {};
+  u64 curBlockNextEA[2] = {};
+  u8 curBlockIndex[2] = {};
+  // Whether the page of that block has guest patches, see PPC_Hooks.h.
+  bool curBlockHooked[2] = {};
+  // Instruction fetched by ppuReadNextInstruction, if it came pre-decoded.
+  PPCInterpreter::instructionHandler nextHandler = nullptr;
+
+  // Block recompiler, only present when enabled in the config.
+  std::unique_ptr<PPU_JIT> ppuJIT;
+  // Run whole decoded blocks at once instead of fetching every instruction.
+  bool blockDispatch = false;
+
+  // Spin loop each thread is in, and how many times in a row it entered it.
+  bool spinLoopSkip = false;
+  PPU_DECODE_BLOCK *spinBlock[2] = {};
+  u64 spinEA[2] = {};
+  u32 spinIters[2] = {};
+  // The current thread is stuck in a spin loop.
+  bool spinDetected = false;
 
   // Helpers
 
+  // Creates the decode cache and the block recompiler.
+  void initExecution();
+  // Whether a thread is enabled and executed by this PPU.
+  bool isThreadActive(PPU_THREAD thrdID);
+  // Runs a time slice on one of the threads.
+  void runThreadSlice(PPU_THREAD thrdID);
   // Returns the number of instructions per second the current
   // host computer can process.
   u32 getIPS();
   // Read next intruction from memory,
   bool ppuReadNextInstruction();
+  // Whether a valid block still holds the instructions in memory, they may
+  // have been modified anywhere on the chip.
+  bool ppuDecodeBlockCurrent(const PPU_DECODE_BLOCK *block);
+  // Fetch the instruction at CIA through the decode cache.
+  const PPU_DECODED_INSTR *ppuFetchDecodedInstruction();
+  // Returns the cached decode block at NIA, nullptr if there's none yet.
+  PPU_DECODE_BLOCK *ppuLookupDecodeBlock();
+  // Runs the recompiled block at NIA, returns the amount of instructions
+  // executed or 0 if there's no block to run.
+  u32 ppuExecuteJitBlock();
+  // Recompiles a block that got hot at EA along with the warm ones, returns
+  // false if it couldn't be compiled.
+  bool ppuCompileJitBlocks(PPU_DECODE_BLOCK *hotBlock, u64 EA);
+  // Drops all recompiled code, and the recompiler itself if disable is set.
+  void ppuDiscardJitCode(bool disable);
+  // Same, running the decoded block at NIA with the interpreter.
+  u32 ppuExecuteDecodedBlock();
+  // Decodes the basic block starting at a given real address.
+  void ppuBuildDecodeBlock(PPU_DECODE_BLOCK *block, u64 RA);
+  // Called whenever the current thread enters a decode block at a given EA.
+  void ppuTrackSpinLoop(PPU_DECODE_BLOCK *block, u64 EA);
+  // Skips the instructions a stuck thread would run until the next event, up
+  // to maxInstrs. Returns the amount skipped.
+  u64 ppuSkipSpinLoop(u64 maxInstrs);
   // Check for pending exceptions.
   void ppuCheckExceptions();
-  // Updates the current PPU's time base and decrementer based on
-  // the amount of ticks per instr we should perform.
-  void updateTimeBase();
   // Gets the current running threads.
   PPU_THREAD getCurrentRunningThreads();
 };
@@ -2,6 +2,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+#include "Core/EventScheduler/EventScheduler.h"
 #include "Core/XCPU/IIC/IIC.h"  
 #include "Core/XCPU/Bitfield.h"
 #include "Core/XCPU/XenonReservations.h"
@@ -89,19 +95,30 @@ perform logical operations on specified bits in the condition register. • CR0
 can be the implicit result of an integer instruction. • CR1 can be the implicit
 result of a floating-point instruction. • A specified CR field can indicate the
 result of either an integer or floating-point compare instruction
+
+The eight fields are stored on their own. Record form instructions only store
+their result, the LT, GT and EQ bits are computed when the field is read,
+since most CR0 updates are overwritten before anything looks at them. See
+PPCInterpreter::ppcGetCR.
 */
-union CRegister {
-  u32 CR_Hex;
-  struct {
-    u32 CR7 : 4;
-    u32 CR6 : 4;
-    u32 CR5 : 4;
-    u32 CR4 : 4;
-    u32 CR3 : 4;
-    u32 CR2 : 4;
-    u32 CR1 : 4;
-    u32 CR0 : 4;
-  };
+enum CR_FIELD_KIND : u8 {
+  // value holds the field.
+  CR_FIELD_VALUE,
+  // result compared with zero as a signed 32 bits value, value holds SO.
+  CR_FIELD_RESULT32,
+  // result compared with zero as a signed 64 bits value, value holds SO.
+  CR_FIELD_RESULT64
+};
+
+struct CR_FIELD {
+  u64 result;
+  u8 value;
+  u8 kind;
+};
+
+struct CRegister {
+  // CR0 to CR7.
+  CR_FIELD field[8];
 };
 
 /*
@@ -223,30 +240,85 @@ struct SLBEntry {
   u64 esidReg;
 };
 
+// The SLB has 64 entries. Lookups go through a small direct mapped table
+// indexed by a hash of the ESID, each slot holds the SLB index + 1 of the last
+// entry used with that hash, or 0. Slots are only hints, the entry they point
+// to is checked on every use and the whole SLB is searched on a mismatch.
+#define PPU_SLB_ENTRIES 64
+#define PPU_SLB_HASH_SIZE 64
+#define PPU_SLB_HASH(ESID)                                                     \
+  (((ESID) ^ ((ESID) >> 6) ^ ((ESID) >> 12) ^ ((ESID) >> 18) ^                 \
+    ((ESID) >> 24) ^ ((ESID) >> 30)) &                                         \
+   (PPU_SLB_HASH_SIZE - 1))
+
 // Traslation lookaside buffer
-struct TLBEntry {
+// 1024 entries, 256 indexes of 4 ways each. Way N is what the TLB SPR's call
+// set N (TS = 0b1000 >> N).
+#define PPU_TLB_INDEXES 256
+#define PPU_TLB_WAYS 4
+
+// Tag layout, VPN | p | C | LP | L | V. Invalid entries have a zero tag.
+#define PPU_TLB_TAG_VALID 0x1
+#define PPU_TLB_TAG_L 0x2
+#define PPU_TLB_TAG_LP 0x4
+// Change bit of the page. Not part of the match, a store hitting an entry
+// without it walks the page table again so the bit gets set there.
+#define PPU_TLB_TAG_C 0x8
+#define PPU_TLB_TAG_P_SHIFT 8
+#define PPU_TLB_TAG_VPN_SHIFT 16
+#define PPU_TLB_TAG(VPN, p, L, LP)                                             \
+  ((static_cast<u64>(VPN) << PPU_TLB_TAG_VPN_SHIFT) |                          \
+   (static_cast<u64>(p) << PPU_TLB_TAG_P_SHIFT) |                              \
+   ((L) && (LP) ? PPU_TLB_TAG_LP : 0) | ((L) ? PPU_TLB_TAG_L : 0) |            \
+   PPU_TLB_TAG_VALID)
+
+// Ways of an index from most to least recently used, 2 bits each. Every
+// index starts as 0, 1, 2, 3.
+#define PPU_TLB_LRU_RESET 0xE4
+
+struct TLB_Reg {
+  // Tags of the 4 ways of an index are contiguous, so they're compared at once.
+  alignas(32) u64 tag[PPU_TLB_INDEXES][PPU_TLB_WAYS];
+  // Real Page Number of every entry.
+  u64 RPN[PPU_TLB_INDEXES][PPU_TLB_WAYS];
+  // Replacement order of every index, see PPU_TLB_LRU_RESET.
+  u8 lruOrder[PPU_TLB_INDEXES];
+  // Lookup statistics.
+  u64 hits;
+  u64 misses;
+};
+
+// Effective to Real Address Translation
+// The PPE has two ERAT's per thread, one for instruction fetches (I-ERAT) and
+// one for data accesses (D-ERAT). Both are 64 entry, 2 way set associative.
+// We keep them at 4Kb granularity, large pages just take several entries.
+#define PPU_ERAT_SETS 32
+#define PPU_ERAT_WAYS 2
+
+// Translation mode bits an ERAT entry was created under.
+#define PPU_ERAT_MODE_RELOC 0x1 // Translation enabled, MSR[IR] or MSR[DR].
+#define PPU_ERAT_MODE_HV 0x2    // MSR[HV]
+#define PPU_ERAT_MODE_SF 0x4    // MSR[SF]
+
+struct ERATEntry {
   bool V;  // Entry valid.
-  u8 p;    // Page Size
-  u64 RPN; // Real page Number
-  u64 VPN; // Virtual Page Number
-  bool L;  // Large pages
-  bool LP; // Large page selector
+  bool C;  // Change bit recorded, stores can use this entry.
+  u8 mode; // Translation mode.
+  u64 EPN; // Effective Page Number
+  u64 RPN; // Real Page Number
 };
-struct TLB_Reg {
-  TLBEntry tlbSet0[256];
-  TLBEntry tlbSet1[256];
-  TLBEntry tlbSet2[256];
-  TLBEntry tlbSet3[256];
+struct ERAT_Reg {
+  ERATEntry eratSet[PPU_ERAT_SETS][PPU_ERAT_WAYS];
+  // Way to be replaced next on each set.
+  u8 lruWay[PPU_ERAT_SETS];
+  // Global tlbie generation this ERAT is in sync with.
+  u32 generation;
 };
 
 // This SPR's are duplicated for every thread.
+// XER, LR, CTR and the MSR are used by most instructions, so they're kept with
+// the other hot registers in PPU_THREAD_REGISTERS instead.
 struct PPU_THREAD_SPRS {
-  // Fixed Point Exception Register (XER)
-  XERegister XER;
-  // Link Register
-  u64 LR;
-  // Count Register
-  u64 CTR;
   // CFAR: I dont know the definition.
   u64 CFAR;
   // VXU Register Save.
@@ -287,8 +359,6 @@ struct PPU_THREAD_SPRS {
   u64 DABR;
   // Data Address Breakpoint Extension
   u64 DABRX;
-  // Machine-State Register
-  MSRegister MSR;
   // Processor Identification Register
   u32 PIR;
 };
@@ -419,6 +489,8 @@ typedef struct SOCSECENG_BLOCK {       // Addr = 80000200_00024000
 #define XE_FUSESET_LOC 0x20000
 #define XE_FUSESET_SIZE 0x17FF
 #define XE_L2_CACHE_SIZE 0x100000
+// Main memory pages tracked for stores to pre-decoded instructions.
+#define XE_CODE_PAGE_COUNT (0x20000000 >> 12)
 #define XE_PVR 0x00710500 // Corona: 0x00710800 Jasper: 0x00710500
 
 // Exception Bitmasks for Exception Register.
@@ -439,6 +511,11 @@ typedef struct SOCSECENG_BLOCK {       // Addr = 80000200_00024000
 #define PPU_EX_SC 0x1000
 #define PPU_EX_TRACE 0x2000
 #define PPU_EX_PERFMON 0x4000
+#define PPU_EX_VXU 0x8000
+
+// Requests posted to a thread by the other thread of its core, see
+// PPU_THREAD_REGISTERS::postedRequests. The low 16 bits are PPU_EX_* bits.
+#define PPU_REQ_FLUSH_ERATS 0x10000
 
 // Floating Point Register
 
@@ -454,34 +531,102 @@ union FPRegister // Double Precision
   u64 valueAsU64;
 };
 
+/*
+Vector Register (VR)
+
+The VMX128 unit has 128 of these per thread. They're kept in host order as a
+whole 128 bit value, so guest element 0 (the leftmost one) is the last element
+of every array here, e.g. guest word i is w[3 - i].
+*/
+union alignas(16) VRegister {
+  u8 b[16];
+  u16 h[8];
+  u32 w[4];
+  u64 dw[2];
+  f32 f[4];
+};
+
+/*
+Vector Status and Control Register (VSCR)
+*/
+union VSCRegister {
+  u32 VSCR_Hex;
+  struct {
+    u32 SAT : 1;
+    u32 : 15;
+    u32 NJ : 1;
+    u32 : 15;
+  };
+};
+
 //
 // PowerPC State definition
 //
 
-// This contains all registers that are duplicated per thread.
-struct PPU_THREAD_REGISTERS {
-  PPU_THREAD_SPRS SPR;
+// This contains all registers that are duplicated per thread. Registers used by
+// almost every instruction come first and are packed in a few cache lines, the
+// rest of the state only gets touched by FPU/VMX code, address translation and
+// exceptions.
+struct alignas(64) PPU_THREAD_REGISTERS {
+  //
+  // Hot state.
+  //
+
   // Current Instruction Address
   u64 CIA;
   // Next Instruction Address
   u64 NIA;
+  // Link Register
+  u64 LR;
+  // Count Register
+  u64 CTR;
+  // Machine-State Register
+  MSRegister MSR;
   // Current instruction data
   PPCOpcode CI;
+  // Fixed Point Exception Register (XER)
+  XERegister XER;
+  // Interrupt Register
+  u16 exceptReg = 0;
   // Instruction fetch flag
   bool iFetch = false;
+  // Exceptions and requests posted by the other thread of the core while it
+  // runs on its own host thread. Merged into exceptReg by the owning thread.
+  std::atomic<u32> postedRequests = 0;
   // General-Purpose Registers (32)
-  u64 GPR[32]{};
+  alignas(64) u64 GPR[32]{};
+  // Condition Register
+  CRegister CR{};
+
+  //
+  // Cold state.
+  //
+
+  // Special Purpose Registers
+  alignas(64) PPU_THREAD_SPRS SPR;
   // Floating-Point Registers (32)
   FPRegister FPR[32]{};
-  // Condition Register
-  CRegister CR;
   // Floating-Point Status Control Register
   FPSCRegister FPSCR;
+  // Host floating point exception flags raised while this thread ran, not yet
+  // folded into the FPSCR. See ppcSyncFPSCR.
+  u32 fpuHostFlags = 0;
+  // Result of the last instruction that sets FPSCR[FPRF], only classified
+  // when the FPSCR is read.
+  f64 fpuLastResult = 0.0;
+  bool fpuResultPending = false;
+  // Vector Registers (128)
+  VRegister VR[128]{};
+  // Vector Status and Control Register
+  VSCRegister VSCR{};
   // Segment Lookaside Buffer
-  SLBEntry SLB[64]{};
+  SLBEntry SLB[PPU_SLB_ENTRIES]{};
+  // SLB lookup table, see PPU_SLB_HASH.
+  u8 slbHash[PPU_SLB_HASH_SIZE]{};
+  // Instruction and Data ERAT's
+  ERAT_Reg iERAT{};
+  ERAT_Reg dERAT{};
 
-  // Interrupt Register
-  u16 exceptReg = 0;
   // Tells wheter we're currently processing an exception.
   bool exceptionTaken = false;
   // For use with Data/Instruction Storage/Segment exceptions.
@@ -494,47 +639,115 @@ struct PPU_THREAD_REGISTERS {
   // Interrupt EA for managing Interrupts.
   u64 intEA = 0;
 
-  // Helper Debug Variables
-  u64 lastWriteAddress = 0;
-  u64 lastRegValue = 0;
-
   PPU_RES *ppuRes;
 };
 
-struct PPU_STATE {
+// The hot registers must stay within the first 7 cache lines of a thread.
+static_assert(offsetof(PPU_THREAD_REGISTERS, GPR) == 64,
+              "Hot thread state header doesn't fit in a cache line");
+static_assert(offsetof(PPU_THREAD_REGISTERS, CR) + sizeof(CRegister) <= 7 * 64,
+              "Hot thread state doesn't fit in 7 cache lines");
+
+// Architected state of a PPU core, both of its hardware threads and what they
+// share.
+struct PPU_CORE_STATE {
   // Thread Specific State.
   PPU_THREAD_REGISTERS ppuThread[2];
-  // Current executing thread.
-  PPU_THREAD currentThread;
   // Shared Special Purpose Registers.
   PPU_STATE_SPRS SPR{};
-  // Translation Lookaside Buffer
+  // Translation Lookaside Buffer, only used on ERAT misses.
   TLB_Reg TLB{};
+  // Taken to update the time base, the decrementers, shared SPR's and the TLB
+  // when each thread runs on its own host thread, see ppcLockCore. The
+  // configuration SPR's read all the time (HRMOR, RMOR, LPCR, HID6, TTR) are
+  // read without it.
+  alignas(HOST_CACHE_LINE_SIZE) std::recursive_mutex lock;
+};
+
+// Execution context of a host thread running a PPU core. Normally one runs
+// both hardware threads in turns, with SMT host threads each runs one of them
+// and they share the same PPU_CORE_STATE.
+struct PPU_STATE {
+  explicit PPU_STATE(PPU_CORE_STATE *inCore)
+      : core(inCore), ppuThread(inCore->ppuThread), SPR(inCore->SPR),
+        TLB(inCore->TLB) {}
+
+  // Core we're running.
+  PPU_CORE_STATE *core;
+  // Thread Specific State, points to the threads of the core.
+  PPU_THREAD_REGISTERS *ppuThread;
+  // Registers of the current executing thread, so instructions don't have to
+  // index ppuThread. Always updated along with currentThread.
+  PPU_THREAD_REGISTERS *curThread = &ppuThread[PPU_THREAD_0];
+  // Current executing thread.
+  PPU_THREAD currentThread = PPU_THREAD_0;
+  // The other thread of the core runs on its own host thread, so its state
+  // can't be touched directly and shared state needs the core lock.
+  bool smtHostThreads = false;
   // Address Traslation Flag
   bool traslationInProgress = false;
+  // Time base ticks per instruction executed.
+  u32 ticksPerInstruction = 0;
+  // Instructions executed since the time base was last updated, and how many
+  // can run before the next decrementer underflow, see ppcUpdateTimeBase.
+  u32 tbPendingInstrs = 0;
+  u32 tbEventInstrs = 0;
   // Current PPU Name, for ease of debugging.
   const char *ppuName = "";
+  // Shared Special Purpose Registers.
+  PPU_STATE_SPRS &SPR;
+  // Translation Lookaside Buffer, only used on ERAT misses.
+  TLB_Reg &TLB;
 };
 
+// Shared by all PPU's, which run on different host threads. Fields are grouped
+// so the ones read all the time don't share cache lines with the ones written
+// often.
 struct XENON_CONTEXT {
+  //
+  // Read mostly.
+  //
+
+  // Time Base switch, possibly RTC register, the TB counter only runs if this
+  // value is set.
+  alignas(HOST_CACHE_LINE_SIZE) std::atomic<bool> timeBaseActive = false;
+
+  // Console wide virtual clock, advanced by the PPU's.
+  EventScheduler *eventScheduler = nullptr;
+
+  // Called with the hardware threads (IIC PPE mask) enabled through CTRL, so
+  // the ones running on their own host thread get scheduled.
+  std::function<void(u8)> threadStartCallback;
+
+  // Per page of main memory, twice the generation of the instructions in it,
+  // plus one while any PPU decode cache holds some. Stores to a marked page
+  // move it to the next generation, which only drops the blocks decoded
+  // from it. See mmuMarkCodePage.
+  std::atomic<u32> *codePages = new std::atomic<u32>[XE_CODE_PAGE_COUNT]{};
+
   // 32Kb SROM
   u8 *SROM = new u8[XE_SROM_SIZE];
   // 64 Kb SRAM
   u8 *SRAM = new u8[XE_SRAM_SIZE];
-  // 768 bits eFuse
-  eFuses fuseSet{};
+  // Security engine Context
+  u8 *secEngData = new u8[XE_SECENG_SIZE];
+
+  //
+  // Written while running.
+  //
 
-  // Xenon IIC.
+  // Incremented on every tlbie, as it must invalidate the ERAT's of all
+  // threads on the chip.
+  alignas(HOST_CACHE_LINE_SIZE) std::atomic<u32> eratGeneration = 0;
+
+  // Xenon IIC, its per PPE blocks are cache line aligned.
   Xe::XCPU::IIC::XenonIIC xenonIIC;
 
   XenonReservations xenonRes;
 
-  // Time Base switch, possibly RTC register, the TB counter only runs if this
-  // value is set.
-  bool timeBaseActive = false;
+  // 768 bits eFuse
+  eFuses fuseSet{};
 
-  // Security engine Context
-  u8 *secEngData = new u8[XE_SECENG_SIZE];
   SOCSECENG_BLOCK secEngBlock = {};
 };
 
@@ -2,11 +2,19 @@
 
 #include "Xenon.h"
 
+#include "Base/Config.h"
 #include "Base/Logging/Log.h"
+#include "Core/XCPU/Interpreter/PPCInterpreter.h"
+#include "Core/XCPU/Interpreter/PPC_Hooks.h"
 
-Xenon::Xenon(RootBus *inBus, const std::string blPath, eFuses inFuseSet) {
+Xenon::Xenon(RootBus *inBus, RAM *inRAM, const std::string blPath, eFuses inFuseSet,
+             EventScheduler *inEventScheduler) {
   // First, Initialize system bus.
   mainBus = inBus;
+  ramPtr = inRAM;
+
+  // The PPU's drive the virtual clock.
+  xenonContext.eventScheduler = inEventScheduler;
 
   // Set SROM to 0.
   memset(xenonContext.SROM, 0, XE_SROM_SIZE);
@@ -35,12 +43,42 @@ Xenon::Xenon(RootBus *inBus, const std::string blPath, eFuses inFuseSet) {
 Xenon::~Xenon() {}
 
 void Xenon::Start(u64 resetVector) {
+  // Guest code patches for the NAND we're booting.
+  PPCInterpreter::ppcLoadHooks(Config::patchesPath());
+
   // Start execution on every thread.
-  ppu0 = std::make_unique<STRIP_UNIQUE(ppu0)>(&xenonContext, mainBus, XE_PVR, 0, "PPU0"); // Threads 0-1
-  ppu1 = std::make_unique<STRIP_UNIQUE(ppu1)>(&xenonContext, mainBus, XE_PVR, 2, "PPU1"); // Threads 2-3
-  ppu2 = std::make_unique<STRIP_UNIQUE(ppu2)>(&xenonContext, mainBus, XE_PVR, 4, "PPU2"); // Threads 4-5
+  ppu0 = std::make_unique<STRIP_UNIQUE(ppu0)>(&xenonContext, mainBus, ramPtr, XE_PVR, 0, "PPU0"); // Threads 0-1
+  ppu1 = std::make_unique<STRIP_UNIQUE(ppu1)>(&xenonContext, mainBus, ramPtr, XE_PVR, 2, "PPU1"); // Threads 2-3
+  ppu2 = std::make_unique<STRIP_UNIQUE(ppu2)>(&xenonContext, mainBus, ramPtr, XE_PVR, 4, "PPU2"); // Threads 4-5
+  if (Config::smtHostThreads()) {
+    ppu0Thread1 = std::make_unique<STRIP_UNIQUE(ppu0Thread1)>(ppu0.get()); // Thread 1
+    ppu1Thread1 = std::make_unique<STRIP_UNIQUE(ppu1Thread1)>(ppu1.get()); // Thread 3
+    ppu2Thread1 = std::make_unique<STRIP_UNIQUE(ppu2Thread1)>(ppu2.get()); // Thread 5
+  }
 
-  while (true) {
-    std::this_thread::sleep_for(std::chrono::seconds(60));
+  scheduler = std::make_unique<STRIP_UNIQUE(scheduler)>(
+      static_cast<u32>(std::max(Config::ppuWorkers(), 0)), Config::ppuAffinity(),
+      xenonContext.eventScheduler);
+  scheduler->AddPPU(ppu0.get());
+  scheduler->AddPPU(ppu1.get());
+  scheduler->AddPPU(ppu2.get());
+  for (PPU *thread1 : {ppu0Thread1.get(), ppu1Thread1.get(), ppu2Thread1.get()}) {
+    if (thread1) {
+      scheduler->AddPPU(thread1);
+    }
   }
+
+  // Idle PPU's are parked until an interrupt is sent to them.
+  xenonContext.xenonIIC.setInterruptCallback(
+      [this](u8 ppeMask) { scheduler->WakePPEs(ppeMask); });
+  // So are hardware threads running on their own host thread until enabled.
+  xenonContext.threadStartCallback =
+      [this](u8 ppeMask) { scheduler->WakePPEs(ppeMask); };
+
+  // Devices writing main memory must drop what the PPU's cached from it.
+  ramPtr->setDMAWriteCallback(
+      [](u64 RA, u64 size) { PPCInterpreter::mmuDeviceWrite(RA, size); });
+
+  scheduler->Start();
+  scheduler->Join();
 }
@@ -15,12 +15,14 @@
 
 #include "Core/RootBus/RootBus.h"
 #include "Core/XCPU/PPU/PPU.h" 
+#include "Core/XCPU/XenonScheduler.h"
 
 #include <filesystem>
 
 class Xenon {
 public:
-  Xenon(RootBus *inBus, const std::string blPath, eFuses inFuseSet);
+  Xenon(RootBus *inBus, RAM *inRAM, const std::string blPath, eFuses inFuseSet,
+        EventScheduler *inEventScheduler);
   ~Xenon();
 
   void Start(u64 resetVector = 0x100);
@@ -30,6 +32,9 @@ private:
   // System Bus
   RootBus *mainBus = nullptr;
 
+  // Main memory, accessed directly by the MMU.
+  RAM *ramPtr = nullptr;
+
   XENON_CONTEXT xenonContext = {};
 
   // Power Processing Units, the effective execution units inside the XBox
@@ -37,4 +42,12 @@ private:
   std::unique_ptr<PPU> ppu0;
   std::unique_ptr<PPU> ppu1;
   std::unique_ptr<PPU> ppu2;
+  // Thread 1 of each PPU, when every hardware thread runs on its own host
+  // thread.
+  std::unique_ptr<PPU> ppu0Thread1;
+  std::unique_ptr<PPU> ppu1Thread1;
+  std::unique_ptr<PPU> ppu2Thread1;
+
+  // Runs the PPU's on host threads.
+  std::unique_ptr<XenonScheduler> scheduler;
 };
@@ -3,29 +3,55 @@
 #include "XenonReservations.h"
 
 XenonReservations::XenonReservations() {
-  nReservations = 0;
   nProcessors = 0;
   Reservations[0] = nullptr;
 }
 
 bool XenonReservations::Register(PPU_RES *Res) {
-  AcquireLock();
+  // Only called while setting up the PPU's, before any of them runs.
+  if (nProcessors >= 6) {
+    return false;
+  }
   Reservations[nProcessors] = Res;
   nProcessors++;
-  ReleaseLock();
   return true;
 }
 
+void XenonReservations::Reserve(PPU_RES *Res, u64 PhysAddress) {
+  const u64 oldRes = Res->resAddr.exchange(
+      (PhysAddress & XENON_RES_GRANULE_MASK) | XENON_RES_VALID);
+  if (!(oldRes & XENON_RES_VALID)) {
+    nReservations.fetch_add(1);
+  }
+}
+
+bool XenonReservations::Claim(PPU_RES *Res, u64 PhysAddress) {
+  u64 expected = (PhysAddress & XENON_RES_GRANULE_MASK) | XENON_RES_VALID;
+  if (Res->resAddr.compare_exchange_strong(expected, 0)) {
+    nReservations.fetch_sub(1);
+    return true;
+  }
+  // Lost it, or it was for another granule.
+  Clear(Res);
+  return false;
+}
+
+void XenonReservations::Clear(PPU_RES *Res) {
+  if (Res->resAddr.exchange(0) & XENON_RES_VALID) {
+    nReservations.fetch_sub(1);
+  }
+}
+
 void XenonReservations::Scan(u64 PhysAddress) {
-  PhysAddress &= ~3;
+  const u64 granule = (PhysAddress & XENON_RES_GRANULE_MASK) | XENON_RES_VALID;
 
-  AcquireLock();
   for (int i = 0; i < nProcessors; i++) {
-    // NB: order of checks matters!
-    if ((Reservations[i]->V) && PhysAddress >= Reservations[i]->resAddr) {
-      Reservations[i]->V = false;
-      Decrement();
+    u64 expected = granule;
+    // Only the thread that clears the reservation accounts for it, it might be
+    // racing with its owner or with another store.
+    if (Reservations[i]->resAddr.load(std::memory_order_relaxed) == granule &&
+        Reservations[i]->resAddr.compare_exchange_strong(expected, 0)) {
+      nReservations.fetch_sub(1);
     }
   }
-  ReleaseLock();
 }
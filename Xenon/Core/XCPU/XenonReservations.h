@@ -2,44 +2,92 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
-#include <vector>
 
 #include "Base/Types.h"
 
-struct PPU_RES {
-  u8 ppuID;
-  volatile bool V;
-  volatile u64 resAddr;
+/*
+ *	XenonReservations.h Load and reserve / store conditional tracking.
+ *
+ *	Reservations are tagged with the 128 byte reservation granule (a cache
+ *	line) they cover. Each hardware thread holds at most one, kept in a single
+ *	atomic word, so taking, checking and dropping a reservation never needs a
+ *	lock. Plain stores only pay for a fence and a relaxed load of the live
+ *	reservations counter unless some thread actually holds one.
+ *
+ *	Conditional stores to the same granule are serialized through a small
+ *	array of locks indexed by granule, so two threads holding a reservation
+ *	on it can't both succeed. They never wait on plain stores.
+ */
+
+// Reservation granule size, the L2 cache line size.
+#define XENON_RES_GRANULE_SIZE 128
+#define XENON_RES_GRANULE_MASK (~static_cast<u64>(XENON_RES_GRANULE_SIZE - 1))
+// Set in resAddr while the reservation is valid, the granule address has its
+// low bits clear so it fits there.
+#define XENON_RES_VALID 0x1
+// Conditional store locks, granules are spread over them by address.
+#define XENON_RES_LOCKS 64
+
+// Written by its owner on every lwarx/stwcx and read by every store that hits
+// a reserved granule, so each one gets its own cache line.
+struct alignas(HOST_CACHE_LINE_SIZE) PPU_RES {
+  u8 ppuID = 0;
+  // Reserved granule address | XENON_RES_VALID, or 0 if there's none.
+  std::atomic<u64> resAddr = 0;
+  // Real address, size and data (in guest byte order) the last lwarx/ldarx
+  // read, only used by the owner. A conditional store to that same word in RAM
+  // is done with a compare and swap against it, so it can't overwrite a plain
+  // store that landed after the reservation was claimed.
+  u64 resDataAddr = 0;
+  u64 resData = 0;
+  u8 resDataSize = 0;
 };
 
 class XenonReservations {
 public:
   XenonReservations();
-  virtual bool Register(PPU_RES *Res);
-  void Increment(void) {                  
-    std::lock_guard lck(ReservationLock);
-    nReservations++;
-  }
-  void Decrement(void) {
-    std::lock_guard lck(ReservationLock);
-    nReservations--;
+  bool Register(PPU_RES *Res);
+  // Sets the reservation of a thread to the granule containing PhysAddress,
+  // replacing any previous one (lwarx/ldarx).
+  void Reserve(PPU_RES *Res, u64 PhysAddress);
+  // Lock every conditional store to the granule containing PhysAddress must
+  // hold, from its Claim until the store is done.
+  std::mutex &GranuleLock(u64 PhysAddress) {
+    return granuleLocks[(PhysAddress / XENON_RES_GRANULE_SIZE) %
+                        XENON_RES_LOCKS]
+        .mutex;
   }
+  // Atomically takes the reservation of a thread if it still covers
+  // PhysAddress. On success the conditional store (stwcx/stdcx) may be
+  // performed, it must be surrounded by calls to Scan so that no other
+  // thread keeps a reservation on the granule. Any reservation is lost
+  // either way. Must be called with GranuleLock(PhysAddress) held.
+  bool Claim(PPU_RES *Res, u64 PhysAddress);
+  // Drops the reservation of a thread, if any.
+  void Clear(PPU_RES *Res);
+  // Invalidates every reservation on the granule a store to PhysAddress hits,
+  // must be called once the store is done. The store has to be visible before
+  // the count is read, or a lwarx taken meanwhile could read the old data and
+  // its stwcx still succeed.
   void Check(u64 x) {
-    if (nReservations)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (nReservations.load(std::memory_order_relaxed))
       Scan(x);
   }
-  virtual void Scan(u64 PhysAddress);
-  void AcquireLock(void) { 
-    ReservationLock.lock();
-  }
-  void ReleaseLock(void) {
-    ReservationLock.unlock();
-  }
+  void Scan(u64 PhysAddress);
 
 private:
-  long nReservations;
-  std::recursive_mutex ReservationLock;
-  int nProcessors;
+  // Live reservations, lets stores skip the scan entirely. It changes on
+  // every reservation taken or lost, keep it away from the read only part.
+  alignas(HOST_CACHE_LINE_SIZE) std::atomic<u32> nReservations = 0;
+  // Only written while registering the PPU's.
+  alignas(HOST_CACHE_LINE_SIZE) int nProcessors;
   struct PPU_RES *Reservations[6];
+  // Taken by different threads, one line each.
+  struct alignas(HOST_CACHE_LINE_SIZE) GRANULE_LOCK {
+    std::mutex mutex;
+  };
+  GRANULE_LOCK granuleLocks[XENON_RES_LOCKS];
 };
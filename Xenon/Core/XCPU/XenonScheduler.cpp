@@ -0,0 +1,179 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include "XenonScheduler.h"
+
+#include <string>
+
+#include "Base/Logging/Log.h"
+#include "Base/Thread.h"
+
+XenonScheduler::XenonScheduler(u32 workerCount, s32 affinityBase,
+                               EventScheduler *eventScheduler) {
+  numWorkers = workerCount;
+  affinity = affinityBase;
+  events = eventScheduler;
+}
+
+XenonScheduler::~XenonScheduler() {
+  Stop();
+  Join();
+}
+
+void XenonScheduler::AddPPU(PPU *ppu) {
+  auto schedPPU = std::make_unique<SCHED_PPU>();
+  schedPPU->ppu = ppu;
+  schedPPU->ppeMask = ppu->GetPPEMask();
+  ppus.push_back(std::move(schedPPU));
+}
+
+void XenonScheduler::Start() {
+  if (numWorkers == 0) {
+    numWorkers = static_cast<u32>(ppus.size());
+  }
+
+  for (u32 workerID = 0; workerID < numWorkers; workerID++) {
+    workers.push_back(std::make_unique<SCHED_WORKER>());
+  }
+
+  // Spread the PPU's between the workers, they'll steal from each other
+  // anyway.
+  for (size_t ppuIdx = 0; ppuIdx < ppus.size(); ppuIdx++) {
+    enqueue(ppuIdx % numWorkers, ppus[ppuIdx].get());
+  }
+
+  LOG_INFO(Xenon, "Scheduler: Running {} PPU's on {} host threads.",
+           ppus.size(), numWorkers);
+
+  running = true;
+  for (u32 workerID = 0; workerID < numWorkers; workerID++) {
+    workers[workerID]->thread =
+        std::thread(&XenonScheduler::workerLoop, this, workerID);
+  }
+}
+
+void XenonScheduler::Join() {
+  for (auto &worker : workers) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+void XenonScheduler::Stop() {
+  {
+    std::lock_guard lck(parkMutex);
+    running = false;
+  }
+  workCV.notify_all();
+}
+
+void XenonScheduler::WakePPEs(u8 ppeMask) {
+  for (auto &schedPPU : ppus) {
+    if ((schedPPU->ppeMask & ppeMask) == 0) {
+      continue;
+    }
+    std::unique_lock lck(parkMutex);
+    if (schedPPU->state == SCHED_PPU_PARKED) {
+      schedPPU->state = SCHED_PPU_QUEUED;
+      lck.unlock();
+      // Any worker will do, idle ones steal it right away.
+      enqueue(0, schedPPU.get());
+    } else {
+      // It's running or about to, make sure it doesn't park after its slice.
+      schedPPU->wakePending = true;
+    }
+  }
+}
+
+void XenonScheduler::workerLoop(u32 workerID) {
+  const std::string workerName = "PPU Worker " + std::to_string(workerID);
+  Base::SetCurrentThreadName(workerName.c_str());
+  if (affinity >= 0) {
+    Base::SetCurrentThreadAffinity(static_cast<u32>(affinity) + workerID);
+  }
+
+  while (running) {
+    SCHED_PPU *schedPPU = dequeue(workerID);
+    if (schedPPU == nullptr) {
+      std::unique_lock lck(parkMutex);
+      if (runningPPUs == 0 && queuedPPUs == 0 && events &&
+          events->GetTicksToNextEvent() != XE_NO_EVENT) {
+        // Every PPU is parked, nobody advances the virtual clock. Jump to
+        // the next device event, it'll likely wake someone up.
+        runningPPUs++;
+        lck.unlock();
+        events->FastForward();
+        lck.lock();
+        runningPPUs--;
+        // Don't spin through periodic events that wake nobody up.
+        workCV.wait_for(lck, std::chrono::milliseconds(1),
+                        [this] { return queuedPPUs != 0 || !running; });
+        continue;
+      }
+      // Nothing to run anywhere, sleep until a PPU is queued.
+      workCV.wait(lck, [this] { return queuedPPUs != 0 || !running; });
+      continue;
+    }
+
+    {
+      std::lock_guard lck(parkMutex);
+      schedPPU->state = SCHED_PPU_RUNNING;
+      schedPPU->wakePending = false;
+      runningPPUs++;
+    }
+
+    const bool runnable = schedPPU->ppu->ExecuteSlice();
+    Base::Log::ClearThreadContext();
+
+    {
+      std::unique_lock lck(parkMutex);
+      runningPPUs--;
+      if (!runnable && !schedPPU->wakePending) {
+        // Idle, park it until the IIC wakes it up.
+        schedPPU->state = SCHED_PPU_PARKED;
+        continue;
+      }
+      schedPPU->state = SCHED_PPU_QUEUED;
+    }
+    enqueue(workerID, schedPPU);
+  }
+}
+
+void XenonScheduler::enqueue(u32 workerID, SCHED_PPU *schedPPU) {
+  {
+    std::lock_guard lck(workers[workerID]->queueMutex);
+    workers[workerID]->runQueue.push_back(schedPPU);
+  }
+  {
+    std::lock_guard lck(parkMutex);
+    queuedPPUs++;
+  }
+  workCV.notify_one();
+}
+
+XenonScheduler::SCHED_PPU *XenonScheduler::dequeue(u32 workerID) {
+  // Our own queue, oldest first.
+  {
+    SCHED_WORKER &worker = *workers[workerID];
+    std::lock_guard lck(worker.queueMutex);
+    if (!worker.runQueue.empty()) {
+      SCHED_PPU *schedPPU = worker.runQueue.front();
+      worker.runQueue.pop_front();
+      queuedPPUs--;
+      return schedPPU;
+    }
+  }
+
+  // Steal from the others.
+  for (u32 offset = 1; offset < numWorkers; offset++) {
+    SCHED_WORKER &victim = *workers[(workerID + offset) % numWorkers];
+    std::lock_guard lck(victim.queueMutex);
+    if (!victim.runQueue.empty()) {
+      SCHED_PPU *schedPPU = victim.runQueue.back();
+      victim.runQueue.pop_back();
+      queuedPPUs--;
+      return schedPPU;
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,93 @@
+// Copyright 2025 Xenon Emulator Project
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Core/EventScheduler/EventScheduler.h"
+#include "Core/XCPU/PPU/PPU.h"
+
+/*
+ *	XenonScheduler.h Runs the PPU's on a pool of host worker threads.
+ *
+ *	PPU's are executed one time slice at a time. Each worker has its own run
+ *	queue and keeps running the PPU's on it, idle workers steal from the
+ *	others. A PPU with no running threads is parked, and isn't scheduled again
+ *	until the IIC generates an interrupt for one of its hardware threads. Idle
+ *	workers sleep until there is something to run, and when every PPU is
+ *	parked the virtual clock is fast forwarded to the next device event.
+ */
+
+class XenonScheduler {
+public:
+  // A workerCount of zero creates one worker per PPU. If affinityBase isn't
+  // negative, worker N is pinned to host core affinityBase + N.
+  XenonScheduler(u32 workerCount, s32 affinityBase,
+                 EventScheduler *eventScheduler);
+  ~XenonScheduler();
+
+  // Adds a PPU to be scheduled, must be called before Start.
+  void AddPPU(PPU *ppu);
+
+  // Starts the workers.
+  void Start();
+
+  // Waits until every worker has finished.
+  void Join();
+
+  // Stops the workers after their current time slice.
+  void Stop();
+
+  // Wakes up the parked PPU's owning any of the given hardware threads.
+  void WakePPEs(u8 ppeMask);
+
+private:
+  enum SCHED_PPU_STATE : u8 {
+    SCHED_PPU_QUEUED,
+    SCHED_PPU_RUNNING,
+    SCHED_PPU_PARKED
+  };
+
+  struct SCHED_PPU {
+    PPU *ppu = nullptr;
+    u8 ppeMask = 0;
+    // Both protected by parkMutex.
+    SCHED_PPU_STATE state = SCHED_PPU_QUEUED;
+    bool wakePending = false;
+  };
+
+  struct SCHED_WORKER {
+    std::thread thread;
+    std::mutex queueMutex;
+    std::deque<SCHED_PPU *> runQueue;
+  };
+
+  // Worker entry point.
+  void workerLoop(u32 workerID);
+  // Adds a PPU to the run queue of a given worker.
+  void enqueue(u32 workerID, SCHED_PPU *schedPPU);
+  // Takes the next PPU to run, from our own queue first, or from the back of
+  // another worker's queue.
+  SCHED_PPU *dequeue(u32 workerID);
+
+  std::vector<std::unique_ptr<SCHED_PPU>> ppus;
+  std::vector<std::unique_ptr<SCHED_WORKER>> workers;
+  u32 numWorkers = 0;
+  s32 affinity = -1;
+  EventScheduler *events = nullptr;
+
+  // Used to park PPU's and to put idle workers to sleep.
+  std::mutex parkMutex;
+  std::condition_variable workCV;
+  // PPU's waiting in any run queue.
+  std::atomic<u32> queuedPPUs = 0;
+  // PPU's executing a time slice, protected by parkMutex.
+  u32 runningPPUs = 0;
+  std::atomic<bool> running = false;
+};
@@ -155,6 +155,12 @@ void Xe::Xenos::XGPU::ConfigWrite(u64 writeAddress, u64 data, u8 byteCount) {
   return;
 }
 
+u32 Xe::Xenos::XGPU::GetBAR(u8 barNum) {
+  u32 bar = 0;
+  memcpy(&bar, &xgpuConfigSpace.data[0x10 + barNum * 4], sizeof(bar));
+  return bar;
+}
+
 bool Xe::Xenos::XGPU::isAddressMappedInBAR(u32 address) {
   #define ADDRESS_BOUNDS_CHECK(a, b) (address >= a && address <= (a + b))
   if (ADDRESS_BOUNDS_CHECK(xgpuConfigSpace.configSpaceHeader.BAR0, XGPU_DEVICE_SIZE) ||
@@ -109,6 +109,9 @@ public:
 
   bool isAddressMappedInBAR(u32 address);
 
+  // Returns the address a given BAR (0 - 5) is set to.
+  u32 GetBAR(u8 barNum);
+
 private:
   // Mutex handle
   std::mutex mutex{};
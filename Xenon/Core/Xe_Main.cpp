@@ -10,6 +10,7 @@ XeMain::XeMain() {
   auto logLevel = Config::getCurrentLogLevel();
   logFilter = std::make_unique<STRIP_UNIQUE(logFilter)>(logLevel);
   Base::Log::SetGlobalFilter(*logFilter);
+  eventScheduler = std::make_unique<STRIP_UNIQUE(eventScheduler)>();
   pciBridge = std::make_unique<STRIP_UNIQUE(pciBridge)>();
   createPCIDevices();
   addPCIDevices();
@@ -18,7 +19,7 @@ XeMain::XeMain() {
   xenos = std::make_shared<STRIP_UNIQUE(xenos)>(ram.get());
   createHostBridge();
   createRootBus();
-  xenonCPU = std::make_shared<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), Config::oneBlPath(), cpuFuses);
+  xenonCPU = std::make_shared<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), ram.get(), Config::oneBlPath(), cpuFuses, eventScheduler.get());
   pciBridge->RegisterIIC(xenonCPU->GetIICPointer());
 }
 XeMain::~XeMain() {
@@ -55,6 +56,12 @@ XeMain::~XeMain() {
 
   // CPU last as we will need to shutdown the threads.
   xenonCPU.reset();
+
+  // Nothing can post events anymore.
+  eventScheduler.reset();
+
+  // Write out whatever is still queued.
+  Base::Log::Stop();
 }
 
 void XeMain::start() {
@@ -101,11 +108,11 @@ void XeMain::createPCIDevices() {
   ehci1 = std::make_unique<STRIP_UNIQUE(ehci1)>("EHCI1", EHCI1_DEV_SIZE);
 
   ram = std::make_shared<STRIP_UNIQUE(ram)>("RAM", RAM_START_ADDR, RAM_START_ADDR + RAM_SIZE, false);
-  sfcx = std::make_unique<STRIP_UNIQUE(sfcx)>("SFCX", Config::nandPath(), SFCX_DEV_SIZE, pciBridge.get());
+  sfcx = std::make_unique<STRIP_UNIQUE(sfcx)>("SFCX", Config::nandPath(), SFCX_DEV_SIZE, pciBridge.get(), eventScheduler.get());
   xma = std::make_unique<STRIP_UNIQUE(xma)>("XMA", XMA_DEV_SIZE);
   odd = std::make_shared<STRIP_UNIQUE(odd)>("CDROM", ODD_DEV_SIZE, pciBridge.get(), ram.get());
   hdd = std::make_shared<STRIP_UNIQUE(hdd)>("HDD", HDD_DEV_SIZE, pciBridge.get());
-  smcCore = std::make_unique<STRIP_UNIQUE(smcCore)>("SMC", SMC_DEV_SIZE, pciBridge.get(), smcCoreState.get());
+  smcCore = std::make_unique<STRIP_UNIQUE(smcCore)>("SMC", SMC_DEV_SIZE, pciBridge.get(), smcCoreState.get(), eventScheduler.get());
   nandDevice = std::make_unique<STRIP_UNIQUE(nandDevice)>("NAND", Config::nandPath(), NAND_START_ADDR, NAND_END_ADDR, true);
 }
 
@@ -6,6 +6,7 @@
 #include "Base/Logging/Log.h"
 #include "Base/Path_util.h"
 
+#include "Core/EventScheduler/EventScheduler.h"
 #include "Core/NAND/NAND.h"
 #include "Core/RAM/RAM.h"
 #include "Core/RootBus/HostBridge/HostBridge.h"
@@ -62,6 +63,7 @@ private:
   std::unique_ptr<Base::Log::Filter> logFilter;
 
   // Main Emulator objects
+  std::unique_ptr<EventScheduler> eventScheduler; // Virtual clock, shared by the CPU and devices
   std::unique_ptr<RootBus> rootBus; // RootBus Object
   std::unique_ptr<HostBridge> hostBridge; // HostBridge Object
   std::unique_ptr<PCIBridge> pciBridge; // PCIBridge Object
@@ -0,0 +1,48 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <memory>
+
+#include <fmt/format.h>
+
+#include "PPCReferenceDecoder.h"
+
+/*
+ *	DecoderTest.cpp Checks PPCDecoder against the flat table it replaced.
+ *
+ *	Every primary opcode and extended opcode combination is decoded with the
+ *	register fields in between set to a few patterns. Both must return the same
+ *	handler, except for 0x60000000 which the old decoder special cased as a nop
+ *	and now decodes as the ori r0,r0,0 it is.
+ */
+
+int main() {
+  const std::unique_ptr<PPCReferenceDecoder> reference =
+      std::make_unique<PPCReferenceDecoder>();
+
+  u32 mismatches = 0;
+  for (const u32 fieldBits : {0x00000000u, 0x03FFF800u, 0x02AAA800u,
+                              0x01555000u}) {
+    for (u32 primaryOp = 0; primaryOp < 64; primaryOp++) {
+      for (u32 extendedOp = 0; extendedOp < 0x800; extendedOp++) {
+        const u32 inst = (primaryOp << 26) | fieldBits | extendedOp;
+        PPCInterpreter::instructionHandler expected = reference->decode(inst);
+        if (inst == 0x60000000) {
+          expected = &PPCInterpreter::PPCInterpreter_ori;
+        }
+        if (PPCInterpreter::ppcDecoder.decode(inst) != expected) {
+          if (mismatches++ < 32) {
+            fmt::print(stderr, "{:#010x} ({}) decodes to a different handler\n",
+                       inst, PPCInterpreter::legacy_GetOpcodeName(inst));
+          }
+        }
+      }
+    }
+  }
+
+  if (mismatches != 0) {
+    fmt::print(stderr, "{} mismatches\n", mismatches);
+    return 1;
+  }
+  fmt::print("PPCDecoder matches the reference decoder\n");
+  return 0;
+}
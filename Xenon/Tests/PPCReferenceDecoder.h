@@ -0,0 +1,72 @@
+// Copyright 2025 Xenon Emulator Project
+
+#pragma once
+
+#include <array>
+#include <initializer_list>
+
+#include "Core/XCPU/Interpreter/PPC_DecodeTable.h"
+
+/*
+ *	PPCReferenceDecoder.h The flat decode table PPCDecoder replaced.
+ *
+ *	One handler per primary opcode and low 11 bits, 0x20000 entries filled at
+ *	runtime from the same lists as PPCDecoder, exactly as the old decoder did.
+ *	Only used to check and benchmark PPCDecoder against it.
+ */
+
+class PPCReferenceDecoder {
+public:
+  struct InstrInfo {
+    u32 value;
+    PPCInterpreter::instructionHandler ptr;
+    u32 magn = 0;
+  };
+
+  PPCReferenceDecoder() {
+    table.fill(&PPCInterpreter::PPCInterpreter_invalid);
+    PPCInterpreter::ppcFillDecodeTable(*this);
+  }
+
+  PPCInterpreter::instructionHandler decode(u32 inst) const noexcept {
+    if (inst == 0x60000000) {
+      return &PPCInterpreter::PPCInterpreter_nop;
+    }
+    return table[((inst >> 26) | (inst << 6)) & 0x1FFFF];
+  }
+
+  void fillTable(u32 mainOp, u32 count, u32 sh,
+                 std::initializer_list<InstrInfo> entries) noexcept {
+    if (sh < 11) {
+      for (const auto &v : entries) {
+        for (u32 i = 0; i < 1u << (v.magn + (11 - sh - count)); i++) {
+          for (u32 j = 0; j < 1u << sh; j++) {
+            const u32 k = (((i << (count - v.magn)) | v.value) << sh) | j;
+            c_at(table, (k << 6) | mainOp) = v.ptr;
+          }
+        }
+      }
+    } else {
+      // Main table (special case)
+      for (const auto &v : entries) {
+        for (u32 i = 0; i < 1u << 11; i++) {
+          c_at(table, i << 6 | v.value) = v.ptr;
+        }
+      }
+    }
+  }
+
+  void fillTableVMX128(u32 mainOp, u32 mask,
+                       std::initializer_list<InstrInfo> entries) noexcept {
+    for (const auto &v : entries) {
+      for (u32 k = 0; k < 1u << 11; k++) {
+        if ((k & mask) == (v.value & mask)) {
+          c_at(table, (k << 6) | mainOp) = v.ptr;
+        }
+      }
+    }
+  }
+
+private:
+  std::array<PPCInterpreter::instructionHandler, 0x20000> table;
+};
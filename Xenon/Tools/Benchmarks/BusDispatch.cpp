@@ -0,0 +1,234 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Core/NAND/NAND.h"
+#include "Core/RAM/RAM.h"
+#include "Core/RootBus/RootBus.h"
+
+/*
+ *	BusDispatch.cpp Measures the cost of resolving a physical address to the
+ *	device that owns it.
+ *
+ *	Usage: XenonBusBenchmark [accesses per address class]
+ *	Builds a bus laid out like a retail console, then reads RAM, NAND, a Xenos
+ *	register and the SMC through RootBus, which uses the page granular memory
+ *	maps, and through a copy of the device scan RootBus, HostBridge and
+ *	PCIBridge did before. Devices are stubs, except for Xenos, so the numbers
+ *	are mostly dispatch.
+ */
+
+// Config space addresses, bus 0 holds the PCI bridge and Xenos, bus 1 the
+// devices behind the bridge.
+#define BENCH_CONFIG_ADDR(bus, dev, reg)                                       \
+  (PCI_CONFIG_REGION_ADDRESS | ((bus) << 20) | ((dev) << 15) | (reg))
+
+struct BENCH_PCI_DEVICE_DESC {
+  const char *name;
+  u64 size;
+  u32 devNum;
+  u32 functNum;
+  u32 BAR;
+};
+
+// In the order XeMain attaches them, the SMC is the last one scanned.
+static const BENCH_PCI_DEVICE_DESC benchPCIDevices[] = {
+    {"OHCI0", 0x1000, 0x4, 0, 0xEA003000},
+    {"OHCI1", 0x1000, 0x5, 0, 0xEA005000},
+    {"EHCI0", 0x1000, 0x4, 1, 0xEA004000},
+    {"EHCI1", 0x1000, 0x5, 1, 0xEA006000},
+    {"AUDIOCTRLR", 0x40, 0x9, 0, 0xEA001600},
+    {"ETHERNET", 0x80, 0x7, 0, 0xEA001400},
+    {"SFCX", 0x400, 0x8, 0, 0xEA00C000},
+    {"XMA", 0x400, 0x0, 0, 0xEA001800},
+    {"CDROM", 0x30, 0x1, 0, 0xEA001200},
+    {"HDD", 0x30, 0x2, 0, 0xEA001300},
+    {"SMC", 0x100, 0xA, 0, 0xEA001000},
+};
+
+#define BENCH_XGPU_BAR 0xEC800000
+#define BENCH_PCI_BRIDGE_WINDOW 0xEA000000
+
+class BenchDevice : public SystemDevice {
+public:
+  using SystemDevice::SystemDevice;
+  void Read(u64 readAddress, u64 *data, u8 byteCount) override {
+    *data = readAddress;
+  }
+};
+
+class BenchPCIDevice : public PCIDevice {
+public:
+  using PCIDevice::PCIDevice;
+  void Read(u64 readAddress, u64 *data, u8 byteCount) override {
+    *data = readAddress;
+  }
+  void ConfigWrite(u64 writeAddress, u64 data, u8 byteCount) override {
+    memcpy(&pciConfigSpace.data[static_cast<u8>(writeAddress)], &data,
+           byteCount);
+  }
+};
+
+// The bus walk used before the memory maps: RootBus devices in order, then the
+// Host Bridge registers, Xenos, the PCI Bridge and every BAR of every device
+// behind it.
+struct LEGACY_BUS {
+  std::vector<SystemDevice *> rootDevices;
+  std::mutex hostBridgeMutex;
+  u32 hostBridgeBARs[6] = {};
+  Xe::Xenos::XGPU *xGPU = nullptr;
+  PCIBridge *pciBridge = nullptr;
+
+  void Read(u64 readAddress, u64 *data, u8 byteCount) {
+    for (auto &device : rootDevices) {
+      if (readAddress >= device->GetStartAddress() &&
+          readAddress <= device->GetEndAddress()) {
+        device->Read(readAddress, data, byteCount);
+        return;
+      }
+    }
+
+    std::lock_guard lck(hostBridgeMutex);
+    for (const u32 bar : hostBridgeBARs) {
+      if (readAddress >= bar && readAddress <= bar + XGPU_DEVICE_SIZE) {
+        *data = 0;
+        return;
+      }
+    }
+    if (xGPU->isAddressMappedInBAR(static_cast<u32>(readAddress))) {
+      xGPU->Read(readAddress, data, byteCount);
+      return;
+    }
+    if (pciBridge->isAddressMappedinBAR(static_cast<u32>(readAddress))) {
+      if (readAddress >= PCI_BRIDGE_BASE_ADDRESS &&
+          readAddress <= PCI_BRIDGE_BASE_END_ADDRESS) {
+        pciBridge->Read(readAddress, data, byteCount);
+        return;
+      }
+      for (auto &device : pciBridge->getPCIDevices()) {
+        if (device->isAddressMappedInBAR(static_cast<u32>(readAddress))) {
+          device->Read(readAddress, data, byteCount);
+          return;
+        }
+      }
+    }
+    *data = 0xFFFFFFFFFFFFFFFF;
+  }
+};
+
+// Runs accessCount reads over the given addresses, returns ns per read.
+template <typename Bus>
+static double benchReads(Bus &bus, const std::vector<u64> &addresses,
+                         u64 accessCount, u64 *checksum) {
+  u64 sum = 0;
+  const auto timerStart = std::chrono::steady_clock::now();
+  for (u64 access = 0; access < accessCount; access++) {
+    u64 data = 0;
+    bus.Read(addresses[access % addresses.size()], &data, 4);
+    sum += data;
+  }
+  const auto timerEnd = std::chrono::steady_clock::now();
+  *checksum += sum;
+  return std::chrono::duration<double, std::nano>(timerEnd - timerStart)
+             .count() /
+         static_cast<double>(accessCount);
+}
+
+int main(int argc, char *argv[]) {
+  const u64 accessCount = argc > 1 ? std::stoull(argv[1]) : 10000000;
+  if (accessCount == 0) {
+    fmt::print(stderr, "Usage: {} [accesses per address class]\n", argv[0]);
+    return 1;
+  }
+
+  //
+  // Build the bus like XeMain does.
+  //
+
+  BenchDevice nand("NAND", NAND_START_ADDR, NAND_END_ADDR, true);
+  BenchDevice ram("RAM", RAM_START_ADDR, RAM_START_ADDR + RAM_SIZE, false);
+  Xe::Xenos::XGPU xenos(nullptr);
+  PCIBridge pciBridge;
+  std::vector<std::unique_ptr<BenchPCIDevice>> pciDevices;
+  for (const BENCH_PCI_DEVICE_DESC &desc : benchPCIDevices) {
+    pciDevices.push_back(
+        std::make_unique<BenchPCIDevice>(desc.name, desc.size));
+    pciBridge.addPCIDevice(pciDevices.back().get());
+  }
+
+  HostBridge hostBridge;
+  hostBridge.RegisterXGPU(&xenos);
+  hostBridge.RegisterPCIBridge(&pciBridge);
+
+  RootBus rootBus;
+  rootBus.AddHostBridge(&hostBridge);
+  rootBus.AddDevice(&nand);
+  rootBus.AddDevice(&ram);
+
+  // Program the BAR's, as the kernel would.
+  rootBus.ConfigWrite(BENCH_CONFIG_ADDR(0, 0x0, 0x10), BENCH_PCI_BRIDGE_WINDOW,
+                      4);
+  rootBus.ConfigWrite(BENCH_CONFIG_ADDR(0, 0x2, 0x10), BENCH_XGPU_BAR, 4);
+  for (const BENCH_PCI_DEVICE_DESC &desc : benchPCIDevices) {
+    rootBus.ConfigWrite(BENCH_CONFIG_ADDR(1, desc.devNum, 0x10) |
+                            (desc.functNum << 12),
+                        desc.BAR, 4);
+  }
+
+  LEGACY_BUS legacyBus;
+  legacyBus.rootDevices = {&nand, &ram};
+  for (u8 barNum = 0; barNum < 6; barNum++) {
+    u64 bar = 0;
+    rootBus.ConfigRead(BENCH_CONFIG_ADDR(0, 0x1, 0x10 + barNum * 4), &bar, 4);
+    legacyBus.hostBridgeBARs[barNum] = static_cast<u32>(bar);
+  }
+  legacyBus.xGPU = &xenos;
+  legacyBus.pciBridge = &pciBridge;
+
+  //
+  // Run every address class through both.
+  //
+
+  struct ADDRESS_CLASS {
+    const char *name;
+    std::vector<u64> addresses;
+  };
+  const ADDRESS_CLASS addressClasses[] = {
+      {"RAM", {0x00100000, 0x01234560, 0x0FFFFFF0, 0x1FFFF000}},
+      {"NAND", {NAND_START_ADDR, NAND_START_ADDR + 0x40000,
+                NAND_START_ADDR + 0x1000000}},
+      {"GPU register", {BENCH_XGPU_BAR + 0x1928 * 4, BENCH_XGPU_BAR + 0xA07 * 4}},
+      {"SMC", {0xEA001050, 0xEA001084}},
+  };
+
+  u64 checksum = 0;
+  fmt::print("{:<14} {:>14} {:>14} {:>9}\n", "Address class", "Scan (ns)",
+             "Map (ns)", "Speedup");
+  for (const ADDRESS_CLASS &addressClass : addressClasses) {
+    // Both must resolve to the same device.
+    for (const u64 address : addressClass.addresses) {
+      u64 scanData = 0, mapData = 0;
+      legacyBus.Read(address, &scanData, 4);
+      rootBus.Read(address, &mapData, 4);
+      if (scanData != mapData) {
+        fmt::print(stderr, "{:#x} resolves to different devices\n", address);
+        return 1;
+      }
+    }
+
+    const double scanNs =
+        benchReads(legacyBus, addressClass.addresses, accessCount, &checksum);
+    const double mapNs =
+        benchReads(rootBus, addressClass.addresses, accessCount, &checksum);
+    fmt::print("{:<14} {:>14.2f} {:>14.2f} {:>8.2f}x\n", addressClass.name,
+               scanNs, mapNs, scanNs / mapNs);
+  }
+  fmt::print("Checksum: {:#x}\n", checksum);
+  return 0;
+}
@@ -0,0 +1,99 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Tests/PPCReferenceDecoder.h"
+
+/*
+ *	DecodeStream.cpp Measures instruction decoding on a recorded opcode stream.
+ *
+ *	Usage: XenonDecodeBenchmark <opcode stream> [decodes]
+ *	The stream is a file of big endian 32 bit opcodes, as the guest sees them,
+ *	in the order they were executed during a boot. Boot code can't be
+ *	distributed, so no stream ships with the emulator. Every opcode is decoded
+ *	through PPCDecoder and through the flat table it replaced, and both must
+ *	agree, then each one decodes the stream over and over until the given
+ *	amount of decodes is reached.
+ */
+
+// Decodes the stream until decodeCount is reached, returns ns per decode.
+template <typename Decoder>
+static double benchDecodes(const Decoder &decoder, const std::vector<u32> &stream,
+                           u64 decodeCount, u64 *checksum) {
+  u64 sum = 0;
+  u64 decoded = 0;
+  const auto timerStart = std::chrono::steady_clock::now();
+  while (decoded < decodeCount) {
+    for (const u32 opcode : stream) {
+      sum += reinterpret_cast<uintptr_t>(decoder.decode(opcode));
+    }
+    decoded += stream.size();
+  }
+  const auto timerEnd = std::chrono::steady_clock::now();
+  *checksum += sum;
+  return std::chrono::duration<double, std::nano>(timerEnd - timerStart)
+             .count() /
+         static_cast<double>(decoded);
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fmt::print(stderr, "Usage: {} <opcode stream> [decodes]\n", argv[0]);
+    return 1;
+  }
+  const u64 decodeCount = argc > 2 ? std::stoull(argv[2]) : 100000000;
+
+  std::ifstream file(argv[1], std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    fmt::print(stderr, "Unable to open {}\n", argv[1]);
+    return 1;
+  }
+  const u64 fileSize = static_cast<u64>(file.tellg());
+  std::vector<u32> stream(fileSize / sizeof(u32));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(stream.data()),
+            stream.size() * sizeof(u32));
+  if (stream.empty() || !file) {
+    fmt::print(stderr, "{} holds no opcodes\n", argv[1]);
+    return 1;
+  }
+  for (u32 &opcode : stream) {
+    opcode = std::byteswap(opcode);
+  }
+
+  const std::unique_ptr<PPCReferenceDecoder> reference =
+      std::make_unique<PPCReferenceDecoder>();
+
+  // Both must agree, but for the nop the old table special cased.
+  for (const u32 opcode : stream) {
+    if (opcode != 0x60000000 &&
+        PPCInterpreter::ppcDecoder.decode(opcode) != reference->decode(opcode)) {
+      fmt::print(stderr, "{:#010x} ({}) decodes to a different handler\n",
+                 opcode, PPCInterpreter::legacy_GetOpcodeName(opcode));
+      return 1;
+    }
+  }
+
+  u64 checksum = 0;
+  const double flatNs =
+      benchDecodes(*reference, stream, decodeCount, &checksum);
+  const double compactNs = benchDecodes(PPCInterpreter::ppcDecoder, stream,
+                                        decodeCount, &checksum);
+
+  fmt::print("Stream: {} opcodes\n", stream.size());
+  fmt::print("{:<10} {:>12} {:>12}\n", "Decoder", "Size (KiB)", "ns/decode");
+  fmt::print("{:<10} {:>12} {:>12.3f}\n", "Flat", sizeof(PPCReferenceDecoder) / 1024,
+             flatNs);
+  fmt::print("{:<10} {:>12} {:>12.3f}\n", "Compact",
+             sizeof(PPCInterpreter::PPCDecoder) / 1024, compactNs);
+  fmt::print("Speedup: {:.2f}x\n", flatNs / compactNs);
+  fmt::print("Checksum: {:#x}\n", checksum);
+  return 0;
+}
@@ -0,0 +1,134 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <bit>
+#include <chrono>
+#include <iterator>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "Base/Config.h"
+#include "Core/XCPU/PPU/PPU.h"
+
+/*
+ *	DispatchIps.cpp Compares the instructions per second of the per
+ *	instruction interpreter loop and of the block dispatch loop.
+ *
+ *	Usage: XenonDispatchBenchmark [loop iterations]
+ *	Runs the same guest loop of ALU ops, a load, a store and a branch on a PPU
+ *	with Config::blockDispatch off and on, then checks both left the registers
+ *	and memory the loop computes.
+ */
+
+// Where the loop and the word it updates live, in hypervisor real mode with
+// EA[0] set so HRMOR doesn't apply.
+#define BENCH_CODE_RA 0x10000
+#define BENCH_DATA_RA 0x20000
+#define BENCH_REAL_EA(RA) (0x8000000000000000 | (RA))
+
+static const u32 benchLoopCode[] = {
+    0x38630001, // loop: addi   r3,r3,1
+    0x5464103A, //       slwi   r4,r3,2
+    0x7CA52214, //       add    r5,r5,r4
+    0x80C70000, //       lwz    r6,0(r7)
+    0x7CC61A78, //       xor    r6,r6,r3
+    0x90C70000, //       stw    r6,0(r7)
+    0x7CA83378, //       or     r8,r5,r6
+    0x7D264050, //       subf   r9,r6,r8
+    0x7C035040, //       cmplw  r3,r10
+    0x4082FFDC, //       bne    loop
+    0x48000000  // end:  b      end
+};
+#define BENCH_LOOP_INSTRS 10
+#define BENCH_END_EA BENCH_REAL_EA(BENCH_CODE_RA + BENCH_LOOP_INSTRS * 4)
+
+struct BENCH_RESULT {
+  double IPS = 0;
+  u64 r5 = 0;
+  u64 r9 = 0;
+  u32 dataWord = 0;
+};
+
+// Runs the loop to completion on a fresh PPU, with or without block dispatch.
+static BENCH_RESULT benchRun(RootBus *rootBus, RAM *ram, bool blockDispatch,
+                             u32 iterations) {
+  for (u32 idx = 0; idx < std::size(benchLoopCode); idx++) {
+    ram->Write(BENCH_CODE_RA + idx * 4, std::byteswap(benchLoopCode[idx]), 4);
+  }
+  ram->Write(BENCH_DATA_RA, 0, 4);
+
+  Config::blockDispatchEnabled = blockDispatch;
+  XENON_CONTEXT xenonContext = {};
+  PPU ppu(&xenonContext, rootBus, ram, 0x00710200, 0, "PPU0");
+
+  PPU_THREAD_REGISTERS *thread = ppu.GetPPUThread(PPU_THREAD_0);
+  thread->NIA = BENCH_REAL_EA(BENCH_CODE_RA);
+  thread->GPR[7] = BENCH_REAL_EA(BENCH_DATA_RA);
+  thread->GPR[10] = iterations;
+
+  const auto timerStart = std::chrono::steady_clock::now();
+  while (thread->NIA != BENCH_END_EA) {
+    ppu.ExecuteSlice();
+  }
+  const auto timerEnd = std::chrono::steady_clock::now();
+
+  BENCH_RESULT result;
+  result.IPS = static_cast<double>(iterations) * BENCH_LOOP_INSTRS /
+               std::chrono::duration<double>(timerEnd - timerStart).count();
+  result.r5 = thread->GPR[5];
+  result.r9 = thread->GPR[9];
+  u64 dataWord = 0;
+  ram->Read(BENCH_DATA_RA, &dataWord, 4);
+  result.dataWord = std::byteswap(static_cast<u32>(dataWord));
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  const u64 iterations = argc > 1 ? std::stoull(argv[1]) : 10000000;
+  if (iterations == 0 || iterations > 0xFFFFFFFF) {
+    fmt::print(stderr, "Usage: {} [loop iterations]\n", argv[0]);
+    return 1;
+  }
+
+  RootBus rootBus;
+  RAM ram("RAM", RAM_START_ADDR, RAM_START_ADDR + RAM_SIZE, false);
+  rootBus.AddDevice(&ram);
+
+  // Timing must not depend on the host.
+  Config::ticksPerInstruction = 1;
+  Config::spinLoopSkipEnabled = false;
+  Config::jitEnabled = false;
+
+  // What the loop computes.
+  u64 r5 = 0;
+  u32 dataWord = 0;
+  for (u32 r3 = 1; r3 <= iterations; r3++) {
+    r5 += static_cast<u64>(r3) << 2 & 0xFFFFFFFC;
+    dataWord ^= r3;
+  }
+  const u64 r9 = (r5 | dataWord) - dataWord;
+
+  fmt::print("{:<16} {:>10}\n", "Loop", "MIPS");
+  double defaultIPS = 0;
+  for (const bool blockDispatch : {false, true}) {
+    const BENCH_RESULT result = benchRun(&rootBus, &ram, blockDispatch,
+                                         static_cast<u32>(iterations));
+    if (result.r5 != r5 || result.r9 != r9 || result.dataWord != dataWord) {
+      fmt::print(stderr,
+                 "{} loop computed r5 = {:#x}, r9 = {:#x}, word = {:#x}, "
+                 "expected {:#x}, {:#x}, {:#x}\n",
+                 blockDispatch ? "Block dispatch" : "Default", result.r5,
+                 result.r9, result.dataWord, r5, r9, dataWord);
+      return 1;
+    }
+    fmt::print("{:<16} {:>10.2f}\n",
+               blockDispatch ? "Block dispatch" : "Default",
+               result.IPS / 1000000);
+    if (blockDispatch) {
+      fmt::print("Speedup: {:.2f}x\n", result.IPS / defaultIPS);
+    } else {
+      defaultIPS = result.IPS;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,288 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Core/XCPU/Interpreter/PPCInterpreter.h"
+
+/*
+ *	ReservationStress.cpp Hammers one reservation granule from every hardware
+ *	thread of the chip at once.
+ *
+ *	Usage: XenonReservationBenchmark [increments per thread]
+ *	Each hardware thread runs on its own host thread, like with SMT host
+ *	threads, and atomically increments a shared counter with lwarx/stwcx.,
+ *	then stores to its own word in the same granule, which drops every other
+ *	reservation on it. Any conditional store that succeeds without holding the
+ *	reservation loses an increment, so the counter must end up at exactly
+ *	threads * increments. Runs with 1, 2 (one core), 4 and 6 threads.
+ *
+ *	A last run has the sixth thread do plain stores to the counter word itself
+ *	while the other five increment it. Stores put a sequence number in the
+ *	upper half of the word and increments only wrap the lower half, so a
+ *	conditional store that overwrites a plain store it didn't see brings back
+ *	an older sequence number. The storing thread checks for it after every
+ *	store, and the counter must end up with the last one.
+ *
+ *	Instructions are fetched and executed one by one through the MMU and the
+ *	interpreter handlers, without the PPU class, as it can't start threads
+ *	without a booting kernel.
+ */
+
+// Where the loop and the granule it updates live, in hypervisor real mode
+// with EA[0] set so HRMOR doesn't apply.
+#define BENCH_CODE_RA 0x10000
+#define BENCH_MIXED_CODE_RA 0x11000
+#define BENCH_COUNTER_RA 0x20000
+#define BENCH_REAL_EA(RA) (0x8000000000000000 | (RA))
+
+static const u32 benchLoopCode[] = {
+    0x7C602028, // loop: lwarx  r3,0,r4
+    0x38630001, //       addi   r3,r3,1
+    0x7C60212D, //       stwcx. r3,0,r4
+    0x4082FFF4, //       bne-   loop
+    0x38A50001, //       addi   r5,r5,1
+    0x90A60000, //       stw    r5,0(r6)
+    0x7C053840, //       cmplw  r5,r7
+    0x4082FFE4, //       bne    loop
+    0x48000000  // end:  b      end
+};
+// Instructions of an increment, and of a failed attempt at it.
+#define BENCH_INCREMENT_INSTRS 8
+#define BENCH_RETRY_INSTRS 4
+#define BENCH_END_EA BENCH_REAL_EA(BENCH_CODE_RA + 8 * 4)
+
+// Same loop, but the increment doesn't carry into the upper half, followed by
+// the plain store loop. It leaves early if the word lost one of its stores.
+static const u32 benchMixedCode[] = {
+    0x7C602028, // loop:  lwarx  r3,0,r4
+    0x39030001, //        addi   r8,r3,1
+    0x5103043E, //        rlwimi r3,r8,0,16,31
+    0x7C60212D, //        stwcx. r3,0,r4
+    0x4082FFF0, //        bne-   loop
+    0x38A50001, //        addi   r5,r5,1
+    0x90A60000, //        stw    r5,0(r6)
+    0x7C053840, //        cmplw  r5,r7
+    0x4082FFE0, //        bne    loop
+    0x48000024, //        b      end
+    0x3CA50001, // store: addis  r5,r5,1
+    0x90A40000, //        stw    r5,0(r4)
+    0x81040000, //        lwz    r8,0(r4)
+    0x5508001E, //        rlwinm r8,r8,0,0,15
+    0x7C082840, //        cmplw  r8,r5
+    0x4082000C, //        bne    end
+    0x7C253840, //        cmpld  r5,r7
+    0x4082FFE4, //        bne    store
+    0x48000000  // end:   b      end
+};
+#define BENCH_MIXED_INCREMENT_INSTRS 9
+#define BENCH_MIXED_RETRY_INSTRS 5
+#define BENCH_MIXED_STORE_EA BENCH_REAL_EA(BENCH_MIXED_CODE_RA + 10 * 4)
+#define BENCH_MIXED_END_EA BENCH_REAL_EA(BENCH_MIXED_CODE_RA + 18 * 4)
+
+// Counter word, then one word per hardware thread.
+#define BENCH_THREAD_WORD_RA(thrdID) (BENCH_COUNTER_RA + 4 + (thrdID) * 4)
+
+struct BENCH_THREAD {
+  std::unique_ptr<PPU_STATE> ppuState;
+  std::unique_ptr<PPU_RES> ppuRes;
+  u64 executedInstrs = 0;
+  bool faulted = false;
+};
+
+static u32 benchReadWord(RAM *ram, u32 RA) {
+  u64 data = 0;
+  ram->Read(RA, &data, 4);
+  return std::byteswap(static_cast<u32>(data));
+}
+
+// Fetches and runs instructions until the thread reaches endEA.
+static void benchRunThread(BENCH_THREAD *benchThread, u64 endEA,
+                           const std::atomic<bool> *startFlag) {
+  PPU_STATE *hCore = benchThread->ppuState.get();
+  PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+
+  while (!startFlag->load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  while (thread.NIA != endEA) {
+    thread.CIA = thread.NIA;
+    thread.NIA += 4;
+    thread.iFetch = true;
+    thread.CI.opcode = PPCInterpreter::MMURead32(hCore, thread.CIA);
+    thread.iFetch = false;
+    PPCInterpreter::ppcExecuteSingleInstruction(hCore, nullptr);
+    benchThread->executedInstrs++;
+    if (thread.exceptReg != 0) {
+      benchThread->faulted = true;
+      return;
+    }
+  }
+}
+
+// Runs the increments on threadCount threads, the last one doing plain stores
+// to the counter instead when plainStores is set. Returns false on a lost
+// update.
+static bool benchRun(RAM *ram, u8 threadCount, bool plainStores,
+                     u64 increments) {
+  const u8 incrementThreads = plainStores ? threadCount - 1 : threadCount;
+  const u64 endEA = plainStores ? BENCH_MIXED_END_EA : BENCH_END_EA;
+
+  // A fresh chip every run, threads fill the cores in order like the hardware
+  // thread numbering does.
+  std::unique_ptr<XENON_CONTEXT> xenonContext =
+      std::make_unique<XENON_CONTEXT>();
+  PPCInterpreter::intXCPUContext = xenonContext.get();
+  std::unique_ptr<PPU_CORE_STATE> coreStates[3];
+  std::vector<BENCH_THREAD> benchThreads(threadCount);
+  for (u8 thrdID = 0; thrdID < threadCount; thrdID++) {
+    std::unique_ptr<PPU_CORE_STATE> &coreState = coreStates[thrdID / 2];
+    if (!coreState) {
+      coreState = std::make_unique<PPU_CORE_STATE>();
+    }
+    BENCH_THREAD &benchThread = benchThreads[thrdID];
+    benchThread.ppuState = std::make_unique<PPU_STATE>(coreState.get());
+    PPU_STATE *hCore = benchThread.ppuState.get();
+    hCore->currentThread = static_cast<PPU_THREAD>(thrdID % 2);
+    hCore->curThread = &hCore->ppuThread[hCore->currentThread];
+    hCore->smtHostThreads = true;
+
+    PPU_THREAD_REGISTERS &thread = *hCore->curThread;
+    thread.MSR.MSR_Hex = 0x9000000000000000;
+    thread.SPR.PIR = thrdID;
+    thread.GPR[4] = BENCH_REAL_EA(BENCH_COUNTER_RA);
+    if (thrdID >= incrementThreads) {
+      // Stores a new sequence number as often as the others increment.
+      thread.NIA = BENCH_MIXED_STORE_EA;
+      thread.GPR[7] = increments << 16;
+    } else {
+      thread.NIA = BENCH_REAL_EA(plainStores ? BENCH_MIXED_CODE_RA
+                                             : BENCH_CODE_RA);
+      thread.GPR[6] = BENCH_REAL_EA(BENCH_THREAD_WORD_RA(thrdID));
+      thread.GPR[7] = increments;
+    }
+
+    benchThread.ppuRes = std::make_unique<PPU_RES>();
+    benchThread.ppuRes->ppuID = thrdID;
+    thread.ppuRes = benchThread.ppuRes.get();
+    xenonContext->xenonRes.Register(thread.ppuRes);
+  }
+  for (u8 idx = 0; idx < 7; idx++) {
+    ram->Write(BENCH_COUNTER_RA + idx * 4, 0, 4);
+  }
+
+  std::atomic<bool> startFlag = false;
+  std::vector<std::thread> hostThreads;
+  for (BENCH_THREAD &benchThread : benchThreads) {
+    hostThreads.emplace_back(benchRunThread, &benchThread, endEA, &startFlag);
+  }
+  const auto timerStart = std::chrono::steady_clock::now();
+  startFlag.store(true, std::memory_order_release);
+  for (std::thread &hostThread : hostThreads) {
+    hostThread.join();
+  }
+  const auto timerEnd = std::chrono::steady_clock::now();
+
+  u64 retries = 0;
+  for (u8 thrdID = 0; thrdID < threadCount; thrdID++) {
+    const BENCH_THREAD &benchThread = benchThreads[thrdID];
+    if (benchThread.faulted) {
+      fmt::print(stderr, "Thread {} took an exception at {:#x}\n", thrdID,
+                 benchThread.ppuState->curThread->CIA);
+      return false;
+    }
+    if (thrdID >= incrementThreads) {
+      continue;
+    }
+    if (benchReadWord(ram, BENCH_THREAD_WORD_RA(thrdID)) != increments) {
+      fmt::print(stderr, "Thread {} lost a plain store\n", thrdID);
+      return false;
+    }
+    retries += plainStores ? (benchThread.executedInstrs -
+                              increments * BENCH_MIXED_INCREMENT_INSTRS) /
+                                 BENCH_MIXED_RETRY_INSTRS
+                           : (benchThread.executedInstrs -
+                              increments * BENCH_INCREMENT_INSTRS) /
+                                 BENCH_RETRY_INSTRS;
+  }
+
+  const u64 totalIncrements = increments * incrementThreads;
+  const u32 counter = benchReadWord(ram, BENCH_COUNTER_RA);
+  fmt::print("{:<8} {:>14.2f} {:>14.2f} {:>14}\n",
+             plainStores ? fmt::format("{}+1", incrementThreads)
+                         : fmt::format("{}", threadCount),
+             std::chrono::duration<double, std::nano>(timerEnd - timerStart)
+                     .count() /
+                 static_cast<double>(totalIncrements),
+             static_cast<double>(retries) / totalIncrements, counter);
+
+  if (plainStores) {
+    // The storing thread leaves early with the sequence number it lost.
+    const PPU_THREAD_REGISTERS &storeThread =
+        *benchThreads.back().ppuState->curThread;
+    const u64 lastStore = storeThread.GPR[5] >> 16;
+    if (storeThread.GPR[5] != storeThread.GPR[7] ||
+        storeThread.GPR[8] != (storeThread.GPR[5] & 0xFFFF0000)) {
+      fmt::print(stderr,
+                 "Plain store {} was overwritten by a conditional store, "
+                 "read back {:#x}\n",
+                 lastStore, storeThread.GPR[8] >> 16);
+      return false;
+    }
+    if ((counter >> 16) != (lastStore & 0xFFFF)) {
+      fmt::print(stderr,
+                 "Counter is {:#x}, the last plain store was overwritten\n",
+                 counter);
+      return false;
+    }
+  } else if (counter != totalIncrements) {
+    fmt::print(stderr, "Counter is {}, expected {}, {} increments lost\n",
+               counter, totalIncrements,
+               static_cast<s64>(totalIncrements) - counter);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  const u64 increments = argc > 1 ? std::stoull(argv[1]) : 1000000;
+  if (increments == 0 || increments > 0xFFFFFFFF / 6) {
+    fmt::print(stderr, "Usage: {} [increments per thread]\n", argv[0]);
+    return 1;
+  }
+
+  RootBus rootBus;
+  RAM ram("RAM", RAM_START_ADDR, RAM_START_ADDR + RAM_SIZE, false);
+  rootBus.AddDevice(&ram);
+  PPCInterpreter::sysBus = &rootBus;
+  PPCInterpreter::mainMemory = &ram;
+
+  for (u32 idx = 0; idx < std::size(benchLoopCode); idx++) {
+    ram.Write(BENCH_CODE_RA + idx * 4, std::byteswap(benchLoopCode[idx]), 4);
+  }
+  for (u32 idx = 0; idx < std::size(benchMixedCode); idx++) {
+    ram.Write(BENCH_MIXED_CODE_RA + idx * 4,
+              std::byteswap(benchMixedCode[idx]), 4);
+  }
+
+  fmt::print("{:<8} {:>14} {:>14} {:>14}\n", "Threads", "ns/increment",
+             "Retries/inc", "Counter");
+  for (const u8 threadCount : {1, 2, 4, 6}) {
+    if (!benchRun(&ram, threadCount, false, increments)) {
+      return 1;
+    }
+  }
+  if (!benchRun(&ram, 6, true, increments)) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,116 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Core/XCPU/Interpreter/PPCInterpreter.h"
+
+/*
+ *	SlbLookup.cpp Measures the cost of finding the SLB entry of a segment.
+ *
+ *	Usage: XenonSlbBenchmark [lookups per SLB fill]
+ *	Fills the SLB of a thread with 4, 16 and 64 valid segments and looks up
+ *	random segments among them through mmuSearchSlbEntry, and through a copy
+ *	of the full SLB scan MMUTranslateAddress did before.
+ */
+
+// The SLB walk used before the lookup table.
+static SLBEntry *legacySearchSlbEntry(PPU_STATE *hCore, u64 ESID) {
+  for (auto &slbEntry : hCore->curThread->SLB) {
+    if (slbEntry.V && (slbEntry.ESID == ESID)) {
+      return &slbEntry;
+    }
+  }
+  return nullptr;
+}
+
+// Small LCG, so every run looks up the same segments.
+static u64 benchRandom(u64 *seed) {
+  *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return *seed >> 33;
+}
+
+// Runs lookupCount lookups over the given ESID's, returns ns per lookup.
+template <typename Search>
+static double benchLookups(Search search, PPU_STATE *hCore,
+                           const std::vector<u64> &lookups, u64 lookupCount,
+                           u64 *checksum) {
+  u64 sum = 0;
+  const auto timerStart = std::chrono::steady_clock::now();
+  for (u64 lookup = 0; lookup < lookupCount; lookup++) {
+    const SLBEntry *slbEntry =
+        search(hCore, lookups[lookup % lookups.size()]);
+    sum += slbEntry->VSID;
+  }
+  const auto timerEnd = std::chrono::steady_clock::now();
+  *checksum += sum;
+  return std::chrono::duration<double, std::nano>(timerEnd - timerStart)
+             .count() /
+         static_cast<double>(lookupCount);
+}
+
+int main(int argc, char *argv[]) {
+  const u64 lookupCount = argc > 1 ? std::stoull(argv[1]) : 10000000;
+  if (lookupCount == 0) {
+    fmt::print(stderr, "Usage: {} [lookups per SLB fill]\n", argv[0]);
+    return 1;
+  }
+
+  std::unique_ptr<PPU_CORE_STATE> coreState =
+      std::make_unique<PPU_CORE_STATE>();
+  PPU_STATE ppuState(coreState.get());
+
+  u64 checksum = 0;
+  fmt::print("{:<12} {:>14} {:>14} {:>9}\n", "Segments", "Scan (ns)",
+             "Hash (ns)", "Speedup");
+  for (const u8 segmentCount : {4, 16, 64}) {
+    // Fill the SLB from the first entry, like the kernel does, with segments
+    // spread over the 36 bit ESID space.
+    u64 seed = segmentCount;
+    std::vector<u64> segments;
+    for (auto &slbEntry : ppuState.curThread->SLB) {
+      slbEntry = {};
+    }
+    memset(ppuState.curThread->slbHash, 0, sizeof(ppuState.curThread->slbHash));
+    for (u8 slbIdx = 0; slbIdx < segmentCount; slbIdx++) {
+      SLBEntry &slbEntry = ppuState.curThread->SLB[slbIdx];
+      slbEntry.V = 1;
+      slbEntry.ESID = benchRandom(&seed) & 0xFFFFFFFFF;
+      slbEntry.VSID = benchRandom(&seed) << 28;
+      segments.push_back(slbEntry.ESID);
+    }
+
+    std::vector<u64> lookups(4096);
+    for (u64 &ESID : lookups) {
+      ESID = segments[benchRandom(&seed) % segments.size()];
+    }
+
+    // Both must find the same entry, and neither one a segment that isn't
+    // there.
+    for (const u64 ESID : lookups) {
+      if (legacySearchSlbEntry(&ppuState, ESID) !=
+          PPCInterpreter::mmuSearchSlbEntry(&ppuState, ESID)) {
+        fmt::print(stderr, "ESID {:#x} resolves to different entries\n", ESID);
+        return 1;
+      }
+    }
+    if (PPCInterpreter::mmuSearchSlbEntry(&ppuState, 0x1000000000) != nullptr) {
+      fmt::print(stderr, "Lookup of a missing segment hit\n");
+      return 1;
+    }
+
+    const double scanNs = benchLookups(legacySearchSlbEntry, &ppuState,
+                                       lookups, lookupCount, &checksum);
+    const double hashNs =
+        benchLookups(PPCInterpreter::mmuSearchSlbEntry, &ppuState, lookups,
+                     lookupCount, &checksum);
+    fmt::print("{:<12} {:>14.2f} {:>14.2f} {:>8.2f}x\n", segmentCount, scanNs,
+               hashNs, scanNs / hashNs);
+  }
+  fmt::print("Checksum: {:#x}\n", checksum);
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright 2025 Xenon Emulator Project
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Base/Logging/Flight_recorder.h"
+
+/*
+ *	LogDecoder.cpp Turns a flight recorder ring back into text.
+ *
+ *	Usage: XenonLogDecoder <xenon_flight_recorder.bin> [output.txt]
+ *	Entries are printed oldest first. Slots that were being written when the
+ *	emulator died are skipped.
+ */
+
+using namespace Base::Log;
+
+static std::string getName(const char *name) {
+  return std::string(name, strnlen(name, FlightRecorderNameSize));
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fmt::print(stderr, "Usage: {} <flight recorder file> [output file]\n",
+               argv[0]);
+    return 1;
+  }
+
+  std::ifstream ringFile(argv[1], std::ios::binary);
+  if (!ringFile) {
+    fmt::print(stderr, "Unable to open {}\n", argv[1]);
+    return 1;
+  }
+
+  FlightRecorderHeader header{};
+  ringFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!ringFile || header.magic != FlightRecorderMagic) {
+    fmt::print(stderr, "{} is not a flight recorder file\n", argv[1]);
+    return 1;
+  }
+  if (header.version != FlightRecorderVersion ||
+      header.entry_size != sizeof(FlightRecorderEntry) ||
+      header.entry_count == 0) {
+    fmt::print(stderr, "Unsupported flight recorder version {}\n",
+               header.version);
+    return 1;
+  }
+
+  std::vector<FlightRecorderEntry> entries(header.entry_count);
+  ringFile.seekg(FlightRecorderDataOffset);
+  ringFile.read(reinterpret_cast<char *>(entries.data()),
+                entries.size() * sizeof(FlightRecorderEntry));
+  if (!ringFile) {
+    fmt::print(stderr, "{} is truncated\n", argv[1]);
+    return 1;
+  }
+
+  std::FILE *out = stdout;
+  if (argc > 2) {
+    out = std::fopen(argv[2], "w");
+    if (out == nullptr) {
+      fmt::print(stderr, "Unable to create {}\n", argv[2]);
+      return 1;
+    }
+  }
+
+  // The ring only holds the last entry_count entries.
+  const u64 endIndex = header.write_index;
+  const u64 startIndex =
+      endIndex > header.entry_count ? endIndex - header.entry_count : 0;
+  u64 skippedEntries = 0;
+
+  for (u64 index = startIndex; index < endIndex; index++) {
+    const FlightRecorderEntry &entry = entries[index % header.entry_count];
+    if (entry.sequence != index + 1) {
+      skippedEntries++;
+      continue;
+    }
+
+    const std::string className =
+        entry.log_class < header.class_count
+            ? getName(header.class_names[entry.log_class])
+            : fmt::format("Class{}", entry.log_class);
+    const std::string levelName =
+        entry.log_level < header.level_count
+            ? getName(header.level_names[entry.log_level])
+            : fmt::format("Level{}", entry.log_level);
+    const std::string message(
+        entry.message, strnlen(entry.message, FlightRecorderMessageSize));
+
+    const u64 seconds = entry.timestamp / 1000000;
+    const u64 micros = entry.timestamp % 1000000;
+    if (entry.thread_id != FlightRecorderNoThread) {
+      fmt::print(out, "[{:6}.{:06}] [{}] <{}> (PPE{} {:#x}) {}\n", seconds,
+                 micros, className, levelName, entry.thread_id, entry.cia,
+                 message);
+    } else {
+      fmt::print(out, "[{:6}.{:06}] [{}] <{}> {}\n", seconds, micros,
+                 className, levelName, message);
+    }
+  }
+
+  if (skippedEntries != 0) {
+    fmt::print(stderr, "Skipped {} incomplete entries\n", skippedEntries);
+  }
+  if (out != stdout) {
+    std::fclose(out);
+  }
+  return 0;
+}